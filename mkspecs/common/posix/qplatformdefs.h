@@ -63,6 +63,8 @@
 #define QT_LSEEK                ::lseek64
 #define QT_FSTAT                ::fstat64
 #define QT_FTRUNCATE            ::ftruncate64
+#define QT_PREAD                ::pread64
+#define QT_PWRITE               ::pwrite64
 
 // Standard C89
 #define QT_FOPEN                ::fopen64
@@ -88,6 +90,8 @@
 #define QT_LSEEK                ::lseek
 #define QT_FSTAT                ::fstat
 #define QT_FTRUNCATE            ::ftruncate
+#define QT_PREAD                ::pread
+#define QT_PWRITE               ::pwrite
 
 // Posix extensions to C89
 #if !defined(QT_USE_XOPEN_LFS_EXTENSIONS) && !defined(QT_NO_USE_FSEEKO)
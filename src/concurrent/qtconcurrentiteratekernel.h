@@ -45,6 +45,7 @@
 #if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
 
 #include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
 #include <QtConcurrent/qtconcurrentmedian.h>
 #include <QtConcurrent/qtconcurrentthreadengine.h>
 
@@ -361,6 +362,130 @@ public:
     DefaultValueContainer<ResultType> defaultValue;
 };
 
+/*
+    The PhasedKernel class runs algorithms that need several parallel passes
+    over the data, like sorting or scanning. Each phase consists of a number
+    of independent tasks, which the threads reserve in blocks sized by the
+    BlockSizeManager. The thread that completes the last task of a phase
+    moves on to the next one, starting more threads as needed, so no thread
+    ever waits for another.
+*/
+template <typename T>
+class PhasedKernel : public ThreadEngine<T>
+{
+public:
+    typedef T ResultType;
+
+    explicit PhasedKernel(QThreadPool *pool)
+        : ThreadEngine<T>(pool)
+    {
+    }
+
+    // The number of phases, and the number of tasks in each of them (which
+    // may be 0). Must not change while the kernel runs.
+    virtual int phaseCount() const = 0;
+    virtual int taskCount(int phase) const = 0;
+    virtual void runTask(int phase, int task) = 0;
+
+    void start() override
+    {
+        int totalTaskCount = 0;
+        for (int phase = 0; phase < phaseCount(); ++phase)
+            totalTaskCount += taskCount(phase);
+
+        progressReportingEnabled = this->isProgressReportingEnabled();
+        if (progressReportingEnabled && totalTaskCount > 0)
+            this->setProgressRange(0, totalTaskCount);
+
+        currentPhase = -1;
+        advancePhase();
+    }
+
+    bool shouldStartThread() override
+    {
+        QMutexLocker locker(&phaseMutex);
+        return nextTask < currentTaskCount && !this->shouldThrottleThread();
+    }
+
+    ThreadFunctionResult threadFunction() override
+    {
+        BlockSizeManager blockSizeManager(ThreadEngineBase::threadPool, maximumTaskCount());
+
+        for (;;) {
+            if (this->isCanceled())
+                break;
+
+            const int currentBlockSize = blockSizeManager.blockSize();
+
+            // Reserve a block of the current phase's tasks for this thread.
+            QMutexLocker locker(&phaseMutex);
+            const int phase = currentPhase;
+            const int beginIndex = nextTask;
+            const int endIndex = qMin(beginIndex + currentBlockSize, currentTaskCount);
+            if (beginIndex >= endIndex) {
+                // No more work until the threads running this phase finish
+                break;
+            }
+            nextTask = endIndex;
+            locker.unlock();
+
+            this->waitForResume(); // (only waits if the qfuture is paused.)
+
+            if (shouldStartThread())
+                this->startThread();
+
+            blockSizeManager.timeBeforeUser();
+            for (int i = beginIndex; i < endIndex; ++i)
+                runTask(phase, i);
+            blockSizeManager.timeAfterUser();
+
+            locker.relock();
+            finishedTasks += endIndex - beginIndex;
+            if (finishedTasks == currentTaskCount)
+                advancePhase();
+            locker.unlock();
+
+            // Report progress if progress reporting enabled.
+            if (progressReportingEnabled) {
+                completed.fetchAndAddAcquire(endIndex - beginIndex);
+                this->setProgressValue(this->completed.loadRelaxed());
+            }
+
+            if (this->shouldThrottleThread())
+                return ThrottleThread;
+        }
+        return ThreadFinished;
+    }
+
+private:
+    // Called with phaseMutex locked, or before any thread was started.
+    void advancePhase()
+    {
+        do {
+            ++currentPhase;
+            currentTaskCount = currentPhase < phaseCount() ? taskCount(currentPhase) : 0;
+        } while (currentTaskCount == 0 && currentPhase < phaseCount());
+        nextTask = 0;
+        finishedTasks = 0;
+    }
+
+    int maximumTaskCount() const
+    {
+        int result = 0;
+        for (int phase = 0; phase < phaseCount(); ++phase)
+            result = qMax(result, taskCount(phase));
+        return result;
+    }
+
+    QMutex phaseMutex;
+    int currentPhase = -1;
+    int currentTaskCount = 0;
+    int nextTask = 0;
+    int finishedTasks = 0;
+    QAtomicInt completed;
+    bool progressReportingEnabled = true;
+};
+
 } // namespace QtConcurrent
 
 
@@ -0,0 +1,288 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+/*!
+  \class QtConcurrent::ScanKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(QThreadPool *pool, Sequence &sequence, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items in \a sequence with the result of combining it with all the items
+    preceding it, using \a operation. The \a operation must be associative; it is applied to chunks
+    of the range concurrently.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa blockingInclusiveScan(), exclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(Sequence &sequence, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items in \a sequence with the result of combining it with all the items
+    preceding it, using \a operation. The \a operation must be associative; it is applied to chunks
+    of the range concurrently.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \sa blockingInclusiveScan(), exclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items from \a begin to \a end with the result of combining it with all the
+    items preceding it, using \a operation. The \a operation must be associative; it is applied to
+    chunks of the range concurrently.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa blockingInclusiveScan(), exclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(Iterator begin, Iterator end, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items from \a begin to \a end with the result of combining it with all the
+    items preceding it, using \a operation. The \a operation must be associative; it is applied to
+    chunks of the range concurrently.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \sa blockingInclusiveScan(), exclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(QThreadPool *pool, Sequence &sequence, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items in \a sequence with the result of combining it with all the items
+    preceding it, using \a operation. The \a operation must be associative; it is applied to chunks
+    of the range concurrently.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(Sequence &sequence, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items in \a sequence with the result of combining it with all the items
+    preceding it, using \a operation. The \a operation must be associative; it is applied to chunks
+    of the range concurrently.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items from \a begin to \a end with the result of combining it with all the
+    items preceding it, using \a operation. The \a operation must be associative; it is applied to
+    chunks of the range concurrently.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(Iterator begin, Iterator end, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items from \a begin to \a end with the result of combining it with all the
+    items preceding it, using \a operation. The \a operation must be associative; it is applied to
+    chunks of the range concurrently.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \note This function will block until all items have been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation> QFuture<void> QtConcurrent::exclusiveScan(QThreadPool *pool, Sequence &sequence, T &&initialValue, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items in \a sequence with the result of combining \a initialValue with all
+    the items preceding it, using \a operation. The first item is replaced by \a initialValue. The
+    \a operation must be associative; it is applied to chunks of the range concurrently.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa blockingExclusiveScan(), inclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation> QFuture<void> QtConcurrent::exclusiveScan(Sequence &sequence, T &&initialValue, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items in \a sequence with the result of combining \a initialValue with all
+    the items preceding it, using \a operation. The first item is replaced by \a initialValue. The
+    \a operation must be associative; it is applied to chunks of the range concurrently.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \sa blockingExclusiveScan(), inclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename T, typename BinaryOperation> QFuture<void> QtConcurrent::exclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, T &&initialValue, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items from \a begin to \a end with the result of combining \a initialValue
+    with all the items preceding it, using \a operation. The first item is replaced by \a
+    initialValue. The \a operation must be associative; it is applied to chunks of the range
+    concurrently.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa blockingExclusiveScan(), inclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename T, typename BinaryOperation> QFuture<void> QtConcurrent::exclusiveScan(Iterator begin, Iterator end, T &&initialValue, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items from \a begin to \a end with the result of combining \a initialValue
+    with all the items preceding it, using \a operation. The first item is replaced by \a
+    initialValue. The \a operation must be associative; it is applied to chunks of the range
+    concurrently.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \sa blockingExclusiveScan(), inclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation> void QtConcurrent::blockingExclusiveScan(QThreadPool *pool, Sequence &sequence, T &&initialValue, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items in \a sequence with the result of combining \a initialValue with all
+    the items preceding it, using \a operation. The first item is replaced by \a initialValue. The
+    \a operation must be associative; it is applied to chunks of the range concurrently.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa exclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename T, typename BinaryOperation> void QtConcurrent::blockingExclusiveScan(Sequence &sequence, T &&initialValue, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items in \a sequence with the result of combining \a initialValue with all
+    the items preceding it, using \a operation. The first item is replaced by \a initialValue. The
+    \a operation must be associative; it is applied to chunks of the range concurrently.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \note This function will block until all items have been processed.
+
+    \sa exclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename T, typename BinaryOperation> void QtConcurrent::blockingExclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, T &&initialValue, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items from \a begin to \a end with the result of combining \a initialValue
+    with all the items preceding it, using \a operation. The first item is replaced by \a
+    initialValue. The \a operation must be associative; it is applied to chunks of the range
+    concurrently.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa exclusiveScan(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename T, typename BinaryOperation> void QtConcurrent::blockingExclusiveScan(Iterator begin, Iterator end, T &&initialValue, BinaryOperation operation = BinaryOperation())
+
+    \since 6.4
+
+    Replaces each of the items from \a begin to \a end with the result of combining \a initialValue
+    with all the items preceding it, using \a operation. The first item is replaced by \a
+    initialValue. The \a operation must be associative; it is applied to chunks of the range
+    concurrently.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \note This function will block until all items have been processed.
+
+    \sa exclusiveScan(), {Concurrent Sort and Scan}
+*/
@@ -0,0 +1,309 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QTCONCURRENT_SCAN_H
+#define QTCONCURRENT_SCAN_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentscankernel.h>
+#include <QtConcurrent/qtconcurrentfunctionwrappers.h>
+#include <QtCore/qfuture.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+
+
+namespace QtConcurrent {
+
+// inclusiveScan() on sequences
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename BinaryOperation>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename BinaryOperation = std::plus<>>
+#endif
+QFuture<void> inclusiveScan(QThreadPool *pool, Sequence &sequence,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(pool, sequence.begin(), sequence.end(), std::move(operation));
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename BinaryOperation>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename BinaryOperation = std::plus<>>
+#endif
+QFuture<void> inclusiveScan(Sequence &sequence, BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                              std::move(operation));
+}
+
+// inclusiveScan() on iterators
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename BinaryOperation>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename BinaryOperation = std::plus<>>
+#endif
+QFuture<void> inclusiveScan(QThreadPool *pool, Iterator begin, Iterator end,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(pool, begin, end, std::move(operation));
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename BinaryOperation>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename BinaryOperation = std::plus<>>
+#endif
+QFuture<void> inclusiveScan(Iterator begin, Iterator end,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(QThreadPool::globalInstance(), begin, end, std::move(operation));
+}
+
+// blockingInclusiveScan() on sequences
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename BinaryOperation>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename BinaryOperation = std::plus<>>
+#endif
+void blockingInclusiveScan(QThreadPool *pool, Sequence &sequence,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(pool, sequence.begin(), sequence.end(),
+                                              std::move(operation));
+    future.waitForFinished();
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename BinaryOperation>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename BinaryOperation = std::plus<>>
+#endif
+void blockingInclusiveScan(Sequence &sequence, BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(QThreadPool::globalInstance(), sequence.begin(),
+                                              sequence.end(), std::move(operation));
+    future.waitForFinished();
+}
+
+// blockingInclusiveScan() on iterators
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename BinaryOperation>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename BinaryOperation = std::plus<>>
+#endif
+void blockingInclusiveScan(QThreadPool *pool, Iterator begin, Iterator end,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(pool, begin, end, std::move(operation));
+    future.waitForFinished();
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename BinaryOperation>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename BinaryOperation = std::plus<>>
+#endif
+void blockingInclusiveScan(Iterator begin, Iterator end,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(QThreadPool::globalInstance(), begin, end,
+                                              std::move(operation));
+    future.waitForFinished();
+}
+
+// exclusiveScan() on sequences
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename T, typename BinaryOperation>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename T,
+          typename BinaryOperation = std::plus<>>
+#endif
+QFuture<void> exclusiveScan(QThreadPool *pool, Sequence &sequence, T &&initialValue,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startExclusiveScan(pool, sequence.begin(), sequence.end(),
+                              std::forward<T>(initialValue), std::move(operation));
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename T, typename BinaryOperation>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename T,
+          typename BinaryOperation = std::plus<>>
+#endif
+QFuture<void> exclusiveScan(Sequence &sequence, T &&initialValue,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startExclusiveScan(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                              std::forward<T>(initialValue), std::move(operation));
+}
+
+// exclusiveScan() on iterators
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename T, typename BinaryOperation>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename T,
+          typename BinaryOperation = std::plus<>>
+#endif
+QFuture<void> exclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, T &&initialValue,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startExclusiveScan(pool, begin, end, std::forward<T>(initialValue),
+                              std::move(operation));
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename T, typename BinaryOperation>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename T,
+          typename BinaryOperation = std::plus<>>
+#endif
+QFuture<void> exclusiveScan(Iterator begin, Iterator end, T &&initialValue,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startExclusiveScan(QThreadPool::globalInstance(), begin, end,
+                              std::forward<T>(initialValue), std::move(operation));
+}
+
+// blockingExclusiveScan() on sequences
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename T, typename BinaryOperation>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename T,
+          typename BinaryOperation = std::plus<>>
+#endif
+void blockingExclusiveScan(QThreadPool *pool, Sequence &sequence, T &&initialValue,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startExclusiveScan(pool, sequence.begin(), sequence.end(),
+                                              std::forward<T>(initialValue), std::move(operation));
+    future.waitForFinished();
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename T, typename BinaryOperation>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename T,
+          typename BinaryOperation = std::plus<>>
+#endif
+void blockingExclusiveScan(Sequence &sequence, T &&initialValue,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startExclusiveScan(QThreadPool::globalInstance(), sequence.begin(),
+                                              sequence.end(), std::forward<T>(initialValue),
+                                                           std::move(operation));
+    future.waitForFinished();
+}
+
+// blockingExclusiveScan() on iterators
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename T, typename BinaryOperation>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename T,
+          typename BinaryOperation = std::plus<>>
+#endif
+void blockingExclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, T &&initialValue,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startExclusiveScan(pool, begin, end, std::forward<T>(initialValue),
+                                              std::move(operation));
+    future.waitForFinished();
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename T, typename BinaryOperation>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename T,
+          typename BinaryOperation = std::plus<>>
+#endif
+void blockingExclusiveScan(Iterator begin, Iterator end, T &&initialValue,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startExclusiveScan(QThreadPool::globalInstance(), begin, end,
+                                              std::forward<T>(initialValue), std::move(operation));
+    future.waitForFinished();
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
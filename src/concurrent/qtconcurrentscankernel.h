@@ -0,0 +1,186 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QTCONCURRENT_SCANKERNEL_H
+#define QTCONCURRENT_SCANKERNEL_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined (Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentiteratekernel.h>
+#include <QtConcurrent/qtconcurrentsortkernel.h>
+
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtConcurrent {
+
+/*
+    The scan kernel works in three phases: it reduces every chunk but the
+    last one, computes the sum of the preceding chunks for each chunk in a
+    single task, and then scans every chunk starting from that sum.
+*/
+template <typename Iterator, typename BinaryOperation>
+class ScanKernel : public PhasedKernel<void>
+{
+    using ValueType = typename std::iterator_traits<Iterator>::value_type;
+
+public:
+    typedef void ReturnType;
+
+    template <typename F = BinaryOperation>
+    ScanKernel(QThreadPool *pool, Iterator begin, Iterator end, F &&operation)
+        : PhasedKernel<void>(pool),
+          begin(begin),
+          range(pool, std::distance(begin, end)),
+          operation(std::forward<F>(operation)),
+          sums(range.chunks),
+          inclusive(true)
+    {
+    }
+
+    template <typename F = BinaryOperation, typename U = ValueType>
+    ScanKernel(QThreadPool *pool, Iterator begin, Iterator end, F &&operation, U &&initialValue)
+        : PhasedKernel<void>(pool),
+          begin(begin),
+          range(pool, std::distance(begin, end)),
+          operation(std::forward<F>(operation)),
+          initialValue(std::forward<U>(initialValue)),
+          sums(range.chunks),
+          inclusive(false)
+    {
+    }
+
+    int phaseCount() const override { return 3; }
+
+    int taskCount(int phase) const override
+    {
+        switch (phase) {
+        case 0:
+            return range.chunks - 1;
+        case 1:
+            return range.chunks > 1 ? 1 : 0;
+        default:
+            return range.chunks;
+        }
+    }
+
+    void runTask(int phase, int task) override
+    {
+        Iterator it = begin + range.chunkBegin(task);
+        const Iterator last = begin + range.chunkBegin(task + 1);
+
+        switch (phase) {
+        case 0: {
+            ValueType sum = *it;
+            for (++it; it != last; ++it)
+                sum = std::invoke(operation, std::move(sum), *it);
+            sums[task] = std::move(sum);
+            break;
+        }
+        case 1: {
+            // replace the sums by the sums of the preceding chunks
+            std::optional<ValueType> carry = initialValue;
+            for (int chunk = 0; chunk < range.chunks; ++chunk) {
+                std::optional<ValueType> sum = std::move(sums[chunk]);
+                sums[chunk] = carry;
+                if (!sum)
+                    break;
+                carry = carry ? std::invoke(operation, std::move(*carry), *sum) : std::move(*sum);
+            }
+            break;
+        }
+        default: {
+            std::optional<ValueType> carry = task == 0 ? initialValue : std::move(sums[task]);
+            for ( ; it != last; ++it) {
+                if (inclusive) {
+                    carry = carry ? std::invoke(operation, std::move(*carry), *it) : *it;
+                    *it = *carry;
+                } else {
+                    ValueType value = std::move(*it);
+                    *it = *carry;
+                    carry = std::invoke(operation, std::move(*carry), std::move(value));
+                }
+            }
+            break;
+        }
+        }
+    }
+
+private:
+    const Iterator begin;
+    const ChunkedRange range;
+    BinaryOperation operation;
+    const std::optional<ValueType> initialValue;
+    std::vector<std::optional<ValueType>> sums;
+    const bool inclusive;
+};
+
+template <typename Iterator, typename BinaryOperation>
+inline ThreadEngineStarter<void> startInclusiveScan(QThreadPool *pool, Iterator begin,
+                                                    Iterator end, BinaryOperation &&operation)
+{
+    return startThreadEngine(new ScanKernel<Iterator, std::decay_t<BinaryOperation>>(
+            pool, begin, end, std::forward<BinaryOperation>(operation)));
+}
+
+template <typename Iterator, typename BinaryOperation, typename T>
+inline ThreadEngineStarter<void> startExclusiveScan(QThreadPool *pool, Iterator begin,
+                                                    Iterator end, T &&initialValue,
+                                                    BinaryOperation &&operation)
+{
+    return startThreadEngine(new ScanKernel<Iterator, std::decay_t<BinaryOperation>>(
+            pool, begin, end, std::forward<BinaryOperation>(operation),
+            std::forward<T>(initialValue)));
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
@@ -0,0 +1,469 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+/*!
+    \page qtconcurrentsort.html
+    \title Concurrent Sort and Scan
+    \ingroup thread
+
+    The QtConcurrent::sort(), QtConcurrent::stableSort(), QtConcurrent::partition(),
+    QtConcurrent::inclusiveScan() and QtConcurrent::exclusiveScan() functions
+    reorder or accumulate the items of a random access range in place, using
+    multiple threads.
+
+    The range is divided into chunks of at least 1024 items, with at most four
+    chunks per thread in the pool. Each algorithm runs in a number of passes
+    over these chunks; the chunks of a pass are distributed over the threads
+    using the same adaptive block size as QtConcurrent::map(). Ranges that are
+    smaller than two chunks are processed as a single chunk.
+
+    The non-blocking variants return a QFuture. Its progress value counts the
+    chunk operations that have completed, across all passes, and
+    QFuture::cancel() stops the algorithm before the next chunk operation
+    starts. A canceled operation leaves the range as a permutation of its
+    original items (sort, stable sort and partition) or with an unspecified
+    mix of original and accumulated values (scans).
+
+    \snippet code/src_concurrent_qtconcurrentsort.cpp 0
+
+    The blocking variants wait for the result, and
+    QtConcurrent::blockingPartition() returns the partition point directly:
+
+    \snippet code/src_concurrent_qtconcurrentsort.cpp 1
+*/
+
+/*!
+  \class QtConcurrent::PhasedKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::ChunkedRange
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::SortKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::PartitionKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::sort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items in \a sequence in ascending order, as determined by \a lessThan, which must
+    implement a strict weak ordering. The range is split into chunks that are sorted concurrently
+    and then merged pairwise. The relative order of equivalent items is not preserved. Returns a
+    future that can be used to follow progress and to cancel the operation; a canceled sort leaves
+    the range in an unspecified order.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa blockingSort(), stableSort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::sort(Sequence &sequence, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items in \a sequence in ascending order, as determined by \a lessThan, which must
+    implement a strict weak ordering. The range is split into chunks that are sorted concurrently
+    and then merged pairwise. The relative order of equivalent items is not preserved. Returns a
+    future that can be used to follow progress and to cancel the operation; a canceled sort leaves
+    the range in an unspecified order.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \sa blockingSort(), stableSort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> QFuture<void> QtConcurrent::sort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items from \a begin to \a end in ascending order, as determined by \a lessThan, which
+    must implement a strict weak ordering. The range is split into chunks that are sorted
+    concurrently and then merged pairwise. The relative order of equivalent items is not preserved.
+    Returns a future that can be used to follow progress and to cancel the operation; a canceled
+    sort leaves the range in an unspecified order.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa blockingSort(), stableSort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> QFuture<void> QtConcurrent::sort(Iterator begin, Iterator end, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items from \a begin to \a end in ascending order, as determined by \a lessThan, which
+    must implement a strict weak ordering. The range is split into chunks that are sorted
+    concurrently and then merged pairwise. The relative order of equivalent items is not preserved.
+    Returns a future that can be used to follow progress and to cancel the operation; a canceled
+    sort leaves the range in an unspecified order.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \sa blockingSort(), stableSort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items in \a sequence in ascending order, as determined by \a lessThan, which must
+    implement a strict weak ordering. The range is split into chunks that are sorted concurrently
+    and then merged pairwise. The relative order of equivalent items is not preserved.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa sort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingSort(Sequence &sequence, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items in \a sequence in ascending order, as determined by \a lessThan, which must
+    implement a strict weak ordering. The range is split into chunks that are sorted concurrently
+    and then merged pairwise. The relative order of equivalent items is not preserved.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \note This function will block until all items have been processed.
+
+    \sa sort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> void QtConcurrent::blockingSort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items from \a begin to \a end in ascending order, as determined by \a lessThan, which
+    must implement a strict weak ordering. The range is split into chunks that are sorted
+    concurrently and then merged pairwise. The relative order of equivalent items is not preserved.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa sort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> void QtConcurrent::blockingSort(Iterator begin, Iterator end, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items from \a begin to \a end in ascending order, as determined by \a lessThan, which
+    must implement a strict weak ordering. The range is split into chunks that are sorted
+    concurrently and then merged pairwise. The relative order of equivalent items is not preserved.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \note This function will block until all items have been processed.
+
+    \sa sort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::stableSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items in \a sequence in ascending order, as determined by \a lessThan, which must
+    implement a strict weak ordering. The range is split into chunks that are sorted concurrently
+    and then merged pairwise. The relative order of equivalent items is preserved. Returns a future
+    that can be used to follow progress and to cancel the operation.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa blockingStableSort(), sort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::stableSort(Sequence &sequence, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items in \a sequence in ascending order, as determined by \a lessThan, which must
+    implement a strict weak ordering. The range is split into chunks that are sorted concurrently
+    and then merged pairwise. The relative order of equivalent items is preserved. Returns a future
+    that can be used to follow progress and to cancel the operation.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \sa blockingStableSort(), sort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> QFuture<void> QtConcurrent::stableSort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items from \a begin to \a end in ascending order, as determined by \a lessThan, which
+    must implement a strict weak ordering. The range is split into chunks that are sorted
+    concurrently and then merged pairwise. The relative order of equivalent items is preserved.
+    Returns a future that can be used to follow progress and to cancel the operation.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa blockingStableSort(), sort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> QFuture<void> QtConcurrent::stableSort(Iterator begin, Iterator end, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items from \a begin to \a end in ascending order, as determined by \a lessThan, which
+    must implement a strict weak ordering. The range is split into chunks that are sorted
+    concurrently and then merged pairwise. The relative order of equivalent items is preserved.
+    Returns a future that can be used to follow progress and to cancel the operation.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \sa blockingStableSort(), sort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingStableSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items in \a sequence in ascending order, as determined by \a lessThan, which must
+    implement a strict weak ordering. The range is split into chunks that are sorted concurrently
+    and then merged pairwise. The relative order of equivalent items is preserved.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa stableSort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingStableSort(Sequence &sequence, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items in \a sequence in ascending order, as determined by \a lessThan, which must
+    implement a strict weak ordering. The range is split into chunks that are sorted concurrently
+    and then merged pairwise. The relative order of equivalent items is preserved.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \note This function will block until all items have been processed.
+
+    \sa stableSort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> void QtConcurrent::blockingStableSort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items from \a begin to \a end in ascending order, as determined by \a lessThan, which
+    must implement a strict weak ordering. The range is split into chunks that are sorted
+    concurrently and then merged pairwise. The relative order of equivalent items is preserved.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa stableSort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename LessThan> void QtConcurrent::blockingStableSort(Iterator begin, Iterator end, LessThan lessThan = LessThan())
+
+    \since 6.4
+
+    Sorts the items from \a begin to \a end in ascending order, as determined by \a lessThan, which
+    must implement a strict weak ordering. The range is split into chunks that are sorted
+    concurrently and then merged pairwise. The relative order of equivalent items is preserved.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \note This function will block until all items have been processed.
+
+    \sa stableSort(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> QFuture<qsizetype> QtConcurrent::partition(QThreadPool *pool, Sequence &sequence, Predicate &&predicate)
+
+    \since 6.4
+
+    Reorders the items in \a sequence so that all items for which \a predicate returns \c true
+    precede the items for which it returns \c false. The relative order of the items in each group
+    is preserved. The result of the returned future is the index of the first item of the second
+    group.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa blockingPartition(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> QFuture<qsizetype> QtConcurrent::partition(Sequence &sequence, Predicate &&predicate)
+
+    \since 6.4
+
+    Reorders the items in \a sequence so that all items for which \a predicate returns \c true
+    precede the items for which it returns \c false. The relative order of the items in each group
+    is preserved. The result of the returned future is the index of the first item of the second
+    group.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \sa blockingPartition(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> QFuture<qsizetype> QtConcurrent::partition(QThreadPool *pool, Iterator begin, Iterator end, Predicate &&predicate)
+
+    \since 6.4
+
+    Reorders the items from \a begin to \a end so that all items for which \a predicate returns \c
+    true precede the items for which it returns \c false. The relative order of the items in each
+    group is preserved. The result of the returned future is the index of the first item of the
+    second group.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa blockingPartition(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> QFuture<qsizetype> QtConcurrent::partition(Iterator begin, Iterator end, Predicate &&predicate)
+
+    \since 6.4
+
+    Reorders the items from \a begin to \a end so that all items for which \a predicate returns \c
+    true precede the items for which it returns \c false. The relative order of the items in each
+    group is preserved. The result of the returned future is the index of the first item of the
+    second group.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \sa blockingPartition(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> qsizetype QtConcurrent::blockingPartition(QThreadPool *pool, Sequence &sequence, Predicate &&predicate)
+
+    \since 6.4
+
+    Reorders the items in \a sequence so that all items for which \a predicate returns \c true
+    precede the items for which it returns \c false. The relative order of the items in each group
+    is preserved. Returns the index of the first item of the second group.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa partition(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> qsizetype QtConcurrent::blockingPartition(Sequence &sequence, Predicate &&predicate)
+
+    \since 6.4
+
+    Reorders the items in \a sequence so that all items for which \a predicate returns \c true
+    precede the items for which it returns \c false. The relative order of the items in each group
+    is preserved. Returns the index of the first item of the second group.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \note This function will block until all items have been processed.
+
+    \sa partition(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> qsizetype QtConcurrent::blockingPartition(QThreadPool *pool, Iterator begin, Iterator end, Predicate &&predicate)
+
+    \since 6.4
+
+    Reorders the items from \a begin to \a end so that all items for which \a predicate returns \c
+    true precede the items for which it returns \c false. The relative order of the items in each
+    group is preserved. Returns the index of the first item of the second group.
+
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until all items have been processed.
+
+    \sa partition(), {Concurrent Sort and Scan}
+*/
+
+/*!
+    \fn template <typename Iterator, typename Predicate> qsizetype QtConcurrent::blockingPartition(Iterator begin, Iterator end, Predicate &&predicate)
+
+    \since 6.4
+
+    Reorders the items from \a begin to \a end so that all items for which \a predicate returns \c
+    true precede the items for which it returns \c false. The relative order of the items in each
+    group is preserved. Returns the index of the first item of the second group.
+
+    All work is done by threads taken from the global QThreadPool.
+
+    \note This function will block until all items have been processed.
+
+    \sa partition(), {Concurrent Sort and Scan}
+*/
@@ -0,0 +1,395 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QTCONCURRENT_SORT_H
+#define QTCONCURRENT_SORT_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentsortkernel.h>
+#include <QtConcurrent/qtconcurrentfunctionwrappers.h>
+#include <QtCore/qfuture.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+
+
+namespace QtConcurrent {
+
+// sort() on sequences
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename LessThan>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+QFuture<void> sort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(pool, sequence.begin(), sequence.end(), std::move(lessThan), false);
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename LessThan>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+QFuture<void> sort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                     std::move(lessThan), false);
+}
+
+// sort() on iterators
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename LessThan>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+QFuture<void> sort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan = LessThan())
+{
+    return startSort(pool, begin, end, std::move(lessThan), false);
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename LessThan>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+QFuture<void> sort(Iterator begin, Iterator end, LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), begin, end, std::move(lessThan), false);
+}
+
+// blockingSort() on sequences
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename LessThan>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+void blockingSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(pool, sequence.begin(), sequence.end(), std::move(lessThan),
+                                     false);
+    future.waitForFinished();
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename LessThan>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+void blockingSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(QThreadPool::globalInstance(), sequence.begin(),
+                                     sequence.end(), std::move(lessThan), false);
+    future.waitForFinished();
+}
+
+// blockingSort() on iterators
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename LessThan>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+void blockingSort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(pool, begin, end, std::move(lessThan), false);
+    future.waitForFinished();
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename LessThan>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+void blockingSort(Iterator begin, Iterator end, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(QThreadPool::globalInstance(), begin, end,
+                                     std::move(lessThan), false);
+    future.waitForFinished();
+}
+
+// stableSort() on sequences
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename LessThan>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+QFuture<void> stableSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(pool, sequence.begin(), sequence.end(), std::move(lessThan), true);
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename LessThan>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+QFuture<void> stableSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                     std::move(lessThan), true);
+}
+
+// stableSort() on iterators
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename LessThan>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+QFuture<void> stableSort(QThreadPool *pool, Iterator begin, Iterator end,
+                         LessThan lessThan = LessThan())
+{
+    return startSort(pool, begin, end, std::move(lessThan), true);
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename LessThan>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+QFuture<void> stableSort(Iterator begin, Iterator end, LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), begin, end, std::move(lessThan), true);
+}
+
+// blockingStableSort() on sequences
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename LessThan>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+void blockingStableSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(pool, sequence.begin(), sequence.end(), std::move(lessThan),
+                                     true);
+    future.waitForFinished();
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename LessThan>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+void blockingStableSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(QThreadPool::globalInstance(), sequence.begin(),
+                                     sequence.end(), std::move(lessThan), true);
+    future.waitForFinished();
+}
+
+// blockingStableSort() on iterators
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename LessThan>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+void blockingStableSort(QThreadPool *pool, Iterator begin, Iterator end,
+                        LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(pool, begin, end, std::move(lessThan), true);
+    future.waitForFinished();
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename LessThan>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename LessThan = std::less<>>
+#endif
+void blockingStableSort(Iterator begin, Iterator end, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(QThreadPool::globalInstance(), begin, end,
+                                     std::move(lessThan), true);
+    future.waitForFinished();
+}
+
+// partition() on sequences
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename Predicate>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename Predicate>
+#endif
+QFuture<qsizetype> partition(QThreadPool *pool, Sequence &sequence, Predicate &&predicate)
+{
+    return startPartition(pool, sequence.begin(), sequence.end(),
+                          std::forward<Predicate>(predicate));
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename Predicate>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename Predicate>
+#endif
+QFuture<qsizetype> partition(Sequence &sequence, Predicate &&predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                          std::forward<Predicate>(predicate));
+}
+
+// partition() on iterators
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename Predicate>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename Predicate>
+#endif
+QFuture<qsizetype> partition(QThreadPool *pool, Iterator begin, Iterator end, Predicate &&predicate)
+{
+    return startPartition(pool, begin, end, std::forward<Predicate>(predicate));
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename Predicate>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename Predicate>
+#endif
+QFuture<qsizetype> partition(Iterator begin, Iterator end, Predicate &&predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), begin, end,
+                          std::forward<Predicate>(predicate));
+}
+
+// blockingPartition() on sequences
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename Predicate>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename Predicate>
+#endif
+qsizetype blockingPartition(QThreadPool *pool, Sequence &sequence, Predicate &&predicate)
+{
+    QFuture<qsizetype> future = startPartition(pool, sequence.begin(), sequence.end(),
+                                               std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Sequence, typename Predicate>
+#else
+template <typename Sequence,
+          std::enable_if_t<QtPrivate::IsIterableValue<Sequence>, int> = 0,
+          typename Predicate>
+#endif
+qsizetype blockingPartition(Sequence &sequence, Predicate &&predicate)
+{
+    QFuture<qsizetype> future = startPartition(QThreadPool::globalInstance(), sequence.begin(),
+                                               sequence.end(), std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+// blockingPartition() on iterators
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename Predicate>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename Predicate>
+#endif
+qsizetype blockingPartition(QThreadPool *pool, Iterator begin, Iterator end, Predicate &&predicate)
+{
+    QFuture<qsizetype> future = startPartition(pool, begin, end,
+                                               std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+#ifdef Q_CLANG_QDOC
+template <typename Iterator, typename Predicate>
+#else
+template <typename Iterator,
+          std::enable_if_t<QtPrivate::isIterator_v<Iterator>, int> = 0,
+          typename Predicate>
+#endif
+qsizetype blockingPartition(Iterator begin, Iterator end, Predicate &&predicate)
+{
+    QFuture<qsizetype> future = startPartition(QThreadPool::globalInstance(), begin, end,
+                                               std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
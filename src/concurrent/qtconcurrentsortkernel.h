@@ -0,0 +1,234 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QTCONCURRENT_SORTKERNEL_H
+#define QTCONCURRENT_SORTKERNEL_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined (Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentiteratekernel.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtConcurrent {
+
+/*
+    The sort and partition kernels split the range into chunks, process each
+    chunk on its own, and then combine neighboring runs of chunks pairwise,
+    doubling the run length in every phase until a single run is left.
+*/
+class ChunkedRange
+{
+public:
+    // Tunable parameter: below this, the overhead outweighs the parallelism.
+    enum { MinimumChunkSize = 1024 };
+
+    ChunkedRange(QThreadPool *pool, qsizetype size)
+        : size(size),
+          chunks(int(qBound(qsizetype(1), size / MinimumChunkSize,
+                             qsizetype(qMax(pool->maxThreadCount(), 1)) * 4)))
+    {
+    }
+
+    qsizetype chunkBegin(int chunk) const
+    {
+        return chunk >= chunks ? size : size * chunk / chunks;
+    }
+
+    // Phase 0 processes the chunks, phase n combines runs of 2^(n-1) chunks.
+    int phaseCount() const
+    {
+        int phases = 1;
+        while ((1 << (phases - 1)) < chunks)
+            ++phases;
+        return phases;
+    }
+
+    int taskCount(int phase) const
+    {
+        if (phase == 0)
+            return chunks;
+        const int width = 1 << (phase - 1);
+        return (chunks - width + 2 * width - 1) / (2 * width);
+    }
+
+    // The chunks of the two runs combined by the given task.
+    void runsForTask(int phase, int task, int *first, int *middle, int *last) const
+    {
+        const int width = 1 << (phase - 1);
+        *first = 2 * width * task;
+        *middle = *first + width;
+        *last = qMin(*middle + width, chunks);
+    }
+
+    const qsizetype size;
+    const int chunks;
+};
+
+template <typename Iterator, typename LessThan>
+class SortKernel : public PhasedKernel<void>
+{
+public:
+    typedef void ReturnType;
+
+    template <typename F = LessThan>
+    SortKernel(QThreadPool *pool, Iterator begin, Iterator end, F &&lessThan, bool stable)
+        : PhasedKernel<void>(pool),
+          begin(begin),
+          range(pool, std::distance(begin, end)),
+          lessThan(std::forward<F>(lessThan)),
+          stable(stable)
+    {
+    }
+
+    int phaseCount() const override { return range.phaseCount(); }
+    int taskCount(int phase) const override { return range.taskCount(phase); }
+
+    void runTask(int phase, int task) override
+    {
+        if (phase == 0) {
+            const Iterator first = begin + range.chunkBegin(task);
+            const Iterator last = begin + range.chunkBegin(task + 1);
+            if (stable)
+                std::stable_sort(first, last, lessThan);
+            else
+                std::sort(first, last, lessThan);
+            return;
+        }
+
+        // std::inplace_merge is stable, so it serves both cases
+        int first, middle, last;
+        range.runsForTask(phase, task, &first, &middle, &last);
+        std::inplace_merge(begin + range.chunkBegin(first), begin + range.chunkBegin(middle),
+                           begin + range.chunkBegin(last), lessThan);
+    }
+
+private:
+    const Iterator begin;
+    const ChunkedRange range;
+    LessThan lessThan;
+    const bool stable;
+};
+
+template <typename Iterator, typename Predicate>
+class PartitionKernel : public PhasedKernel<qsizetype>
+{
+public:
+    typedef qsizetype ReturnType;
+
+    template <typename F = Predicate>
+    PartitionKernel(QThreadPool *pool, Iterator begin, Iterator end, F &&predicate)
+        : PhasedKernel<qsizetype>(pool),
+          begin(begin),
+          range(pool, std::distance(begin, end)),
+          predicate(std::forward<F>(predicate)),
+          splits(range.chunks)
+    {
+    }
+
+    int phaseCount() const override { return range.phaseCount(); }
+    int taskCount(int phase) const override { return range.taskCount(phase); }
+
+    void runTask(int phase, int task) override
+    {
+        if (phase == 0) {
+            const Iterator split = std::stable_partition(begin + range.chunkBegin(task),
+                                                         begin + range.chunkBegin(task + 1),
+                                                         predicate);
+            splits[task] = std::distance(begin, split);
+            return;
+        }
+
+        // [T1 F1][T2 F2] becomes [T1 T2][F1 F2] by rotating F1 and T2
+        int first, middle, last;
+        range.runsForTask(phase, task, &first, &middle, &last);
+        const qsizetype middleBegin = range.chunkBegin(middle);
+        std::rotate(begin + splits[first], begin + middleBegin, begin + splits[middle]);
+        splits[first] += splits[middle] - middleBegin;
+    }
+
+    void finish() override
+    {
+        partitionPoint = splits.empty() ? 0 : splits.front();
+    }
+
+    qsizetype *result() override
+    {
+        return &partitionPoint;
+    }
+
+private:
+    const Iterator begin;
+    const ChunkedRange range;
+    Predicate predicate;
+    std::vector<qsizetype> splits;
+    qsizetype partitionPoint = 0;
+};
+
+template <typename Iterator, typename LessThan>
+inline ThreadEngineStarter<void> startSort(QThreadPool *pool, Iterator begin, Iterator end,
+                                           LessThan &&lessThan, bool stable)
+{
+    return startThreadEngine(new SortKernel<Iterator, std::decay_t<LessThan>>(
+            pool, begin, end, std::forward<LessThan>(lessThan), stable));
+}
+
+template <typename Iterator, typename Predicate>
+inline ThreadEngineStarter<qsizetype> startPartition(QThreadPool *pool, Iterator begin,
+                                                     Iterator end, Predicate &&predicate)
+{
+    return startThreadEngine(new PartitionKernel<Iterator, std::decay_t<Predicate>>(
+            pool, begin, end, std::forward<Predicate>(predicate)));
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
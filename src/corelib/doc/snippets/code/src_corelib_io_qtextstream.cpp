@@ -137,3 +137,16 @@ stream << '\n' << Qt::flush;
 QTextStream out(&file);
 out.setEncoding(QStringConverter::Utf8);
 //! [10]
+
+
+//! [11]
+QFile file("/var/log/messages");
+if (file.open(QIODevice::ReadOnly)) {
+    QTextStream in(&file);
+    qsizetype errors = 0;
+    for (QStringView line = in.readLineView(); !line.isNull(); line = in.readLineView()) {
+        if (line.contains(u"error"))
+            ++errors;
+    }
+}
+//! [11]
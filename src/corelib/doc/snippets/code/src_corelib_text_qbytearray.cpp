@@ -508,4 +508,14 @@ QByteArray ba = QByteArrayLiteral("byte array contents");
 QByteArray encoded("Qt%20is%20great%33");
 QByteArray decoded = encoded.percentDecoded(); // Set to "Qt is great!"
 //! [54]
+
+//! [55]
+QByteArray csv;
+for (const Sample &sample : samples) {
+    csv.appendNumber(sample.id);
+    csv.append(',');
+    csv.appendNumber(sample.value, 'g', QLocale::FloatingPointShortest);
+    csv.append('\n');
+}
+//! [55]
 }
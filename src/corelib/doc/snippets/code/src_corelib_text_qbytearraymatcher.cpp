@@ -55,3 +55,11 @@ static const auto matcher = qMakeStaticByteArrayMatcher("needle");
 //! [1]
 static const auto matcher = qMakeStaticByteArrayMatcher("needle");
 //! [1]
+
+//! [2]
+QMultiByteArrayMatcher matcher({ "GET", "POST", "\r\n" });
+for (auto match = matcher.indexIn(request); match.isValid();
+     match = matcher.indexIn(request, match.position + match.length)) {
+    handleToken(match.patternIndex, match.position);
+}
+//! [2]
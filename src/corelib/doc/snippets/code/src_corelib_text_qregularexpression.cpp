@@ -386,4 +386,36 @@ if (m.hasMatch()) {
 //! [36]
 }
 
+{
+//! [37]
+QRegularExpressionStreamMatcher matcher(QRegularExpression(R"(ERROR: (.*))"));
+QFile log("server.log");
+log.open(QIODevice::ReadOnly | QIODevice::Text);
+QStringDecoder toUtf16(QStringDecoder::Utf8);
+
+while (!log.atEnd()) {
+    const QString chunk = toUtf16(log.read(1024 * 1024));
+    for (const QRegularExpressionMatch &match : matcher.feed(chunk))
+        qDebug() << match.capturedStart() << match.captured(1);
+}
+for (const QRegularExpressionMatch &match : matcher.finish())
+    qDebug() << match.capturedStart() << match.captured(1);
+//! [37]
+}
+
+{
+//! [38]
+// at build time, in a tool that generates patterns.qrx for the resources
+QFile out("patterns.qrx");
+out.open(QIODevice::WriteOnly);
+out.write(QRegularExpressionCache::serialize({ QRegularExpression(R"(^\d{4}-\d{2}-\d{2}$)"),
+                                               QRegularExpression(R"(^[\w.+-]+@[\w-]+\.[\w.]+$)") }));
+
+// at startup
+QFile in(":/patterns.qrx");
+if (in.open(QIODevice::ReadOnly))
+    QRegularExpressionCache::deserialize(in.readAll());
+//! [38]
+}
+
 }
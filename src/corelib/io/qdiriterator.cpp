@@ -87,6 +87,14 @@
     enables iterating through all subdirectories of the assigned path,
     following all symbolic links. Symbolic link loops (e.g., "link" => "." or
     "link" => "..") are automatically detected and ignored.
+
+    \value ParallelTraversal When combined with Subdirectories, subdirectories
+    are listed concurrently on worker threads while the iterator hands out
+    the entries found so far. This speeds up listing large trees, in
+    particular on network file systems, but the entries are returned in an
+    unspecified order. The flag only applies to directories on the native
+    file system and is ignored for Qt resources and custom file engines.
+    (since 6.4)
 */
 
 #include "qdiriterator.h"
@@ -109,6 +117,15 @@
 
 #include <memory>
 
+#if QT_CONFIG(thread) && !defined(QT_NO_FILESYSTEMITERATOR)
+#  include <QtCore/qmutex.h>
+#  include <QtCore/qthread.h>
+#  include <QtCore/qthreadpool.h>
+#  include <QtCore/qwaitcondition.h>
+#  include <deque>
+#  define QDIRITERATOR_PARALLEL
+#endif
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -123,6 +140,10 @@ public:
     }
 };
 
+#ifdef QDIRITERATOR_PARALLEL
+class QDirIteratorParallelWalker;
+#endif
+
 class QDirIteratorPrivate
 {
 public:
@@ -157,8 +178,134 @@ public:
 
     // Loop protection
     QDuplicateTracker<QString> visitedLinks;
+
+#ifdef QDIRITERATOR_PARALLEL
+    // Declared last so that it stops its workers before anything they use goes away.
+    std::unique_ptr<QDirIteratorParallelWalker> walker;
+    bool walkerHasNext = false;
+#endif
+};
+
+#ifdef QDIRITERATOR_PARALLEL
+/*!
+    \internal
+
+    Lists the directories of a QDirIterator::ParallelTraversal iteration on a
+    thread pool. Each directory is one task, which applies the iterator's
+    filters and schedules the subdirectories it finds as new tasks. The
+    matching entries are queued, in batches, for QDirIteratorPrivate::advance()
+    to pick up.
+*/
+class QDirIteratorParallelWalker
+{
+public:
+    explicit QDirIteratorParallelWalker(QDirIteratorPrivate *d)
+        : d(d)
+    {
+        // The tasks mostly wait for the file system, so use more threads than cores.
+        pool.setMaxThreadCount(qMax(4, 2 * QThread::idealThreadCount()));
+    }
+    ~QDirIteratorParallelWalker();
+
+    void schedule(const QFileSystemEntry &dirEntry);
+    bool takeNext(QFileInfo *fileInfo);
+
+    // Also guards QDirIteratorPrivate::visitedLinks.
+    QMutex mutex;
+
+private:
+    enum { BatchSize = 64, MaxQueuedEntries = 16 * 1024 };
+
+    void list(const QFileSystemEntry &dirEntry);
+    bool deliver(QList<QFileInfo> &batch);
+
+    QDirIteratorPrivate *const d;
+    QWaitCondition entriesAvailable;
+    QWaitCondition spaceAvailable;
+    std::deque<QFileInfo> entries;
+    int pendingDirectories = 0;
+    bool aborted = false;
+    QThreadPool pool;
 };
 
+QDirIteratorParallelWalker::~QDirIteratorParallelWalker()
+{
+    {
+        QMutexLocker locker(&mutex);
+        aborted = true;
+        spaceAvailable.wakeAll();
+    }
+    pool.waitForDone();
+}
+
+void QDirIteratorParallelWalker::schedule(const QFileSystemEntry &dirEntry)
+{
+    {
+        QMutexLocker locker(&mutex);
+        if (aborted)
+            return;
+        ++pendingDirectories;
+    }
+    pool.start([this, dirEntry] { list(dirEntry); });
+}
+
+bool QDirIteratorParallelWalker::takeNext(QFileInfo *fileInfo)
+{
+    QMutexLocker locker(&mutex);
+    while (entries.empty() && pendingDirectories > 0)
+        entriesAvailable.wait(&mutex);
+    if (entries.empty())
+        return false;
+
+    *fileInfo = std::move(entries.front());
+    entries.pop_front();
+    if (entries.size() == MaxQueuedEntries - 1)
+        spaceAvailable.wakeAll();
+    return true;
+}
+
+void QDirIteratorParallelWalker::list(const QFileSystemEntry &dirEntry)
+{
+    QFileSystemIterator it(dirEntry, d->filters, d->nameFilters, d->iteratorFlags);
+    QFileSystemEntry entry;
+    QFileSystemMetaData metaData;
+    QList<QFileInfo> batch;
+    batch.reserve(BatchSize);
+
+    bool keepGoing = true;
+    while (keepGoing && it.advance(entry, metaData)) {
+        QFileInfo info(new QFileInfoPrivate(entry, metaData));
+        d->checkAndPushDirectory(info);
+        if (d->matchesFilters(entry.fileName(), info))
+            batch.append(std::move(info));
+        metaData = QFileSystemMetaData();
+        if (batch.size() == BatchSize)
+            keepGoing = deliver(batch);
+    }
+    if (keepGoing && !batch.isEmpty())
+        deliver(batch);
+
+    QMutexLocker locker(&mutex);
+    if (--pendingDirectories == 0)
+        entriesAvailable.wakeAll();
+}
+
+bool QDirIteratorParallelWalker::deliver(QList<QFileInfo> &batch)
+{
+    QMutexLocker locker(&mutex);
+    // Don't run arbitrarily far ahead of a slow consumer.
+    while (!aborted && entries.size() >= MaxQueuedEntries)
+        spaceAvailable.wait(&mutex);
+    if (aborted)
+        return false;
+
+    std::move(batch.begin(), batch.end(), std::back_inserter(entries));
+    batch.clear();
+    entriesAvailable.wakeAll();
+    return true;
+}
+#endif // QDIRITERATOR_PARALLEL
+
 /*!
     \internal
 */
@@ -181,6 +328,10 @@ QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QS
     if (resolveEngine)
         engine.reset(QFileSystemEngine::resolveEntryAndCreateLegacyEngine(dirEntry, metaData));
     QFileInfo fileInfo(new QFileInfoPrivate(dirEntry, metaData));
+#ifdef QDIRITERATOR_PARALLEL
+    if ((flags & QDirIterator::ParallelTraversal) && !engine)
+        walker = std::make_unique<QDirIteratorParallelWalker>(this);
+#endif
 
     // Populate fields for hasNext() and next()
     pushDirectory(fileInfo);
@@ -201,7 +352,11 @@ void QDirIteratorPrivate::pushDirectory(const QFileInfo &fileInfo)
 
     if ((iteratorFlags & QDirIterator::FollowSymlinks)) {
         // Stop link loops
-        if (visitedLinks.hasSeen(fileInfo.canonicalFilePath()))
+        const QString canonicalPath = fileInfo.canonicalFilePath();
+#ifdef QDIRITERATOR_PARALLEL
+        QMutexLocker locker(walker ? &walker->mutex : nullptr);
+#endif
+        if (visitedLinks.hasSeen(canonicalPath))
             return;
     }
 
@@ -215,6 +370,12 @@ void QDirIteratorPrivate::pushDirectory(const QFileInfo &fileInfo)
             // No iterator; no entry list.
         }
     } else {
+#ifdef QDIRITERATOR_PARALLEL
+        if (walker) {
+            walker->schedule(fileInfo.d_ptr->fileEntry);
+            return;
+        }
+#endif
 #ifndef QT_NO_FILESYSTEMITERATOR
         QFileSystemIterator *it = new QFileSystemIterator(fileInfo.d_ptr->fileEntry,
             filters, nameFilters, iteratorFlags);
@@ -259,6 +420,15 @@ void QDirIteratorPrivate::advance()
             delete it;
         }
     } else {
+#ifdef QDIRITERATOR_PARALLEL
+        if (walker) {
+            QFileInfo info;
+            walkerHasNext = walker->takeNext(&info);
+            currentFileInfo = nextFileInfo;
+            nextFileInfo = info;
+            return;
+        }
+#endif
 #ifndef QT_NO_FILESYSTEMITERATOR
         QFileSystemEntry nextEntry;
         QFileSystemMetaData nextMetaData;
@@ -535,6 +705,10 @@ bool QDirIterator::hasNext() const
 {
     if (d->engine)
         return !d->fileEngineIterators.isEmpty();
+#ifdef QDIRITERATOR_PARALLEL
+    else if (d->walker)
+        return d->walkerHasNext;
+#endif
     else
 #ifndef QT_NO_FILESYSTEMITERATOR
         return !d->nativeIterators.isEmpty();
@@ -51,7 +51,8 @@ public:
     enum IteratorFlag {
         NoIteratorFlags = 0x0,
         FollowSymlinks = 0x1,
-        Subdirectories = 0x2
+        Subdirectories = 0x2,
+        ParallelTraversal = 0x4
     };
     Q_DECLARE_FLAGS(IteratorFlags, IteratorFlag)
 
@@ -47,6 +47,7 @@
 #include "qlist.h"
 #include "qfileinfo.h"
 #include "private/qiodevice_p.h"
+#include "private/qbytearray_p.h"
 #include "private/qfile_p.h"
 #include "private/qfilesystemengine_p.h"
 #include "private/qsystemerror_p.h"
@@ -54,6 +55,14 @@
 #if defined(QT_BUILD_CORE_LIB)
 # include "qcoreapplication.h"
 #endif
+#if QT_CONFIG(future)
+# include "qfuture.h"
+# include "qthread.h"
+# include "qthreadpool.h"
+# ifdef QT_PREAD
+#  include "private/qcore_unix_p.h"
+# endif
+#endif
 
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
@@ -888,6 +897,15 @@ QFile::copy(const QString &fileName, const QString &newName)
     QIODevice::ReadWrite. It may also have additional flags, such as
     QIODevice::Text and QIODevice::Unbuffered.
 
+    If \a mode is QIODevice::ReadOnly combined with QIODevice::MemoryMapped,
+    the whole file is mapped into memory when it is opened and reads are
+    served from the mapping, without going through the QIODevice read
+    buffer. QFileDevice::peekView(), QFileDevice::readView() and
+    QFileDevice::readLineView() then give access to the data without
+    copying it. Data appended to the file after it was opened is not seen.
+    If the file cannot be mapped, for instance because it is empty or
+    sequential, it is read as if the flag had not been passed.
+
     \note In \l{QIODevice::}{WriteOnly} or \l{QIODevice::}{ReadWrite}
     mode, if the relevant file does not already exist, this function
     will try to create a new file before opening it. The file will be
@@ -912,6 +930,8 @@ bool QFile::open(OpenMode mode)
 
     // QIODevice provides the buffering, so there's no need to request it from the file engine.
     if (d->engine()->open(mode | QIODevice::Unbuffered)) {
+        if ((mode & MemoryMapped) && !(mode & WriteOnly))
+            d->mapForReading();
         QIODevice::open(mode);
         if (mode & Append)
             seek(size());
@@ -957,6 +977,8 @@ bool QFile::open(OpenMode mode, QFile::Permissions permissions)
 
     // QIODevice provides the buffering, so there's no need to request it from the file engine.
     if (d->engine()->open(mode | QIODevice::Unbuffered, permissions)) {
+        if ((mode & MemoryMapped) && !(mode & WriteOnly))
+            d->mapForReading();
         QIODevice::open(mode);
         if (mode & Append)
             seek(size());
@@ -1176,6 +1198,264 @@ qint64 QFile::size() const
     return QFileDevice::size(); // for now
 }
 
+#if QT_CONFIG(future)
+namespace {
+// The asynchronous calls spend their time blocked in the kernel, so they
+// get a pool of their own: a stalled network file system must not starve
+// QThreadPool::globalInstance() of its CPU-bound tasks.
+class QFileAsyncIoPool : public QThreadPool
+{
+public:
+    QFileAsyncIoPool()
+    {
+        setObjectName(QStringLiteral("QFile async I/O"));
+        setMaxThreadCount(qMax(4, QThread::idealThreadCount()));
+    }
+};
+
+// What a worker needs to reach the file without touching the QFile, which
+// belongs to another thread: a private duplicate of the native descriptor
+// where there is one, and otherwise the name to reopen it by.
+struct QFileAsyncTarget
+{
+    QString fileName;
+#ifdef QT_PREAD
+    int fd = -1;
+#endif
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QFileAsyncIoPool, fileAsyncIoPool)
+
+template <typename T>
+static QFuture<T> canceledAsyncFuture()
+{
+    QFutureInterface<T> promise;
+    promise.reportStarted();
+    promise.reportCanceled();
+    promise.reportFinished();
+    return promise.future();
+}
+
+static bool prepareAsync(QFile *file, QFileAsyncTarget *target,
+                         QIODevice::OpenModeFlag access, const char *function)
+{
+    if (!(file->openMode() & access)) {
+        qWarning("QFile::%s: File not open for %s", function,
+                 access == QIODevice::ReadOnly ? "reading" : "writing");
+        return false;
+    }
+    if (file->isSequential()) {
+        qWarning("QFile::%s: Sequential files do not support positional access", function);
+        return false;
+    }
+    // Positional writes on a file opened for appending go to the offset on
+    // some platforms and to the end of the file on others (O_APPEND).
+    if (access == QIODevice::WriteOnly && (file->openMode() & QIODevice::Append)) {
+        qWarning("QFile::%s: Files opened in Append mode do not support positional writes",
+                 function);
+        return false;
+    }
+    // Whatever the QFile has buffered must reach the file before the worker looks at it.
+    if (file->isWritable() && !file->flush())
+        return false;
+
+    target->fileName = file->fileName();
+#ifdef QT_PREAD
+    if (const int fd = file->handle(); fd != -1)
+        target->fd = qt_safe_dup(fd);
+    if (target->fd == -1 && target->fileName.isEmpty())
+        return false;
+#else
+    if (target->fileName.isEmpty())
+        return false;
+#endif
+    return true;
+}
+
+#ifdef QT_PREAD
+static qint64 nativeReadAt(int fd, char *data, qint64 maxSize, qint64 offset)
+{
+    qint64 total = 0;
+    while (total < maxSize) {
+        qint64 r;
+        EINTR_LOOP(r, QT_PREAD(fd, data + total, size_t(maxSize - total), QT_OFF_T(offset + total)));
+        if (r < 0)
+            return -1;
+        if (r == 0)
+            break;
+        total += r;
+    }
+    return total;
+}
+
+static qint64 nativeWriteAt(int fd, const char *data, qint64 size, qint64 offset)
+{
+    qint64 total = 0;
+    while (total < size) {
+        qint64 r;
+        EINTR_LOOP(r, QT_PWRITE(fd, data + total, size_t(size - total), QT_OFF_T(offset + total)));
+        if (r <= 0)
+            return -1;
+        total += r;
+    }
+    return total;
+}
+#endif // QT_PREAD
+
+#ifdef QT_PREAD
+static constexpr qint64 AsyncReadChunkSize = 1024 * 1024;
+#endif
+
+static bool asyncReadAt(QFileAsyncTarget &target, qint64 offset, qint64 maxSize,
+                        QByteArray *data)
+{
+#ifdef QT_PREAD
+    if (target.fd != -1) {
+        // Only regular files report how much there is to read. For anything
+        // else (block devices, say), grow the buffer as the data arrives
+        // instead of allocating maxSize up front.
+        qint64 chunkSize = qMin(maxSize, AsyncReadChunkSize);
+        QT_STATBUF st;
+        if (QT_FSTAT(target.fd, &st) == 0 && S_ISREG(st.st_mode)) {
+            maxSize = qBound(Q_INT64_C(0), qint64(st.st_size) - offset, maxSize);
+            chunkSize = maxSize;
+        }
+        qint64 total = 0;
+        qint64 read = 0;
+        do {
+            const qint64 chunk = qMin(chunkSize, maxSize - total);
+            data->resize(qsizetype(total + chunk));
+            read = nativeReadAt(target.fd, data->data() + total, chunk, offset + total);
+            if (read < 0)
+                break;
+            total += read;
+            if (read < chunk)
+                break;
+        } while (total < maxSize);
+        qt_safe_close(target.fd);
+        if (read < 0)
+            return false;
+        data->truncate(qsizetype(total));
+        return true;
+    }
+#endif
+    QFile file(target.fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered) || !file.seek(offset))
+        return false;
+    *data = file.read(qBound(Q_INT64_C(0), file.size() - offset, maxSize));
+    return file.error() == QFile::NoError;
+}
+
+static qint64 asyncWriteAt(QFileAsyncTarget &target, qint64 offset, const QByteArray &data)
+{
+#ifdef QT_PREAD
+    if (target.fd != -1) {
+        const qint64 written = nativeWriteAt(target.fd, data.constData(), data.size(), offset);
+        qt_safe_close(target.fd);
+        return written;
+    }
+#endif
+    // Anything but ReadWrite would truncate the file.
+    QFile file(target.fileName);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::ExistingOnly | QIODevice::Unbuffered)
+            || !file.seek(offset)) {
+        return -1;
+    }
+    return file.write(data) == data.size() ? data.size() : -1;
+}
+
+/*!
+    \since 6.4
+
+    Starts reading at most \a maxSize bytes at position \a offset of the
+    file on a worker thread and returns a future for the data. Fewer bytes
+    are delivered if the end of the file is reached first.
+
+    The file must be open for reading and must not be sequential. The
+    read does not use or change pos() and does not go through the
+    device's buffers, so the QFile can be used, and even closed, while the
+    read is in progress. Any data written to the QFile but not yet flushed
+    is flushed before the read starts.
+
+    The calls run on a thread pool reserved for file I/O, so a slow
+    network file system does not block the calling thread or
+    QThreadPool::globalInstance(). On Unix systems, the worker reads from a
+    duplicate of the file's native handle with \c pread(); elsewhere, and
+    for files not backed by a native handle, the file is reopened by name.
+
+    If the read cannot be started or fails, the returned future is
+    canceled and holds no result.
+
+    \note Include <QFuture> to use the returned future.
+
+    \sa writeAsync(), QIODevice::read()
+*/
+QFuture<QByteArray> QFile::readAsync(qint64 offset, qint64 maxSize)
+{
+    QFileAsyncTarget target;
+    if (offset < 0 || maxSize < 0
+            || !prepareAsync(this, &target, QIODevice::ReadOnly, "readAsync")) {
+        return canceledAsyncFuture<QByteArray>();
+    }
+    maxSize = qMin(maxSize, qint64(MaxByteArraySize));
+
+    QFutureInterface<QByteArray> promise;
+    promise.reportStarted();
+    fileAsyncIoPool()->start([promise, target, offset, maxSize]() mutable {
+        QByteArray data;
+        if (asyncReadAt(target, offset, maxSize, &data))
+            promise.reportAndMoveResult(std::move(data));
+        else
+            promise.reportCanceled();
+        promise.reportFinished();
+    });
+    return promise.future();
+}
+
+/*!
+    \since 6.4
+
+    Starts writing \a data at position \a offset of the file on a worker
+    thread and returns a future for the number of bytes written, which is
+    the size of \a data on success.
+
+    The file must be open for writing and must not be sequential. Like
+    readAsync(), the write does not use or change pos() and the QFile can
+    be used while it is in progress. Writes through the QFile that
+    overlap a pending asynchronous write have undefined results.
+
+    Files opened in QIODevice::Append mode are rejected: whether a
+    positional write on such a file goes to \a offset or to the end of the
+    file depends on the platform (on Unix, the write always appends).
+
+    If the write cannot be started or fails, the returned future is
+    canceled and holds no result.
+
+    \note Include <QFuture> to use the returned future.
+
+    \sa readAsync(), QIODevice::write()
+*/
+QFuture<qint64> QFile::writeAsync(qint64 offset, const QByteArray &data)
+{
+    QFileAsyncTarget target;
+    if (offset < 0 || !prepareAsync(this, &target, QIODevice::WriteOnly, "writeAsync"))
+        return canceledAsyncFuture<qint64>();
+
+    QFutureInterface<qint64> promise;
+    promise.reportStarted();
+    fileAsyncIoPool()->start([promise, target, offset, data]() mutable {
+        const qint64 written = asyncWriteAt(target, offset, data);
+        if (written >= 0)
+            promise.reportResult(written);
+        else
+            promise.reportCanceled();
+        promise.reportFinished();
+    });
+    return promise.future();
+}
+#endif // QT_CONFIG(future)
+
 /*!
     \fn QFile::QFile(const std::filesystem::path &name)
     \since 6.0
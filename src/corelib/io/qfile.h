@@ -62,6 +62,10 @@ namespace std {
 
 QT_BEGIN_NAMESPACE
 
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
+
 #if QT_CONFIG(cxx17_filesystem)
 namespace QtPrivate {
 inline QString fromFilesystemPath(const std::filesystem::path &path)
@@ -290,6 +294,11 @@ public:
 
     qint64 size() const override;
 
+#if QT_CONFIG(future)
+    QFuture<QByteArray> readAsync(qint64 offset, qint64 maxSize);
+    QFuture<qint64> writeAsync(qint64 offset, const QByteArray &data);
+#endif
+
     bool resize(qint64 sz) override;
     static bool resize(const QString &filename, qint64 sz);
 
@@ -42,6 +42,10 @@
 #include "qfiledevice_p.h"
 #include "qfsfileengine_p.h"
 
+#ifdef Q_OS_UNIX
+#  include <sys/mman.h>
+#endif
+
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
 #endif
@@ -86,6 +90,54 @@ void QFileDevicePrivate::setError(QFileDevice::FileError err, int errNum)
     errorString = qt_error_string(errNum);
 }
 
+/*!
+    \internal
+
+    Maps the whole of the freshly opened file for QIODevice::MemoryMapped
+    reads. Returns \c false, leaving the device to read through the file
+    engine, if the file is sequential, empty or cannot be mapped.
+*/
+bool QFileDevicePrivate::mapForReading()
+{
+    Q_ASSERT(!mappedData);
+    if (!fileEngine || fileEngine->isSequential()
+            || !fileEngine->supportsExtension(QAbstractFileEngine::MapExtension)) {
+        return false;
+    }
+
+    const qint64 size = fileEngine->size();
+    if (size <= 0 || quint64(size) > quint64(std::numeric_limits<qsizetype>::max()))
+        return false;
+
+    uchar *address = fileEngine->map(0, size, QFileDevice::NoOptions);
+    if (!address)
+        return false;
+
+#if defined(Q_OS_UNIX) && defined(POSIX_MADV_SEQUENTIAL)
+    // Only a hint; most readers walk the file front to back.
+    posix_madvise(address, size_t(size), POSIX_MADV_SEQUENTIAL);
+#endif
+
+    mappedData = address;
+    mappedSize = size;
+    // Bypass QIODevice's read buffer: readData() copies straight out of the mapping.
+    readBufferChunkSize = 0;
+    return true;
+}
+
+/*!
+    \internal
+*/
+void QFileDevicePrivate::unmapForReading()
+{
+    if (!mappedData)
+        return;
+    fileEngine->unmap(mappedData);
+    mappedData = nullptr;
+    mappedSize = 0;
+    readBufferChunkSize = QIODEVICE_BUFFERSIZE;
+}
+
 /*!
     \enum QFileDevice::FileError
 
@@ -326,6 +378,8 @@ void QFileDevice::close()
     // reset cached size
     d->cachedSize = 0;
 
+    d->unmapForReading();
+
     // keep earlier error from flush
     if (d->fileEngine->close() && flushed)
         unsetError();
@@ -361,6 +415,9 @@ bool QFileDevice::atEnd() const
     if (!isOpen())
         return true;
 
+    if (d->mappedData)
+        return pos() >= d->mappedSize;
+
     if (!d->ensureFlushed())
         return false;
 
@@ -406,7 +463,8 @@ bool QFileDevice::seek(qint64 off)
     if (!d->ensureFlushed())
         return false;
 
-    if (!d->fileEngine->seek(off) || !QIODevice::seek(off)) {
+    // A memory-mapped device has no engine position to keep in sync.
+    if ((!d->mappedData && !d->fileEngine->seek(off)) || !QIODevice::seek(off)) {
         QFileDevice::FileError err = d->fileEngine->error();
         if (err == QFileDevice::UnspecifiedError)
             err = QFileDevice::PositionError;
@@ -423,6 +481,22 @@ bool QFileDevice::seek(qint64 off)
 qint64 QFileDevice::readLineData(char *data, qint64 maxlen)
 {
     Q_D(QFileDevice);
+    if (d->mappedData) {
+        // QIODevicePrivate::readLine() has made devicePos match pos.
+        const qint64 offset = qMin(d->devicePos, d->mappedSize);
+        const char *begin = reinterpret_cast<const char *>(d->mappedData) + offset;
+        const qint64 available = qMin(maxlen, d->mappedSize - offset);
+        const char *newline = static_cast<const char *>(memchr(begin, '\n', size_t(available)));
+        const qint64 read = newline ? newline - begin + 1 : available;
+        memcpy(data, begin, size_t(read));
+        // Advance the positions ourselves, as QIODevice::readLineData() would,
+        // so that the next read does not have to seek.
+        d->baseReadLineDataCalled = true;
+        d->pos += read;
+        d->devicePos = d->pos;
+        return read;
+    }
+
     if (!d->ensureFlushed())
         return -1;
 
@@ -452,6 +526,14 @@ qint64 QFileDevice::readData(char *data, qint64 len)
     if (!len)
         return 0;
     unsetError();
+
+    if (d->mappedData) {
+        const qint64 offset = qMin(d->devicePos, d->mappedSize);
+        const qint64 read = qMin(len, d->mappedSize - offset);
+        memcpy(data, d->mappedData + offset, size_t(read));
+        return read;
+    }
+
     if (!d->ensureFlushed())
         return -1;
 
@@ -735,6 +817,81 @@ bool QFileDevice::unmap(uchar *address)
     return false;
 }
 
+/*!
+    \since 6.4
+
+    Returns a view of at most \a maxSize bytes at the current position,
+    without advancing it and without copying the data.
+
+    Views are only available while the file is open with
+    QIODevice::MemoryMapped and the mapping succeeded. They point directly
+    into the mapped file, so \c{\\r\\n} is not translated in
+    QIODevice::Text mode; in that mode, or if data has been put back into
+    the device with ungetChar(), a null view is returned and the data must
+    be read with read() instead. At the end of the file, an empty but
+    non-null view is returned.
+
+    The view remains valid until the file is closed.
+
+    \sa readView(), readLineView(), QIODevice::peek()
+*/
+QByteArrayView QFileDevice::peekView(qint64 maxSize) const
+{
+    Q_D(const QFileDevice);
+    if (!d->canReadFromMap())
+        return QByteArrayView();
+    const qint64 offset = qMin(d->pos, d->mappedSize);
+    const qint64 size = qBound(Q_INT64_C(0), maxSize, d->mappedSize - offset);
+    return QByteArrayView(d->mappedData + offset, qsizetype(size));
+}
+
+/*!
+    \since 6.4
+
+    Returns a view of at most \a maxSize bytes at the current position and
+    advances the position past them. The data is not copied.
+
+    The same restrictions as for peekView() apply.
+
+    \sa peekView(), readLineView(), QIODevice::read()
+*/
+QByteArrayView QFileDevice::readView(qint64 maxSize)
+{
+    Q_D(QFileDevice);
+    const QByteArrayView view = peekView(maxSize);
+    if (!view.isNull()) {
+        d->pos += view.size();
+        d->devicePos = d->pos;
+    }
+    return view;
+}
+
+/*!
+    \since 6.4
+
+    Returns a view of the data from the current position up to and
+    including the next \c{'\\n'}, and advances the position past it. If
+    \a maxSize is not 0, the view holds at most \a maxSize bytes. The data
+    is not copied.
+
+    The same restrictions as for peekView() apply.
+
+    \sa peekView(), readView(), QIODevice::readLine()
+*/
+QByteArrayView QFileDevice::readLineView(qint64 maxSize)
+{
+    Q_D(QFileDevice);
+    QByteArrayView view = peekView(maxSize > 0 ? maxSize : d->mappedSize);
+    if (view.isNull())
+        return view;
+    const qsizetype newline = view.indexOf('\n');
+    if (newline >= 0)
+        view.truncate(newline + 1);
+    d->pos += view.size();
+    d->devicePos = d->pos;
+    return view;
+}
+
 /*!
     \enum QFileDevice::FileTime
     \since 5.10
@@ -41,6 +41,7 @@
 #define QFILEDEVICE_H
 
 #include <QtCore/qiodevice.h>
+#include <QtCore/qbytearrayview.h>
 #include <QtCore/qstring.h>
 
 QT_BEGIN_NAMESPACE
@@ -127,6 +128,10 @@ public:
     uchar *map(qint64 offset, qint64 size, MemoryMapFlags flags = NoOptions);
     bool unmap(uchar *address);
 
+    QByteArrayView peekView(qint64 maxSize) const;
+    QByteArrayView readView(qint64 maxSize);
+    QByteArrayView readLineView(qint64 maxSize = 0);
+
     QDateTime fileTime(QFileDevice::FileTime time) const;
     bool setFileTime(const QDateTime &newDate, QFileDevice::FileTime fileTime);
 
@@ -91,9 +91,19 @@ protected:
     void setError(QFileDevice::FileError err, const QString &errorString);
     void setError(QFileDevice::FileError err, int errNum);
 
+    bool mapForReading();
+    void unmapForReading();
+    inline bool canReadFromMap() const
+    { return mappedData && !(openMode & QIODevice::Text) && isBufferEmpty(); }
+
     mutable std::unique_ptr<QAbstractFileEngine> fileEngine;
     mutable qint64 cachedSize;
 
+    // Set when opened with QIODevice::MemoryMapped; reads are then served
+    // from the mapping and devicePos is never forwarded to the engine.
+    uchar *mappedData = nullptr;
+    qint64 mappedSize = 0;
+
     QFileDevice::FileHandleFlags handleFlags;
     QFileDevice::FileError error;
 
@@ -67,6 +67,12 @@
 #include <QtCore/qscopedpointer.h>
 #endif
 
+#if defined(Q_OS_LINUX) && defined(QT_USE_XOPEN_LFS_EXTENSIONS) && defined(QT_LARGEFILE_SUPPORT)
+// QT_DIRENT is struct dirent64, which has the layout getdents64(2) fills in
+#  define QT_FILESYSTEMITERATOR_GETDENTS
+#  include <memory>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QFileSystemIterator
@@ -90,6 +96,15 @@ private:
     bool uncFallback;
     int uncShareIndex;
     bool onlyDirs;
+#elif defined(QT_FILESYSTEMITERATOR_GETDENTS)
+    bool fillDirEntType(QT_DIRENT *entry) const;
+
+    std::unique_ptr<char[]> buffer;
+    int dirFd;
+    int bufferPos;
+    int bufferEnd;
+    int lastError;
+    bool needsFileType;
 #else
     QT_DIR *dir;
     QT_DIRENT *dirEntry;
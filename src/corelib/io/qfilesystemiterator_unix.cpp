@@ -41,6 +41,13 @@
 #include "qfilesystemiterator_p.h"
 
 #include <private/qstringconverter_p.h>
+#ifdef QT_FILESYSTEMITERATOR_GETDENTS
+#  include <private/qcore_unix_p.h>
+#  include <sys/syscall.h>
+#  if QT_CONFIG(statx)
+#    define QT_FILESYSTEMITERATOR_STATX
+#  endif
+#endif
 
 #ifndef QT_NO_FILESYSTEMITERATOR
 
@@ -59,6 +66,113 @@ static bool checkNameDecodable(const char *d_name, qsizetype len)
     return QUtf8::isValidUtf8(QByteArrayView(d_name, len)).isValidUtf8;
 }
 
+#ifdef QT_FILESYSTEMITERATOR_GETDENTS
+// glibc's readdir() refills 32 KiB at a time; a larger buffer needs fewer
+// round trips on big directories, which matters most on network file systems.
+static constexpr int DirentBufferSize = 128 * 1024;
+
+// QDirIterator looks at the type of an entry to recurse into directories and
+// to apply most filters. Only an unfiltered, flat listing can do without.
+static bool filtersNeedFileType(QDir::Filters filters, const QStringList &nameFilters,
+                                QDirIterator::IteratorFlags flags)
+{
+    if (flags & QDirIterator::Subdirectories)
+        return true;
+    if (!(filters & QDir::System) || (filters & QDir::NoSymLinks))
+        return true;
+    if (!(filters & QDir::Files) || !(filters & (QDir::Dirs | QDir::AllDirs)))
+        return true;
+    if ((filters & QDir::AllDirs) && !nameFilters.isEmpty())
+        return true;
+    const QDir::Filters permissions = filters & QDir::PermissionMask;
+    return permissions && permissions != QDir::PermissionMask;
+}
+
+QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Filters filters,
+                                         const QStringList &nameFilters, QDirIterator::IteratorFlags flags)
+    : nativePath(entry.nativeFilePath())
+    , dirFd(-1)
+    , bufferPos(0)
+    , bufferEnd(0)
+    , lastError(0)
+    , needsFileType(filtersNeedFileType(filters, nameFilters, flags))
+{
+    dirFd = qt_safe_open(nativePath.constData(), O_RDONLY | O_DIRECTORY);
+    if (dirFd == -1) {
+        lastError = errno;
+    } else {
+        buffer.reset(new char[DirentBufferSize]);
+        if (!nativePath.endsWith('/'))
+            nativePath.append('/');
+    }
+}
+
+QFileSystemIterator::~QFileSystemIterator()
+{
+    if (dirFd != -1)
+        qt_safe_close(dirFd);
+}
+
+// Some file systems leave d_type as DT_UNKNOWN. Ask for the type alone,
+// relative to the open directory, so that QFileInfo does not have to stat
+// the full path later just to tell files from directories.
+bool QFileSystemIterator::fillDirEntType(QT_DIRENT *entry) const
+{
+    mode_t mode;
+#ifdef QT_FILESYSTEMITERATOR_STATX
+    struct statx statxBuffer;
+    if (statx(dirFd, entry->d_name, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT, STATX_TYPE,
+              &statxBuffer) == 0) {
+        mode = statxBuffer.stx_mode;
+    } else
+#endif
+    {
+        QT_STATBUF statBuffer;
+        if (::fstatat64(dirFd, entry->d_name, &statBuffer, AT_SYMLINK_NOFOLLOW) != 0)
+            return false;
+        mode = statBuffer.st_mode;
+    }
+    entry->d_type = IFTODT(mode);
+    return true;
+}
+
+bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData)
+{
+    if (dirFd == -1)
+        return false;
+
+    for (;;) {
+        if (bufferPos >= bufferEnd) {
+            const long read = syscall(SYS_getdents64, dirFd, buffer.get(), DirentBufferSize);
+            if (read <= 0) {
+                lastError = read < 0 ? errno : 0;
+                return false;
+            }
+            bufferPos = 0;
+            bufferEnd = int(read);
+        }
+
+        auto *entry = reinterpret_cast<QT_DIRENT *>(buffer.get() + bufferPos);
+        bufferPos += entry->d_reclen;
+
+        const qsizetype len = strlen(entry->d_name);
+        if (!checkNameDecodable(entry->d_name, len))
+            continue;
+
+        if (needsFileType && entry->d_type == DT_UNKNOWN)
+            fillDirEntType(entry);
+
+        QByteArray path;
+        path.reserve(nativePath.size() + len);
+        path.append(nativePath).append(entry->d_name, len);
+        fileEntry = QFileSystemEntry(path, QFileSystemEntry::FromNativePath());
+        metaData.fillFromDirEnt(*entry);
+        return true;
+    }
+}
+
+#else // !QT_FILESYSTEMITERATOR_GETDENTS
+
 QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Filters filters,
                                          const QStringList &nameFilters, QDirIterator::IteratorFlags flags)
     : nativePath(entry.nativeFilePath())
@@ -108,6 +222,8 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
     return false;
 }
 
+#endif // QT_FILESYSTEMITERATOR_GETDENTS
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_FILESYSTEMITERATOR
@@ -345,6 +345,11 @@ QIODevicePrivate::~QIODevicePrivate()
                      classes might use this flag in the future, but until then
                      using this flag with any classes other than QFile may
                      result in undefined behavior. (since Qt 5.11)
+    \value MemoryMapped When the file is opened for reading only, serve reads
+                     from a memory mapping of the file instead of copying
+                     them through the device's read buffer. If the file
+                     cannot be mapped, it is read normally. This flag
+                     currently only affects QFile. (since Qt 6.4)
 
     Certain flags, such as \c Unbuffered and \c Truncate, are
     meaningless when used with some subclasses. Some of these
@@ -2262,6 +2267,8 @@ QDebug operator<<(QDebug debug, QIODevice::OpenMode modes)
             modeList << "Text"_L1;
         if (modes & QIODevice::Unbuffered)
             modeList << "Unbuffered"_L1;
+        if (modes & QIODevice::MemoryMapped)
+            modeList << "MemoryMapped"_L1;
     }
     std::sort(modeList.begin(), modeList.end());
     debug << modeList.join(u'|');
@@ -360,7 +360,13 @@ Q_CONSTINIT bool QCoreApplicationPrivate::is_app_closing = false;
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
     QThreadData *currentThreadData = QThreadData::current();
-    return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
+    QPostEventList &postEventList = currentThreadData->postEventList;
+    // queued calls still on the lock-free stack count too
+    if (postEventList.hasIncomingEvents()) {
+        const auto locker = qt_scoped_lock(postEventList.mutex);
+        postEventList.takeIncomingEvents();
+    }
+    return postEventList.size() - postEventList.startOffset;
 }
 
 Q_CONSTINIT QAbstractEventDispatcher *QCoreApplicationPrivate::eventDispatcher = nullptr;
@@ -508,6 +514,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->postEventList.takeIncomingEvents();
         for (int i = 0; i < thisThreadData->postEventList.size(); ++i) {
             const QPostEvent &pe = thisThreadData->postEventList.at(i);
             if (pe.event) {
@@ -1580,6 +1587,8 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     }
 
     QThreadData *data = locker.threadData;
+    // keep the events of each poster in order
+    data->postEventList.takeIncomingEvents();
 
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
@@ -1629,6 +1638,50 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+/*!
+  \internal
+
+  Posts the queued call \a event to \a receiver without locking the post
+  event list: the event is pushed onto the list's incoming stack, and
+  moved into the list by the next thread that locks it.
+
+  Queued calls are never compressed, and as they are posted at normal
+  priority they don't need to be sorted in. postEvent() cannot take this
+  path for QEvent::MetaCall events, as user code may post events of that
+  type that are not QAbstractMetaCallEvents.
+*/
+void QCoreApplicationPrivate::postMetaCallEvent(QObject *receiver, QAbstractMetaCallEvent *event)
+{
+    auto &threadData = QObjectPrivate::get(receiver)->threadData;
+    QThreadData *data = nullptr;
+
+    // if object has moved to another thread, follow it
+    for (;;) {
+        data = threadData.loadAcquire();
+        if (!data) {
+            // posting during destruction? just delete the event to prevent a leak
+            delete event;
+            return;
+        }
+        data->postEventList.incomingPosters.ref();
+        // pairs with the fence in QObject::moveToThread()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (data == threadData.loadRelaxed())
+            break;
+        data->postEventList.incomingPosters.deref();
+    }
+
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+    event->m_posted = true;
+    ++QObjectPrivate::get(receiver)->postedEvents;
+    data->postEventList.pushIncomingEvent(receiver, event);
+    data->postEventList.incomingPosters.deref();
+
+    QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+    if (dispatcher)
+        dispatcher->wakeUp();
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
@@ -1726,6 +1779,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->postEventList.takeIncomingEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1888,6 +1942,8 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
     if (receiver && !receiver->d_func()->postedEvents)
         return;
 
+    data->postEventList.takeIncomingEvents();
+
     //we will collect all the posted events for the QObject
     //and we'll delete after the mutex was unlocked
     QVarLengthArray<QEvent*> events;
@@ -1943,6 +1999,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->postEventList.takeIncomingEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
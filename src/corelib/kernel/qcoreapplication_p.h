@@ -153,6 +153,7 @@ public:
         void unlock() { locker.unlock(); }
     };
     static QPostEventListLocker lockThreadPostEventList(QObject *object);
+    static void postMetaCallEvent(QObject *receiver, QAbstractMetaCallEvent *event);
 #endif // QT_NO_QOBJECT
 
     int &argc;
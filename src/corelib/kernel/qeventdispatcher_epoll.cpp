@@ -0,0 +1,504 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplatformdefs.h"
+
+#include "qcoreapplication.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include "qeventdispatcher_epoll_p.h"
+#include <private/qthread_p.h>
+#include <private/qcoreapplication_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QEventDispatcherEpoll is a drop-in replacement for QEventDispatcherUNIX
+    on Linux. Instead of building a pollfd array for every socket notifier on
+    each pass through the event loop, the descriptors are registered once
+    with a level-triggered epoll instance and only changes to the interest
+    set cost a system call. The cost of a wakeup is then proportional to the
+    number of ready descriptors rather than to the number of registered
+    ones, which matters for servers with thousands of open connections.
+
+    Timers and the wake-up pipe are handled exactly as in
+    QEventDispatcherUNIX. The dispatcher is selected by setting
+    QT_EVENT_DISPATCHER_EPOLL=1 in the environment.
+*/
+
+static const char *socketType(QSocketNotifier::Type type)
+{
+    switch (type) {
+    case QSocketNotifier::Read:
+        return "Read";
+    case QSocketNotifier::Write:
+        return "Write";
+    case QSocketNotifier::Exception:
+        return "Exception";
+    }
+
+    Q_UNREACHABLE();
+}
+
+static int timespecToEpollTimeout(const timespec *tm)
+{
+    if (!tm)
+        return -1;
+
+    // round up, so we don't wake up before the timer is due and spin
+    const qint64 msecs = qint64(tm->tv_sec) * 1000 + (tm->tv_nsec + 999999) / 1000000;
+    return int(qMin<qint64>(msecs, INT_MAX));
+}
+
+QEventDispatcherEpollPrivate::QEventDispatcherEpollPrivate()
+{
+    if (Q_UNLIKELY(threadPipe.init() == false))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot continue without a thread pipe");
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (Q_UNLIKELY(epollFd == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Unable to create epoll instance: %s",
+               qPrintable(qt_error_string(errno)));
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (Q_UNLIKELY(epoll_ctl(epollFd, EPOLL_CTL_ADD, threadPipe.fds[0], &ev) == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Unable to watch the thread pipe: %s",
+               qPrintable(qt_error_string(errno)));
+}
+
+QEventDispatcherEpollPrivate::~QEventDispatcherEpollPrivate()
+{
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+}
+
+void QEventDispatcherEpollPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+
+    if (pendingNotifiers.contains(notifier))
+        return;
+
+    pendingNotifiers << notifier;
+}
+
+int QEventDispatcherEpollPrivate::activateTimers()
+{
+    return timerList.activateTimers();
+}
+
+/*!
+    \internal
+
+    Brings the kernel's interest set for \a fd in line with \a sn_set.
+*/
+void QEventDispatcherEpollPrivate::updateInterest(int fd, const QSocketNotifierSetUNIX &sn_set)
+{
+    const qsizetype pollOnlyIndex = pollOnlyFds.indexOf(fd);
+
+    if (sn_set.isEmpty()) {
+        if (pollOnlyIndex != -1) {
+            pollOnlyFds.removeAt(pollOnlyIndex);
+        } else {
+            // the descriptor may already have been closed, which removes it
+            // from the epoll set on its own; that is not an error
+            epoll_event ev = {};
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &ev);
+        }
+        return;
+    }
+
+    if (pollOnlyIndex != -1)
+        return;
+
+    epoll_event ev = {};
+    if (sn_set.notifiers[QSocketNotifier::Read])
+        ev.events |= EPOLLIN;
+    if (sn_set.notifiers[QSocketNotifier::Write])
+        ev.events |= EPOLLOUT;
+    if (sn_set.notifiers[QSocketNotifier::Exception])
+        ev.events |= EPOLLPRI;
+    ev.data.fd = fd;
+
+    // Try MOD first: the common case is a notifier being toggled on a
+    // descriptor that is already watched. ENOENT means it isn't (or it was
+    // closed and the number reused behind our back).
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) == 0)
+        return;
+    if (errno == ENOENT && epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0)
+        return;
+
+    if (errno == EPERM) {
+        // regular files and the like can't be watched by epoll, but poll(2)
+        // considers them always readable and writable
+        pollOnlyFds.append(fd);
+        return;
+    }
+
+    qWarning("QSocketNotifier: Unable to watch socket %d: %s",
+             fd, qPrintable(qt_error_string(errno)));
+}
+
+void QEventDispatcherEpollPrivate::markPendingSocketNotifiers(const epoll_event *events, int count)
+{
+    static const struct {
+        QSocketNotifier::Type type;
+        uint32_t flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      EPOLLIN  | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Write,     EPOLLOUT | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Exception, EPOLLPRI | EPOLLHUP | EPOLLERR }
+    };
+
+    for (int i = 0; i < count; ++i) {
+        const int fd = events[i].data.fd;
+        if (fd == threadPipe.fds[0])
+            continue;
+
+        auto it = socketNotifiers.constFind(fd);
+        if (it == socketNotifiers.cend())
+            continue;
+
+        const QSocketNotifierSetUNIX &sn_set = it.value();
+        for (const auto &n : notifiers) {
+            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+            if (notifier && (events[i].events & n.flags))
+                setSocketNotifierPending(notifier);
+        }
+    }
+}
+
+void QEventDispatcherEpollPrivate::markPollOnlySocketNotifiers()
+{
+    for (int fd : qAsConst(pollOnlyFds)) {
+        auto it = socketNotifiers.constFind(fd);
+        Q_ASSERT(it != socketNotifiers.cend());
+
+        const QSocketNotifierSetUNIX &sn_set = it.value();
+        if (QSocketNotifier *notifier = sn_set.notifiers[QSocketNotifier::Read])
+            setSocketNotifierPending(notifier);
+        if (QSocketNotifier *notifier = sn_set.notifiers[QSocketNotifier::Write])
+            setSocketNotifierPending(notifier);
+    }
+}
+
+int QEventDispatcherEpollPrivate::activateSocketNotifiers()
+{
+    if (pendingNotifiers.isEmpty())
+        return 0;
+
+    int n_activated = 0;
+    QEvent event(QEvent::SockAct);
+
+    while (!pendingNotifiers.isEmpty()) {
+        QSocketNotifier *notifier = pendingNotifiers.takeFirst();
+        QCoreApplication::sendEvent(notifier, &event);
+        ++n_activated;
+    }
+
+    return n_activated;
+}
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QObject *parent)
+    : QAbstractEventDispatcher(*new QEventDispatcherEpollPrivate, parent)
+{ }
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent)
+    : QAbstractEventDispatcher(dd, parent)
+{ }
+
+QEventDispatcherEpoll::~QEventDispatcherEpoll()
+{ }
+
+/*!
+    \internal
+*/
+void QEventDispatcherEpoll::registerTimer(int timerId, qint64 interval, Qt::TimerType timerType, QObject *obj)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1 || interval < 0 || !obj) {
+        qWarning("QEventDispatcherEpoll::registerTimer: invalid arguments");
+        return;
+    } else if (obj->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::registerTimer: timers cannot be started from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    d->timerList.registerTimer(timerId, interval, timerType, obj);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimer(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: invalid argument");
+        return false;
+    } else if (thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimer(timerId);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimers(QObject *object)
+{
+#ifndef QT_NO_DEBUG
+    if (!object) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: invalid argument");
+        return false;
+    } else if (object->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimers(object);
+}
+
+QList<QEventDispatcherEpoll::TimerInfo>
+QEventDispatcherEpoll::registeredTimers(QObject *object) const
+{
+    if (!object) {
+        qWarning("QEventDispatcherEpoll:registeredTimers: invalid argument");
+        return QList<TimerInfo>();
+    }
+
+    Q_D(const QEventDispatcherEpoll);
+    return d->timerList.registeredTimers(object);
+}
+
+void QEventDispatcherEpoll::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    QSocketNotifier::Type type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (notifier->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be enabled from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    QSocketNotifierSetUNIX &sn_set = d->socketNotifiers[sockfd];
+
+    if (sn_set.notifiers[type] && sn_set.notifiers[type] != notifier)
+        qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
+                 Q_FUNC_INFO, sockfd, socketType(type));
+
+    sn_set.notifiers[type] = notifier;
+    d->updateInterest(sockfd, sn_set);
+}
+
+void QEventDispatcherEpoll::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    QSocketNotifier::Type type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (notifier->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifier (fd %d) cannot be disabled from another thread.\n"
+                "(Notifier's thread is %s(%p), event dispatcher's thread is %s(%p), current thread is %s(%p))",
+                sockfd,
+                notifier->thread() ? notifier->thread()->metaObject()->className() : "QThread", notifier->thread(),
+                thread() ? thread()->metaObject()->className() : "QThread", thread(),
+                QThread::currentThread() ? QThread::currentThread()->metaObject()->className() : "QThread", QThread::currentThread());
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+
+    d->pendingNotifiers.removeOne(notifier);
+
+    auto i = d->socketNotifiers.find(sockfd);
+    if (i == d->socketNotifiers.end())
+        return;
+
+    QSocketNotifierSetUNIX &sn_set = i.value();
+
+    if (sn_set.notifiers[type] == nullptr)
+        return;
+
+    if (sn_set.notifiers[type] != notifier) {
+        qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
+                 Q_FUNC_INFO, sockfd, socketType(type));
+        return;
+    }
+
+    sn_set.notifiers[type] = nullptr;
+    d->updateInterest(sockfd, sn_set);
+
+    if (sn_set.isEmpty())
+        d->socketNotifiers.erase(i);
+}
+
+bool QEventDispatcherEpoll::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.storeRelaxed(0);
+
+    // we are awake, broadcast it
+    emit awake();
+
+    auto threadData = d->threadData.loadRelaxed();
+    QCoreApplicationPrivate::sendPostedEvents(nullptr, 0, threadData);
+
+    const bool include_timers = (flags & QEventLoop::X11ExcludeTimers) == 0;
+    const bool include_notifiers = (flags & QEventLoop::ExcludeSocketNotifiers) == 0;
+    const bool wait_for_events = (flags & QEventLoop::WaitForMoreEvents) != 0;
+
+    const bool canWait = (threadData->canWaitLocked()
+                          && !d->interrupt.loadRelaxed()
+                          && wait_for_events);
+
+    if (canWait)
+        emit aboutToBlock();
+
+    if (d->interrupt.loadRelaxed())
+        return false;
+
+    timespec *tm = nullptr;
+    timespec wait_tm = { 0, 0 };
+
+    if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
+        tm = &wait_tm;
+
+    int nevents = 0;
+
+    if (!include_notifiers) {
+        // The epoll set is level-triggered, so waiting on it while ignoring
+        // the notifiers would return immediately for every ready socket.
+        // Wait on the thread pipe alone instead.
+        pollfd pfd = d->threadPipe.prepare();
+        switch (qt_safe_poll(&pfd, 1, tm)) {
+        case -1:
+            perror("qt_safe_poll");
+            break;
+        case 0:
+            break;
+        default:
+            nevents += d->threadPipe.check(pfd);
+            break;
+        }
+    } else {
+        if (!d->pollOnlyFds.isEmpty()) {
+            wait_tm = { 0, 0 };
+            tm = &wait_tm;
+        }
+
+        const int count = epoll_wait(d->epollFd, d->events, QEventDispatcherEpollPrivate::MaxEventsPerWait,
+                                     timespecToEpollTimeout(tm));
+        if (count == -1) {
+            // unlike qt_safe_poll, don't restart on EINTR: the caller loops
+            // and recalculates the timer deadline anyway
+            if (errno != EINTR)
+                perror("epoll_wait");
+        } else {
+            for (int i = 0; i < count; ++i) {
+                if (d->events[i].data.fd == d->threadPipe.fds[0]) {
+                    pollfd pfd = d->threadPipe.prepare();
+                    pfd.revents = POLLIN;
+                    nevents += d->threadPipe.check(pfd);
+                    break;
+                }
+            }
+            d->markPendingSocketNotifiers(d->events, count);
+        }
+
+        d->markPollOnlySocketNotifiers();
+        nevents += d->activateSocketNotifiers();
+    }
+
+    if (include_timers)
+        nevents += d->activateTimers();
+
+    // return true if we handled events, false otherwise
+    return (nevents > 0);
+}
+
+int QEventDispatcherEpoll::remainingTime(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::remainingTime: invalid argument");
+        return -1;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.timerRemainingTime(timerId);
+}
+
+void QEventDispatcherEpoll::wakeUp()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->threadPipe.wakeUp();
+}
+
+void QEventDispatcherEpoll::interrupt()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.storeRelaxed(1);
+    wakeUp();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qeventdispatcher_epoll_p.cpp"
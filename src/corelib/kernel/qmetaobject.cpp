@@ -54,6 +54,7 @@
 #include <qsemaphore.h>
 #endif
 
+#include "private/qcoreapplication_p.h"
 #include "private/qobject_p.h"
 #include "private/qmetaobject_p.h"
 #include "private/qthread_p.h"
@@ -1537,14 +1538,14 @@ bool QMetaObject::invokeMethodImpl(QObject *object, QtPrivate::QSlotObjectBase *
             return false;
         }
 
-        QCoreApplication::postEvent(object, new QMetaCallEvent(slot, nullptr, -1, 1));
+        QCoreApplicationPrivate::postMetaCallEvent(object, new QMetaCallEvent(slot, nullptr, -1, 1));
     } else if (type == Qt::BlockingQueuedConnection) {
 #if QT_CONFIG(thread)
         if (receiverInSameThread)
             qWarning("QMetaObject::invokeMethod: Dead lock detected");
 
         QSemaphore semaphore;
-        QCoreApplication::postEvent(object, new QMetaCallEvent(slot, nullptr, -1, argv, &semaphore));
+        QCoreApplicationPrivate::postMetaCallEvent(object, new QMetaCallEvent(slot, nullptr, -1, argv, &semaphore));
         semaphore.acquire();
 #endif // QT_CONFIG(thread)
     } else {
@@ -2426,7 +2427,7 @@ bool QMetaMethod::invoke(QObject *object,
             }
         }
 
-        QCoreApplication::postEvent(object, event.release());
+        QCoreApplicationPrivate::postMetaCallEvent(object, event.release());
     } else { // blocking queued connection
 #if QT_CONFIG(thread)
         if (receiverInSameThread) {
@@ -2436,8 +2437,9 @@ bool QMetaMethod::invoke(QObject *object,
         }
 
         QSemaphore semaphore;
-        QCoreApplication::postEvent(object, new QMetaCallEvent(idx_offset, idx_relative, callFunction,
-                                                        nullptr, -1, param, &semaphore));
+        QCoreApplicationPrivate::postMetaCallEvent(object,
+                new QMetaCallEvent(idx_offset, idx_relative, callFunction,
+                                   nullptr, -1, param, &semaphore));
         semaphore.acquire();
 #endif // QT_CONFIG(thread)
     }
@@ -72,6 +72,7 @@
 #include <new>
 #include <mutex>
 #include <memory>
+#include <cstddef>
 
 #include <ctype.h>
 #include <limits.h>
@@ -140,7 +141,12 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
     ushort isSlotObject : 1;
     ushort ownArgumentTypes : 1;
     ushort isSingleShot : 1;
-    Connection() : ownArgumentTypes(true) { }
+    ushort isCoalesced : 1;
+    // the pending call of a Qt::CoalescedConnection; atomic, as the event
+    // delivering it must not take the receiver's signalSlotLock(), see
+    // queued_activate()
+    QAtomicPointer<QMetaCallEvent> coalescedCall;
+    Connection() : ownArgumentTypes(true), isCoalesced(false) { }
     ~Connection();
     int method() const { Q_ASSERT(!isSlotObject); return method_offset + method_relative; }
     void ref() { ref_.ref(); }
@@ -862,6 +868,170 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+namespace {
+/*
+    Recycles the memory of QMetaCallEvents.
+
+    A queued call is usually created in one thread and destroyed in
+    another one. Each thread keeps a list of free blocks that only it
+    touches; a block freed by any other thread is pushed onto a lock-free
+    stack of the cache it was allocated from, which the owner takes over
+    as a whole when its own list runs dry (so there is no ABA problem).
+    The cache of a finished thread is parked for the next new thread to
+    adopt, so a block that is still in flight always has a cache to go
+    back to.
+*/
+class QMetaCallEventCache
+{
+public:
+    struct Block
+    {
+        Block *next;
+        QMetaCallEventCache *cache;
+        alignas(QMetaCallEvent) char storage[sizeof(QMetaCallEvent)];
+    };
+
+    static Block *allocate();
+    static void deallocate(Block *block);
+
+private:
+    enum { MaxFreeBlocks = 512 };
+
+    static QMetaCallEventCache *local();
+    void refill();
+
+    Block *freeList = nullptr;
+    int freeCount = 0;
+    QAtomicPointer<Block> remoteFreeList;
+    QMetaCallEventCache *nextParked = nullptr;
+
+    static QBasicMutex parkedMutex;
+    static QMetaCallEventCache *parked;
+    struct Parker { ~Parker(); };
+};
+
+Q_CONSTINIT QBasicMutex QMetaCallEventCache::parkedMutex;
+Q_CONSTINIT QMetaCallEventCache *QMetaCallEventCache::parked = nullptr;
+Q_CONSTINIT static thread_local QMetaCallEventCache *currentMetaCallEventCache = nullptr;
+Q_CONSTINIT static thread_local bool metaCallEventCacheParked = false;
+
+QMetaCallEventCache::Parker::~Parker()
+{
+    QMetaCallEventCache *cache = std::exchange(currentMetaCallEventCache, nullptr);
+    metaCallEventCacheParked = true;
+    if (cache) {
+        const auto locker = qt_scoped_lock(parkedMutex);
+        cache->nextParked = parked;
+        parked = cache;
+    }
+}
+
+QMetaCallEventCache *QMetaCallEventCache::local()
+{
+    if (QMetaCallEventCache *cache = currentMetaCallEventCache)
+        return cache;
+    // the thread is exiting, don't set up a new cache for it
+    if (metaCallEventCacheParked)
+        return nullptr;
+
+    static thread_local Parker parker;
+    Q_UNUSED(parker);
+
+    QMetaCallEventCache *cache = nullptr;
+    {
+        const auto locker = qt_scoped_lock(parkedMutex);
+        if ((cache = parked))
+            parked = std::exchange(cache->nextParked, nullptr);
+    }
+    if (!cache)
+        cache = new QMetaCallEventCache;
+    currentMetaCallEventCache = cache;
+    return cache;
+}
+
+void QMetaCallEventCache::refill()
+{
+    Q_ASSERT(!freeList);
+    freeList = remoteFreeList.fetchAndStoreAcquire(nullptr);
+    freeCount = 0;
+    for (Block **b = &freeList; *b; b = &(*b)->next) {
+        if (++freeCount > MaxFreeBlocks) {
+            // give the surplus of a burst back to the system
+            Block *surplus = std::exchange(*b, nullptr);
+            while (surplus)
+                ::operator delete(std::exchange(surplus, surplus->next));
+            --freeCount;
+            break;
+        }
+    }
+}
+
+QMetaCallEventCache::Block *QMetaCallEventCache::allocate()
+{
+    QMetaCallEventCache *cache = local();
+    if (cache) {
+        if (!cache->freeList)
+            cache->refill();
+        if (Block *block = cache->freeList) {
+            cache->freeList = block->next;
+            --cache->freeCount;
+            return block;
+        }
+    }
+    Block *block = static_cast<Block *>(::operator new(sizeof(Block)));
+    block->cache = cache;
+    return block;
+}
+
+void QMetaCallEventCache::deallocate(Block *block)
+{
+    QMetaCallEventCache *cache = block->cache;
+    if (!cache) {
+        ::operator delete(block);
+    } else if (cache == currentMetaCallEventCache) {
+        if (cache->freeCount < MaxFreeBlocks) {
+            block->next = cache->freeList;
+            cache->freeList = block;
+            ++cache->freeCount;
+        } else {
+            ::operator delete(block);
+        }
+    } else {
+        Block *head = cache->remoteFreeList.loadRelaxed();
+        do {
+            block->next = head;
+        } while (!cache->remoteFreeList.testAndSetRelease(head, block, head));
+    }
+}
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Queued calls are allocated from a per-thread cache, see
+    QMetaCallEventCache.
+ */
+void *QMetaCallEvent::operator new(std::size_t size)
+{
+    // a subclass we don't know about
+    if (size != sizeof(QMetaCallEvent))
+        return ::operator new(size);
+    return QMetaCallEventCache::allocate()->storage;
+}
+
+/*!
+    \internal
+ */
+void QMetaCallEvent::operator delete(void *ptr, std::size_t size) noexcept
+{
+    if (!ptr)
+        return;
+    if (size != sizeof(QMetaCallEvent))
+        return ::operator delete(ptr);
+    char *block = static_cast<char *>(ptr) - offsetof(QMetaCallEventCache::Block, storage);
+    QMetaCallEventCache::deallocate(reinterpret_cast<QMetaCallEventCache::Block *>(block));
+}
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals().
@@ -1347,6 +1517,8 @@ QObject::~QObject()
 
 QObjectPrivate::Connection::~Connection()
 {
+    // a pending coalesced call keeps the connection alive
+    Q_ASSERT(!coalescedCall.loadRelaxed());
     if (ownArgumentTypes) {
         const int *v = argumentTypes.loadRelaxed();
         if (v != &DIRECT_CONNECTION_ONLY)
@@ -1886,6 +2058,10 @@ void QObject::moveToThread(QThread *targetThread)
     // keep currentData alive (since we've got it locked)
     currentData->ref();
 
+    // queued calls on their way to this object are moved along with the
+    // other posted events
+    currentData->postEventList.takeIncomingEvents();
+
     // move the object
     auto threadPrivate =  targetThread
         ? static_cast<QThreadPrivate *>(QThreadPrivate::get(targetThread))
@@ -1898,6 +2074,30 @@ void QObject::moveToThread(QThread *targetThread)
     }
     d_func()->setThreadData_helper(currentData, targetData, bindingStatus);
 
+    // Queued calls can still be pushed onto currentData's list by threads
+    // that read the old thread data before it was replaced. Wait for them
+    // and move what they posted; pairs with the fence in
+    // QCoreApplicationPrivate::postMetaCallEvent().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (currentData->postEventList.incomingPosters.loadAcquire())
+        QThread::yieldCurrentThread();
+    if (currentData->postEventList.hasIncomingEvents()) {
+        currentData->postEventList.takeIncomingEvents();
+        int eventsMoved = 0;
+        for (int i = 0; i < currentData->postEventList.size(); ++i) {
+            const QPostEvent &pe = currentData->postEventList.at(i);
+            if (pe.event && pe.receiver->d_func()->threadData.loadRelaxed() == targetData) {
+                targetData->postEventList.addEvent(pe);
+                const_cast<QPostEvent &>(pe).event = nullptr;
+                ++eventsMoved;
+            }
+        }
+        if (eventsMoved > 0 && targetData->hasEventDispatcher()) {
+            targetData->canWait = false;
+            targetData->eventDispatcher.loadRelaxed()->wakeUp();
+        }
+    }
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -3684,6 +3884,8 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
 
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~Qt::CoalescedConnection;
 
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
@@ -3702,6 +3904,7 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
     c->isSingleShot = isSingleShot;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
 
@@ -3999,6 +4202,46 @@ private:
     QtPrivate::QSlotObjectBase *m_slotObject = nullptr;
 };
 
+namespace {
+/*
+    Delivers the latest call of a Qt::CoalescedConnection. There is at
+    most one of these per connection in the event queue, and while it is
+    there, the connection's coalescedCall is set.
+*/
+class QCoalescedMetaCallEvent : public QAbstractMetaCallEvent
+{
+public:
+    QCoalescedMetaCallEvent(QObjectPrivate::Connection *c, const QObject *sender, int signalId)
+        : QAbstractMetaCallEvent(sender, signalId), connection(c)
+    {
+        connection->ref();
+    }
+
+    ~QCoalescedMetaCallEvent()
+    {
+        // dropped without being delivered (e.g. by removePostedEvents(), or
+        // by postMetaCallEvent() while queued_activate() holds the lock), so
+        // the next emission needs to post again
+        std::unique_ptr<QMetaCallEvent> call(takeCall());
+        connection->deref();
+    }
+
+    void placeMetaCall(QObject *object) override
+    {
+        if (std::unique_ptr<QMetaCallEvent> call{takeCall()})
+            call->placeMetaCall(object);
+    }
+
+private:
+    QMetaCallEvent *takeCall()
+    {
+        return connection->coalescedCall.fetchAndStoreAcquire(nullptr);
+    }
+
+    QObjectPrivate::Connection *connection;
+};
+} // unnamed namespace
+
 /*!
     \internal
 
@@ -4065,7 +4308,20 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
-    QCoreApplication::postEvent(receiver, ev);
+    if (c->isCoalesced) {
+        // if the previous emission is still waiting to be delivered, only
+        // replace its arguments; otherwise post an event to deliver ours
+        if (QMetaCallEvent *pending = c->coalescedCall.fetchAndStoreOrdered(ev)) {
+            locker.unlock();
+            delete pending;
+            return;
+        }
+        QCoreApplicationPrivate::postMetaCallEvent(receiver,
+                                                   new QCoalescedMetaCallEvent(c, sender, signal));
+        return;
+    }
+
+    QCoreApplicationPrivate::postMetaCallEvent(receiver, ev);
 }
 
 template <bool callbacks_enabled>
@@ -4172,7 +4428,7 @@ void doActivate(QObject *sender, int signal_index, void **argv)
                         new QMetaCallEvent(c->slotObj, sender, signal_index, argv, &semaphore) :
                         new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction,
                                            sender, signal_index, argv, &semaphore);
-                    QCoreApplication::postEvent(receiver, ev);
+                    QCoreApplicationPrivate::postMetaCallEvent(receiver, ev);
                 }
                 semaphore.acquire();
                 continue;
@@ -5315,6 +5571,8 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
 
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~Qt::CoalescedConnection;
 
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
@@ -5334,6 +5592,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
         c->ownArgumentTypes = false;
     }
     c->isSingleShot = isSingleShot;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
     QMetaObject::Connection ret(c.release());
@@ -397,11 +397,16 @@ public:
     inline int signalId() const { return signalId_; }
 
 private:
+    friend class QPostEventList;
+
     int signalId_;
     const QObject *sender_;
 #if QT_CONFIG(thread)
     QSemaphore *semaphore_;
 #endif
+    // used while the event is on QPostEventList's incoming stack
+    QObject *postedReceiver_ = nullptr;
+    QAbstractMetaCallEvent *nextPosted_ = nullptr;
 };
 
 class Q_CORE_EXPORT QMetaCallEvent : public QAbstractMetaCallEvent
@@ -435,6 +440,10 @@ public:
 
     virtual void placeMetaCall(QObject *object) override;
 
+    // recycled per thread, see qobject.cpp
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size) noexcept;
+
 private:
     inline void allocArgs();
 
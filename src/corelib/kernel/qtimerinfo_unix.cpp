@@ -40,6 +40,7 @@
 
 #include <qelapsedtimer.h>
 #include <qcoreapplication.h>
+#include <qvarlengtharray.h>
 
 #include "private/qcore_unix_p.h"
 #include "private/qtimerinfo_unix_p.h"
@@ -53,10 +54,27 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
 
+static inline quint64 timespecToTick(timespec t, bool roundUp)
+{
+    if (t.tv_sec < 0)
+        return 0;
+    return quint64(t.tv_sec) * 1000 + (quint64(t.tv_nsec) + (roundUp ? 999999 : 0)) / 1000000;
+}
+
+static inline timespec tickToTimespec(quint64 tick)
+{
+    timespec t;
+    t.tv_sec = time_t(tick / 1000);
+    t.tv_nsec = long(tick % 1000) * 1000 * 1000;
+    return t;
+}
+
 /*
  * Internal functions for manipulating timer data structures.  The
  * timerBitVec array is used for keeping track of timer identifiers.
@@ -83,7 +101,13 @@ QTimerInfoList::QTimerInfoList()
     }
 #endif
 
-    firstTimerInfo = nullptr;
+    std::fill_n(occupied, std::size(occupied), 0);
+    wheelTick = 0;
+}
+
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(timers);
 }
 
 timespec QTimerInfoList::updateCurrentTime()
@@ -146,11 +170,20 @@ bool QTimerInfoList::timeChanged(timespec *delta)
 */
 void QTimerInfoList::timerRepair(const timespec &diff)
 {
-    // repair all timers
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
+    // repair all timers; the wheel positions are meaningless after a clock
+    // change, so take everything out and put it back relative to now
+    QVarLengthArray<QTimerInfo *> wheeled;
+    for (QTimerInfo *t : qAsConst(timers)) {
         t->timeout = t->timeout + diff;
+        if (t->bucket != ExpiredBucket) {
+            unlink(t);
+            wheeled.append(t);
+        }
     }
+
+    wheelTick = timespecToTick(currentTime, false);
+    for (QTimerInfo *t : qAsConst(wheeled))
+        wheelInsert(t);
 }
 
 void QTimerInfoList::repairTimersIfNeeded()
@@ -171,17 +204,171 @@ void QTimerInfoList::repairTimersIfNeeded()
 #endif
 
 /*
-  insert timer info into list
+  Timer wheel bookkeeping. Every registered timer lives in exactly one
+  bucket: a root bucket (one per millisecond tick of the current 256 ms
+  rotation), a bucket of one of the coarser levels, the overflow bucket, or
+  the expired bucket, which holds the timers activateTimers() is about to
+  fire.
 */
-void QTimerInfoList::timerInsert(QTimerInfo *ti)
+void QTimerInfoList::link(uint bucket, QTimerInfo *t)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
-            break;
+    Bucket &b = buckets[bucket];
+    t->bucket = int(bucket);
+    t->next = nullptr;
+    t->prev = b.last;
+    if (b.last)
+        b.last->next = t;
+    else
+        b.first = t;
+    b.last = t;
+
+    if (bucket < OverflowBucket)
+        occupied[bucket / 64] |= Q_UINT64_C(1) << (bucket % 64);
+}
+
+void QTimerInfoList::unlink(QTimerInfo *t)
+{
+    const uint bucket = uint(t->bucket);
+    Bucket &b = buckets[bucket];
+    if (t->prev)
+        t->prev->next = t->next;
+    else
+        b.first = t->next;
+    if (t->next)
+        t->next->prev = t->prev;
+    else
+        b.last = t->prev;
+    t->prev = t->next = nullptr;
+
+    if (!b.first && bucket < OverflowBucket)
+        occupied[bucket / 64] &= ~(Q_UINT64_C(1) << (bucket % 64));
+}
+
+void QTimerInfoList::wheelInsert(QTimerInfo *t)
+{
+    // overdue timers go into the bucket that is expired next
+    const quint64 expires = qMax(timespecToTick(t->timeout, true), wheelTick);
+    const quint64 delta = expires - wheelTick;
+
+    uint bucket;
+    if (delta < RootSize) {
+        bucket = expires % RootSize;
+    } else {
+        bucket = OverflowBucket;
+        for (uint level = 0; level < LevelCount; ++level) {
+            const uint shift = RootBits + level * LevelBits;
+            if (delta < (Q_UINT64_C(1) << (shift + LevelBits))) {
+                bucket = RootSize + level * LevelSize + ((expires >> shift) % LevelSize);
+                break;
+            }
+        }
     }
-    insert(index+1, ti);
+    link(bucket, t);
+}
+
+void QTimerInfoList::rehashBucket(uint bucket)
+{
+    QTimerInfo *t = buckets[bucket].first;
+    buckets[bucket] = Bucket();
+    if (bucket < OverflowBucket)
+        occupied[bucket / 64] &= ~(Q_UINT64_C(1) << (bucket % 64));
+
+    while (t) {
+        QTimerInfo *next = t->next;
+        wheelInsert(t);
+        t = next;
+    }
+}
+
+/*
+  Called whenever wheelTick starts a new rotation of the root buckets:
+  moves the timers due in this rotation down from the first level, and the
+  levels above that whenever the one below them wraps around.
+*/
+void QTimerInfoList::cascade()
+{
+    for (uint level = 0; level < LevelCount; ++level) {
+        const uint shift = RootBits + level * LevelBits;
+        const uint index = (wheelTick >> shift) % LevelSize;
+        rehashBucket(RootSize + level * LevelSize + index);
+        if (index != 0)
+            return;
+    }
+    rehashBucket(OverflowBucket);
+}
+
+uint QTimerInfoList::nextOccupiedRootBucket(uint from) const
+{
+    for (uint word = from / 64; word < RootSize / 64; ++word) {
+        quint64 bits = occupied[word];
+        if (word == from / 64)
+            bits &= ~Q_UINT64_C(0) << (from % 64);
+        if (bits)
+            return word * 64 + qCountTrailingZeroBits(bits);
+    }
+    return RootSize;
+}
+
+/*
+  Moves all timers due at \a currentTime into the expired bucket, sorted by
+  their timeout.
+*/
+void QTimerInfoList::expireTimers(timespec currentTime)
+{
+    const quint64 currentTick = timespecToTick(currentTime, false);
+    while (wheelTick <= currentTick) {
+        const uint index = wheelTick % RootSize;
+        if (index == 0)
+            cascade();
+
+        QTimerInfo *t = buckets[index].first;
+        while (t) {
+            QTimerInfo *next = t->next;
+            unlink(t);
+            link(ExpiredBucket, t);
+            t = next;
+        }
+
+        // skip the empty buckets, but not the start of the next rotation
+        const quint64 next = wheelTick - index + nextOccupiedRootBucket(index + 1);
+        wheelTick = qMin(next, currentTick + 1);
+    }
+
+    // the bucket for the next tick may hold timers due within the current
+    // millisecond (cascading is idempotent, so doing it early is fine)
+    const uint index = wheelTick % RootSize;
+    if (index == 0)
+        cascade();
+    for (QTimerInfo *t = buckets[index].first; t; ) {
+        QTimerInfo *next = t->next;
+        if (!(currentTime < t->timeout)) {
+            unlink(t);
+            link(ExpiredBucket, t);
+        }
+        t = next;
+    }
+
+    Bucket &expired = buckets[ExpiredBucket];
+    if (expired.first == expired.last)
+        return;
+
+    QVarLengthArray<QTimerInfo *, 64> sorted;
+    for (QTimerInfo *t = expired.first; t; t = t->next)
+        sorted.append(t);
+    std::stable_sort(sorted.begin(), sorted.end(), [](const QTimerInfo *lhs, const QTimerInfo *rhs) {
+        return lhs->timeout < rhs->timeout;
+    });
+    expired = Bucket();
+    for (QTimerInfo *t : qAsConst(sorted))
+        link(ExpiredBucket, t);
+}
+
+/*
+  insert timer info into the wheel
+*/
+void QTimerInfoList::timerInsert(QTimerInfo *ti)
+{
+    wheelInsert(ti);
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -392,20 +579,69 @@ bool QTimerInfoList::timerWait(timespec &tm)
     repairTimersIfNeeded();
 
     // Find first waiting timer not already active
-    QTimerInfo *t = nullptr;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
+    const auto firstWaiting = [](const Bucket &b) -> const QTimerInfo * {
+        const QTimerInfo *first = nullptr;
+        for (const QTimerInfo *t = b.first; t; t = t->next) {
+            if (!t->activateRef && (!first || t->timeout < first->timeout))
+                first = t;
         }
+        return first;
+    };
+
+    bool found = false;
+    timespec timeout;
+
+    // timers that are about to be fired by an outer activateTimers() call
+    if (const QTimerInfo *t = firstWaiting(buckets[ExpiredBucket])) {
+        found = true;
+        timeout = t->timeout;
     }
 
-    if (!t)
+    // the root buckets, in the order they expire
+    const uint root = wheelTick % RootSize;
+    for (uint i = 0; !found && i < 2; ++i) {
+        const uint end = i ? root : RootSize;
+        for (uint bucket = nextOccupiedRootBucket(i ? 0 : root); bucket < end;
+             bucket = nextOccupiedRootBucket(bucket + 1)) {
+            if (const QTimerInfo *t = firstWaiting(buckets[bucket])) {
+                found = true;
+                timeout = t->timeout;
+                break;
+            }
+        }
+    }
+
+    // For the coarser levels it's enough to know when the first non-empty
+    // bucket gets cascaded: the timers in it can't fire before that.
+    for (uint level = 0; level < LevelCount; ++level) {
+        const quint64 bits = occupied[RootSize / 64 + level];
+        if (!bits)
+            continue;
+        const uint shift = RootBits + level * LevelBits;
+        const uint current = (wheelTick >> shift) % LevelSize;
+        const quint64 later = (current + 1 < LevelSize) ? bits & (~Q_UINT64_C(0) << (current + 1)) : 0;
+        const uint index = qCountTrailingZeroBits(later ? later : bits);
+        const uint distance = ((index - current) % LevelSize) ? (index - current) % LevelSize : LevelSize;
+        const timespec start = tickToTimespec(((wheelTick >> shift) + distance) << shift);
+        if (!found || start < timeout) {
+            found = true;
+            timeout = start;
+        }
+    }
+
+    if (const QTimerInfo *t = firstWaiting(buckets[OverflowBucket])) {
+        if (!found || t->timeout < timeout) {
+            found = true;
+            timeout = t->timeout;
+        }
+    }
+
+    if (!found)
       return false;
 
-    if (currentTime < t->timeout) {
+    if (currentTime < timeout) {
         // time to wait
-        tm = roundToMillisecond(t->timeout - currentTime);
+        tm = roundToMillisecond(timeout - currentTime);
     } else {
         // no time to wait
         tm.tv_sec  = 0;
@@ -426,16 +662,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timers.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -454,6 +687,8 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
     t->timerType = timerType;
     t->obj = object;
     t->activateRef = nullptr;
+    t->prev = t->next = nullptr;
+    t->bucket = -1;
 
     timespec expected = updateCurrentTime() + interval;
 
@@ -496,6 +731,11 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
             ++t->timeout.tv_sec;
     }
 
+    // an empty wheel can be moved to the present for free, which saves
+    // walking over all the ticks that passed while no timer was running
+    if (timers.isEmpty())
+        wheelTick = timespecToTick(currentTime, false);
+    timers.insert(timerId, t);
     timerInsert(t);
 
 #ifdef QTIMERINFO_DEBUG
@@ -511,39 +751,32 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
     // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    QTimerInfo *t = timers.take(timerId);
+    if (!t)
+        return false; // id not found
+
+    unlink(t);
+    if (t->activateRef)
+        *(t->activateRef) = nullptr;
+    delete t;
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
+    for (auto it = timers.begin(); it != timers.end(); ) {
+        QTimerInfo *t = it.value();
         if (t->obj == object) {
             // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
+            it = timers.erase(it);
+            unlink(t);
             if (t->activateRef)
                 *(t->activateRef) = nullptr;
             delete t;
-            // move back one so that we don't skip the new current item
-            --i;
+        } else {
+            ++it;
         }
     }
     return true;
@@ -552,8 +785,7 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
+    for (const QTimerInfo *t : timers) {
         if (t->obj == object) {
             list << QAbstractEventDispatcher::TimerInfo(t->id,
                                                         (t->timerType == Qt::VeryCoarseTimer
@@ -573,42 +805,21 @@ int QTimerInfoList::activateTimers()
     if (qt_disable_lowpriority_timers || isEmpty())
         return 0; // nothing to do
 
-    int n_act = 0, maxCount = 0;
-    firstTimerInfo = nullptr;
+    int n_act = 0;
 
     timespec currentTime = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << currentTime;
     repairTimersIfNeeded();
 
-
-    // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
-    }
+    // Find out which timers have expired. Each of them is fired at most once
+    // per call: re-armed timers go back into the wheel, not into the
+    // expired bucket.
+    expireTimers(currentTime);
 
     //fire the timers.
-    while (maxCount--) {
-        if (isEmpty())
-            break;
-
-        QTimerInfo *currentTimerInfo = constFirst();
-        if (currentTime < currentTimerInfo->timeout)
-            break; // no timer has expired
-
-        if (!firstTimerInfo) {
-            firstTimerInfo = currentTimerInfo;
-        } else if (firstTimerInfo == currentTimerInfo) {
-            // avoid sending the same timer multiple times
-            break;
-        } else if (currentTimerInfo->interval <  firstTimerInfo->interval
-                   || currentTimerInfo->interval == firstTimerInfo->interval) {
-            firstTimerInfo = currentTimerInfo;
-        }
-
+    while (QTimerInfo *currentTimerInfo = buckets[ExpiredBucket].first) {
         // remove from list
-        removeFirst();
+        unlink(currentTimerInfo);
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -653,7 +864,6 @@ int QTimerInfoList::activateTimers()
         }
     }
 
-    firstTimerInfo = nullptr;
     // qDebug() << "Thread" << QThread::currentThreadId() << "activated" << n_act << "timers";
     return n_act;
 }
@@ -56,6 +56,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -70,6 +71,11 @@ struct QTimerInfo {
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
 
+    // links into the timer wheel bucket the timer currently lives in
+    QTimerInfo *prev;
+    QTimerInfo *next;
+    int bucket;
+
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
     float cumulativeError;
@@ -77,8 +83,10 @@ struct QTimerInfo {
 #endif
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+class Q_CORE_EXPORT QTimerInfoList
 {
+    Q_DISABLE_COPY_MOVE(QTimerInfoList)
+
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
     timespec previousTime;
     clock_t previousTicks;
@@ -89,11 +97,44 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     void timerRepair(const timespec &);
 #endif
 
-    // state variables used by activateTimers()
-    QTimerInfo *firstTimerInfo;
+    // The timers are kept in a hierarchical timer wheel with a resolution of
+    // one millisecond: 256 buckets of 1 ms, then three levels of 64 buckets
+    // covering 2^14, 2^20 and 2^26 ms. Timers further away than that (about
+    // 18 hours) wait in an overflow bucket. Registering and unregistering a
+    // timer is O(1); timers move down a level at most three times during
+    // their lifetime.
+    enum : uint {
+        RootBits = 8,
+        LevelBits = 6,
+        RootSize = 1 << RootBits,
+        LevelSize = 1 << LevelBits,
+        LevelCount = 3,
+        OverflowBucket = RootSize + LevelCount * LevelSize,
+        ExpiredBucket,
+        BucketCount
+    };
+
+    struct Bucket {
+        QTimerInfo *first = nullptr;
+        QTimerInfo *last = nullptr;
+    };
+
+    Bucket buckets[BucketCount];
+    quint64 occupied[RootSize / 64 + LevelCount];  // non-empty buckets, except overflow and expired
+    quint64 wheelTick;   // first tick whose root bucket hasn't been expired yet
+    QHash<int, QTimerInfo *> timers;
+
+    void link(uint bucket, QTimerInfo *t);
+    void unlink(QTimerInfo *t);
+    void wheelInsert(QTimerInfo *t);
+    void rehashBucket(uint bucket);
+    void cascade();
+    uint nextOccupiedRootBucket(uint from) const;
+    void expireTimers(timespec currentTime);
 
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
 
     timespec currentTime;
     timespec updateCurrentTime();
@@ -112,6 +153,9 @@ public:
     QList<QAbstractEventDispatcher::TimerInfo> registeredTimers(QObject *object) const;
 
     int activateTimers();
+
+    bool isEmpty() const { return timers.isEmpty(); }
+    qsizetype size() const { return timers.size(); }
 };
 
 QT_END_NAMESPACE
@@ -47,6 +47,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -283,8 +284,63 @@ void Parser::eatBOM()
         json += 3;
 }
 
-bool Parser::eatSpace()
+/*
+    The scanners below look at 16 bytes at a time where SIMD is available,
+    and finish with the same byte by byte loops as the parser used before,
+    so they return the same positions.
+*/
+#if defined(__SSE2__)
+// returns a bit for each of the 16 bytes at p that is not JSON whitespace
+static inline uint nonSpaceMask(const char *p) noexcept
+{
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i space = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8(Space)), _mm_cmpeq_epi8(data, _mm_set1_epi8(Tab))),
+            _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8(LineFeed)), _mm_cmpeq_epi8(data, _mm_set1_epi8(Return))));
+    return ~uint(_mm_movemask_epi8(space)) & 0xffff;
+}
+
+// returns a bit for each of the 16 bytes at p that ends a run of ASCII
+// string characters: quotes, backslashes and non-ASCII bytes
+static inline uint stringSpecialMask(const char *p) noexcept
+{
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8(Quote)),
+                                         _mm_cmpeq_epi8(data, _mm_set1_epi8('\\')));
+    // non-ASCII bytes have the sign bit set already
+    return uint(_mm_movemask_epi8(_mm_or_si128(special, data)));
+}
+#elif defined(__ARM_NEON__)
+static inline bool hasNonSpace(const char *p) noexcept
+{
+    const uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+    const uint8x16_t space = vorrq_u8(
+            vorrq_u8(vceqq_u8(data, vdupq_n_u8(Space)), vceqq_u8(data, vdupq_n_u8(Tab))),
+            vorrq_u8(vceqq_u8(data, vdupq_n_u8(LineFeed)), vceqq_u8(data, vdupq_n_u8(Return))));
+    return vminvq_u8(space) == 0;
+}
+
+static inline bool hasStringSpecial(const char *p) noexcept
+{
+    const uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+    const uint8x16_t special = vorrq_u8(
+            vorrq_u8(vceqq_u8(data, vdupq_n_u8(Quote)), vceqq_u8(data, vdupq_n_u8('\\'))),
+            vcgeq_u8(data, vdupq_n_u8(0x80)));
+    return vmaxvq_u8(special) != 0;
+}
+#endif
+
+static inline const char *skipSpace(const char *json, const char *end) noexcept
 {
+#if defined(__SSE2__)
+    for ( ; end - json >= 16; json += 16) {
+        if (uint mask = nonSpaceMask(json))
+            return json + qCountTrailingZeroBits(mask);
+    }
+#elif defined(__ARM_NEON__)
+    for ( ; end - json >= 16 && !hasNonSpace(json); json += 16)
+        ;
+#endif
     while (json < end) {
         if (*json > Space)
             break;
@@ -295,6 +351,37 @@ bool Parser::eatSpace()
             break;
         ++json;
     }
+    return json;
+}
+
+// returns the first quote, backslash or non-ASCII byte at or after json
+static inline const char *scanAsciiStringChars(const char *json, const char *end) noexcept
+{
+#if defined(__SSE2__)
+    for ( ; end - json >= 16; json += 16) {
+        if (uint mask = stringSpecialMask(json))
+            return json + qCountTrailingZeroBits(mask);
+    }
+#elif defined(__ARM_NEON__)
+    for ( ; end - json >= 16 && !hasStringSpecial(json); json += 16)
+        ;
+#endif
+    while (json < end && *json != Quote && *json != '\\' && uchar(*json) < 0x80)
+        ++json;
+    return json;
+}
+
+const char *QJsonPrivate::skipWhitespace(const char *json, const char *end) noexcept
+{
+    return skipSpace(json, end);
+}
+
+bool Parser::eatSpace()
+{
+    // compact documents rarely have more than one space in a row
+    if (json < end && uchar(*json) > Space)
+        return true;
+    json = skipSpace(json, end);
     return (json < end);
 }
 
@@ -713,12 +800,9 @@ bool Parser::parseValue()
 
 */
 
-bool Parser::parseNumber()
+const char *QJsonPrivate::scanNumber(const char *json, const char *end, bool *isInt) noexcept
 {
-    BEGIN << "parseNumber" << json;
-
-    const char *start = json;
-    bool isInt = true;
+    *isInt = true;
 
     // minus
     if (json < end && *json == '-')
@@ -736,14 +820,14 @@ bool Parser::parseNumber()
     if (json < end && *json == '.') {
         ++json;
         while (json < end && *json >= '0' && *json <= '9') {
-            isInt = isInt && *json == '0';
+            *isInt = *isInt && *json == '0';
             ++json;
         }
     }
 
     // exp = e [ minus / plus ] 1*DIGIT
     if (json < end && (*json == 'e' || *json == 'E')) {
-        isInt = false;
+        *isInt = false;
         ++json;
         if (json < end && (*json == '-' || *json == '+'))
             ++json;
@@ -751,20 +835,18 @@ bool Parser::parseNumber()
             ++json;
     }
 
-    if (json >= end) {
-        lastError = QJsonParseError::TerminationByNumber;
-        return false;
-    }
+    return json;
+}
 
-    const QByteArray number = QByteArray::fromRawData(start, json - start);
+bool QJsonPrivate::numberToValue(QByteArrayView number, bool isInt, QCborValue *value)
+{
     DEBUG << "numberstring" << number;
 
     if (isInt) {
         bool ok;
         qlonglong n = number.toLongLong(&ok);
         if (ok) {
-            container->append(QCborValue(n));
-            END;
+            *value = QCborValue(n);
             return true;
         }
     }
@@ -772,16 +854,36 @@ bool Parser::parseNumber()
     bool ok;
     double d = number.toDouble(&ok);
 
-    if (!ok) {
-        lastError = QJsonParseError::IllegalNumber;
+    if (!ok)
         return false;
-    }
 
     qint64 n;
     if (convertDoubleTo(d, &n))
-        container->append(QCborValue(n));
+        *value = QCborValue(n);
     else
-        container->append(QCborValue(d));
+        *value = QCborValue(d);
+    return true;
+}
+
+bool Parser::parseNumber()
+{
+    BEGIN << "parseNumber" << json;
+
+    const char *start = json;
+    bool isInt;
+    json = scanNumber(json, end, &isInt);
+
+    if (json >= end) {
+        lastError = QJsonParseError::TerminationByNumber;
+        return false;
+    }
+
+    QCborValue value;
+    if (!numberToValue(QByteArrayView(start, json - start), isInt, &value)) {
+        lastError = QJsonParseError::IllegalNumber;
+        return false;
+    }
+    container->append(value);
 
     END;
     return true;
@@ -881,6 +983,78 @@ static inline bool scanUtf8Char(const char *&json, const char *end, char32_t *re
     return true;
 }
 
+// Validates the UTF-8 up to the closing quote or the first escape sequence,
+// noting whether it's 7bit ASCII. Leaves json at the quote or backslash.
+static QJsonParseError::ParseError scanUnescapedString(const char *&json, const char *end,
+                                                       bool *isAscii)
+{
+    *isAscii = true;
+    while (json < end) {
+        json = scanAsciiStringChars(json, end);
+        if (json >= end)
+            break;
+        char32_t ch = 0;
+        if (*json == '"' || *json == '\\')
+            return QJsonParseError::NoError;
+        if (!scanUtf8Char(json, end, &ch))
+            return QJsonParseError::IllegalUTF8String;
+        if (ch > 0x7f)
+            *isAscii = false;
+        DEBUG << "  " << ch << char(ch);
+    }
+    return QJsonParseError::UnterminatedString;
+}
+
+// Decodes the string up to the closing quote, resolving escape sequences.
+// Leaves json at the quote.
+static QJsonParseError::ParseError decodeEscapedString(const char *&json, const char *end,
+                                                       QString *ucs4)
+{
+    while (json < end) {
+        const char *run = json;
+        json = scanAsciiStringChars(json, end);
+        if (json != run)
+            ucs4->append(QLatin1String(run, json - run));
+        if (json >= end)
+            break;
+        char32_t ch = 0;
+        if (*json == '"')
+            return QJsonParseError::NoError;
+        else if (*json == '\\') {
+            if (!scanEscapeSequence(json, end, &ch))
+                return QJsonParseError::IllegalEscapeSequence;
+        } else {
+            if (!scanUtf8Char(json, end, &ch))
+                return QJsonParseError::IllegalUTF8String;
+        }
+        ucs4->append(QChar::fromUcs4(ch));
+    }
+    return QJsonParseError::UnterminatedString;
+}
+
+QJsonParseError::ParseError QJsonPrivate::decodeString(const char *&json, const char *end,
+                                                       QString *result)
+{
+    const char *start = json;
+    bool isAscii;
+    QJsonParseError::ParseError error = scanUnescapedString(json, end, &isAscii);
+    if (error != QJsonParseError::NoError)
+        return error;
+
+    if (*json == '"') {
+        *result = isAscii ? QString::fromLatin1(start, json - start)
+                          : QString::fromUtf8(start, json - start);
+    } else {
+        json = start;
+        result->clear();
+        error = decodeEscapedString(json, end, result);
+        if (error != QJsonParseError::NoError)
+            return error;
+    }
+    ++json;
+    return QJsonParseError::NoError;
+}
+
 bool Parser::parseString()
 {
     const char *start = json;
@@ -888,28 +1062,15 @@ bool Parser::parseString()
     // try to parse a utf-8 string without escape sequences, and note whether it's 7bit ASCII.
 
     BEGIN << "parse string" << json;
-    bool isUtf8 = true;
-    bool isAscii = true;
-    while (json < end) {
-        char32_t ch = 0;
-        if (*json == '"')
-            break;
-        if (*json == '\\') {
-            isAscii = false;
-            // If we find escape sequences, we store UTF-16 as there are some
-            // escape sequences which are hard to represent in UTF-8.
-            // (plain "\\ud800" for example)
-            isUtf8 = false;
-            break;
-        }
-        if (!scanUtf8Char(json, end, &ch)) {
-            lastError = QJsonParseError::IllegalUTF8String;
-            return false;
-        }
-        if (ch > 0x7f)
-            isAscii = false;
-        DEBUG << "  " << ch << char(ch);
+    bool isAscii;
+    if (scanUnescapedString(json, end, &isAscii) == QJsonParseError::IllegalUTF8String) {
+        lastError = QJsonParseError::IllegalUTF8String;
+        return false;
     }
+    // If we find escape sequences, we store UTF-16 as there are some
+    // escape sequences which are hard to represent in UTF-8.
+    // (plain "\\ud800" for example)
+    const bool isUtf8 = (json >= end || *json != '\\');
     ++json;
     DEBUG << "end of string";
     if (json >= end) {
@@ -932,22 +1093,10 @@ bool Parser::parseString()
     json = start;
 
     QString ucs4;
-    while (json < end) {
-        char32_t ch = 0;
-        if (*json == '"')
-            break;
-        else if (*json == '\\') {
-            if (!scanEscapeSequence(json, end, &ch)) {
-                lastError = QJsonParseError::IllegalEscapeSequence;
-                return false;
-            }
-        } else {
-            if (!scanUtf8Char(json, end, &ch)) {
-                lastError = QJsonParseError::IllegalUTF8String;
-                return false;
-            }
-        }
-        ucs4.append(QChar::fromUcs4(ch));
+    const QJsonParseError::ParseError error = decodeEscapedString(json, end, &ucs4);
+    if (error != QJsonParseError::NoError && error != QJsonParseError::UnterminatedString) {
+        lastError = error;
+        return false;
     }
     ++json;
 
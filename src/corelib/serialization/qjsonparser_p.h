@@ -86,6 +86,12 @@ private:
     QExplicitlySharedDataPointer<QCborContainerPrivate> container;
 };
 
+// building blocks of the parser, also used by QJsonStreamReader
+const char *skipWhitespace(const char *json, const char *end) noexcept;
+const char *scanNumber(const char *json, const char *end, bool *isInt) noexcept;
+bool numberToValue(QByteArrayView number, bool isInt, QCborValue *value);
+QJsonParseError::ParseError decodeString(const char *&json, const char *end, QString *result);
+
 }
 
 QT_END_NAMESPACE
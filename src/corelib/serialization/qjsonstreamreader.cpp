@@ -0,0 +1,945 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qjsonstreamreader.h"
+
+#include "qjsonarray.h"
+#include "qjsonobject.h"
+#include "qjsonparser_p.h"
+
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+
+QT_BEGIN_NAMESPACE
+
+static const int nestingLimit = 1024;
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.4
+
+    \brief The QJsonStreamReader class is a simple JSON stream decoder, operating
+    on either a QByteArray or QIODevice.
+
+    This class can be used to decode a JSON document directly from either a
+    QByteArray or a QIODevice, one element at a time, without building a
+    QJsonDocument first. It works like QCborStreamReader: the reader is
+    always positioned on one element, whose type() can be queried and whose
+    value can be extracted with toBool(), toInteger(), toDouble() or
+    readString(). Calling next() advances to the following element, skipping
+    the current one entirely if it is an array or object.
+
+    Arrays and objects are entered with enterContainer() and left with
+    leaveContainer(). Inside an object, the elements alternate between the
+    member names, which are always strings, and their values. hasNext()
+    returns false once the end of the current container has been reached.
+
+    \code
+        QJsonStreamReader reader(&file);
+        if (reader.isArray() && reader.enterContainer()) {
+            while (reader.hasNext())
+                process(reader.readValue().toObject());
+            reader.leaveContainer();
+        }
+        if (reader.lastError().error != QJsonParseError::NoError)
+            qWarning() << reader.lastError().errorString();
+    \endcode
+
+    Only the data that has not been consumed yet is kept in memory, so
+    reading a document from a QIODevice needs no more memory than the
+    largest string in it, plus a small read buffer. The grammar accepted and
+    the errors reported are the same as those of QJsonDocument::fromJson():
+    the document must consist of a single array or object.
+
+    \section1 Incremental parsing
+
+    When the reader runs out of data in the middle of the document, it
+    reports the error that QJsonDocument::fromJson() would report for the
+    truncated input, such as QJsonParseError::UnterminatedArray, and stays
+    on the element it was decoding. If more data can arrive later, for
+    example on a socket, add it with addData() or wait for the device to
+    have it, then call reparse() to resume.
+
+    \sa QJsonStreamWriter, QJsonDocument, QCborStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::Type
+
+    This enumeration contains the types of element the reader can be
+    positioned on.
+
+    \value Null         The JSON \c null literal.
+    \value Bool         One of the literals \c true or \c false.
+    \value Integer      A number that has no fractional part and fits a qint64.
+    \value Double       Any other number.
+    \value String       A string, which includes the member names in an object.
+    \value Array        An array.
+    \value Object       An object.
+    \value Invalid      No element: the end of a container or of the document
+                        was reached, or an error occurred.
+
+    Numbers are split into Integer and Double the same way QJsonValue does
+    when parsing a document.
+*/
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum { ReadChunkSize = 16384 };
+    enum Position : quint8 { BeforeSeparator, AtElement, AtContainerEnd };
+
+    struct Level {
+        QJsonStreamReader::Type type;
+        bool first;
+        bool expectValue;
+    };
+
+    QJsonStreamReaderPrivate(QJsonStreamReader *q) : q(q) {}
+
+    QJsonStreamReader *q;
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype pos = 0;              // offset in buffer of the current element
+    qsizetype elementLength = 0;    // for literals and numbers
+    qint64 bufferOffset = 0;        // offset in the document of buffer[0]
+    qint64 errorOffset = 0;
+    QVarLengthArray<Level, 16> levels;
+    QJsonParseError::ParseError lastError = QJsonParseError::NoError;
+    Position position = BeforeSeparator;
+    bool started = false;
+
+    void reset()
+    {
+        buffer.clear();
+        pos = 0;
+        elementLength = 0;
+        bufferOffset = 0;
+        errorOffset = 0;
+        levels.clear();
+        lastError = QJsonParseError::NoError;
+        position = BeforeSeparator;
+        started = false;
+    }
+
+    qsizetype available() const { return buffer.size() - pos; }
+    const char *current() const { return buffer.constData() + pos; }
+
+    bool readMore(qsizetype minimum);
+    bool ensureAvailable(qsizetype n);
+    bool skipSpace(qsizetype *off);
+    void handleError(QJsonParseError::ParseError error, qsizetype off);
+
+    void preparse();
+    bool parseSeparators();
+    void parseElement();
+    void elementConsumed();
+    bool findStringEnd(qsizetype *quote);
+    bool readString(QString *result);
+};
+
+// Discards the consumed data and reads at least \a minimum more bytes
+// (one chunk if 0) from the device.
+bool QJsonStreamReaderPrivate::readMore(qsizetype minimum)
+{
+    if (!device)
+        return false;
+
+    if (pos) {
+        buffer.remove(0, pos);
+        bufferOffset += pos;
+        pos = 0;
+    }
+
+    const qsizetype oldSize = buffer.size();
+    const qsizetype wanted = qMax(minimum, qsizetype(ReadChunkSize));
+    buffer.resize(oldSize + wanted);
+    const qint64 n = device->read(buffer.data() + oldSize, wanted);
+    buffer.truncate(oldSize + qMax(n, qint64(0)));
+    return n > 0;
+}
+
+bool QJsonStreamReaderPrivate::ensureAvailable(qsizetype n)
+{
+    while (available() < n) {
+        if (!readMore(n - available()))
+            return false;
+    }
+    return true;
+}
+
+// Advances *off past whitespace; returns false at the end of the data.
+bool QJsonStreamReaderPrivate::skipSpace(qsizetype *off)
+{
+    forever {
+        const char *end = buffer.constData() + buffer.size();
+        const char *p = QJsonPrivate::skipWhitespace(current() + *off, end);
+        *off = p - current();
+        if (p != end)
+            return true;
+        if (!readMore(0))
+            return false;
+    }
+}
+
+void QJsonStreamReaderPrivate::handleError(QJsonParseError::ParseError error, qsizetype off)
+{
+    lastError = error;
+    errorOffset = bufferOffset + pos + off;
+    q->type_ = QJsonStreamReader::Invalid;
+}
+
+void QJsonStreamReaderPrivate::preparse()
+{
+    q->type_ = QJsonStreamReader::Invalid;
+    q->value.i = 0;
+    if (lastError != QJsonParseError::NoError)
+        return;
+
+    if (position == BeforeSeparator && !parseSeparators())
+        return;
+    if (position == AtElement)
+        parseElement();
+}
+
+// Consumes the whitespace, commas and colons before the next element, or
+// finds the end of the current container. The position is only committed
+// once the separators are complete, so that reparse() can resume here.
+bool QJsonStreamReaderPrivate::parseSeparators()
+{
+    qsizetype off = 0;
+
+    if (levels.isEmpty()) {
+        if (!started) {
+            // JSON-text = object / array, optionally preceded by a UTF-8 BOM
+            if (bufferOffset == 0 && ensureAvailable(3) && current()[0] == '\xef'
+                    && current()[1] == '\xbb' && current()[2] == '\xbf') {
+                off = 3;
+            }
+            if (!skipSpace(&off) || (current()[off] != '[' && current()[off] != '{')) {
+                handleError(QJsonParseError::IllegalValue, off);
+                return false;
+            }
+            pos += off;
+            position = AtElement;
+            return true;
+        }
+
+        // only whitespace may follow the document
+        if (skipSpace(&off)) {
+            handleError(QJsonParseError::GarbageAtEnd, off);
+            return false;
+        }
+        pos += off;
+        return false;
+    }
+
+    const Level &level = levels.last();
+    const bool isObject = level.type == QJsonStreamReader::Object;
+    const QJsonParseError::ParseError unterminated =
+            isObject ? QJsonParseError::UnterminatedObject : QJsonParseError::UnterminatedArray;
+    const char closing = isObject ? '}' : ']';
+
+    if (!skipSpace(&off)) {
+        handleError(unterminated, off);
+        return false;
+    }
+
+    char c = current()[off];
+    if (level.expectValue) {
+        // member = string name-separator value
+        if (c != ':') {
+            handleError(QJsonParseError::MissingNameSeparator, off);
+            return false;
+        }
+        ++off;
+        if (!skipSpace(&off)) {
+            handleError(QJsonParseError::UnterminatedObject, off);
+            return false;
+        }
+    } else if (c == closing) {
+        pos += off;
+        position = AtContainerEnd;
+        return false;
+    } else if (!level.first) {
+        if (c != ',') {
+            handleError(isObject ? QJsonParseError::UnterminatedObject
+                                 : QJsonParseError::MissingValueSeparator, off);
+            return false;
+        }
+        ++off;
+        if (!skipSpace(&off)) {
+            handleError(unterminated, off);
+            return false;
+        }
+        c = current()[off];
+        if (isObject && c == '}') {
+            handleError(QJsonParseError::MissingObject, off);
+            return false;
+        }
+    }
+
+    if (isObject && !level.expectValue && c != '"') {
+        handleError(QJsonParseError::UnterminatedObject, off);
+        return false;
+    }
+
+    pos += off;
+    position = AtElement;
+    return true;
+}
+
+// Determines the type of the element at pos. Scalars are decoded right
+// away, but not consumed until next().
+void QJsonStreamReaderPrivate::parseElement()
+{
+    Q_ASSERT(available() > 0);
+    const char c = *current();
+
+    auto parseLiteral = [this](const char *literal, qsizetype len) {
+        if (!ensureAvailable(len) || memcmp(current(), literal, len) != 0) {
+            handleError(QJsonParseError::IllegalValue, 0);
+            return false;
+        }
+        elementLength = len;
+        return true;
+    };
+
+    switch (c) {
+    case '"':
+        q->type_ = QJsonStreamReader::String;
+        return;
+    case '[':
+        q->type_ = QJsonStreamReader::Array;
+        return;
+    case '{':
+        q->type_ = QJsonStreamReader::Object;
+        return;
+    case 'n':
+        if (parseLiteral("null", 4))
+            q->type_ = QJsonStreamReader::Null;
+        return;
+    case 't':
+        if (parseLiteral("true", 4)) {
+            q->type_ = QJsonStreamReader::Bool;
+            q->value.i = 1;
+        }
+        return;
+    case 'f':
+        if (parseLiteral("false", 5))
+            q->type_ = QJsonStreamReader::Bool;
+        return;
+    case ',':
+        // Essentially missing value, but after a colon, not after a comma
+        // like the other MissingObject errors.
+        handleError(QJsonParseError::IllegalValue, 0);
+        return;
+    case ']':
+    case '}':
+        handleError(QJsonParseError::MissingObject, 0);
+        return;
+    }
+
+    // a number must be followed by something else, so make sure we have
+    // all of it before decoding
+    bool isInt;
+    const char *end;
+    forever {
+        end = QJsonPrivate::scanNumber(current(), buffer.constData() + buffer.size(), &isInt);
+        if (end != buffer.constData() + buffer.size())
+            break;
+        if (!readMore(0)) {
+            handleError(QJsonParseError::TerminationByNumber, available());
+            return;
+        }
+    }
+
+    QCborValue number;
+    if (!QJsonPrivate::numberToValue(QByteArrayView(current(), end), isInt, &number)) {
+        handleError(QJsonParseError::IllegalNumber, end - current());
+        return;
+    }
+    elementLength = end - current();
+    if (number.isInteger()) {
+        q->type_ = QJsonStreamReader::Integer;
+        q->value.i = number.toInteger();
+    } else {
+        q->type_ = QJsonStreamReader::Double;
+        q->value.d = number.toDouble();
+    }
+}
+
+void QJsonStreamReaderPrivate::elementConsumed()
+{
+    if (levels.isEmpty()) {
+        started = true;
+    } else {
+        Level &level = levels.last();
+        level.first = false;
+        if (level.type == QJsonStreamReader::Object)
+            level.expectValue = !level.expectValue;
+    }
+    pos += elementLength;
+    elementLength = 0;
+    position = BeforeSeparator;
+    preparse();
+}
+
+// Finds the closing quote of the string at pos, reading more data as needed.
+bool QJsonStreamReaderPrivate::findStringEnd(qsizetype *quote)
+{
+    qsizetype off = 1;
+    forever {
+        const char *p = current();
+        const qsizetype size = available();
+        while (off < size) {
+            if (p[off] == '"') {
+                *quote = off;
+                return true;
+            }
+            // skip the escaped character, which may be a quote
+            off += (p[off] == '\\') ? 2 : 1;
+        }
+        if (!readMore(0))
+            return false;
+    }
+}
+
+bool QJsonStreamReaderPrivate::readString(QString *result)
+{
+    Q_ASSERT(q->isString());
+
+    qsizetype quote;
+    if (!findStringEnd(&quote)) {
+        handleError(QJsonParseError::UnterminatedString, available());
+        return false;
+    }
+
+    const char *json = current() + 1;
+    const QJsonParseError::ParseError error =
+            QJsonPrivate::decodeString(json, current() + quote + 1, result);
+    if (error != QJsonParseError::NoError) {
+        handleError(error, json - current());
+        return false;
+    }
+
+    elementLength = quote + 1;
+    elementConsumed();
+    return true;
+}
+
+/*!
+    Creates a QJsonStreamReader object with no source data. After
+    construction, QJsonStreamReader will report an error parsing.
+
+    You can add more data by calling addData() or by setting a different
+    source device using setDevice().
+
+    \sa addData(), isValid()
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate(this)), type_(Invalid)
+{
+    d->preparse();
+}
+
+/*!
+    Creates a QJsonStreamReader object that will parse the JSON document
+    contained in \a data.
+
+    \sa addData()
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : d(new QJsonStreamReaderPrivate(this)), type_(Invalid)
+{
+    d->buffer = data;
+    d->preparse();
+}
+
+/*!
+    Creates a QJsonStreamReader object that will parse the JSON document read
+    from the \a device. The device is read in chunks as the document is
+    decoded.
+
+    \sa setDevice(), clear()
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : d(new QJsonStreamReaderPrivate(this)), type_(Invalid)
+{
+    setDevice(device);
+}
+
+/*!
+    Destroys this QJsonStreamReader object and frees any associated resources.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the source of data to \a device, resetting the decoder to its
+    initial state.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->reset();
+    d->device = device;
+    d->preparse();
+}
+
+/*!
+    Returns the QIODevice that was set with either setDevice() or the
+    QJsonStreamReader constructor. If this object was reading from a
+    QByteArray, this function returns nullptr instead.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Adds \a data to the JSON stream and calls reparse(). This function
+    is useful if the reader was created without a device and more of the
+    document is now available.
+
+    \sa reparse()
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+/*!
+    \overload
+
+    Adds \a len bytes of data starting at \a data to the JSON stream and
+    calls reparse().
+*/
+void QJsonStreamReader::addData(const char *data, qsizetype len)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with a device is not supported");
+        return;
+    }
+    if (d->pos) {
+        d->buffer.remove(0, d->pos);
+        d->bufferOffset += d->pos;
+        d->pos = 0;
+    }
+    d->buffer.append(data, len);
+    reparse();
+}
+
+/*!
+    Resumes decoding at the current element after the reader ran out of
+    data. addData() calls this function already; call it directly when
+    reading from a device that has received more data since.
+
+    Any error is cleared, since the reader cannot tell whether it was caused
+    by the data ending prematurely. If the document is really malformed, the
+    same error is reported again.
+*/
+void QJsonStreamReader::reparse()
+{
+    d->lastError = QJsonParseError::NoError;
+    d->errorOffset = 0;
+    d->preparse();
+}
+
+/*!
+    Clears the decoder state and resets the input source data to an empty
+    byte array. After this function is called, QJsonStreamReader will be
+    indicating an error parsing.
+
+    Call addData() to add more data to be parsed.
+
+    \sa setDevice()
+*/
+void QJsonStreamReader::clear()
+{
+    setDevice(nullptr);
+}
+
+/*!
+    Returns the last error in decoding the stream, with its offset in the
+    document, or an error with QJsonParseError::NoError if none occurred.
+
+    \sa isValid()
+*/
+QJsonParseError QJsonStreamReader::lastError() const
+{
+    QJsonParseError error;
+    error.offset = int(d->errorOffset);
+    error.error = d->lastError;
+    return error;
+}
+
+/*!
+    Returns the offset in the input stream of the item currently being
+    decoded. The offset is the number of bytes from the beginning of the
+    document.
+*/
+qint64 QJsonStreamReader::currentOffset() const
+{
+    return d->bufferOffset + d->pos;
+}
+
+/*!
+    \fn bool QJsonStreamReader::isValid() const
+
+    Returns true if the reader is positioned on an element, false if it is
+    at the end of a container or of the document, or an error occurred.
+
+    \sa type(), lastError()
+*/
+
+/*!
+    Returns the number of containers that this stream has entered with
+    enterContainer() but not yet left.
+
+    \sa enterContainer(), leaveContainer()
+*/
+int QJsonStreamReader::containerDepth() const
+{
+    return d->levels.size();
+}
+
+/*!
+    Returns either QJsonStreamReader::Array or QJsonStreamReader::Object,
+    indicating whether the container that contains the current item was an
+    array or an object, respectively. If we're currently parsing the root
+    element, this function returns QJsonStreamReader::Invalid.
+
+    \sa containerDepth(), enterContainer()
+*/
+QJsonStreamReader::Type QJsonStreamReader::parentContainerType() const
+{
+    if (d->levels.isEmpty())
+        return Invalid;
+    return d->levels.last().type;
+}
+
+/*!
+    Returns true if there are more elements to be decoded in the current
+    container, false if the end of the container or of the document was
+    reached, or an error occurred.
+
+    \sa leaveContainer(), containerDepth()
+*/
+bool QJsonStreamReader::hasNext() const noexcept
+{
+    return type_ != Invalid;
+}
+
+/*!
+    Advances the JSON stream decoding by one element, skipping the current
+    one entirely if it is a string, an array or an object. Returns true if
+    the element was skipped, false if an error occurred while doing so or
+    the reader was not positioned on an element. An error decoding the
+    element that follows is reported by lastError() only.
+
+    \sa readValue(), enterContainer()
+*/
+bool QJsonStreamReader::next()
+{
+    switch (type()) {
+    case Invalid:
+        return false;
+    case String: {
+        QString string;
+        return d->readString(&string);
+    }
+    case Array:
+    case Object:
+        if (!enterContainer())
+            return false;
+        while (hasNext()) {
+            if (!next())
+                return false;
+        }
+        return leaveContainer();
+    default:
+        d->elementConsumed();
+        return true;
+    }
+}
+
+/*!
+    \fn QJsonStreamReader::Type QJsonStreamReader::type() const
+
+    Returns the type of the current element, or QJsonStreamReader::Invalid
+    if the reader is not positioned on one.
+
+    \sa isValid(), hasNext()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isNull() const
+
+    Returns true if the current element is the \c null literal.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isBool() const
+
+    Returns true if the current element is either \c true or \c false.
+
+    \sa toBool()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isInteger() const
+
+    Returns true if the current element is a number without fractional part
+    that fits a qint64.
+
+    \sa toInteger(), isNumber()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isDouble() const
+
+    Returns true if the current element is a number that is not an integer.
+
+    \sa toDouble(), isNumber()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isNumber() const
+
+    Returns true if the current element is a number of either type.
+
+    \sa isInteger(), isDouble()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isString() const
+
+    Returns true if the current element is a string.
+
+    \sa readString()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isArray() const
+
+    Returns true if the current element is an array.
+
+    \sa enterContainer()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isObject() const
+
+    Returns true if the current element is an object.
+
+    \sa enterContainer()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isInvalid() const
+
+    Returns true if the reader is not positioned on an element.
+
+    \sa isValid()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isContainer() const
+
+    Returns true if the current element is an array or an object.
+
+    \sa enterContainer()
+*/
+
+/*!
+    Enters the array or object that is the current element and positions
+    the reader on its first element. Returns true on success, false if the
+    containers are nested too deeply or the first element could not be
+    decoded.
+
+    \sa leaveContainer(), next()
+*/
+bool QJsonStreamReader::enterContainer()
+{
+    Q_ASSERT(isContainer());
+    if (d->levels.size() >= nestingLimit) {
+        d->handleError(QJsonParseError::DeepNesting, 0);
+        return false;
+    }
+    d->levels.append({ type(), true, false });
+    ++d->pos;
+    d->position = QJsonStreamReaderPrivate::BeforeSeparator;
+    d->preparse();
+    return d->lastError == QJsonParseError::NoError;
+}
+
+/*!
+    Leaves the current container, skipping any elements that were not read
+    yet, and positions the reader on the element following it. Returns true
+    on success, false if an error occurred.
+
+    \sa enterContainer(), hasNext()
+*/
+bool QJsonStreamReader::leaveContainer()
+{
+    Q_ASSERT(!d->levels.isEmpty());
+    while (hasNext()) {
+        if (!next())
+            return false;
+    }
+    if (d->position != QJsonStreamReaderPrivate::AtContainerEnd)
+        return false;
+
+    ++d->pos;
+    d->levels.removeLast();
+    d->elementLength = 0;
+    d->elementConsumed();
+    return true;
+}
+
+/*!
+    Decodes the string that is the current element, including any escape
+    sequences, and advances to the next element. If the string could not be
+    decoded, returns a null QString and sets lastError().
+
+    \sa isString(), readValue()
+*/
+QString QJsonStreamReader::readString()
+{
+    QString result;
+    if (!d->readString(&result))
+        return QString();
+    return result;
+}
+
+/*!
+    Decodes the current element, including all the elements of an array or
+    object, into a QJsonValue and advances to the next element. This is
+    convenient to process a large array one element at a time. If an error
+    occurs, returns an undefined QJsonValue and sets lastError().
+
+    As with QJsonDocument::fromJson(), the last value is kept for duplicate
+    member names. If the data ends inside an array or object, the part of
+    it that was decoded is lost, so when parsing incrementally, prefer
+    reading the elements of large containers one by one.
+
+    \sa next(), readString()
+*/
+QJsonValue QJsonStreamReader::readValue()
+{
+    QJsonValue result;
+    switch (type()) {
+    case Invalid:
+        return QJsonValue(QJsonValue::Undefined);
+    case Null:
+        break;
+    case Bool:
+        result = toBool();
+        break;
+    case Integer:
+        result = toInteger();
+        break;
+    case Double:
+        result = toDouble();
+        break;
+    case String: {
+        QString string;
+        if (!d->readString(&string))
+            return QJsonValue(QJsonValue::Undefined);
+        return string;
+    }
+    case Array: {
+        QJsonArray array;
+        if (!enterContainer())
+            return QJsonValue(QJsonValue::Undefined);
+        while (hasNext())
+            array.append(readValue());
+        if (!leaveContainer())
+            return QJsonValue(QJsonValue::Undefined);
+        return array;
+    }
+    case Object: {
+        QJsonObject object;
+        if (!enterContainer())
+            return QJsonValue(QJsonValue::Undefined);
+        while (hasNext()) {
+            const QString key = readString();
+            if (hasNext())
+                object.insert(key, readValue());
+        }
+        if (!leaveContainer())
+            return QJsonValue(QJsonValue::Undefined);
+        return object;
+    }
+    }
+
+    d->elementConsumed();
+    return result;
+}
+
+/*!
+    \fn bool QJsonStreamReader::toBool() const
+
+    Returns the value of the current boolean element. This function must
+    only be called if isBool() returns true.
+*/
+
+/*!
+    \fn qint64 QJsonStreamReader::toInteger() const
+
+    Returns the value of the current integer element. This function must
+    only be called if isInteger() returns true.
+*/
+
+/*!
+    \fn double QJsonStreamReader::toDouble() const
+
+    Returns the value of the current number element, converting integers to
+    double. This function must only be called if isNumber() returns true.
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,131 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QJSONSTREAMREADER_H
+#define QJSONSTREAMREADER_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class QJsonStreamReaderPrivate;
+class Q_CORE_EXPORT QJsonStreamReader
+{
+public:
+    enum Type : quint8 {
+        Null,
+        Bool,
+        Integer,
+        Double,
+        String,
+        Array,
+        Object,
+
+        Invalid = 0xff
+    };
+
+    QJsonStreamReader();
+    explicit QJsonStreamReader(const QByteArray &data);
+    explicit QJsonStreamReader(QIODevice *device);
+    ~QJsonStreamReader();
+    Q_DISABLE_COPY(QJsonStreamReader)
+
+    void setDevice(QIODevice *device);
+    QIODevice *device() const;
+    void addData(const QByteArray &data);
+    void addData(const char *data, qsizetype len);
+    void reparse();
+    void clear();
+
+    QJsonParseError lastError() const;
+
+    qint64 currentOffset() const;
+
+    bool isValid() const        { return !isInvalid(); }
+
+    int containerDepth() const;
+    QJsonStreamReader::Type parentContainerType() const;
+    bool hasNext() const noexcept Q_DECL_PURE_FUNCTION;
+    bool next();
+
+    Type type() const           { return QJsonStreamReader::Type(type_); }
+    bool isNull() const         { return type() == Null; }
+    bool isBool() const         { return type() == Bool; }
+    bool isInteger() const      { return type() == Integer; }
+    bool isDouble() const       { return type() == Double; }
+    bool isNumber() const       { return isInteger() || isDouble(); }
+    bool isString() const       { return type() == String; }
+    bool isArray() const        { return type() == Array; }
+    bool isObject() const       { return type() == Object; }
+    bool isInvalid() const      { return type() == Invalid; }
+
+    bool isContainer() const    { return isArray() || isObject(); }
+    bool enterContainer();
+    bool leaveContainer();
+
+    QString readString();
+    QJsonValue readValue();
+
+    bool toBool() const         { Q_ASSERT(isBool()); return value.i != 0; }
+    qint64 toInteger() const    { Q_ASSERT(isInteger()); return value.i; }
+    double toDouble() const
+    {
+        Q_ASSERT(isNumber());
+        return isInteger() ? double(value.i) : value.d;
+    }
+
+private:
+    friend QJsonStreamReaderPrivate;
+    union {
+        qint64 i;
+        double d;
+    } value = {};
+    QScopedPointer<QJsonStreamReaderPrivate> d;
+    quint8 type_;
+};
+
+QT_END_NAMESPACE
+
+#endif // QJSONSTREAMREADER_H
@@ -0,0 +1,450 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qjsonstreamwriter.h"
+
+#include "qjsonwriter_p.h"
+
+#include <qcborvalue.h>
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.4
+
+    \brief The QJsonStreamWriter class is a simple JSON encoder operating on
+    a one-way stream.
+
+    This class can be used to quickly encode a stream of JSON content
+    directly to either a QByteArray or QIODevice, without building a
+    QJsonDocument first. It works like QCborStreamWriter: values are added
+    with the append() overloads, and arrays and objects are opened with
+    startArray() and startObject() and closed with endArray() and
+    endObject(). Inside an object, the appended values alternate between the
+    member names, which must be strings, and their values.
+
+    \code
+        QJsonStreamWriter writer(&file);
+        writer.startArray();
+        for (const Record &record : records) {
+            writer.startObject();
+            writer.append("name"_L1);
+            writer.append(record.name);
+            writer.append("size"_L1);
+            writer.append(record.size);
+            writer.endObject();
+        }
+        writer.endArray();
+    \endcode
+
+    The output is the same as that of QJsonDocument::toJson() for the same
+    content, in the format set with setFormat(). When writing to a
+    QIODevice, the encoded data is kept in a small buffer that is written to
+    the device whenever it fills up, when the outermost container is closed,
+    and when flush() is called or the writer is destroyed.
+
+    QJsonStreamWriter does not validate the structure of what is written
+    beyond the nesting of containers: it is the caller's responsibility to
+    produce a single array or object if the output is to be read by
+    QJsonDocument::fromJson().
+
+    \sa QJsonStreamReader, QJsonDocument, QCborStreamWriter
+*/
+
+class QJsonStreamWriterPrivate
+{
+public:
+    enum { FlushThreshold = 16384 };
+
+    struct Level {
+        bool isObject;
+        bool first;
+        bool expectValue;
+    };
+
+    QIODevice *device = nullptr;
+    QByteArray *data = nullptr;
+    QByteArray buffer;
+    QVarLengthArray<Level, 16> levels;
+    QJsonDocument::JsonFormat format = QJsonDocument::Indented;
+
+    bool compact() const { return format == QJsonDocument::Compact; }
+    QByteArray &output() { return data ? *data : buffer; }
+
+    void separate(Level &level);
+    bool startValue();
+    void appendValue(const QCborValue &value);
+    bool endContainer(bool isObject);
+    void flush();
+};
+
+// Writes what goes between the previous element of the container and this one
+void QJsonStreamWriterPrivate::separate(Level &level)
+{
+    QByteArray &json = output();
+    if (!level.first)
+        json += compact() ? "," : ",\n";
+    level.first = false;
+    if (!compact())
+        json += QByteArray(4 * levels.size(), ' ');
+}
+
+bool QJsonStreamWriterPrivate::startValue()
+{
+    if (levels.isEmpty())
+        return true;
+
+    Level &level = levels.last();
+    if (!level.isObject) {
+        separate(level);
+    } else if (level.expectValue) {
+        level.expectValue = false;
+    } else {
+        qWarning("QJsonStreamWriter: object member names must be strings");
+        return false;
+    }
+    return true;
+}
+
+void QJsonStreamWriterPrivate::appendValue(const QCborValue &value)
+{
+    if (!startValue())
+        return;
+    QJsonPrivate::Writer::valueToJson(value, output(), compact() ? 0 : levels.size(), compact());
+    if (device && buffer.size() >= FlushThreshold)
+        flush();
+}
+
+bool QJsonStreamWriterPrivate::endContainer(bool isObject)
+{
+    if (levels.isEmpty() || levels.last().isObject != isObject)
+        return false;
+    if (levels.last().expectValue) {
+        qWarning("QJsonStreamWriter: object member has no value");
+        return false;
+    }
+
+    const Level level = levels.last();
+    levels.removeLast();
+    QByteArray &json = output();
+    if (!compact()) {
+        if (!level.first)
+            json += '\n';
+        json += QByteArray(4 * levels.size(), ' ');
+    }
+    json += isObject ? '}' : ']';
+
+    if (levels.isEmpty()) {
+        if (!compact())
+            json += '\n';
+        flush();
+    } else if (device && buffer.size() >= FlushThreshold) {
+        flush();
+    }
+    return true;
+}
+
+void QJsonStreamWriterPrivate::flush()
+{
+    if (!device || buffer.isEmpty())
+        return;
+    device->write(buffer);
+    buffer.clear();
+}
+
+/*!
+    Creates a QJsonStreamWriter object that will write the stream to \a
+    device. The device must be opened before the first append() call is
+    made.
+
+    \sa setDevice()
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : d(new QJsonStreamWriterPrivate)
+{
+    d->device = device;
+}
+
+/*!
+    Creates a QJsonStreamWriter object that will append the stream to \a
+    data. All streaming is done immediately to the byte array, without the
+    need for flushing any buffers.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : d(new QJsonStreamWriterPrivate)
+{
+    d->data = data;
+}
+
+/*!
+    Destroys this QJsonStreamWriter object, writing any buffered data to the
+    device. The containers that are still open are not closed.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d->flush();
+}
+
+/*!
+    Replaces the device or byte array that this QJsonStreamWriter object is
+    writing to with \a device. Any buffered data is written to the previous
+    device first.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->flush();
+    d->device = device;
+    d->data = nullptr;
+}
+
+/*!
+    Returns the QIODevice that this QJsonStreamWriter object is writing to,
+    or nullptr if it is appending to a QByteArray.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Sets the \a format of the output, which is QJsonDocument::Indented by
+    default. The format should be set before anything is written.
+
+    \sa format(), QJsonDocument::toJson()
+*/
+void QJsonStreamWriter::setFormat(QJsonDocument::JsonFormat format)
+{
+    d->format = format;
+}
+
+/*!
+    Returns the format of the output.
+
+    \sa setFormat()
+*/
+QJsonDocument::JsonFormat QJsonStreamWriter::format() const
+{
+    return d->format;
+}
+
+/*!
+    \overload
+
+    Appends the integer \a i to the stream.
+*/
+void QJsonStreamWriter::append(qint64 i)
+{
+    d->appendValue(QCborValue(i));
+}
+
+/*!
+    \overload
+
+    Appends the floating point number \a d to the stream. As with
+    QJsonDocument::toJson(), infinities and NaN are written as \c null.
+*/
+void QJsonStreamWriter::append(double d)
+{
+    this->d->appendValue(QCborValue(d));
+}
+
+/*!
+    \overload
+
+    Appends the boolean value \a b to the stream.
+*/
+void QJsonStreamWriter::append(bool b)
+{
+    d->appendValue(QCborValue(b));
+}
+
+/*!
+    \overload
+
+    Appends the Latin-1 string \a str to the stream, either as a value or,
+    inside an object, as the name of the next member.
+*/
+void QJsonStreamWriter::append(QLatin1StringView str)
+{
+    append(QString(str));
+}
+
+/*!
+    Appends the string \a str to the stream, either as a value or, inside an
+    object, as the name of the next member.
+*/
+void QJsonStreamWriter::append(QStringView str)
+{
+    if (!d->levels.isEmpty() && d->levels.last().isObject
+            && !d->levels.last().expectValue) {
+        QJsonStreamWriterPrivate::Level &level = d->levels.last();
+        d->separate(level);
+        QByteArray &json = d->output();
+        json += '"';
+        json += QJsonPrivate::Writer::escapedString(str);
+        json += d->compact() ? "\":" : "\": ";
+        level.expectValue = true;
+        return;
+    }
+
+    if (!d->startValue())
+        return;
+    QByteArray &json = d->output();
+    json += '"';
+    json += QJsonPrivate::Writer::escapedString(str);
+    json += '"';
+    if (d->device && d->buffer.size() >= QJsonStreamWriterPrivate::FlushThreshold)
+        d->flush();
+}
+
+/*!
+    \fn void QJsonStreamWriter::append(const QString &str)
+    \overload
+
+    Appends the string \a str to the stream.
+*/
+
+/*!
+    \fn void QJsonStreamWriter::append(std::nullptr_t)
+    \overload
+
+    Appends a \c null value to the stream.
+*/
+
+/*!
+    \fn void QJsonStreamWriter::append(const char *str)
+    \overload
+
+    Appends the UTF-8 string \a str to the stream.
+*/
+
+/*!
+    \overload
+
+    Appends \a value to the stream, including all the elements if it is an
+    array or an object. A QJsonValue::Undefined value is written as \c null.
+*/
+void QJsonStreamWriter::append(const QJsonValue &value)
+{
+    if (value.isString())
+        append(value.toString());
+    else
+        d->appendValue(QCborValue::fromJsonValue(value));
+}
+
+/*!
+    Appends a \c null value to the stream.
+*/
+void QJsonStreamWriter::appendNull()
+{
+    d->appendValue(QCborValue(nullptr));
+}
+
+/*!
+    Starts an array in the stream. Each following append() adds an element
+    to it, until endArray() is called.
+
+    \sa endArray(), startObject()
+*/
+void QJsonStreamWriter::startArray()
+{
+    if (!d->startValue())
+        return;
+    d->output() += d->compact() ? "[" : "[\n";
+    d->levels.append({ false, true, false });
+}
+
+/*!
+    Ends the array started by the last startArray() call. Returns false if
+    the innermost open container is not an array.
+
+    \sa startArray(), endObject()
+*/
+bool QJsonStreamWriter::endArray()
+{
+    return d->endContainer(false);
+}
+
+/*!
+    Starts an object in the stream. The following append() calls alternate
+    between the name of a member, which must be a string, and its value,
+    until endObject() is called.
+
+    \sa endObject(), startArray()
+*/
+void QJsonStreamWriter::startObject()
+{
+    if (!d->startValue())
+        return;
+    d->output() += d->compact() ? "{" : "{\n";
+    d->levels.append({ true, true, false });
+}
+
+/*!
+    Ends the object started by the last startObject() call. Returns false if
+    the innermost open container is not an object, or if the last member
+    has no value.
+
+    \sa startObject(), endArray()
+*/
+bool QJsonStreamWriter::endObject()
+{
+    return d->endContainer(true);
+}
+
+/*!
+    Writes any buffered data to the device. This is done automatically when
+    the outermost container is closed.
+*/
+void QJsonStreamWriter::flush()
+{
+    d->flush();
+}
+
+QT_END_NAMESPACE
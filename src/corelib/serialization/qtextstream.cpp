@@ -40,6 +40,7 @@
 
 //#define QTEXTSTREAM_DEBUG
 static const int QTEXTSTREAM_BUFFERSIZE = 16384;
+static const int QTEXTSTREAM_MAPSIZE = 64 * 1024 * 1024;
 
 /*!
     \class QTextStream
@@ -238,6 +239,7 @@ static const int QTEXTSTREAM_BUFFERSIZE = 16384;
 
 #include <stdlib.h>
 #include <limits.h>
+#include <algorithm>
 #include <new>
 
 // A precondition macro
@@ -283,6 +285,36 @@ using namespace Qt::StringLiterals;
 
 //-------------------------------------------------------------------
 
+#ifndef QT_NO_QOBJECT
+/*!
+    \internal
+
+    Flushes the stream before its device is closed. The bytes read ahead
+    by readUtf8LineView() are dropped, as closing the device invalidates
+    a mapping of them.
+*/
+void QDeviceClosedNotifier::flushStream()
+{
+    stream->q_ptr->flush();
+    if (sender() == stream->device)
+        stream->resetUtf8Buffer();
+}
+
+/*!
+    \internal
+
+    Forgets the read-ahead of a device that is being destroyed, without
+    touching the device; destroying a file has unmapped it already.
+*/
+void QDeviceClosedNotifier::dropDevice()
+{
+    if (sender() != stream->device)
+        return;
+    stream->utf8Map = nullptr;
+    stream->resetUtf8Buffer();
+}
+#endif
+
 /*!
     \internal
 */
@@ -299,6 +331,8 @@ QTextStreamPrivate::QTextStreamPrivate(QTextStream *q_ptr)
 */
 QTextStreamPrivate::~QTextStreamPrivate()
 {
+    // The device may be gone already, so leave a mapping of the read-ahead
+    // to the file, which unmaps it when it is closed.
     if (deleteDevice) {
 #ifndef QT_NO_QOBJECT
         device->blockSignals(true);
@@ -361,28 +395,53 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
     // read raw data into a temporary buffer
     char buf[QTEXTSTREAM_BUFFERSIZE];
     qint64 bytesRead = 0;
+    if (utf8Data) {
+        // Hand the bytes that readUtf8LineView() read ahead back to the
+        // decoder, by seeking back to them if possible.
+        const qint64 pendingPos = utf8StartDevicePos + utf8Offset;
+        if (pendingPos) {
+            // the decoder has not seen the lines before, so it must not take
+            // what it gets now for the start of the text
+            toUtf16 = QStringDecoder(encoding, QStringDecoder::Flag::ConvertInitialBom);
+        }
+        if (readBuffer.isEmpty())
+            saveConverterState(pendingPos);
+        if (!device->isSequential() && device->seek(pendingPos)) {
+            resetUtf8Buffer();
+        } else {
+            bytesRead = qMin<qint64>(utf8Size - utf8Offset, sizeof(buf));
+            if (maxBytes != -1)
+                bytesRead = qMin(bytesRead, maxBytes);
+            memcpy(buf, utf8Data + utf8Offset, bytesRead);
+            utf8Offset += bytesRead;
+            if (utf8Offset == utf8Size)
+                resetUtf8Buffer();
+        }
+    }
+    if (!bytesRead) {
 #if defined(Q_OS_WIN)
-    // On Windows, there is no non-blocking stdin - so we fall back to reading
-    // lines instead. If there is no QOBJECT, we read lines for all sequential
-    // devices; otherwise, we read lines only for stdin.
-    QFile *file = 0;
-    Q_UNUSED(file);
-    if (device->isSequential()
+        // On Windows, there is no non-blocking stdin - so we fall back to reading
+        // lines instead. If there is no QOBJECT, we read lines for all sequential
+        // devices; otherwise, we read lines only for stdin.
+        QFile *file = 0;
+        Q_UNUSED(file);
+        if (device->isSequential()
 #if !defined(QT_NO_QOBJECT)
-        && (file = qobject_cast<QFile *>(device)) && file->handle() == 0
+            && (file = qobject_cast<QFile *>(device)) && file->handle() == 0
 #endif
-        ) {
-        if (maxBytes != -1)
-            bytesRead = device->readLine(buf, qMin<qint64>(sizeof(buf), maxBytes));
-        else
-            bytesRead = device->readLine(buf, sizeof(buf));
-    } else
+            ) {
+            if (maxBytes != -1)
+                bytesRead = device->readLine(buf, qMin<qint64>(sizeof(buf), maxBytes));
+            else
+                bytesRead = device->readLine(buf, sizeof(buf));
+        } else
 #endif
-    {
-        if (maxBytes != -1)
-            bytesRead = device->read(buf, qMin<qint64>(sizeof(buf), maxBytes));
-        else
-            bytesRead = device->read(buf, sizeof(buf));
+        {
+            if (maxBytes != -1)
+                bytesRead = device->read(buf, qMin<qint64>(sizeof(buf), maxBytes));
+            else
+                bytesRead = device->read(buf, sizeof(buf));
+        }
     }
 
     // reset the Text flag.
@@ -412,8 +471,12 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
            QtDebugUtils::toPrintable(buf, bytesRead, 32).constData(), int(sizeof(buf)), int(bytesRead));
 #endif
 
+    // decode in place, so that a reused readBuffer needs no allocation
     int oldReadBufferSize = readBuffer.size();
-    readBuffer += toUtf16(QByteArrayView(buf, bytesRead));
+    readBuffer.resize(oldReadBufferSize + toUtf16.requiredSpace(bytesRead));
+    const QChar *decodedEnd = toUtf16.appendToBuffer(readBuffer.data() + oldReadBufferSize,
+                                                     QByteArrayView(buf, bytesRead));
+    readBuffer.truncate(decodedEnd - readBuffer.constData());
 
     // remove all '\r\n' in the string.
     if (readBuffer.size() > oldReadBufferSize && textModeEnabled) {
@@ -457,11 +520,113 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
 */
 void QTextStreamPrivate::resetReadBuffer()
 {
+    resetUtf8Buffer();
     readBuffer.clear();
     readBufferOffset = 0;
     readBufferStartDevicePos = (device ? device->pos() : 0);
 }
 
+/*!
+    \internal
+
+    Reads more UTF-8 from the device for readUtf8LineView(), keeping the
+    bytes not consumed yet. Files are mapped into memory rather than read
+    where possible. Returns \c false if no more data could be read; the
+    pending bytes are still available then.
+*/
+bool QTextStreamPrivate::fillUtf8Buffer()
+{
+    Q_ASSERT(device && readBuffer.isEmpty());
+    const qsizetype pending = utf8Size - utf8Offset;
+    const qint64 pendingPos = utf8Data ? utf8StartDevicePos + utf8Offset : device->pos();
+
+#ifndef QT_NO_QOBJECT
+    QFileDevice *file = qobject_cast<QFileDevice *>(device);
+    if (file && !file->isSequential() && !file->isWritable() && (utf8Map || !pending)) {
+        const qint64 available = file->size() - pendingPos;
+        if (available <= pending)
+            return false;
+        const qint64 mapSize = qMin(available, qMax<qint64>(QTEXTSTREAM_MAPSIZE, 2 * pending));
+        if (uchar *map = file->map(pendingPos, mapSize)) {
+            resetUtf8Buffer();
+            utf8Map = map;
+            utf8Data = reinterpret_cast<const char *>(map);
+            utf8Size = qsizetype(mapSize);
+            utf8StartDevicePos = pendingPos;
+            device->seek(pendingPos + mapSize);
+            return true;
+        }
+        // fall back to reading, e.g. for resources
+    }
+#endif
+
+    if (utf8Data == utf8Buffer.constData()) {
+        memmove(utf8Buffer.data(), utf8Data + utf8Offset, pending);
+    } else {
+        // the first fill, or the last window could not be followed by another one
+        utf8Buffer.resize(qMax<qsizetype>(4 * QTEXTSTREAM_BUFFERSIZE, pending));
+        if (pending)
+            memcpy(utf8Buffer.data(), utf8Data + utf8Offset, pending);
+        resetUtf8Buffer();
+    }
+    if (utf8Buffer.size() - pending < QTEXTSTREAM_BUFFERSIZE)
+        utf8Buffer.resize(2 * utf8Buffer.size());
+
+    // handle text translation ourselves, as fillReadBuffer() does
+    const bool textModeEnabled = device->isTextModeEnabled();
+    if (textModeEnabled)
+        device->setTextModeEnabled(false);
+    const qint64 bytesRead = device->read(utf8Buffer.data() + pending, utf8Buffer.size() - pending);
+    if (textModeEnabled)
+        device->setTextModeEnabled(true);
+
+    utf8Data = utf8Buffer.constData();
+    utf8Offset = 0;
+    utf8Size = pending + qMax<qint64>(bytesRead, 0);
+    utf8StartDevicePos = pendingPos;
+    return bytesRead > 0;
+}
+
+/*!
+    \internal
+
+    Drops the bytes read ahead by readUtf8LineView(). The device must still
+    exist if they are mapped from it.
+*/
+void QTextStreamPrivate::resetUtf8Buffer()
+{
+#ifndef QT_NO_QOBJECT
+    if (utf8Map) {
+        if (QFileDevice *file = qobject_cast<QFileDevice *>(device))
+            file->unmap(utf8Map);
+        utf8Map = nullptr;
+    }
+#endif
+    utf8Data = nullptr;
+    utf8Offset = 0;
+    utf8Size = 0;
+}
+
+/*!
+    \internal
+
+    Returns the line from \a begin to \a end, without its end-of-line
+    characters.
+*/
+QUtf8StringView QTextStreamPrivate::utf8LineView(const char *begin, const char *end)
+{
+    if (device->isTextModeEnabled() && memchr(begin, '\r', end - begin)) {
+        // fillReadBuffer() drops all carriage returns in text mode
+        utf8Line.resize(end - begin);
+        char *out = std::remove_copy(begin, end, utf8Line.data(), '\r');
+        utf8Line.truncate(out - utf8Line.constData());
+        return QUtf8StringView(utf8Line.constData(), utf8Line.size());
+    }
+    if (begin != end && end[-1] == '\r')
+        --end;
+    return QUtf8StringView(begin, end - begin);
+}
+
 /*!
     \internal
 */
@@ -574,6 +739,26 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
         }
         chPtr += startOffset;
 
+        if (delimiter == EndOfLine) {
+            // let the vectorized search in QStringView find the newline
+            int n = endOffset - startOffset;
+            if (maxlen)
+                n = qMin(n, maxlen - totalSize);
+            const int newline = int(QStringView(chPtr, n).indexOf(u'\n'));
+            if (newline >= 0) {
+                foundToken = true;
+                const QChar previous = newline ? chPtr[newline - 1] : lastChar;
+                delimSize = (previous == u'\r') ? 2 : 1;
+                consumeDelimiter = true;
+                n = newline + 1;
+            }
+            if (n)
+                lastChar = chPtr[n - 1];
+            startOffset += n;
+            totalSize += n;
+            continue;
+        }
+
         for (; !foundToken && startOffset < endOffset && (!maxlen || totalSize < maxlen); ++startOffset) {
             const QChar ch = *chPtr++;
             ++totalSize;
@@ -592,12 +777,7 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
                 }
                 break;
             case EndOfLine:
-                if (ch == u'\n') {
-                    foundToken = true;
-                    delimSize = (lastChar == u'\r') ? 2 : 1;
-                    consumeDelimiter = true;
-                }
-                lastChar = ch;
+                Q_UNREACHABLE(); // handled above
                 break;
             }
         }
@@ -939,7 +1119,7 @@ QTextStream::QTextStream(QIODevice *device)
     Q_D(QTextStream);
     d->device = device;
 #ifndef QT_NO_QOBJECT
-    d->deviceClosedNotifier.setupDevice(this, d->device);
+    d->deviceClosedNotifier.setupDevice(d, d->device);
 #endif
     d->status = Ok;
 }
@@ -978,7 +1158,7 @@ QTextStream::QTextStream(QByteArray *array, OpenMode openMode)
     d->device->open(openMode);
     d->deleteDevice = true;
 #ifndef QT_NO_QOBJECT
-    d->deviceClosedNotifier.setupDevice(this, d->device);
+    d->deviceClosedNotifier.setupDevice(d, d->device);
 #endif
     d->status = Ok;
 }
@@ -1008,7 +1188,7 @@ QTextStream::QTextStream(const QByteArray &array, OpenMode openMode)
     d->device = buffer;
     d->deleteDevice = true;
 #ifndef QT_NO_QOBJECT
-    d->deviceClosedNotifier.setupDevice(this, d->device);
+    d->deviceClosedNotifier.setupDevice(d, d->device);
 #endif
     d->status = Ok;
 }
@@ -1038,7 +1218,7 @@ QTextStream::QTextStream(FILE *fileHandle, OpenMode openMode)
     d->device = file;
     d->deleteDevice = true;
 #ifndef QT_NO_QOBJECT
-    d->deviceClosedNotifier.setupDevice(this, d->device);
+    d->deviceClosedNotifier.setupDevice(d, d->device);
 #endif
     d->status = Ok;
 }
@@ -1098,7 +1278,8 @@ bool QTextStream::seek(qint64 pos)
             return false;
         d->resetReadBuffer();
 
-        d->toUtf16.resetState();
+        // also drops the flags that readUtf8LineView() may have set
+        d->toUtf16 = QStringDecoder(d->encoding);
         d->fromUtf16.resetState();
         return true;
     }
@@ -1130,8 +1311,11 @@ qint64 QTextStream::pos() const
     Q_D(const QTextStream);
     if (d->device) {
         // Cutoff
-        if (d->readBuffer.isEmpty())
+        if (d->readBuffer.isEmpty()) {
+            if (d->utf8Data && !d->device->isSequential())
+                return d->utf8StartDevicePos + d->utf8Offset;
             return d->device->pos();
+        }
         if (d->device->isSequential())
             return 0;
 
@@ -1201,6 +1385,7 @@ void QTextStream::setDevice(QIODevice *device)
 {
     Q_D(QTextStream);
     flush();
+    d->resetUtf8Buffer();
     if (d->deleteDevice) {
 #ifndef QT_NO_QOBJECT
         d->deviceClosedNotifier.disconnect();
@@ -1214,7 +1399,7 @@ void QTextStream::setDevice(QIODevice *device)
     d->device = device;
     d->resetReadBuffer();
 #ifndef QT_NO_QOBJECT
-    d->deviceClosedNotifier.setupDevice(this, d->device);
+    d->deviceClosedNotifier.setupDevice(d, d->device);
 #endif
 }
 
@@ -1241,6 +1426,7 @@ void QTextStream::setString(QString *string, OpenMode openMode)
 {
     Q_D(QTextStream);
     flush();
+    d->resetUtf8Buffer();
     if (d->deleteDevice) {
 #ifndef QT_NO_QOBJECT
         d->deviceClosedNotifier.disconnect();
@@ -1519,7 +1705,7 @@ bool QTextStream::atEnd() const
 
     if (d->string)
         return d->string->size() == d->stringOffset;
-    return d->readBuffer.isEmpty() && d->device->atEnd();
+    return d->readBuffer.isEmpty() && d->utf8Offset == d->utf8Size && d->device->atEnd();
 }
 
 /*!
@@ -1615,6 +1801,138 @@ bool QTextStream::readLineInto(QString *line, qint64 maxlen)
     return true;
 }
 
+/*!
+    \since 6.4
+
+    Reads one line of text from the stream, and returns a view of it. The
+    view has no trailing end-of-line characters ("\\n" or "\\r\\n"). If the
+    stream has read to the end of the file, a null view is returned; an
+    empty line gives an empty view that is not null.
+
+    The view refers to the stream's internal buffer, or to the string the
+    stream operates on, and remains valid until the next read from the
+    stream or until the stream is changed. Unlike readLine() and
+    readLineInto(), this function allocates no memory for the lines, so it
+    is the fastest way to process a large text line by line:
+
+    \snippet code/src_corelib_io_qtextstream.cpp 11
+
+    \sa readLine(), readUtf8LineView()
+*/
+QStringView QTextStream::readLineView()
+{
+    Q_D(QTextStream);
+    CHECK_VALID_STREAM(QStringView());
+
+    // The last line handed out is no longer needed, so compacting is safe.
+    if (d->device && d->readBufferOffset > QTEXTSTREAM_BUFFERSIZE)
+        d->consume(0);
+
+    const QChar *readPtr;
+    int length;
+    if (!d->scan(&readPtr, &length, 0, QTextStreamPrivate::EndOfLine))
+        return QStringView();
+    const QStringView line(readPtr, length);
+
+    if (d->string) {
+        d->consumeLastToken();
+        return line;
+    }
+
+    // Unlike consumeLastToken(), never move or release the line's storage.
+    d->readBufferOffset += d->lastTokenSize;
+    d->lastTokenSize = 0;
+    if (d->readBufferOffset >= d->readBuffer.size()) {
+        d->readBuffer.swap(d->spareReadBuffer);
+        if (!d->readBuffer.isNull())
+            d->readBuffer.resize(0);
+        d->readBufferOffset = 0;
+        d->saveConverterState(d->device->pos());
+    }
+    return line;
+}
+
+/*!
+    \since 6.4
+
+    Reads one line of text from the stream, and returns a view of it in
+    UTF-8. The view has no trailing end-of-line characters ("\\n" or
+    "\\r\\n"). If the stream has read to the end of the file, a null view
+    is returned; an empty line gives an empty view that is not null.
+
+    When the stream reads UTF-8 from a device, the lines are not decoded:
+    the function searches the raw bytes for the end of the line and returns
+    a view into them. Files that can be memory-mapped are not even copied.
+    No memory is allocated for the lines, and invalid UTF-8 is passed
+    through unchanged. Otherwise, for other encodings or when the stream
+    operates on a string, the line is read as by readLineView() and
+    converted into a buffer that is reused for every line.
+
+    The view remains valid until the next read from the stream, or until
+    the stream or its device is changed or closed.
+
+    \sa readLineView(), readLine(), encoding()
+*/
+QUtf8StringView QTextStream::readUtf8LineView()
+{
+    Q_D(QTextStream);
+    CHECK_VALID_STREAM(QUtf8StringView());
+
+    if (!d->device || d->encoding != QStringConverter::Utf8 || !d->readBuffer.isEmpty()) {
+        const QStringView line = readLineView();
+        if (line.isNull())
+            return QUtf8StringView();
+        QStringConverter::State state;
+        d->utf8Line.resize(line.size() * 3);
+        char *end = QUtf8::convertFromUnicode(d->utf8Line.data(), line, &state);
+        d->utf8Line.truncate(end - d->utf8Line.constData());
+        return QUtf8StringView(d->utf8Line.constData(), d->utf8Line.size());
+    }
+
+    if (!d->utf8Data) {
+        const bool atStart = d->device->isSequential() ? d->autoDetectUnicode
+                                                       : d->device->pos() == 0;
+        d->fillUtf8Buffer();
+        if (!d->utf8Data)
+            return QUtf8StringView();
+        const QByteArrayView head(d->utf8Data, d->utf8Size);
+        if (d->autoDetectUnicode) {
+            d->autoDetectUnicode = false;
+            const auto e = QStringConverter::encodingForData(head);
+            if (e && *e != QStringConverter::Utf8) {
+                d->encoding = *e;
+                d->toUtf16 = QStringDecoder(d->encoding);
+                d->fromUtf16 = QStringEncoder(d->encoding);
+                return readUtf8LineView();
+            }
+        }
+        // the decoder would skip the byte order mark, too
+        if (atStart && head.startsWith("\xef\xbb\xbf"))
+            d->utf8Offset = 3;
+    }
+
+    qsizetype searched = 0; // bytes known not to contain a newline
+    forever {
+        const char *begin = d->utf8Data + d->utf8Offset;
+        const char *end = d->utf8Data + d->utf8Size;
+        if (const void *newline = memchr(begin + searched, '\n', end - begin - searched)) {
+            d->utf8Offset = static_cast<const char *>(newline) + 1 - d->utf8Data;
+            return d->utf8LineView(begin, static_cast<const char *>(newline));
+        }
+        searched = end - begin;
+        if (!d->fillUtf8Buffer())
+            break;
+    }
+
+    // the last line has no newline
+    const char *begin = d->utf8Data + d->utf8Offset;
+    const char *end = d->utf8Data + d->utf8Size;
+    if (begin == end)
+        return QUtf8StringView();
+    d->utf8Offset = d->utf8Size;
+    return d->utf8LineView(begin, end);
+}
+
 /*!
     \since 4.1
 
@@ -2952,7 +3270,7 @@ void QTextStream::setEncoding(QStringConverter::Encoding encoding)
         return;
 
     qint64 seekPos = -1;
-    if (!d->readBuffer.isEmpty()) {
+    if (!d->readBuffer.isEmpty() || d->utf8Data) {
         if (!d->device->isSequential()) {
             seekPos = pos();
         }
@@ -2964,7 +3282,7 @@ void QTextStream::setEncoding(QStringConverter::Encoding encoding)
     d->fromUtf16 = QStringEncoder(d->encoding,
                                   generateBOM ? QStringEncoder::Flag::WriteBom : QStringEncoder::Flag::Default);
 
-    if (seekPos >=0 && !d->readBuffer.isEmpty())
+    if (seekPos >=0 && (!d->readBuffer.isEmpty() || d->utf8Data))
         seek(seekPos);
 }
 
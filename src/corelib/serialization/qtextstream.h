@@ -44,6 +44,7 @@
 #include <QtCore/qchar.h>
 #include <QtCore/qscopedpointer.h>
 #include <QtCore/qstringconverter_base.h>
+#include <QtCore/qstringfwd.h>
 
 #include <stdio.h>
 
@@ -127,6 +128,8 @@ public:
 
     QString readLine(qint64 maxlen = 0);
     bool readLineInto(QString *line, qint64 maxlen = 0);
+    QStringView readLineView();
+    QUtf8StringView readUtf8LineView();
     QString readAll();
     QString read(qint64 maxlen);
 
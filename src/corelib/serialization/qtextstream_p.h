@@ -60,6 +60,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QTextStreamPrivate;
+
 #ifndef QT_NO_QOBJECT
 class QDeviceClosedNotifier : public QObject
 {
@@ -68,7 +70,7 @@ public:
     inline QDeviceClosedNotifier()
     { }
 
-    inline void setupDevice(QTextStream *stream, QIODevice *device)
+    inline void setupDevice(QTextStreamPrivate *stream, QIODevice *device)
     {
         disconnect();
         if (device) {
@@ -77,15 +79,18 @@ public:
             // synchronization (see also QTBUG-12055).
             connect(device, SIGNAL(aboutToClose()), this, SLOT(flushStream()),
                     Qt::DirectConnection);
+            connect(device, SIGNAL(destroyed()), this, SLOT(dropDevice()),
+                    Qt::DirectConnection);
         }
         this->stream = stream;
     }
 
 public Q_SLOTS:
-    inline void flushStream() { stream->flush(); }
+    void flushStream();
+    void dropDevice();
 
 private:
-    QTextStream *stream;
+    QTextStreamPrivate *stream;
 };
 #endif
 
@@ -130,6 +135,7 @@ public:
 
     QString writeBuffer;
     QString readBuffer;
+    QString spareReadBuffer; // keeps the last readLineView() alive
     int readBufferOffset;
     int readConverterSavedStateOffset; //the offset between readBufferStartDevicePos and that start of the buffer
     qint64 readBufferStartDevicePos;
@@ -199,6 +205,22 @@ public:
     bool fillReadBuffer(qint64 maxBytes = -1);
     void resetReadBuffer();
     void flushWriteBuffer();
+
+    // Undecoded UTF-8 read ahead by readUtf8LineView(): the bytes from
+    // utf8Data + utf8Offset to utf8Data + utf8Size, which start at
+    // utf8StartDevicePos in the device. They live in utf8Buffer, or in
+    // utf8Map if the device is a memory-mapped file.
+    QByteArray utf8Buffer;
+    QByteArray utf8Line;
+    const char *utf8Data = nullptr;
+    qsizetype utf8Offset = 0;
+    qsizetype utf8Size = 0;
+    qint64 utf8StartDevicePos = 0;
+    uchar *utf8Map = nullptr;
+
+    bool fillUtf8Buffer();
+    void resetUtf8Buffer();
+    QUtf8StringView utf8LineView(const char *begin, const char *end);
 };
 
 QT_END_NAMESPACE
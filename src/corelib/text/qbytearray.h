@@ -388,6 +388,17 @@ public:
     QByteArray &setNum(double, char format = 'g', int precision = 6);
     QByteArray &setRawData(const char *a, qsizetype n);
 
+    inline QByteArray &appendNumber(short, int base = 10);
+    inline QByteArray &appendNumber(ushort, int base = 10);
+    inline QByteArray &appendNumber(int, int base = 10);
+    inline QByteArray &appendNumber(uint, int base = 10);
+    inline QByteArray &appendNumber(long, int base = 10);
+    inline QByteArray &appendNumber(ulong, int base = 10);
+    QByteArray &appendNumber(qlonglong, int base = 10);
+    QByteArray &appendNumber(qulonglong, int base = 10);
+    inline QByteArray &appendNumber(float, char format = 'g', int precision = 6);
+    QByteArray &appendNumber(double, char format = 'g', int precision = 6);
+
     [[nodiscard]] static QByteArray number(int, int base = 10);
     [[nodiscard]] static QByteArray number(uint, int base = 10);
     [[nodiscard]] static QByteArray number(long, int base = 10);
@@ -602,6 +613,20 @@ inline QByteArray &QByteArray::setNum(ulong n, int base)
 { return setNum(qulonglong(n), base); }
 inline QByteArray &QByteArray::setNum(float n, char format, int precision)
 { return setNum(double(n), format, precision); }
+inline QByteArray &QByteArray::appendNumber(short n, int base)
+{ return appendNumber(qlonglong(n), base); }
+inline QByteArray &QByteArray::appendNumber(ushort n, int base)
+{ return appendNumber(qulonglong(n), base); }
+inline QByteArray &QByteArray::appendNumber(int n, int base)
+{ return appendNumber(qlonglong(n), base); }
+inline QByteArray &QByteArray::appendNumber(uint n, int base)
+{ return appendNumber(qulonglong(n), base); }
+inline QByteArray &QByteArray::appendNumber(long n, int base)
+{ return appendNumber(qlonglong(n), base); }
+inline QByteArray &QByteArray::appendNumber(ulong n, int base)
+{ return appendNumber(qulonglong(n), base); }
+inline QByteArray &QByteArray::appendNumber(float n, char format, int precision)
+{ return appendNumber(double(n), format, precision); }
 
 inline std::string QByteArray::toStdString() const
 { return std::string(constData(), length()); }
@@ -41,6 +41,8 @@
 #define QBYTEARRAYMATCHER_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
 
 #include <limits>
 
@@ -95,6 +97,52 @@ private:
     };
 };
 
+class QMultiPatternMatcherPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QMultiPatternMatcherPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QMultiByteArrayMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position = -1;
+        qsizetype length = 0;
+        qsizetype patternIndex = -1;
+
+        constexpr bool isValid() const noexcept { return position >= 0; }
+    };
+
+    QMultiByteArrayMatcher();
+    explicit QMultiByteArrayMatcher(const QList<QByteArray> &patterns,
+                                    Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other);
+    QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other) noexcept;
+    ~QMultiByteArrayMatcher();
+
+    QMultiByteArrayMatcher &operator=(const QMultiByteArrayMatcher &other);
+    QMultiByteArrayMatcher &operator=(QMultiByteArrayMatcher &&other) noexcept;
+
+    void swap(QMultiByteArrayMatcher &other) noexcept
+    {
+        d.swap(other.d);
+        std::swap(q_cs, other.q_cs);
+    }
+
+    void setPatterns(const QList<QByteArray> &patterns);
+    QList<QByteArray> patterns() const;
+    void setCaseSensitivity(Qt::CaseSensitivity cs);
+    Qt::CaseSensitivity caseSensitivity() const { return q_cs; }
+
+    Match indexIn(QByteArrayView data, qsizetype from = 0) const;
+    QList<Match> indexesIn(QByteArrayView data, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiPatternMatcherPrivate> d;
+    Qt::CaseSensitivity q_cs = Qt::CaseSensitive;
+};
+
+Q_DECLARE_SHARED(QMultiByteArrayMatcher)
+
 class QStaticByteArrayMatcherBase
 {
     alignas(16)
@@ -43,6 +43,8 @@
 #include "qlocale_p.h"
 #include "qstring.h"
 
+#include <QtCore/qendian.h>
+
 #include <private/qnumeric_p.h>
 
 #include <ctype.h>
@@ -116,6 +118,36 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
     if (form == QLocaleData::DFSignificantDigits && precision == 0)
         precision = 1; // 0 significant digits is silently converted to 1
 
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    if (precision == QLocale::FloatingPointShortest
+            && bufSize >= std::numeric_limits<double>::max_digits10) {
+        // Standard libraries implement the shortest round-trip mode of
+        // std::to_chars() with Ryu-style algorithms, which are faster than
+        // libdouble-conversion's Grisu3 and never need a bignum fallback.
+        // The scientific form is easy to take apart: [-]d[.ddd]e(+|-)dd[d]
+        char scientific[32];
+        const auto result = std::to_chars(scientific, scientific + sizeof(scientific), d,
+                                          std::chars_format::scientific);
+        Q_ASSERT(result.ec == std::errc{});
+        const char *p = scientific;
+        sign = *p == '-';
+        if (sign)
+            ++p;
+        length = 0;
+        for ( ; *p != 'e'; ++p) {
+            if (*p != '.')
+                buf[length++] = *p;
+        }
+        Q_ASSERT(length <= std::numeric_limits<double>::max_digits10);
+        ++p;
+        const bool negativeExponent = *p == '-';
+        int exponent = 0;
+        std::from_chars(p + 1, result.ptr, exponent);
+        decpt = (negativeExponent ? -exponent : exponent) + 1;
+        return;
+    }
+#endif
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     // one digit before the decimal dot, counts as significant digit for DoubleToStringConverter
     if (form == QLocaleData::DFExponent && precision >= 0)
@@ -441,6 +473,58 @@ static bool isDigitForBase(char d, int base)
     return false;
 }
 
+// Reads eight ASCII bytes as one little-endian word. The digit test and
+// conversion below work on all eight at once ("SIMD within a register").
+static inline quint64 loadEightChars(const char *p)
+{
+    return qFromLittleEndian<quint64>(p);
+}
+
+static inline bool isEightDigits(quint64 chunk)
+{
+    // Adding 0x46 carries into bit 7 for bytes above '9', subtracting 0x30
+    // borrows into it for bytes below '0'.
+    return !(((chunk + 0x4646464646464646) | (chunk - 0x3030303030303030))
+             & 0x8080808080808080);
+}
+
+static inline quint32 eightDigitsValue(quint64 chunk)
+{
+    constexpr quint64 Mask = 0x000000FF000000FF;
+    constexpr quint64 Mul1 = 100 + (1000000ULL << 32);
+    constexpr quint64 Mul2 = 1 + (10000ULL << 32);
+    chunk -= 0x3030303030303030;
+    chunk = chunk * 10 + (chunk >> 8); // pairs of digits
+    return quint32(((chunk & Mask) * Mul1 + ((chunk >> 16) & Mask) * Mul2) >> 32);
+}
+
+// std::from_chars() for base 10, converting eight digits at a time. A run
+// of more digits than are sure to fit is left to std::from_chars(), which
+// detects the overflow.
+static std::from_chars_result decimalFromChars(const char *first, const char *last,
+                                               unsigned long long &value)
+{
+    constexpr qsizetype MaxSafeDigits = std::numeric_limits<unsigned long long>::digits10;
+    const char *p = first;
+    unsigned long long result = 0;
+    while (last - p >= 8 && p - first + 8 <= MaxSafeDigits) {
+        const quint64 chunk = loadEightChars(p);
+        if (!isEightDigits(chunk))
+            break;
+        result = result * 100000000 + eightDigitsValue(chunk);
+        p += 8;
+    }
+    while (p < last && p - first < MaxSafeDigits && *p >= '0' && *p <= '9')
+        result = result * 10 + (*p++ - '0');
+
+    if (p == first)
+        return { first, std::errc::invalid_argument };
+    if (p < last && *p >= '0' && *p <= '9')
+        return std::from_chars(first, last, value, 10);
+    value = result;
+    return { p, std::errc{} };
+}
+
 unsigned long long
 qstrntoull(const char *begin, qsizetype size, const char **endptr, int base, bool *ok)
 {
@@ -462,7 +546,9 @@ qstrntoull(const char *begin, qsizetype size, const char **endptr, int base, boo
         return 0;
     }
 
-    const auto res = std::from_chars(prefix.next, stop, result, prefix.base);
+    const auto res = prefix.base == 10
+            ? decimalFromChars(prefix.next, stop, result)
+            : std::from_chars(prefix.next, stop, result, prefix.base);
     *ok = res.ec == std::errc{};
     if (endptr)
         *endptr = res.ptr == prefix.next ? begin : res.ptr;
@@ -492,6 +578,20 @@ qstrntoll(const char *begin, qsizetype size, const char **endptr, int base, bool
         return 0;
     }
 
+    if (prefix.base == 10) {
+        unsigned long long magnitude = 0;
+        const auto res = decimalFromChars(prefix.next, stop, magnitude);
+        constexpr unsigned long long Max = std::numeric_limits<long long>::max();
+        *ok = res.ec == std::errc{} && magnitude <= Max + (negate ? 1 : 0);
+        if (endptr)
+            *endptr = res.ptr == prefix.next ? begin : res.ptr;
+        if (!*ok)
+            return 0;
+        if (magnitude > Max)
+            return std::numeric_limits<long long>::min();
+        return negate ? -static_cast<long long>(magnitude) : static_cast<long long>(magnitude);
+    }
+
     long long result = 0;
     auto res = std::from_chars(prefix.next, stop, result, prefix.base);
     *ok = res.ec == std::errc{};
@@ -559,6 +659,19 @@ QString qulltoBasicLatin(qulonglong number, int base, bool negative)
     return QString(reinterpret_cast<QChar *>(p), end - p);
 }
 
+void qulltoBasicLatin(QString &result, qulonglong number, int base, bool negative)
+{
+    const unsigned maxlen = 65;
+    char16_t buff[maxlen];
+    char16_t *const end = buff + maxlen, *p = end;
+
+    qulltoString_helper<char16_t>(number, base, p);
+    if (negative)
+        *--p = u'-';
+
+    result.append(reinterpret_cast<QChar *>(p), end - p);
+}
+
 QString qulltoa(qulonglong number, int base, const QStringView zero)
 {
     // Length of MAX_ULLONG in base 2 is 64; and we may need a surrogate pair
@@ -677,9 +790,10 @@ static constexpr int digits(int number)
     return i;
 }
 
-// Used generically for both QString and QByteArray
+// Used generically for both QString and QByteArray; appends to result
 template <typename T>
-static T dtoString(double d, QLocaleData::DoubleForm form, int precision, bool uppercase)
+static void dtoString(T &result, double d, QLocaleData::DoubleForm form, int precision,
+                      bool uppercase)
 {
     // Undocumented: aside from F.P.Shortest, precision < 0 is treated as
     // default, 6 - same as printf().
@@ -746,15 +860,17 @@ static T dtoString(double d, QLocaleData::DoubleForm form, int precision, bool u
     constexpr bool IsQString = std::is_same_v<T, QString>;
     using Char = std::conditional_t<IsQString, char16_t, char>;
 
-    T result;
-    result.reserve(total);
+    // When appending, leave the growth to append(), which over-allocates.
+    // Reserving size() + total on every call would reallocate each time.
+    const qsizetype start = result.size();
+    if (result.isEmpty())
+        result.reserve(total);
 
     if (negative && !isZero(d)) // We don't return "-0"
         result.append(Char('-'));
     if (!qIsFinite(d)) {
-        result.append(view);
-        if (uppercase)
-            result = std::move(result).toUpper();
+        for (char c : view)
+            result.append(Char(uppercase ? c - 'a' + 'A' : c));
     } else {
         switch (form) {
         case QLocaleData::DFExponent: {
@@ -792,7 +908,7 @@ static T dtoString(double d, QLocaleData::DoubleForm form, int precision, bool u
                     result.append(Char('0'));
                 result.append(view);
                 if (!succinct) {
-                    auto numDecimals = result.size() - 2 - (negative ? 1 : 0);
+                    auto numDecimals = result.size() - start - 2 - (negative ? 1 : 0);
                     for (qsizetype i = numDecimals; i < precision; ++i)
                         result.append(Char('0'));
                 }
@@ -800,7 +916,7 @@ static T dtoString(double d, QLocaleData::DoubleForm form, int precision, bool u
                 if (decpt > view.size()) {
                     result.append(view);
                     const int sign = negative ? 1 : 0;
-                    while (result.size() - sign < decpt)
+                    while (result.size() - start - sign < decpt)
                         result.append(Char('0'));
                     view = {};
                 } else if (decpt) {
@@ -824,18 +940,33 @@ static T dtoString(double d, QLocaleData::DoubleForm form, int precision, bool u
             break;
         }
     }
-    Q_ASSERT(total >= result.size()); // No reallocations are needed
-    return result;
+    Q_ASSERT(total >= result.size() - start); // No reallocations are needed
 }
 
 QString qdtoBasicLatin(double d, QLocaleData::DoubleForm form, int precision, bool uppercase)
 {
-    return dtoString<QString>(d, form, precision, uppercase);
+    QString result;
+    dtoString(result, d, form, precision, uppercase);
+    return result;
+}
+
+void qdtoBasicLatin(QString &result, double d, QLocaleData::DoubleForm form, int precision,
+                    bool uppercase)
+{
+    dtoString(result, d, form, precision, uppercase);
 }
 
 QByteArray qdtoAscii(double d, QLocaleData::DoubleForm form, int precision, bool uppercase)
 {
-    return dtoString<QByteArray>(d, form, precision, uppercase);
+    QByteArray result;
+    dtoString(result, d, form, precision, uppercase);
+    return result;
+}
+
+void qdtoAscii(QByteArray &result, double d, QLocaleData::DoubleForm form, int precision,
+               bool uppercase)
+{
+    dtoString(result, d, form, precision, uppercase);
 }
 
 QT_END_NAMESPACE
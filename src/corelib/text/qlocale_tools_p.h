@@ -69,12 +69,17 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
                       bool &sign, int &length, int &decpt);
 
 [[nodiscard]] QString qulltoBasicLatin(qulonglong l, int base, bool negative);
+void qulltoBasicLatin(QString &result, qulonglong l, int base, bool negative);
 [[nodiscard]] QString qulltoa(qulonglong l, int base, const QStringView zero);
 [[nodiscard]] Q_CORE_EXPORT QString qdtoa(qreal d, int *decpt, int *sign);
 [[nodiscard]] QString qdtoBasicLatin(double d, QLocaleData::DoubleForm form,
                                      int precision, bool uppercase);
+void qdtoBasicLatin(QString &result, double d, QLocaleData::DoubleForm form,
+                    int precision, bool uppercase);
 [[nodiscard]] QByteArray qdtoAscii(double d, QLocaleData::DoubleForm form,
                                    int precision, bool uppercase);
+void qdtoAscii(QByteArray &result, double d, QLocaleData::DoubleForm form,
+               int precision, bool uppercase);
 
 [[nodiscard]] constexpr inline bool isZero(double d)
 {
@@ -0,0 +1,758 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qbytearraymatcher.h"
+#include "qstringmatcher.h"
+#include "qmultipatternmatcher_p.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/private/qsimd_p.h>
+
+#include <algorithm>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiPatternMatcherPrivate)
+
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SSSE3)
+static inline QT_FUNCTION_TARGET(SSSE3) __m128i loadTeddyBlock(const uchar *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+static inline QT_FUNCTION_TARGET(SSSE3) __m128i loadTeddyBlock(const char16_t *p)
+{
+    // Saturating to bytes turns everything above U+00FF into 0x00 or 0xFF.
+    // The prefilter is only built when no fingerprint needs such a
+    // character, so this can cause false positives but never hide a match.
+    const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 8));
+    return _mm_packus_epi16(first, second);
+}
+
+static inline QT_FUNCTION_TARGET(SSSE3)
+__m128i teddyBuckets(__m128i block, const uchar *low, const uchar *high)
+{
+    const __m128i nibbleMask = _mm_set1_epi8(0xf);
+    const __m128i lowNibbles = _mm_and_si128(block, nibbleMask);
+    const __m128i highNibbles = _mm_and_si128(_mm_srli_epi16(block, 4), nibbleMask);
+    const __m128i lowTable = _mm_load_si128(reinterpret_cast<const __m128i *>(low));
+    const __m128i highTable = _mm_load_si128(reinterpret_cast<const __m128i *>(high));
+    return _mm_and_si128(_mm_shuffle_epi8(lowTable, lowNibbles),
+                         _mm_shuffle_epi8(highTable, highNibbles));
+}
+
+// Returns the first position at or after \a from where a pattern may start,
+// or the position of the tail that is too short for a full block.
+template <typename Char>
+static QT_FUNCTION_TARGET(SSSE3)
+qsizetype teddyScan(const QMultiPatternMatcherPrivate::Prefilter &filter,
+                    const Char *data, qsizetype from, qsizetype length)
+{
+    const qsizetype lastBlock = length - 16 - (filter.fingerprintLength - 1);
+    for ( ; from <= lastBlock; from += 16) {
+        __m128i buckets = teddyBuckets(loadTeddyBlock(data + from),
+                                       filter.low[0], filter.high[0]);
+        if (filter.fingerprintLength > 1) {
+            buckets = _mm_and_si128(buckets, teddyBuckets(loadTeddyBlock(data + from + 1),
+                                                          filter.low[1], filter.high[1]));
+        }
+        const __m128i empty = _mm_cmpeq_epi8(buckets, _mm_setzero_si128());
+        const uint candidates = ~uint(_mm_movemask_epi8(empty)) & 0xffffu;
+        if (candidates)
+            return from + qCountTrailingZeroBits(candidates);
+    }
+    return from;
+}
+#endif
+
+QMultiPatternMatcherPrivate::QMultiPatternMatcherPrivate(const QList<QString> &patterns,
+                                                         Encoding encoding,
+                                                         Qt::CaseSensitivity cs)
+    : patterns(patterns), encoding(encoding), cs(cs)
+{
+    QList<QString> folded;
+    folded.reserve(patterns.size());
+    for (const QString &pattern : patterns) {
+        QString f(pattern.size(), Qt::Uninitialized);
+        std::transform(pattern.utf16(), pattern.utf16() + pattern.size(),
+                       reinterpret_cast<char16_t *>(f.data()),
+                       [this](char16_t c) { return fold(c); });
+        folded.append(f);
+    }
+
+    buildClasses(folded);
+    buildAutomaton(folded);
+    buildPrefilter(folded);
+}
+
+char16_t QMultiPatternMatcherPrivate::fold(char16_t c) const noexcept
+{
+    if (cs == Qt::CaseSensitive)
+        return c;
+    const char32_t folded = QChar::toCaseFolded(char32_t(c));
+    // U+00B5 MICRO SIGN folds to U+03BC, which a byte can't hold
+    if (encoding == Latin1 && folded > 0xff)
+        return c;
+    return char16_t(folded);
+}
+
+void QMultiPatternMatcherPrivate::buildClasses(const QList<QString> &patterns)
+{
+    QHash<char16_t, uint> alphabet;
+    for (const QString &pattern : patterns) {
+        for (QChar c : pattern) {
+            if (!alphabet.contains(c.unicode()))
+                alphabet.insert(c.unicode(), uint(alphabet.size() + 1));
+        }
+    }
+    classCount = alphabet.size() + 1;
+
+    const auto classOfCharacter = [&](char16_t c) { return alphabet.value(fold(c)); };
+    for (int c = 0; c < 256; ++c)
+        latin1Classes[c] = classOfCharacter(char16_t(c));
+
+    if (encoding != Utf16)
+        return;
+    if (cs == Qt::CaseSensitive) {
+        for (auto it = alphabet.cbegin(); it != alphabet.cend(); ++it) {
+            if (it.key() > 0xff)
+                otherClasses.append({ it.key(), it.value() });
+        }
+        std::sort(otherClasses.begin(), otherClasses.end());
+    } else {
+        // Code units outside Latin-1 can fold into the alphabet too (U+212A
+        // KELVIN SIGN folds to 'k'), so every one of them has to be checked.
+        for (char32_t c = 0x100; c <= 0xffff; ++c) {
+            if (uint cls = classOfCharacter(char16_t(c)))
+                otherClasses.append({ char16_t(c), cls });
+        }
+    }
+}
+
+uint QMultiPatternMatcherPrivate::otherClassOf(char16_t c) const noexcept
+{
+    const auto it = std::lower_bound(otherClasses.cbegin(), otherClasses.cend(), c,
+                                     [](const std::pair<char16_t, uint> &entry, char16_t c) {
+                                         return entry.first < c;
+                                     });
+    return it != otherClasses.cend() && it->first == c ? it->second : 0;
+}
+
+void QMultiPatternMatcherPrivate::buildAutomaton(const QList<QString> &patterns)
+{
+    // First the trie, with -1 for missing edges...
+    transitions.fill(-1, classCount);
+    depth.append(0);
+    output.append(-1);
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QString &pattern = patterns.at(i);
+        if (pattern.isEmpty())
+            continue;
+
+        qint32 state = 0;
+        for (QChar c : pattern) {
+            const qsizetype edge = state * classCount + classOf(c.unicode());
+            qint32 target = transitions.at(edge);
+            if (target < 0) {
+                target = qint32(depth.size());
+                transitions[edge] = target;
+                transitions.insert(transitions.size(), classCount, -1);
+                depth.append(depth.at(state) + 1);
+                output.append(-1);
+            }
+            state = target;
+        }
+        // a repeated pattern reports the index of its first occurrence
+        if (output.at(state) < 0)
+            output[state] = qint32(i);
+    }
+
+    // ...then a breadth-first walk turns it into a complete DFA: a missing
+    // edge takes the edge of the failure state, which is shallower and thus
+    // already complete.
+    const qsizetype stateCount = depth.size();
+    QList<qint32> failure(stateCount, 0);
+    outputLink.fill(0, stateCount);
+    QList<qint32> queue;
+    queue.reserve(stateCount);
+    for (qsizetype cls = 0; cls < classCount; ++cls) {
+        if (transitions.at(cls) < 0)
+            transitions[cls] = 0;
+        else
+            queue.append(transitions.at(cls));
+    }
+    for (qsizetype head = 0; head < queue.size(); ++head) {
+        const qint32 state = queue.at(head);
+        const qint32 fail = failure.at(state);
+        for (qsizetype cls = 0; cls < classCount; ++cls) {
+            const qsizetype edge = state * classCount + cls;
+            const qint32 target = transitions.at(edge);
+            const qint32 fallback = transitions.at(fail * classCount + cls);
+            if (target < 0) {
+                transitions[edge] = fallback;
+            } else {
+                failure[target] = fallback;
+                outputLink[target] = output.at(fallback) >= 0 ? fallback : outputLink.at(fallback);
+                queue.append(target);
+            }
+        }
+    }
+}
+
+void QMultiPatternMatcherPrivate::buildPrefilter(const QList<QString> &patterns)
+{
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    // With more patterns than this the eight buckets fill up and nearly
+    // every position becomes a candidate.
+    constexpr qsizetype MaxPrefilterPatterns = 64;
+
+    qsizetype minLength = std::numeric_limits<qsizetype>::max();
+    qsizetype count = 0;
+    for (const QString &pattern : patterns) {
+        if (!pattern.isEmpty()) {
+            minLength = qMin(minLength, pattern.size());
+            ++count;
+        }
+    }
+    if (count == 0 || count > MaxPrefilterPatterns)
+        return;
+
+    Prefilter filter = {};
+    filter.fingerprintLength = minLength > 1 ? 2 : 1;
+    for (const QString &pattern : patterns) {
+        if (pattern.isEmpty())
+            continue;
+        // patterns with the same first character share a bucket
+        const uchar bucket = uchar(1u << (pattern.front().unicode() & 7));
+        for (int k = 0; k < filter.fingerprintLength; ++k) {
+            const uint cls = classOf(pattern.at(k).unicode());
+            for (const auto &entry : otherClasses) {
+                if (entry.second == cls)
+                    return;
+            }
+            for (int c = 0; c < 256; ++c) {
+                if (latin1Classes[c] == cls) {
+                    filter.low[k][c & 0xf] |= bucket;
+                    filter.high[k][c >> 4] |= bucket;
+                }
+            }
+        }
+    }
+    prefilter = filter;
+#else
+    Q_UNUSED(patterns);
+#endif
+}
+
+template <typename Char>
+qsizetype QMultiPatternMatcherPrivate::skipToCandidate(const Char *data, qsizetype from,
+                                                       qsizetype length) const noexcept
+{
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    if (prefilter.fingerprintLength && qCpuHasFeature(SSSE3))
+        return teddyScan(prefilter, data, from, length);
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(length);
+#endif
+    return from;
+}
+
+// Leftmost match, and the longest one among those starting there.
+template <typename Char, typename Match>
+Match QMultiPatternMatcherPrivate::indexIn(const Char *data, qsizetype length,
+                                           qsizetype from) const
+{
+    const qint32 *delta = transitions.constData();
+    const qint32 *outputs = output.constData();
+    const qint32 *links = outputLink.constData();
+    const qint32 *depths = depth.constData();
+
+    Match best;
+    qint32 state = 0;
+    for (qsizetype i = qMax(from, qsizetype(0)); i < length; ++i) {
+        if (state == 0) {
+            i = skipToCandidate(data, i, length);
+            if (i == length)
+                break;
+        }
+        state = delta[state * classCount + classOf(data[i])];
+
+        // the longest pattern ending here is the state itself or the
+        // first one on its output chain
+        const qint32 hit = outputs[state] >= 0 ? state : links[state];
+        if (hit) {
+            const qsizetype position = i + 1 - depths[hit];
+            if (!best.isValid() || position <= best.position) {
+                best.position = position;
+                best.length = depths[hit];
+                best.patternIndex = outputs[hit];
+            }
+        }
+
+        // the partial match tracked by the state can't start at or before
+        // the best match any more, so nothing better can follow
+        if (best.isValid() && i + 1 - depths[state] > best.position)
+            break;
+    }
+    return best;
+}
+
+template <typename Char, typename Match>
+QList<Match> QMultiPatternMatcherPrivate::indexesIn(const Char *data, qsizetype length,
+                                                   qsizetype from) const
+{
+    const qint32 *delta = transitions.constData();
+    const qint32 *outputs = output.constData();
+    const qint32 *links = outputLink.constData();
+    const qint32 *depths = depth.constData();
+
+    QList<Match> matches;
+    qint32 state = 0;
+    for (qsizetype i = qMax(from, qsizetype(0)); i < length; ++i) {
+        if (state == 0) {
+            i = skipToCandidate(data, i, length);
+            if (i == length)
+                break;
+        }
+        state = delta[state * classCount + classOf(data[i])];
+        for (qint32 hit = outputs[state] >= 0 ? state : links[state]; hit; hit = links[hit])
+            matches.append(Match{ i + 1 - depths[hit], depths[hit], outputs[hit] });
+    }
+
+    // The automaton finds matches in order of their end; shorter matches
+    // starting at the same position were found first and stay first.
+    std::stable_sort(matches.begin(), matches.end(), [](const Match &lhs, const Match &rhs) {
+        return lhs.position < rhs.position;
+    });
+    return matches;
+}
+
+/*!
+    \class QMultiByteArrayMatcher
+    \inmodule QtCore
+    \since 6.4
+    \brief The QMultiByteArrayMatcher class holds a set of byte sequences
+    that can be searched for in a byte array at the same time.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    QByteArrayMatcher searches for one pattern. When a byte array has to be
+    scanned for many patterns at once, such as the keywords and delimiters
+    of a protocol, searching for each of them in turn reads the data once
+    per pattern. QMultiByteArrayMatcher builds an Aho-Corasick automaton
+    from all the patterns instead, and finds every occurrence of any of them
+    in a single pass over the data.
+
+    indexIn() returns the leftmost match, preferring the longest pattern
+    when several start at the same position. To iterate over
+    non-overlapping matches, continue searching from the end of the
+    previous match:
+
+    \snippet code/src_corelib_text_qbytearraymatcher.cpp 2
+
+    indexesIn() returns all matches, including overlapping ones.
+
+    On x86 processors with SSSE3, stretches of data in which no pattern can
+    start are skipped sixteen bytes at a time, using the first one or two
+    bytes of each pattern as a fingerprint. This works best with a few dozen
+    patterns or fewer.
+
+    Empty patterns never match. If the same pattern occurs more than once,
+    matches report the index of its first occurrence.
+
+    \sa QByteArrayMatcher, QMultiStringMatcher
+*/
+
+/*!
+    \class QMultiByteArrayMatcher::Match
+    \inmodule QtCore
+    \since 6.4
+    \brief The Match struct describes one match found by QMultiByteArrayMatcher.
+
+    \variable QMultiByteArrayMatcher::Match::position
+    \brief the index of the first byte of the match, or -1 for no match
+
+    \variable QMultiByteArrayMatcher::Match::length
+    \brief the number of bytes matched
+
+    \variable QMultiByteArrayMatcher::Match::patternIndex
+    \brief the index in QMultiByteArrayMatcher::patterns() of the matched pattern
+*/
+
+/*!
+    \fn bool QMultiByteArrayMatcher::Match::isValid() const
+
+    Returns \c true if this object describes a match, \c false otherwise.
+*/
+
+/*!
+    Constructs a matcher without patterns, which won't match anything.
+    Call setPatterns() to give it patterns to match.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher() = default;
+
+static QMultiPatternMatcherPrivate *
+createMultiByteArrayMatcher(const QList<QByteArray> &patterns, Qt::CaseSensitivity cs)
+{
+    QList<QString> widened;
+    widened.reserve(patterns.size());
+    for (const QByteArray &pattern : patterns)
+        widened.append(QString::fromLatin1(pattern));
+    return new QMultiPatternMatcherPrivate(widened, QMultiPatternMatcherPrivate::Latin1, cs);
+}
+
+/*!
+    Constructs a matcher that searches for all of \a patterns, with case
+    sensitivity \a cs. Case-insensitive matching compares the bytes as
+    Latin-1 characters.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QList<QByteArray> &patterns,
+                                               Qt::CaseSensitivity cs)
+    : d(createMultiByteArrayMatcher(patterns, cs)), q_cs(cs)
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other) = default;
+
+/*!
+    \fn QMultiByteArrayMatcher::QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other) noexcept = default;
+
+/*!
+    Destroys the matcher.
+*/
+QMultiByteArrayMatcher::~QMultiByteArrayMatcher() = default;
+
+/*!
+    Assigns \a other to this matcher.
+*/
+QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(const QMultiByteArrayMatcher &other) = default;
+
+/*!
+    Move-assigns \a other to this matcher.
+*/
+QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(QMultiByteArrayMatcher &&other) noexcept = default;
+
+/*!
+    \fn void QMultiByteArrayMatcher::swap(QMultiByteArrayMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Sets the patterns to search for to \a patterns.
+
+    \sa patterns(), setCaseSensitivity()
+*/
+void QMultiByteArrayMatcher::setPatterns(const QList<QByteArray> &patterns)
+{
+    d.reset(createMultiByteArrayMatcher(patterns, q_cs));
+}
+
+/*!
+    Returns the patterns this matcher searches for.
+
+    \sa setPatterns()
+*/
+QList<QByteArray> QMultiByteArrayMatcher::patterns() const
+{
+    QList<QByteArray> result;
+    if (d) {
+        result.reserve(d->patterns.size());
+        for (const QString &pattern : d->patterns)
+            result.append(pattern.toLatin1());
+    }
+    return result;
+}
+
+/*!
+    Sets the case sensitivity of the matcher to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiByteArrayMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs == q_cs)
+        return;
+    q_cs = cs;
+    if (d)
+        setPatterns(patterns());
+}
+
+/*!
+    \fn Qt::CaseSensitivity QMultiByteArrayMatcher::caseSensitivity() const
+
+    Returns the case sensitivity of the matcher.
+
+    \sa setCaseSensitivity()
+*/
+
+/*!
+    Searches \a data from byte position \a from (default 0, i.e. from the
+    first byte), for the leftmost occurrence of any of the patterns. If
+    several patterns match at that position, the longest one is returned.
+
+    Returns an invalid Match if none of the patterns occurs.
+
+    \sa indexesIn()
+*/
+QMultiByteArrayMatcher::Match QMultiByteArrayMatcher::indexIn(QByteArrayView data,
+                                                              qsizetype from) const
+{
+    if (!d)
+        return Match();
+    return d->indexIn<uchar, Match>(reinterpret_cast<const uchar *>(data.data()),
+                                    data.size(), from);
+}
+
+/*!
+    Returns all occurrences of the patterns in \a data at or after byte
+    position \a from, including overlapping ones. The matches are ordered by
+    position, and by increasing length when they start at the same position.
+
+    \sa indexIn()
+*/
+QList<QMultiByteArrayMatcher::Match> QMultiByteArrayMatcher::indexesIn(QByteArrayView data,
+                                                                       qsizetype from) const
+{
+    if (!d)
+        return {};
+    return d->indexesIn<uchar, Match>(reinterpret_cast<const uchar *>(data.data()),
+                                      data.size(), from);
+}
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \since 6.4
+    \brief The QMultiStringMatcher class holds a set of strings that can be
+    searched for in a Unicode string at the same time.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    This is the UTF-16 counterpart of QMultiByteArrayMatcher: it finds the
+    occurrences of any number of patterns in a single pass over the string.
+    indexIn() returns the leftmost match, preferring the longest pattern
+    when several start at the same position, and indexesIn() returns all
+    matches, including overlapping ones.
+
+    Case-insensitive matching folds each UTF-16 code unit with
+    QChar::toCaseFolded(), so characters such as U+212A KELVIN SIGN match
+    their folded forms too.
+
+    On x86 processors with SSSE3, stretches of text in which no pattern can
+    start are skipped sixteen characters at a time, provided the first one
+    or two characters of every pattern, and all their case variants, are
+    Latin-1 characters.
+
+    Empty patterns never match. If the same pattern occurs more than once,
+    matches report the index of its first occurrence.
+
+    \sa QStringMatcher, QMultiByteArrayMatcher
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \since 6.4
+    \brief The Match struct describes one match found by QMultiStringMatcher.
+
+    \variable QMultiStringMatcher::Match::position
+    \brief the index of the first character of the match, or -1 for no match
+
+    \variable QMultiStringMatcher::Match::length
+    \brief the number of characters matched
+
+    \variable QMultiStringMatcher::Match::patternIndex
+    \brief the index in QMultiStringMatcher::patterns() of the matched pattern
+*/
+
+/*!
+    \fn bool QMultiStringMatcher::Match::isValid() const
+
+    Returns \c true if this object describes a match, \c false otherwise.
+*/
+
+/*!
+    Constructs a matcher without patterns, which won't match anything.
+    Call setPatterns() to give it patterns to match.
+*/
+QMultiStringMatcher::QMultiStringMatcher() = default;
+
+/*!
+    Constructs a matcher that searches for all of \a patterns, with case
+    sensitivity \a cs.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiPatternMatcherPrivate(patterns, QMultiPatternMatcherPrivate::Utf16, cs)),
+      q_cs(cs)
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+*/
+QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other) noexcept = default;
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+/*!
+    Assigns \a other to this matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other) = default;
+
+/*!
+    Move-assigns \a other to this matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other) noexcept = default;
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Sets the patterns to search for to \a patterns.
+
+    \sa patterns(), setCaseSensitivity()
+*/
+void QMultiStringMatcher::setPatterns(const QStringList &patterns)
+{
+    d.reset(new QMultiPatternMatcherPrivate(patterns, QMultiPatternMatcherPrivate::Utf16, q_cs));
+}
+
+/*!
+    Returns the patterns this matcher searches for.
+
+    \sa setPatterns()
+*/
+QStringList QMultiStringMatcher::patterns() const
+{
+    return d ? d->patterns : QStringList();
+}
+
+/*!
+    Sets the case sensitivity of the matcher to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs == q_cs)
+        return;
+    q_cs = cs;
+    if (d)
+        setPatterns(d->patterns);
+}
+
+/*!
+    \fn Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+
+    Returns the case sensitivity of the matcher.
+
+    \sa setCaseSensitivity()
+*/
+
+/*!
+    \fn QMultiStringMatcher::Match QMultiStringMatcher::indexIn(const QString &str, qsizetype from) const
+    \overload
+*/
+
+/*!
+    Searches \a str from character position \a from (default 0, i.e. from
+    the first character), for the leftmost occurrence of any of the
+    patterns. If several patterns match at that position, the longest one
+    is returned.
+
+    Returns an invalid Match if none of the patterns occurs.
+
+    \sa indexesIn()
+*/
+QMultiStringMatcher::Match QMultiStringMatcher::indexIn(QStringView str, qsizetype from) const
+{
+    if (!d)
+        return Match();
+    return d->indexIn<char16_t, Match>(str.utf16(), str.size(), from);
+}
+
+/*!
+    \fn QList<QMultiStringMatcher::Match> QMultiStringMatcher::indexesIn(const QString &str, qsizetype from) const
+    \overload
+*/
+
+/*!
+    Returns all occurrences of the patterns in \a str at or after character
+    position \a from, including overlapping ones. The matches are ordered by
+    position, and by increasing length when they start at the same position.
+
+    \sa indexIn()
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::indexesIn(QStringView str,
+                                                                 qsizetype from) const
+{
+    if (!d)
+        return {};
+    return d->indexesIn<char16_t, Match>(str.utf16(), str.size(), from);
+}
+
+QT_END_NAMESPACE
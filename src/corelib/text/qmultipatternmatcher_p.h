@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QMULTIPATTERNMATCHER_P_H
+#define QMULTIPATTERNMATCHER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstring.h>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+// Aho-Corasick automaton shared by QMultiByteArrayMatcher and
+// QMultiStringMatcher. The patterns are always stored as UTF-16; byte
+// patterns are widened as Latin-1, so both matchers can share the same
+// construction code. Input characters are first mapped to a "class" (the
+// index of the folded character in the pattern alphabet, or 0 for
+// characters that appear in no pattern), which keeps the transition table
+// at states x classes instead of states x 65536.
+class QMultiPatternMatcherPrivate : public QSharedData
+{
+public:
+    enum Encoding { Latin1, Utf16 };
+
+    // Teddy-style prefilter: every pattern is assigned to one of eight
+    // buckets, and for each of the first fingerprintLength characters two
+    // 16-byte tables map the low and the high nibble of a byte to the set
+    // of buckets that may contain it. A position is a candidate only if
+    // AND-ing the four (or two) lookups leaves a bucket bit set.
+    struct Prefilter
+    {
+        alignas(16) uchar low[2][16];
+        alignas(16) uchar high[2][16];
+        int fingerprintLength = 0;  // 0 disables the prefilter
+    };
+
+    QMultiPatternMatcherPrivate(const QList<QString> &patterns, Encoding encoding,
+                                Qt::CaseSensitivity cs);
+
+    // as given, before case folding
+    const QList<QString> patterns;
+
+    template <typename Char, typename Match>
+    Match indexIn(const Char *data, qsizetype length, qsizetype from) const;
+    template <typename Char, typename Match>
+    QList<Match> indexesIn(const Char *data, qsizetype length, qsizetype from) const;
+
+private:
+    char16_t fold(char16_t c) const noexcept;
+    void buildClasses(const QList<QString> &patterns);
+    void buildAutomaton(const QList<QString> &patterns);
+    void buildPrefilter(const QList<QString> &patterns);
+
+    uint classOf(uchar c) const noexcept { return latin1Classes[c]; }
+    uint classOf(char16_t c) const noexcept
+    {
+        if (c < 256)
+            return latin1Classes[c];
+        return otherClassOf(c);
+    }
+    uint otherClassOf(char16_t c) const noexcept;
+
+    template <typename Char>
+    qsizetype skipToCandidate(const Char *data, qsizetype from, qsizetype length) const noexcept;
+
+    Encoding encoding;
+    Qt::CaseSensitivity cs;
+    qsizetype classCount = 1;
+
+    // class of every Latin-1 character, after case folding
+    uint latin1Classes[256] = {};
+    // sorted (character, class) pairs for UTF-16 code units above U+00FF
+    QList<std::pair<char16_t, uint>> otherClasses;
+
+    // complete DFA, states x classCount; state 0 is the root
+    QList<qint32> transitions;
+    // length of the pattern prefix each state represents
+    QList<qint32> depth;
+    // index of the pattern ending exactly at each state, or -1
+    QList<qint32> output;
+    // nearest proper suffix state that has an output, or 0 for none
+    QList<qint32> outputLink;
+
+    Prefilter prefilter = {};
+};
+
+QT_END_NAMESPACE
+
+#endif // QMULTIPATTERNMATCHER_P_H
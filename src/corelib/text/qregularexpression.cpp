@@ -41,6 +41,7 @@
 
 #include "qregularexpression.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
@@ -50,6 +51,12 @@
 #include <QtCore/qglobal.h>
 #include <QtCore/qatomic.h>
 #include <QtCore/qdatastream.h>
+#include <QtCore/qscopeguard.h>
+
+#if QT_CONFIG(thread)
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
+#endif
 
 #if defined(Q_OS_MACOS)
 #include <QtCore/private/qcore_mac_p.h>
@@ -59,6 +66,8 @@
 
 #include <pcre2.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -422,6 +431,20 @@ using namespace Qt::StringLiterals;
     text) would have been \c{"abcabc"}; by matching only against the leading
     \c{"abc"} we instead get a partial match.
 
+    QRegularExpressionStreamMatcher implements incremental matching on top of
+    the PartialPreferFirstMatch match type: it keeps the part of the text
+    that might still match, and reports the complete matches as the chunks
+    are fed to it.
+
+    \section1 Matching Large Texts
+
+    The globalMatchParallel() function finds the same matches as
+    globalMatch(), but distributes the work among the threads of a
+    QThreadPool. It is useful on subjects of several megabytes, such as
+    entire log files, where matching is the bottleneck. Anchored matches
+    (AnchorAtOffsetMatchOption) cannot be split and are always found in the
+    calling thread.
+
     \section1 Error Handling
 
     It is possible for a QRegularExpression object to be invalid because of
@@ -745,7 +768,8 @@ struct QRegularExpressionPrivate : QSharedData
     void cleanCompiledPattern();
     void compilePattern();
     void getPatternInfo();
-    void optimizePattern();
+    static void optimizePattern(pcre2_code_16 *code);
+    pcre2_code_16 *compileOffsetLimitedPattern() const;
 
     enum CheckSubjectStringOption {
         CheckSubjectString,
@@ -755,7 +779,9 @@ struct QRegularExpressionPrivate : QSharedData
     void doMatch(QRegularExpressionMatchPrivate *priv,
                  qsizetype offset,
                  CheckSubjectStringOption checkSubjectStringOption = CheckSubjectString,
-                 const QRegularExpressionMatchPrivate *previous = nullptr) const;
+                 const QRegularExpressionMatchPrivate *previous = nullptr,
+                 const pcre2_code_16 *offsetLimitedPattern = nullptr,
+                 qsizetype offsetLimit = -1) const;
 
     int captureIndexForName(QStringView name) const;
 
@@ -768,9 +794,11 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The PCRE code is shared with the compiled pattern cache and with other
+    // QRegularExpressionPrivate objects for the same pattern; compiledCode
+    // owns a reference, and compiledPattern points to the code. When the
+    // private is copied (i.e. a detach happened) both are reset
+    std::shared_ptr<pcre2_code_16> compiledCode;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     qsizetype errorOffset;
@@ -806,6 +834,10 @@ struct QRegularExpressionMatchPrivate : QSharedData
 
     int capturedCount = 0;
 
+    // the offset of the subject inside the string the captured offsets refer
+    // to; only non-zero for matches reported by QRegularExpressionStreamMatcher
+    qsizetype subjectOffset = 0;
+
     bool hasMatch = false;
     bool hasPartialMatch = false;
     bool isValid = false;
@@ -825,6 +857,61 @@ struct QRegularExpressionMatchIteratorPrivate : QSharedData
     const QRegularExpression::MatchOptions matchOptions;
 };
 
+namespace {
+struct QRegularExpressionCacheKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions patternOptions;
+
+    friend bool operator==(const QRegularExpressionCacheKey &lhs,
+                           const QRegularExpressionCacheKey &rhs) noexcept
+    {
+        return lhs.patternOptions == rhs.patternOptions && lhs.pattern == rhs.pattern;
+    }
+};
+
+size_t qHash(const QRegularExpressionCacheKey &key, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, key.pattern, key.patternOptions);
+}
+
+// The process-wide cache of compiled patterns, see QRegularExpressionCache
+struct QRegularExpressionCacheData
+{
+    // QCache wants to own heap allocated objects
+    struct Entry
+    {
+        std::shared_ptr<pcre2_code_16> code;
+    };
+
+    static constexpr qsizetype DefaultCapacity = 256;
+
+    std::shared_ptr<pcre2_code_16> find(const QRegularExpressionCacheKey &key)
+    {
+        const QMutexLocker lock(&mutex);
+        if (Entry *entry = cache.object(key)) {
+            ++hits;
+            return entry->code;
+        }
+        ++misses;
+        return nullptr;
+    }
+
+    void insert(const QRegularExpressionCacheKey &key, std::shared_ptr<pcre2_code_16> code)
+    {
+        const QMutexLocker lock(&mutex);
+        cache.insert(key, new Entry{ std::move(code) });
+    }
+
+    QMutex mutex;
+    QCache<QRegularExpressionCacheKey, Entry> cache{DefaultCapacity};
+    quint64 hits = 0;
+    quint64 misses = 0;
+};
+}
+
+Q_GLOBAL_STATIC(QRegularExpressionCacheData, regularExpressionCache)
+
 /*!
     \internal
 
@@ -904,7 +991,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    compiledCode.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -925,26 +1012,38 @@ void QRegularExpressionPrivate::compilePattern()
     isDirty = false;
     cleanCompiledPattern();
 
-    int options = convertToPcreOptions(patternOptions);
-    options |= PCRE2_UTF;
+    const QRegularExpressionCacheKey key{ pattern, patternOptions };
+    QRegularExpressionCacheData *cache = regularExpressionCache();
+    if (cache)
+        compiledCode = cache->find(key);
+
+    if (!compiledCode) {
+        int options = convertToPcreOptions(patternOptions);
+        options |= PCRE2_UTF;
+
+        PCRE2_SIZE patternErrorOffset;
+        pcre2_code_16 *code = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
+                                               pattern.length(),
+                                               options,
+                                               &errorCode,
+                                               &patternErrorOffset,
+                                               nullptr);
+
+        if (!code) {
+            errorOffset = qsizetype(patternErrorOffset);
+            return;
+        } else {
+            // ignore whatever PCRE2 wrote into errorCode -- leave it to 0 to mean "no error"
+            errorCode = 0;
+        }
 
-    PCRE2_SIZE patternErrorOffset;
-    compiledPattern = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
-                                       pattern.length(),
-                                       options,
-                                       &errorCode,
-                                       &patternErrorOffset,
-                                       nullptr);
-
-    if (!compiledPattern) {
-        errorOffset = qsizetype(patternErrorOffset);
-        return;
-    } else {
-        // ignore whatever PCRE2 wrote into errorCode -- leave it to 0 to mean "no error"
-        errorCode = 0;
+        optimizePattern(code);
+        compiledCode.reset(code, pcre2_code_free_16);
+        if (cache)
+            cache->insert(key, compiledCode);
     }
 
-    optimizePattern();
+    compiledPattern = compiledCode.get();
     getPatternInfo();
 }
 
@@ -1026,21 +1125,55 @@ static bool isJitEnabled()
     \internal
 
     The purpose of the function is to call pcre2_jit_compile_16, which
-    JIT-compiles the pattern.
+    JIT-compiles the pattern \a code.
 
     It gets called when a pattern is recompiled by us (in compilePattern()),
-    under mutex protection.
+    under mutex protection, and when compiled patterns are loaded into the
+    cache (in QRegularExpressionCache::deserialize()), before they are shared.
 */
-void QRegularExpressionPrivate::optimizePattern()
+void QRegularExpressionPrivate::optimizePattern(pcre2_code_16 *code)
 {
-    Q_ASSERT(compiledPattern);
+    Q_ASSERT(code);
 
     static const bool enableJit = isJitEnabled();
 
     if (!enableJit)
         return;
 
-    pcre2_jit_compile_16(compiledPattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+    pcre2_jit_compile_16(code, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+}
+
+/*!
+    \internal
+
+    Compiles a separate copy of the pattern that accepts an offset limit,
+    that is, a position after which no match may start (see doMatch()).
+    The caller owns the returned code. Returns nullptr if the pattern
+    does not compile.
+
+    The offset limit must be requested at compile time, and it disables
+    some of PCRE's start-of-match optimizations; therefore the regular
+    compiled pattern does not use it.
+*/
+pcre2_code_16 *QRegularExpressionPrivate::compileOffsetLimitedPattern() const
+{
+    int options = convertToPcreOptions(patternOptions);
+    options |= PCRE2_UTF | PCRE2_USE_OFFSET_LIMIT;
+
+    int patternErrorCode;
+    PCRE2_SIZE patternErrorOffset;
+    pcre2_code_16 *code = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
+                                           pattern.length(),
+                                           options,
+                                           &patternErrorCode,
+                                           &patternErrorOffset,
+                                           nullptr);
+
+    static const bool enableJit = isJitEnabled();
+    if (code && enableJit)
+        pcre2_jit_compile_16(code, PCRE2_JIT_COMPLETE);
+
+    return code;
 }
 
 /*!
@@ -1116,7 +1249,10 @@ static int safe_pcre2_match_16(const pcre2_code_16 *code,
     the substring.
 
     It also advances a match if a previous result is given as \a
-    previous. The subject string goes a Unicode validity check if
+    previous. If \a offsetLimitedPattern is given (see
+    compileOffsetLimitedPattern()), it is used instead of the compiled
+    pattern, and a non-negative \a offsetLimit is the last position where a
+    match may start. The subject string goes a Unicode validity check if
     \a checkSubjectString is CheckSubjectString and the match options don't
     include DontCheckSubjectStringMatchOption (PCRE doesn't like illegal
     UTF-16 sequences).
@@ -1137,7 +1273,9 @@ static int safe_pcre2_match_16(const pcre2_code_16 *code,
 void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
                                         qsizetype offset,
                                         CheckSubjectStringOption checkSubjectStringOption,
-                                        const QRegularExpressionMatchPrivate *previous) const
+                                        const QRegularExpressionMatchPrivate *previous,
+                                        const pcre2_code_16 *offsetLimitedPattern,
+                                        qsizetype offsetLimit) const
 {
     Q_ASSERT(priv);
     Q_ASSUME(priv != previous);
@@ -1177,9 +1315,13 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
         previousMatchWasEmpty = true;
     }
 
+    const pcre2_code_16 *code = offsetLimitedPattern ? offsetLimitedPattern : compiledPattern;
+
     pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(nullptr);
     pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
-    pcre2_match_data_16 *matchData = pcre2_match_data_create_from_pattern_16(compiledPattern, nullptr);
+    if (offsetLimitedPattern && offsetLimit >= 0)
+        pcre2_set_offset_limit_16(matchContext, PCRE2_SIZE(offsetLimit));
+    pcre2_match_data_16 *matchData = pcre2_match_data_create_from_pattern_16(code, nullptr);
 
     // PCRE does not accept a null pointer as subject string, even if
     // its length is zero. We however allow it in input: a QStringView
@@ -1198,12 +1340,12 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
     int result;
 
     if (!previousMatchWasEmpty) {
-        result = safe_pcre2_match_16(compiledPattern,
+        result = safe_pcre2_match_16(code,
                                      reinterpret_cast<PCRE2_SPTR16>(subjectUtf16), subjectLength,
                                      offset, pcreOptions,
                                      matchData, matchContext);
     } else {
-        result = safe_pcre2_match_16(compiledPattern,
+        result = safe_pcre2_match_16(code,
                                      reinterpret_cast<PCRE2_SPTR16>(subjectUtf16), subjectLength,
                                      offset, pcreOptions | PCRE2_NOTEMPTY_ATSTART | PCRE2_ANCHORED,
                                      matchData, matchContext);
@@ -1221,7 +1363,7 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
                 ++offset;
             }
 
-            result = safe_pcre2_match_16(compiledPattern,
+            result = safe_pcre2_match_16(code,
                                          reinterpret_cast<PCRE2_SPTR16>(subjectUtf16), subjectLength,
                                          offset, pcreOptions,
                                          matchData, matchContext);
@@ -1739,11 +1881,172 @@ QRegularExpressionMatchIterator QRegularExpression::globalMatch(QStringView subj
     return QRegularExpressionMatchIterator(*priv);
 }
 
+/*!
+    \since 6.4
+
+    Finds all the matches of the regular expression in \a subject, like
+    globalMatch() does, honoring the given \a matchOptions; the matching is
+    distributed among the threads of \a pool. If \a pool is \nullptr, the
+    global thread pool is used.
+
+    The subject is split into ranges at line boundaries, and a task looks
+    for the matches starting in each range. The results are merged so that
+    the returned list contains the same matches, in the same order, as a
+    global match over the whole \a subject would produce; in particular,
+    matches are allowed to span more than one range.
+
+    Subjects too short to benefit from splitting are matched in the calling
+    thread, and so are all subjects if \a matchOptions contains
+    AnchorAtOffsetMatchOption: every match then has to start where the
+    previous one ended, which cannot be split. The calling thread also takes
+    part in the matching and blocks until it is complete.
+
+    \sa globalMatch(), QRegularExpressionStreamMatcher
+*/
+QList<QRegularExpressionMatch> QRegularExpression::globalMatchParallel(const QString &subject,
+                                                                      MatchOptions matchOptions,
+                                                                      QThreadPool *pool) const
+{
+    QList<QRegularExpressionMatch> matches;
+
+    d.data()->compilePattern();
+    if (Q_UNLIKELY(!d->compiledPattern)) {
+        qtWarnAboutInvalidRegularExpression(d->pattern, "QRegularExpression::globalMatchParallel");
+        return matches;
+    }
+
+#if QT_CONFIG(thread)
+    // Splitting has a cost of its own, so keep the ranges reasonably long
+    constexpr qsizetype MinimumRangeLength = 64 * 1024;
+
+    if (!pool)
+        pool = QThreadPool::globalInstance();
+
+    const qsizetype rangeCount = qMin(qsizetype(pool->maxThreadCount()) + 1,
+                                      subject.size() / MinimumRangeLength);
+
+    // the match with the offset limited pattern works on the already checked subject
+    const bool subjectIsValid = (matchOptions & DontCheckSubjectStringMatchOption)
+            || subject.isValidUtf16();
+
+    // with an anchored match, each match has to start where the previous
+    // one ended, so the ranges cannot be matched independently
+    const bool anchored = matchOptions.testFlag(AnchorAtOffsetMatchOption);
+
+    pcre2_code_16 *offsetLimitedPattern = nullptr;
+    if (rangeCount > 1 && subjectIsValid && !anchored)
+        offsetLimitedPattern = d->compileOffsetLimitedPattern();
+    const auto cleanup = qScopeGuard([offsetLimitedPattern] {
+        pcre2_code_free_16(offsetLimitedPattern);
+    });
+
+    QList<qsizetype> boundaries;
+    if (offsetLimitedPattern) {
+        boundaries.append(0);
+        const qsizetype step = subject.size() / rangeCount;
+        for (qsizetype i = 1; i < rangeCount; ++i) {
+            const qsizetype newline = subject.indexOf(u'\n', qMax(i * step, boundaries.last()));
+            if (newline < 0 || newline + 1 >= subject.size())
+                break;
+            boundaries.append(newline + 1);
+        }
+        boundaries.append(subject.size());
+    }
+
+    if (boundaries.size() > 2) {
+        // Returns the first match at or after from that starts no later than
+        // limit (or anywhere, if limit is negative)
+        const auto matchUpTo = [&](qsizetype from, qsizetype limit,
+                                   const QRegularExpressionMatch *previous) {
+            auto priv = new QRegularExpressionMatchPrivate(*this,
+                                                           subject,
+                                                           QStringView(subject),
+                                                           NormalMatch,
+                                                           matchOptions);
+            d->doMatch(priv, from, QRegularExpressionPrivate::DontCheckSubjectString,
+                       previous ? previous->d.constData() : nullptr,
+                       offsetLimitedPattern, limit);
+            return QRegularExpressionMatch(*priv);
+        };
+        const auto limitOfRange = [&](qsizetype range) {
+            return range + 2 < boundaries.size() ? boundaries.at(range + 1) - 1 : -1;
+        };
+
+        const qsizetype ranges = boundaries.size() - 1;
+        QList<QList<QRegularExpressionMatch>> rangeMatches(ranges);
+        QList<QRegularExpressionMatch> *const results = rangeMatches.data();
+        const auto matchRange = [&](qsizetype range) {
+            const qsizetype limit = limitOfRange(range);
+            QList<QRegularExpressionMatch> &found = results[range];
+            QRegularExpressionMatch match = matchUpTo(boundaries.at(range), limit, nullptr);
+            while (match.hasMatch()) {
+                found.append(match);
+                match = matchUpTo(match.capturedEnd(), limit, &found.constLast());
+            }
+        };
+
+        QSemaphore finished;
+        int started = 0;
+        for (qsizetype range = 1; range < ranges; ++range) {
+            const auto task = [&, range] {
+                matchRange(range);
+                finished.release();
+            };
+            if (pool->tryStart(task))
+                ++started;
+            else
+                matchRange(range);
+        }
+        matchRange(0);
+        finished.acquire(started);
+
+        // Each range was matched as if no match started before it. That is
+        // what a sequential global match does, unless a match of an earlier
+        // range extends into it; then resume sequentially after that match,
+        // until a match coincides with one found for the range.
+        for (qsizetype range = 0; range < ranges; ++range) {
+            const QList<QRegularExpressionMatch> &found = rangeMatches.at(range);
+            if (matches.isEmpty() || matches.constLast().capturedEnd() <= boundaries.at(range)) {
+                matches.append(found);
+                continue;
+            }
+
+            const qsizetype limit = limitOfRange(range);
+            auto it = found.cbegin();
+            QRegularExpressionMatch match = matchUpTo(matches.constLast().capturedEnd(), limit,
+                                                      &matches.constLast());
+            while (match.hasMatch()) {
+                const qsizetype start = match.capturedStart();
+                while (it != found.cend() && it->capturedStart() < start)
+                    ++it;
+                if (it != found.cend() && it->capturedStart() == start
+                        && it->capturedEnd() == match.capturedEnd()) {
+                    for (; it != found.cend(); ++it)
+                        matches.append(*it);
+                    break;
+                }
+                matches.append(match);
+                match = matchUpTo(match.capturedEnd(), limit, &matches.constLast());
+            }
+        }
+        return matches;
+    }
+#else
+    Q_UNUSED(pool);
+#endif // QT_CONFIG(thread)
+
+    for (const QRegularExpressionMatch &match : globalMatch(subject, 0, NormalMatch, matchOptions))
+        matches.append(match);
+    return matches;
+}
+
 /*!
     \since 5.4
 
     Compiles the pattern immediately, including JIT compiling it (if
-    the JIT is enabled) for optimization.
+    the JIT is enabled) for optimization. If the same pattern with the same
+    pattern options has been compiled before, the compiled code is taken
+    from QRegularExpressionCache instead.
 
     \sa isValid(), {Debugging Code that Uses QRegularExpression}
 */
@@ -2299,7 +2602,7 @@ QStringView QRegularExpressionMatch::capturedView(int nth) const
     if (start == -1) // didn't capture
         return QStringView();
 
-    return d->subject.mid(start, capturedLength(nth));
+    return d->subject.mid(start - d->subjectOffset, capturedLength(nth));
 }
 
 #if QT_STRINGVIEW_LEVEL < 2
@@ -2751,6 +3054,580 @@ QtPrivate::QRegularExpressionMatchIteratorRangeBasedForIterator begin(const QReg
   \internal
 */
 
+/*!
+    \class QRegularExpressionStreamMatcher
+    \inmodule QtCore
+    \reentrant
+    \since 6.4
+
+    \brief The QRegularExpressionStreamMatcher class finds the matches of a
+    regular expression in a text that is available in successive chunks.
+
+    \ingroup tools
+
+    \keyword regular expression stream matcher
+
+    A QRegularExpressionStreamMatcher performs a global match of a
+    QRegularExpression over a text that is too large to be held in memory at
+    once, such as a log file read in blocks. The text is passed to feed()
+    one chunk at a time, and finish() is called after the last chunk. Each
+    call returns the matches that have been completed by then:
+
+    \snippet code/src_corelib_text_qregularexpression.cpp 37
+
+    The matches are the same as the ones globalMatch() would find on the
+    concatenation of all the chunks, regardless of how the text is split;
+    in particular, a match can span several chunks. The offsets reported by
+    the returned QRegularExpressionMatch objects, such as
+    QRegularExpressionMatch::capturedStart(), are relative to the start of
+    the whole text.
+
+    The matcher uses \l{Incremental/multi-segment matching}{partial matching}
+    to tell when a match might continue in the next chunk. Only the text
+    that can still take part in a match, plus the few characters that
+    lookbehind assertions in the pattern may need, is kept between calls.
+    Patterns that can match an unbounded amount of text, such as
+    \c{"a.*z"} with QRegularExpression::DotMatchesEverythingOption, may
+    therefore need to keep a large part of the stream.
+
+    \sa QRegularExpression::globalMatchParallel(), QRegularExpressionMatch
+*/
+
+struct QRegularExpressionStreamMatcherPrivate
+{
+    QRegularExpressionStreamMatcherPrivate(const QRegularExpression &re,
+                                           QRegularExpression::MatchOptions matchOptions);
+
+    void scan(QList<QRegularExpressionMatch> *matches, QRegularExpression::MatchType matchType);
+    QRegularExpressionMatch streamMatch(const QRegularExpressionMatchPrivate &match) const;
+    void clear();
+
+    const QRegularExpression regularExpression;
+    const QRegularExpression::MatchOptions matchOptions;
+
+    // The retained part of the stream: window starts at position
+    // windowStart, and the next match is searched from searchFrom on.
+    QString window;
+    qsizetype windowStart = 0;
+    qsizetype searchFrom = 0;
+
+    // the number of characters before searchFrom kept for lookbehinds
+    qsizetype context = 1;
+
+    // a high surrogate ending a chunk waits for the low surrogate
+    char16_t pendingHighSurrogate = 0;
+
+    bool previousMatchWasEmpty = false;
+    bool windowIsValidUtf16 = true;
+};
+
+/*!
+    \internal
+*/
+QRegularExpressionStreamMatcherPrivate::QRegularExpressionStreamMatcherPrivate(const QRegularExpression &re,
+                                                                               QRegularExpression::MatchOptions matchOptions)
+    : regularExpression(re),
+      matchOptions(matchOptions & ~QRegularExpression::AnchorAtOffsetMatchOption)
+{
+    regularExpression.d.data()->compilePattern();
+    if (const pcre2_code_16 *code = regularExpression.d->compiledPattern) {
+        unsigned int maximumLookBehind;
+        pcre2_pattern_info_16(code, PCRE2_INFO_MAXLOOKBEHIND, &maximumLookBehind);
+        context = qMax(context, qsizetype(maximumLookBehind));
+    }
+}
+
+/*!
+    \internal
+
+    Finds the matches in the window, starting at searchFrom, and appends
+    them to \a matches. With the PartialPreferFirstMatch \a matchType, a
+    match that may continue past the end of the window stops the search, and
+    the window is trimmed so that it starts shortly before where the search
+    must resume.
+*/
+void QRegularExpressionStreamMatcherPrivate::scan(QList<QRegularExpressionMatch> *matches,
+                                                  QRegularExpression::MatchType matchType)
+{
+    const auto checkSubjectString = windowIsValidUtf16
+            ? QRegularExpressionPrivate::DontCheckSubjectString
+            : QRegularExpressionPrivate::CheckSubjectString;
+
+    QRegularExpressionMatchPrivate previous(regularExpression, QString(), QStringView(),
+                                            QRegularExpression::NormalMatch, matchOptions);
+    previous.hasMatch = true;
+    previous.capturedOffsets.resize(2);
+
+    forever {
+        const qsizetype offset = searchFrom - windowStart;
+        previous.capturedOffsets[0] = previous.capturedOffsets[1] = offset;
+
+        QRegularExpressionMatchPrivate current(regularExpression, window, QStringView(window),
+                                               matchType, matchOptions);
+        regularExpression.d->doMatch(&current, offset, checkSubjectString,
+                                     previousMatchWasEmpty ? &previous : nullptr);
+
+        if (current.hasMatch) {
+            matches->append(streamMatch(current));
+            previousMatchWasEmpty = current.capturedOffsets.at(0) == current.capturedOffsets.at(1);
+            searchFrom = windowStart + current.capturedOffsets.at(1);
+            continue;
+        }
+
+        if (current.hasPartialMatch) {
+            // the reported start already accounts for lookbehinds
+            const qsizetype partialStart = windowStart + qMax(current.capturedOffsets.at(0), qsizetype(0));
+            if (partialStart > searchFrom) {
+                searchFrom = partialStart;
+                previousMatchWasEmpty = false;
+            }
+        } else if (current.isValid) {
+            // nothing can match before the end of the window, no matter what follows
+            searchFrom = windowStart + window.size();
+            previousMatchWasEmpty = false;
+        }
+        break;
+    }
+
+    const qsizetype keepFrom = qMax(windowStart, searchFrom - context);
+    window.remove(0, keepFrom - windowStart);
+    windowStart = keepFrom;
+}
+
+/*!
+    \internal
+
+    Returns a match object for \a match, whose offsets are relative to the
+    window, that holds on to just the part of the window it refers to and
+    reports offsets relative to the start of the stream.
+*/
+QRegularExpressionMatch QRegularExpressionStreamMatcherPrivate::streamMatch(const QRegularExpressionMatchPrivate &match) const
+{
+    qsizetype from = window.size();
+    qsizetype to = 0;
+    for (int i = 0; i < match.capturedCount; ++i) {
+        if (match.capturedOffsets.at(i * 2) == -1)
+            continue;
+        from = qMin(from, match.capturedOffsets.at(i * 2));
+        to = qMax(to, match.capturedOffsets.at(i * 2 + 1));
+    }
+
+    const QString subject = window.mid(from, to - from);
+    auto priv = new QRegularExpressionMatchPrivate(regularExpression,
+                                                   subject,
+                                                   QStringView(subject),
+                                                   QRegularExpression::NormalMatch,
+                                                   matchOptions);
+    priv->subjectOffset = windowStart + from;
+    priv->capturedOffsets = match.capturedOffsets;
+    for (qsizetype &offset : priv->capturedOffsets) {
+        if (offset != -1)
+            offset += windowStart;
+    }
+    priv->capturedCount = match.capturedCount;
+    priv->hasMatch = true;
+    priv->isValid = true;
+    return QRegularExpressionMatch(*priv);
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionStreamMatcherPrivate::clear()
+{
+    window.clear();
+    windowStart = 0;
+    searchFrom = 0;
+    pendingHighSurrogate = 0;
+    previousMatchWasEmpty = false;
+    windowIsValidUtf16 = true;
+}
+
+/*!
+    Constructs a matcher that finds the matches of \a re, honoring the given
+    \a matchOptions. QRegularExpression::AnchorAtOffsetMatchOption is not
+    supported and is ignored.
+*/
+QRegularExpressionStreamMatcher::QRegularExpressionStreamMatcher(const QRegularExpression &re,
+                                                                 QRegularExpression::MatchOptions matchOptions)
+    : d(new QRegularExpressionStreamMatcherPrivate(re, matchOptions))
+{
+}
+
+/*!
+    Destroys the matcher. Any text fed but not yet matched is discarded.
+*/
+QRegularExpressionStreamMatcher::~QRegularExpressionStreamMatcher()
+{
+    delete d;
+}
+
+/*!
+    Returns the regular expression this matcher looks for.
+*/
+QRegularExpression QRegularExpressionStreamMatcher::regularExpression() const
+{
+    return d->regularExpression;
+}
+
+/*!
+    Returns the match options used by this matcher.
+*/
+QRegularExpression::MatchOptions QRegularExpressionStreamMatcher::matchOptions() const
+{
+    return d->matchOptions;
+}
+
+/*!
+    Returns the number of UTF-16 code units fed to the matcher since it was
+    constructed or last reset.
+
+    \sa feed(), reset()
+*/
+qsizetype QRegularExpressionStreamMatcher::position() const
+{
+    return d->windowStart + d->window.size() + (d->pendingHighSurrogate ? 1 : 0);
+}
+
+/*!
+    Appends \a chunk to the text being matched, and returns the matches
+    that are complete at this point, in order. Matches that could still
+    continue in the following chunks are reported by later calls to feed()
+    or finish().
+
+    Unless the matcher was constructed with
+    QRegularExpression::DontCheckSubjectStringMatchOption, the text is checked
+    to be valid UTF-16; no matches are found past an invalid sequence until
+    reset() is called. A chunk can end in the middle of a surrogate pair.
+
+    \sa finish()
+*/
+QList<QRegularExpressionMatch> QRegularExpressionStreamMatcher::feed(QStringView chunk)
+{
+    QList<QRegularExpressionMatch> matches;
+
+    if (Q_UNLIKELY(!d->regularExpression.isValid())) {
+        qtWarnAboutInvalidRegularExpression(d->regularExpression.pattern(),
+                                            "QRegularExpressionStreamMatcher::feed");
+        return matches;
+    }
+
+    if (chunk.isEmpty())
+        return matches;
+
+    const qsizetype appendedFrom = d->window.size();
+    if (d->pendingHighSurrogate) {
+        d->window.append(QChar(d->pendingHighSurrogate));
+        d->pendingHighSurrogate = 0;
+    }
+    if (QChar::isHighSurrogate(chunk.back().unicode())) {
+        d->pendingHighSurrogate = chunk.back().unicode();
+        chunk.chop(1);
+    }
+    d->window.append(chunk);
+
+    if (d->windowIsValidUtf16 && !(d->matchOptions & QRegularExpression::DontCheckSubjectStringMatchOption))
+        d->windowIsValidUtf16 = QStringView(d->window).sliced(appendedFrom).isValidUtf16();
+
+    d->scan(&matches, QRegularExpression::PartialPreferFirstMatch);
+    return matches;
+}
+
+/*!
+    Signals the end of the text, and returns the remaining matches, in
+    order. The matcher is then reset, and can be used for a new text.
+
+    \sa feed(), reset()
+*/
+QList<QRegularExpressionMatch> QRegularExpressionStreamMatcher::finish()
+{
+    QList<QRegularExpressionMatch> matches;
+
+    if (Q_UNLIKELY(!d->regularExpression.isValid())) {
+        qtWarnAboutInvalidRegularExpression(d->regularExpression.pattern(),
+                                            "QRegularExpressionStreamMatcher::finish");
+        return matches;
+    }
+
+    if (d->pendingHighSurrogate) {
+        // a lone high surrogate
+        d->window.append(QChar(d->pendingHighSurrogate));
+        if (!(d->matchOptions & QRegularExpression::DontCheckSubjectStringMatchOption))
+            d->windowIsValidUtf16 = false;
+    }
+
+    d->scan(&matches, QRegularExpression::NormalMatch);
+    d->clear();
+    return matches;
+}
+
+/*!
+    Discards any text fed to the matcher, so that it can be used for a new
+    text.
+
+    \sa finish()
+*/
+void QRegularExpressionStreamMatcher::reset()
+{
+    d->clear();
+}
+
+/*!
+    \class QRegularExpressionCache
+    \inmodule QtCore
+    \threadsafe
+    \since 6.4
+
+    \brief The QRegularExpressionCache class controls the process-wide cache
+    of compiled regular expression patterns.
+
+    \ingroup tools
+
+    \keyword regular expression cache
+
+    A QRegularExpression compiles its pattern the first time it is needed,
+    for instance when match() is called. The compiled patterns are kept in
+    a cache shared by the whole process, keyed by the pattern string and the
+    pattern options. A QRegularExpression constructed with a pattern and
+    options that were compiled before reuses the compiled code, including
+    the JIT-compiled code, instead of compiling the pattern again. This
+    makes it cheap to create the same regular expression many times, for
+    instance in validators or filters.
+
+    The cache holds up to capacity() patterns; when it is full, the least
+    recently used patterns are discarded. Discarding a pattern from the
+    cache does not affect the QRegularExpression objects using it. Patterns
+    that fail to compile are not cached.
+
+    The hitCount() and missCount() functions report how often compiling a
+    pattern could use the cache.
+
+    \section1 Precompiled patterns
+
+    Compiling many patterns at application startup can be avoided by
+    serializing them with serialize() and loading the result at startup
+    with deserialize(), for instance from a file embedded with the
+    \l{The Qt Resource System}{Qt Resource System}:
+
+    \snippet code/src_corelib_text_qregularexpression.cpp 38
+
+    The serialized data contains the compiled patterns in the format of the
+    PCRE2 library; it can only be loaded by a Qt build that uses the same
+    PCRE2 version, on the same architecture. JIT compilation, when enabled,
+    is performed again on loading. The data is not validated beyond a
+    version check, so only load data from a trusted source.
+
+    \sa QRegularExpression
+*/
+
+/*!
+    \fn QRegularExpressionCache::QRegularExpressionCache()
+    \internal
+*/
+
+/*!
+    Returns the maximum number of compiled patterns held by the cache. The
+    default is 256.
+
+    \sa setCapacity(), size()
+*/
+qsizetype QRegularExpressionCache::capacity()
+{
+    QRegularExpressionCacheData *cache = regularExpressionCache();
+    if (!cache)
+        return 0;
+    const QMutexLocker lock(&cache->mutex);
+    return cache->cache.maxCost();
+}
+
+/*!
+    Sets the maximum number of compiled patterns held by the cache to \a
+    capacity, discarding the least recently used patterns if the cache
+    holds more. A capacity of 0 disables the cache.
+
+    \sa capacity()
+*/
+void QRegularExpressionCache::setCapacity(qsizetype capacity)
+{
+    QRegularExpressionCacheData *cache = regularExpressionCache();
+    if (!cache)
+        return;
+    const QMutexLocker lock(&cache->mutex);
+    cache->cache.setMaxCost(qMax(capacity, qsizetype(0)));
+}
+
+/*!
+    Returns the number of compiled patterns currently held by the cache.
+
+    \sa capacity(), clear()
+*/
+qsizetype QRegularExpressionCache::size()
+{
+    QRegularExpressionCacheData *cache = regularExpressionCache();
+    if (!cache)
+        return 0;
+    const QMutexLocker lock(&cache->mutex);
+    return cache->cache.size();
+}
+
+/*!
+    Discards all the compiled patterns held by the cache. Existing
+    QRegularExpression objects keep their compiled patterns.
+
+    \sa size()
+*/
+void QRegularExpressionCache::clear()
+{
+    QRegularExpressionCacheData *cache = regularExpressionCache();
+    if (!cache)
+        return;
+    const QMutexLocker lock(&cache->mutex);
+    cache->cache.clear();
+}
+
+/*!
+    Returns how many times a QRegularExpression found its compiled pattern
+    in the cache since the start of the process or the last call to
+    resetStatistics().
+
+    \sa missCount()
+*/
+quint64 QRegularExpressionCache::hitCount()
+{
+    QRegularExpressionCacheData *cache = regularExpressionCache();
+    if (!cache)
+        return 0;
+    const QMutexLocker lock(&cache->mutex);
+    return cache->hits;
+}
+
+/*!
+    Returns how many times a QRegularExpression had to compile its pattern
+    since the start of the process or the last call to resetStatistics().
+
+    \sa hitCount()
+*/
+quint64 QRegularExpressionCache::missCount()
+{
+    QRegularExpressionCacheData *cache = regularExpressionCache();
+    if (!cache)
+        return 0;
+    const QMutexLocker lock(&cache->mutex);
+    return cache->misses;
+}
+
+/*!
+    Resets the counters returned by hitCount() and missCount() to zero.
+*/
+void QRegularExpressionCache::resetStatistics()
+{
+    QRegularExpressionCacheData *cache = regularExpressionCache();
+    if (!cache)
+        return;
+    const QMutexLocker lock(&cache->mutex);
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+#ifndef QT_NO_DATASTREAM
+// "QREC", followed by the version of the format
+static constexpr quint32 SerializedPatternsMagic = 0x51524543;
+static constexpr quint32 SerializedPatternsVersion = 1;
+
+/*!
+    Compiles the patterns of \a expressions, if they have not been compiled
+    yet, and returns them in a serialized form that deserialize() can load
+    into the cache of another run of the application. Invalid regular
+    expressions are skipped.
+
+    \sa deserialize()
+*/
+QByteArray QRegularExpressionCache::serialize(const QList<QRegularExpression> &expressions)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+
+    QList<QRegularExpression> valid;
+    for (const QRegularExpression &re : expressions) {
+        re.d.data()->compilePattern();
+        if (re.d->compiledPattern)
+            valid.append(re);
+    }
+
+    out << SerializedPatternsMagic << SerializedPatternsVersion << quint32(valid.size());
+    for (const QRegularExpression &re : std::as_const(valid)) {
+        // One set of codes per pattern: PCRE2 can only serialize codes that
+        // share the same character tables, which deserialized codes do not
+        const pcre2_code_16 *code = re.d->compiledPattern;
+        uint8_t *bytes = nullptr;
+        PCRE2_SIZE size = 0;
+        if (pcre2_serialize_encode_16(&code, 1, &bytes, &size, nullptr) < 0)
+            return QByteArray();
+        out << re.pattern() << quint32(re.patternOptions().toInt())
+            << QByteArray(reinterpret_cast<const char *>(bytes), qsizetype(size));
+        pcre2_serialize_free_16(bytes);
+    }
+
+    return data;
+}
+
+/*!
+    Loads the compiled patterns from \a data, which must have been returned
+    by serialize(), into the cache, and returns the number of patterns
+    loaded. Returns -1 if \a data is invalid or has been produced by an
+    incompatible build of Qt; in that case, nothing is loaded.
+
+    If \a data contains more patterns than the capacity() of the cache, only
+    the last ones are kept.
+
+    \sa serialize()
+*/
+qsizetype QRegularExpressionCache::deserialize(const QByteArray &data)
+{
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic, version, count;
+    in >> magic >> version >> count;
+    if (in.status() != QDataStream::Ok || magic != SerializedPatternsMagic
+            || version != SerializedPatternsVersion) {
+        return -1;
+    }
+
+    QList<std::pair<QRegularExpressionCacheKey, std::shared_ptr<pcre2_code_16>>> patterns;
+    for (quint32 i = 0; i < count; ++i) {
+        QString pattern;
+        quint32 patternOptions;
+        QByteArray bytes;
+        in >> pattern >> patternOptions >> bytes;
+        if (in.status() != QDataStream::Ok)
+            return -1;
+
+        const auto serialized = reinterpret_cast<const uint8_t *>(bytes.constData());
+        if (bytes.size() < qsizetype(4 * sizeof(quint32))
+                || pcre2_serialize_get_number_of_codes_16(serialized) != 1) {
+            return -1;
+        }
+
+        pcre2_code_16 *code = nullptr;
+        if (pcre2_serialize_decode_16(&code, 1, serialized, nullptr) != 1)
+            return -1;
+
+        QRegularExpressionPrivate::optimizePattern(code);
+        patterns.append({ QRegularExpressionCacheKey{ pattern, QRegularExpression::PatternOptions::fromInt(patternOptions) },
+                          std::shared_ptr<pcre2_code_16>(code, pcre2_code_free_16) });
+    }
+
+    QRegularExpressionCacheData *cache = regularExpressionCache();
+    if (!cache)
+        return -1;
+    for (const auto &pattern : std::as_const(patterns))
+        cache->insert(pattern.first, pattern.second);
+    return patterns.size();
+}
+#endif // QT_NO_DATASTREAM
+
 #ifndef QT_NO_DATASTREAM
 /*!
     \relates QRegularExpression
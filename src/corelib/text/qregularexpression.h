@@ -43,6 +43,7 @@
 #define QREGULAREXPRESSION_H
 
 #include <QtCore/qglobal.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qstringview.h>
 #include <QtCore/qshareddata.h>
@@ -58,6 +59,8 @@ class QRegularExpressionMatch;
 class QRegularExpressionMatchIterator;
 struct QRegularExpressionPrivate;
 class QRegularExpression;
+struct QRegularExpressionStreamMatcherPrivate;
+class QThreadPool;
 
 QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QRegularExpressionPrivate, Q_CORE_EXPORT)
 
@@ -145,6 +148,11 @@ public:
                                                 MatchType matchType       = NormalMatch,
                                                 MatchOptions matchOptions = NoMatchOption) const;
 
+    [[nodiscard]]
+    QList<QRegularExpressionMatch> globalMatchParallel(const QString &subject,
+                                                       MatchOptions matchOptions = NoMatchOption,
+                                                       QThreadPool *pool = nullptr) const;
+
     void optimize() const;
 
     enum WildcardConversionOption {
@@ -185,6 +193,8 @@ private:
     friend class QRegularExpressionMatch;
     friend struct QRegularExpressionMatchPrivate;
     friend class QRegularExpressionMatchIterator;
+    friend struct QRegularExpressionStreamMatcherPrivate;
+    friend class QRegularExpressionCache;
     friend Q_CORE_EXPORT size_t qHash(const QRegularExpression &key, size_t seed) noexcept;
 
     QRegularExpression(QRegularExpressionPrivate &dd);
@@ -272,6 +282,7 @@ private:
     friend class QRegularExpression;
     friend struct QRegularExpressionMatchPrivate;
     friend class QRegularExpressionMatchIterator;
+    friend struct QRegularExpressionStreamMatcherPrivate;
 
     QRegularExpressionMatch(QRegularExpressionMatchPrivate &dd);
     QExplicitlySharedDataPointer<QRegularExpressionMatchPrivate> d;
@@ -411,6 +422,50 @@ private:
 
 Q_DECLARE_SHARED(QRegularExpressionMatchIterator)
 
+class Q_CORE_EXPORT QRegularExpressionStreamMatcher
+{
+public:
+    explicit QRegularExpressionStreamMatcher(const QRegularExpression &re,
+                                             QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption);
+    ~QRegularExpressionStreamMatcher();
+
+    QRegularExpression regularExpression() const;
+    QRegularExpression::MatchOptions matchOptions() const;
+
+    qsizetype position() const;
+
+    [[nodiscard]]
+    QList<QRegularExpressionMatch> feed(QStringView chunk);
+    [[nodiscard]]
+    QList<QRegularExpressionMatch> finish();
+    void reset();
+
+private:
+    Q_DISABLE_COPY(QRegularExpressionStreamMatcher)
+    QRegularExpressionStreamMatcherPrivate *d;
+};
+
+class Q_CORE_EXPORT QRegularExpressionCache
+{
+public:
+    QRegularExpressionCache() = delete;
+
+    static qsizetype capacity();
+    static void setCapacity(qsizetype capacity);
+    static qsizetype size();
+    static void clear();
+
+    static quint64 hitCount();
+    static quint64 missCount();
+    static void resetStatistics();
+
+#ifndef QT_NO_DATASTREAM
+    [[nodiscard]]
+    static QByteArray serialize(const QList<QRegularExpression> &expressions);
+    static qsizetype deserialize(const QByteArray &data);
+#endif
+};
+
 QT_END_NAMESPACE
 
 #endif // QREGULAREXPRESSION_H
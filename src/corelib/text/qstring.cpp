@@ -7501,6 +7501,23 @@ QString &QString::setNum(double n, char format, int precision)
 */
 
 
+static QLocaleData::DoubleForm doubleFormFromFormat(char format)
+{
+    switch (QtMiscUtils::toAsciiLower(format)) {
+        case 'f':
+            return QLocaleData::DFDecimal;
+        case 'e':
+            return QLocaleData::DFExponent;
+        case 'g':
+            return QLocaleData::DFSignificantDigits;
+        default:
+#if defined(QT_CHECK_RANGE)
+            qWarning("QString::setNum: Invalid format char '%c'", format);
+#endif
+            return QLocaleData::DFDecimal;
+    }
+}
+
 /*!
     \fn QString QString::number(long n, int base)
 
@@ -7598,28 +7615,112 @@ QString QString::number(qulonglong n, int base)
 */
 QString QString::number(double n, char format, int precision)
 {
-    QLocaleData::DoubleForm form = QLocaleData::DFDecimal;
+    return qdtoBasicLatin(n, doubleFormFromFormat(format), precision, qIsUpper(format));
+}
 
-    switch (QtMiscUtils::toAsciiLower(format)) {
-        case 'f':
-            form = QLocaleData::DFDecimal;
-            break;
-        case 'e':
-            form = QLocaleData::DFExponent;
-            break;
-        case 'g':
-            form = QLocaleData::DFSignificantDigits;
-            break;
-        default:
+/*!
+    \fn QString &QString::appendNumber(int n, int base)
+    \since 6.4
+
+    Appends the whole number \a n, as text in the given \a base, to this
+    string, and returns a reference to the string.
+
+    The text is the same as that of number() and setNum(), but no temporary
+    string is created for it, which saves one allocation per number when
+    many numbers are written into one string.
+
+    \sa number(), setNum(), QByteArray::appendNumber()
+*/
+
+/*!
+    \fn QString &QString::appendNumber(uint n, int base)
+    \since 6.4
+    \overload
+*/
+
+/*!
+    \fn QString &QString::appendNumber(long n, int base)
+    \since 6.4
+    \overload
+*/
+
+/*!
+    \fn QString &QString::appendNumber(ulong n, int base)
+    \since 6.4
+    \overload
+*/
+
+/*!
+    \fn QString &QString::appendNumber(short n, int base)
+    \since 6.4
+    \overload
+*/
+
+/*!
+    \fn QString &QString::appendNumber(ushort n, int base)
+    \since 6.4
+    \overload
+*/
+
+/*!
+    \since 6.4
+    \overload
+*/
+QString &QString::appendNumber(qlonglong n, int base)
+{
 #if defined(QT_CHECK_RANGE)
-            qWarning("QString::setNum: Invalid format char '%c'", format);
+    if (base < 2 || base > 36) {
+        qWarning("QString::setNum: Invalid base (%d)", base);
+        base = 10;
+    }
 #endif
-            break;
+    bool negative = n < 0;
+    qulltoBasicLatin(*this, negative ? 1u + qulonglong(-(n + 1)) : qulonglong(n), base, negative);
+    return *this;
+}
+
+/*!
+    \since 6.4
+    \overload
+*/
+QString &QString::appendNumber(qulonglong n, int base)
+{
+#if defined(QT_CHECK_RANGE)
+    if (base < 2 || base > 36) {
+        qWarning("QString::setNum: Invalid base (%d)", base);
+        base = 10;
     }
+#endif
+    qulltoBasicLatin(*this, n, base, false);
+    return *this;
+}
 
-    return qdtoBasicLatin(n, form, precision, qIsUpper(format));
+/*!
+    \since 6.4
+    \overload
+
+    Appends the floating-point number \a n, formatted according to the
+    given \a format and \a precision, to this string, and returns a
+    reference to the string.
+
+    \sa number(), setNum(), QLocale::FloatingPointPrecisionOption, {Number Formats}
+*/
+QString &QString::appendNumber(double n, char format, int precision)
+{
+    qdtoBasicLatin(*this, n, doubleFormFromFormat(format), precision, qIsUpper(format));
+    return *this;
 }
 
+/*!
+    \fn QString &QString::appendNumber(float n, char format, int precision)
+    \since 6.4
+    \overload
+
+    Appends the floating-point number \a n, formatted according to the
+    given \a format and \a precision, to this string, and returns a
+    reference to the string.
+*/
+
 namespace {
 template<class ResultList, class StringSource>
 static ResultList splitString(const StringSource &source, QStringView sep,
@@ -956,6 +956,17 @@ public:
     QString &setNum(float, char format='g', int precision=6);
     QString &setNum(double, char format='g', int precision=6);
 
+    QString &appendNumber(short, int base=10);
+    QString &appendNumber(ushort, int base=10);
+    QString &appendNumber(int, int base=10);
+    QString &appendNumber(uint, int base=10);
+    QString &appendNumber(long, int base=10);
+    QString &appendNumber(ulong, int base=10);
+    QString &appendNumber(qlonglong, int base=10);
+    QString &appendNumber(qulonglong, int base=10);
+    QString &appendNumber(float, char format='g', int precision=6);
+    QString &appendNumber(double, char format='g', int precision=6);
+
     static QString number(int, int base=10);
     static QString number(uint, int base=10);
     static QString number(long, int base=10);
@@ -1344,6 +1355,20 @@ inline QString &QString::setNum(ulong n, int base)
 { return setNum(qulonglong(n), base); }
 inline QString &QString::setNum(float n, char f, int prec)
 { return setNum(double(n),f,prec); }
+inline QString &QString::appendNumber(short n, int base)
+{ return appendNumber(qlonglong(n), base); }
+inline QString &QString::appendNumber(ushort n, int base)
+{ return appendNumber(qulonglong(n), base); }
+inline QString &QString::appendNumber(int n, int base)
+{ return appendNumber(qlonglong(n), base); }
+inline QString &QString::appendNumber(uint n, int base)
+{ return appendNumber(qulonglong(n), base); }
+inline QString &QString::appendNumber(long n, int base)
+{ return appendNumber(qlonglong(n), base); }
+inline QString &QString::appendNumber(ulong n, int base)
+{ return appendNumber(qulonglong(n), base); }
+inline QString &QString::appendNumber(float n, char f, int prec)
+{ return appendNumber(double(n),f,prec); }
 inline QString QString::arg(int a, int fieldWidth, int base, QChar fillChar) const
 { return arg(qlonglong(a), fieldWidth, base, fillChar); }
 inline QString QString::arg(uint a, int fieldWidth, int base, QChar fillChar) const
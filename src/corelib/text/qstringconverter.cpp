@@ -491,6 +491,281 @@ static void simdCompareAscii(const char8_t *&, const char8_t *, const char16_t *
 }
 #endif
 
+// Multi-byte UTF-8 transcoding. The ASCII loops above stop at the first
+// non-ASCII character; the functions below take over in text that is mostly
+// non-ASCII (e.g. Greek, Cyrillic, Arabic, CJK) and process sixteen bytes or
+// eight UTF-16 code units at a time. They only handle well-formed 1- to
+// 3-byte sequences; anything else (4-byte sequences, surrogates, invalid
+// input) stops them, so that the scalar code can deal with it and report
+// errors exactly as before.
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SSE4_1) && !defined(QT_BOOTSTRAPPED)
+namespace {
+struct Utf8ShuffleTables
+{
+    // PSHUFB masks moving the 16-bit lanes whose bit is set in the index to
+    // the front of the register
+    uchar compress16[256][16];
+
+    // PSHUFB masks packing four 32-bit lanes each holding a UTF-8 sequence
+    // of (index >> 2 * lane & 3) + 1 bytes, and the resulting sizes
+    uchar pack32[256][16];
+    uchar pack32Size[256];
+
+    constexpr Utf8ShuffleTables()
+        : compress16{}, pack32{}, pack32Size{}
+    {
+        for (int index = 0; index < 256; ++index) {
+            int n = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (index & (1 << lane)) {
+                    compress16[index][n++] = uchar(2 * lane);
+                    compress16[index][n++] = uchar(2 * lane + 1);
+                }
+            }
+            while (n < 16)
+                compress16[index][n++] = 0x80;
+
+            n = 0;
+            for (int lane = 0; lane < 4; ++lane) {
+                const int size = qMin((index >> (2 * lane) & 3) + 1, 3);
+                for (int i = 0; i < size; ++i)
+                    pack32[index][n++] = uchar(4 * lane + i);
+            }
+            pack32Size[index] = uchar(n);
+            while (n < 16)
+                pack32[index][n++] = 0x80;
+        }
+    }
+};
+constexpr Utf8ShuffleTables utf8ShuffleTables;
+
+struct Utf8Block
+{
+    __m128i v0, v1, v2;     // the bytes at offsets 0, 1 and 2 of each position
+    __m128i lead2, lead3;   // lead bytes of sequences of at least 2 and 3 bytes
+    uint continuations;     // positions of continuation bytes
+    uint bad;               // positions where the simple decoding can't proceed
+};
+} // unnamed namespace
+
+// unsigned a >= b, bytewise
+static inline QT_FUNCTION_TARGET(SSE4_1) __m128i mm_cmpge_epu8(__m128i a, __m128i b)
+{
+    return _mm_cmpeq_epi8(_mm_max_epu8(a, b), a);
+}
+
+static inline QT_FUNCTION_TARGET(SSE4_1) __m128i mm_isContinuation(__m128i v)
+{
+    return _mm_cmpeq_epi8(_mm_and_si128(v, _mm_set1_epi8(char(0xc0))), _mm_set1_epi8(char(0x80)));
+}
+
+// Classifies the sixteen bytes at src. Needs two more bytes to be readable,
+// for the sequences starting in the last two positions.
+static inline QT_FUNCTION_TARGET(SSE4_1) Utf8Block simdAnalyzeUtf8(const uchar *src)
+{
+    Utf8Block block;
+    block.v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    block.v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 1));
+    block.v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2));
+
+    const __m128i continuation = mm_isContinuation(block.v0);
+    block.lead2 = mm_cmpge_epu8(block.v0, _mm_set1_epi8(char(0xc0)));
+    block.lead3 = mm_cmpge_epu8(block.v0, _mm_set1_epi8(char(0xe0)));
+    const __m128i lead4 = mm_cmpge_epu8(block.v0, _mm_set1_epi8(char(0xf0)));
+
+    // every continuation byte must belong to the lead byte one or two positions before
+    const __m128i required = _mm_or_si128(_mm_slli_si128(block.lead2, 1),
+                                          _mm_slli_si128(block.lead3, 2));
+    __m128i bad = _mm_or_si128(lead4, _mm_xor_si128(continuation, required));
+
+    // and every lead byte needs its continuation bytes
+    bad = _mm_or_si128(bad, _mm_andnot_si128(mm_isContinuation(block.v1), block.lead2));
+    bad = _mm_or_si128(bad, _mm_andnot_si128(mm_isContinuation(block.v2), block.lead3));
+
+    // overlong sequences (C0, C1, E0 followed by less than A0) and surrogates
+    // (ED followed by A0 or more)
+    const __m128i secondAboveA0 = mm_cmpge_epu8(block.v1, _mm_set1_epi8(char(0xa0)));
+    const __m128i overlong2 = _mm_cmpeq_epi8(_mm_and_si128(block.v0, _mm_set1_epi8(char(0xfe))),
+                                             _mm_set1_epi8(char(0xc0)));
+    const __m128i overlong3 = _mm_andnot_si128(secondAboveA0,
+                                               _mm_cmpeq_epi8(block.v0, _mm_set1_epi8(char(0xe0))));
+    const __m128i surrogate = _mm_and_si128(secondAboveA0,
+                                            _mm_cmpeq_epi8(block.v0, _mm_set1_epi8(char(0xed))));
+    bad = _mm_or_si128(bad, _mm_or_si128(overlong2, _mm_or_si128(overlong3, surrogate)));
+
+    block.continuations = _mm_movemask_epi8(continuation);
+    block.bad = _mm_movemask_epi8(bad);
+    return block;
+}
+
+// Returns the number of bytes that belong to the sequences starting in the
+// first sixteen positions of the block or, if the block has errors, the
+// number of bytes before the first of them.
+static inline QT_FUNCTION_TARGET(SSE4_1) uint simdUtf8BlockSize(const Utf8Block &block)
+{
+    if (block.bad)
+        return qCountTrailingZeroBits(block.bad);
+
+    const uint lead2 = _mm_movemask_epi8(block.lead2);
+    const uint lead3 = _mm_movemask_epi8(block.lead3);
+    if (lead3 & 0x8000)
+        return 18;
+    if ((lead2 & 0x8000) || (lead3 & 0x4000))
+        return 17;
+    return 16;
+}
+
+static QT_FUNCTION_TARGET(SSE4_1)
+bool simdDecodeUtf8_sse4(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    const uchar *const start = src;
+    while (end - src >= 18) {
+        const Utf8Block block = simdAnalyzeUtf8(src);
+        if (!_mm_movemask_epi8(block.v0))
+            break;          // leave US-ASCII to simdDecodeAscii()
+
+        const uint size = simdUtf8BlockSize(block);
+        const uint keep = ~block.continuations & ((1U << qMin(size, 16U)) - 1);
+
+        for (int half = 0; half < 2; ++half) {
+            const uint halfKeep = (keep >> (8 * half)) & 0xff;
+            if (!halfKeep)
+                continue;
+
+            const auto widen = [half](__m128i v) QT_FUNCTION_TARGET(SSE4_1) {
+                return _mm_cvtepu8_epi16(half ? _mm_srli_si128(v, 8) : v);
+            };
+            const __m128i b0 = widen(block.v0);
+            const __m128i b1 = _mm_and_si128(widen(block.v1), _mm_set1_epi16(0x3f));
+            const __m128i b2 = _mm_and_si128(widen(block.v2), _mm_set1_epi16(0x3f));
+            const __m128i lead2 = _mm_cvtepi8_epi16(half ? _mm_srli_si128(block.lead2, 8)
+                                                         : block.lead2);
+            const __m128i lead3 = _mm_cvtepi8_epi16(half ? _mm_srli_si128(block.lead3, 8)
+                                                         : block.lead3);
+
+            // 110xxxxx 10yyyyyy                -> 00000xxx xxyyyyyy
+            // 1110xxxx 10yyyyyy 10zzzzzz       -> xxxxyyyy yyzzzzzz
+            const __m128i high5 = _mm_and_si128(b0, _mm_set1_epi16(0x1f));
+            const __m128i two = _mm_or_si128(_mm_slli_epi16(high5, 6), b1);
+            const __m128i three = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(b0, 12),
+                                                            _mm_slli_epi16(b1, 6)), b2);
+            __m128i utf16 = _mm_blendv_epi8(b0, two, lead2);
+            utf16 = _mm_blendv_epi8(utf16, three, lead3);
+
+            // drop the positions of the continuation bytes
+            const __m128i shuffle = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i *>(utf8ShuffleTables.compress16[halfKeep]));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(utf16, shuffle));
+            dst += qPopulationCount(halfKeep);
+        }
+
+        src += size;
+        if (block.bad)
+            break;
+    }
+    return src != start;
+}
+
+static QT_FUNCTION_TARGET(SSE4_1)
+bool simdValidateUtf8_sse4(const uchar *&src, const uchar *end)
+{
+    const uchar *const start = src;
+    while (end - src >= 18) {
+        const Utf8Block block = simdAnalyzeUtf8(src);
+        if (!_mm_movemask_epi8(block.v0))
+            break;
+
+        src += simdUtf8BlockSize(block);
+        if (block.bad)
+            break;
+    }
+    return src != start;
+}
+
+static QT_FUNCTION_TARGET(SSE4_1)
+bool simdEncodeUtf8_sse4(uchar *&dst, const char16_t *&src, const char16_t *end)
+{
+    const char16_t *const start = src;
+
+    // The output buffer holds three bytes per remaining input character, and
+    // the two stores below write at most 12 + 16 bytes.
+    for ( ; end - src >= 10; src += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+        // leave US-ASCII to simdEncodeAscii() and surrogates to the scalar code
+        const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xff80))),
+                                              _mm_setzero_si128());
+        const __m128i surrogate = _mm_cmpeq_epi16(
+                    _mm_and_si128(data, _mm_set1_epi16(short(0xf800))), _mm_set1_epi16(short(0xd800)));
+        if (_mm_movemask_epi8(ascii) == 0xffff || _mm_movemask_epi8(surrogate))
+            break;
+
+        for (int half = 0; half < 2; ++half) {
+            const __m128i c = _mm_cvtepu16_epi32(half ? _mm_srli_si128(data, 8) : data);
+
+            // 00000xxx xxyyyyyy    -> 110xxxxx 10yyyyyy
+            // xxxxyyyy yyzzzzzz    -> 1110xxxx 10yyyyyy 10zzzzzz
+            const __m128i low6 = _mm_and_si128(c, _mm_set1_epi32(0x3f));
+            const __m128i mid6 = _mm_and_si128(_mm_srli_epi32(c, 6), _mm_set1_epi32(0x3f));
+            const __m128i two = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(c, 6),
+                                                          _mm_slli_epi32(low6, 8)),
+                                             _mm_set1_epi32(0x80c0));
+            const __m128i three = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(c, 12),
+                                                            _mm_slli_epi32(mid6, 8)),
+                                               _mm_or_si128(_mm_slli_epi32(low6, 16),
+                                                            _mm_set1_epi32(0x8080e0)));
+            const __m128i needs2 = _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7f));
+            const __m128i needs3 = _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7ff));
+            __m128i utf8 = _mm_blendv_epi8(c, two, needs2);
+            utf8 = _mm_blendv_epi8(utf8, three, needs3);
+
+            // the number of extra bytes per character, 2 bits each
+            const __m128i extra = _mm_sub_epi32(_mm_setzero_si128(), _mm_add_epi32(needs2, needs3));
+            const uint sizes = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packus_epi32(extra, extra),
+                                                                  _mm_setzero_si128()));
+            const uint index = (sizes & 0x3) | (sizes >> 6 & 0xc) | (sizes >> 12 & 0x30)
+                    | (sizes >> 18 & 0xc0);
+
+            const __m128i shuffle = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i *>(utf8ShuffleTables.pack32[index]));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(utf8, shuffle));
+            dst += utf8ShuffleTables.pack32Size[index];
+        }
+    }
+    return src != start;
+}
+
+static inline bool simdDecodeUtf8(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    return qCpuHasFeature(SSE4_1) && simdDecodeUtf8_sse4(dst, src, end);
+}
+
+static inline bool simdValidateUtf8(const uchar *&src, const uchar *end)
+{
+    return qCpuHasFeature(SSE4_1) && simdValidateUtf8_sse4(src, end);
+}
+
+static inline bool simdEncodeUtf8(uchar *&dst, const char16_t *&src, const char16_t *end)
+{
+    return qCpuHasFeature(SSE4_1) && simdEncodeUtf8_sse4(dst, src, end);
+}
+#else
+static inline bool simdDecodeUtf8(char16_t *&, const uchar *&, const uchar *)
+{
+    return false;
+}
+
+static inline bool simdValidateUtf8(const uchar *&, const uchar *)
+{
+    return false;
+}
+
+static inline bool simdEncodeUtf8(uchar *&, const char16_t *&, const char16_t *)
+{
+    return false;
+}
+#endif
+
 enum { HeaderDone = 1 };
 
 QByteArray QUtf8::convertFromUnicode(QStringView in)
@@ -507,6 +782,8 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(dst, nextAscii, src, end))
             break;
+        if (simdEncodeUtf8(dst, src, end))
+            continue;
 
         do {
             char16_t u = *src++;
@@ -574,6 +851,8 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(cursor, nextAscii, src, end))
             break;
+        if (simdEncodeUtf8(cursor, src, end))
+            continue;
 
         do {
             char16_t uc = *src++;
@@ -661,6 +940,8 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, QByteArrayView in) noexcept
             nextAscii = end;
             if (simdDecodeAscii(dst, nextAscii, src, end))
                 break;
+            if (simdDecodeUtf8(dst, src, end))
+                continue;
 
             do {
                 uchar b = *src++;
@@ -763,8 +1044,12 @@ QChar *QUtf8::convertToUnicode(QChar *out, QByteArrayView in, QStringConverter::
     res = 0;
     const uchar *nextAscii = src;
     while (res >= 0 && src < end) {
-        if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
-            break;
+        if (src >= nextAscii) {
+            if (simdDecodeAscii(dst, nextAscii, src, end))
+                break;
+            if (simdDecodeUtf8(dst, src, end))
+                continue;
+        }
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -812,8 +1097,14 @@ QUtf8::ValidUtf8Result QUtf8::isValidUtf8(QByteArrayView in)
     bool isValidAscii = true;
 
     while (src < end) {
-        if (src >= nextAscii)
+        if (src >= nextAscii) {
             src = simdFindNonAscii(src, end, nextAscii);
+            if (simdValidateUtf8(src, end)) {
+                // the block it started on had non-ASCII characters
+                isValidAscii = false;
+                continue;
+            }
+        }
         if (src == end)
             break;
 
@@ -43,6 +43,8 @@
 
 #include <QtCore/qstring.h>
 #include <QtCore/qstringview.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -86,6 +88,56 @@ private:
     uchar q_skiptable[256] = {};
 };
 
+class QMultiPatternMatcherPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QMultiPatternMatcherPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QMultiStringMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position = -1;
+        qsizetype length = 0;
+        qsizetype patternIndex = -1;
+
+        constexpr bool isValid() const noexcept { return position >= 0; }
+    };
+
+    QMultiStringMatcher();
+    explicit QMultiStringMatcher(const QStringList &patterns,
+                                 Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    QMultiStringMatcher(const QMultiStringMatcher &other);
+    QMultiStringMatcher(QMultiStringMatcher &&other) noexcept;
+    ~QMultiStringMatcher();
+
+    QMultiStringMatcher &operator=(const QMultiStringMatcher &other);
+    QMultiStringMatcher &operator=(QMultiStringMatcher &&other) noexcept;
+
+    void swap(QMultiStringMatcher &other) noexcept
+    {
+        d.swap(other.d);
+        std::swap(q_cs, other.q_cs);
+    }
+
+    void setPatterns(const QStringList &patterns);
+    QStringList patterns() const;
+    void setCaseSensitivity(Qt::CaseSensitivity cs);
+    Qt::CaseSensitivity caseSensitivity() const { return q_cs; }
+
+    Match indexIn(const QString &str, qsizetype from = 0) const
+    { return indexIn(QStringView(str), from); }
+    Match indexIn(QStringView str, qsizetype from = 0) const;
+    QList<Match> indexesIn(const QString &str, qsizetype from = 0) const
+    { return indexesIn(QStringView(str), from); }
+    QList<Match> indexesIn(QStringView str, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiPatternMatcherPrivate> d;
+    Qt::CaseSensitivity q_cs = Qt::CaseSensitive;
+};
+
+Q_DECLARE_SHARED(QMultiStringMatcher)
+
 QT_END_NAMESPACE
 
 #endif // QSTRINGMATCHER_H
@@ -107,8 +107,49 @@ public:
 
     QMutex mutex;
 
+    // Queued calls posted with normal priority don't take the mutex: they
+    // are pushed onto this lock-free stack, and whoever holds the mutex
+    // next moves them into the list, in posting order, before using it.
+    QAtomicPointer<QAbstractMetaCallEvent> incoming;
+    // number of threads pushing onto incoming, see QObject::moveToThread()
+    QAtomicInt incomingPosters;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
+    bool hasIncomingEvents() const
+    { return incoming.loadRelaxed() != nullptr; }
+
+    void pushIncomingEvent(QObject *receiver, QAbstractMetaCallEvent *event)
+    {
+        event->postedReceiver_ = receiver;
+        QAbstractMetaCallEvent *head = incoming.loadRelaxed();
+        do {
+            event->nextPosted_ = head;
+        } while (!incoming.testAndSetRelease(head, event, head));
+    }
+
+    // must be called with the mutex locked
+    void takeIncomingEvents()
+    {
+        QAbstractMetaCallEvent *event = incoming.fetchAndStoreAcquire(nullptr);
+        if (!event)
+            return;
+
+        // the stack has the newest event on top
+        QAbstractMetaCallEvent *oldest = nullptr;
+        while (event) {
+            QAbstractMetaCallEvent *next = event->nextPosted_;
+            event->nextPosted_ = oldest;
+            oldest = event;
+            event = next;
+        }
+        for (event = oldest; event; event = oldest) {
+            oldest = std::exchange(event->nextPosted_, nullptr);
+            QObject *receiver = std::exchange(event->postedReceiver_, nullptr);
+            addEvent(QPostEvent(receiver, event, Qt::NormalEventPriority));
+        }
+    }
+
     void addEvent(const QPostEvent &ev)
     {
         int priority = ev.priority;
@@ -294,7 +335,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasIncomingEvents();
     }
 
     // This class provides per-thread (by way of being a QThreadData
@@ -53,6 +53,9 @@
 #  if !defined(QT_NO_GLIB)
 #    include "../kernel/qeventdispatcher_glib_p.h"
 #  endif
+#  if QT_CONFIG(epoll)
+#    include <private/qeventdispatcher_epoll_p.h>
+#  endif
 #endif
 
 #include <private/qeventdispatcher_unix_p.h>
@@ -256,7 +259,14 @@ QAbstractEventDispatcher *QThreadPrivate::createEventDispatcher(QThreadData *dat
         return new QEventDispatcherUNIX;
 #elif defined(Q_OS_WASM)
     return new QEventDispatcherWasm();
-#elif !defined(QT_NO_GLIB)
+#else
+#  if QT_CONFIG(epoll)
+    bool ok = false;
+    int value = qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL", &ok);
+    if (ok && value > 0)
+        return new QEventDispatcherEpoll;
+#  endif
+#  if !defined(QT_NO_GLIB)
     const bool isQtMainThread = data->thread.loadAcquire() == QCoreApplicationPrivate::mainThread();
     if (qEnvironmentVariableIsEmpty("QT_NO_GLIB")
         && (isQtMainThread || qEnvironmentVariableIsEmpty("QT_NO_THREADED_GLIB"))
@@ -264,8 +274,9 @@ QAbstractEventDispatcher *QThreadPrivate::createEventDispatcher(QThreadData *dat
         return new QEventDispatcherGlib;
     else
         return new QEventDispatcherUNIX;
-#else
+#  else
     return new QEventDispatcherUNIX;
+#  endif
 #endif
 }
 
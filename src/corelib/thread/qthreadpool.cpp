@@ -41,6 +41,7 @@
 #include "qthreadpool_p.h"
 #include "qdeadlinetimer.h"
 #include "qcoreapplication.h"
+#include "qscopeguard.h"
 
 #include <algorithm>
 #include <memory>
@@ -63,8 +64,13 @@ public:
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    QThreadPoolWorkQueue *workQueue = nullptr;
+    uint localRuns = 0;
 };
 
+// the run queue of the pool worker running on this thread, if any
+Q_CONSTINIT static thread_local QThreadPoolWorkQueue *currentWorkQueue = nullptr;
+
 /*
     QThreadPool private class.
 */
@@ -85,33 +91,53 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 void QThreadPoolThread::run()
 {
     QMutexLocker locker(&manager->mutex);
+    const auto releaseWorkQueue = qScopeGuard([this] {
+        if (workQueue) {
+            Q_ASSERT(workQueue->isEmpty());
+            currentWorkQueue = nullptr;
+            workQueue->inUse.storeRelease(0);
+            workQueue = nullptr;
+        }
+    });
+
     for(;;) {
         QRunnable *r = runnable;
         runnable = nullptr;
 
+        if (!workQueue && manager->workStealing.loadRelaxed()) {
+            workQueue = manager->acquireWorkQueue();
+            currentWorkQueue = workQueue;
+        }
+
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
+                    // run the task
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // in work-stealing mode, keep going without the lock
+                    // for as long as there is local or stealable work
+                    r = workQueue ? manager->takeTaskUnlocked(this) : nullptr;
+                } while (r);
                 locker.relock();
             }
 
@@ -120,17 +146,12 @@ void QThreadPoolThread::run()
                 break;
 
             // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
-                break;
-
-            QueuePage *page = manager->queue.first();
-            r = page->pop();
+            r = manager->takeTask(this);
+        } while (r);
 
-            if (page->isFinished()) {
-                manager->queue.removeFirst();
-                delete page;
-            }
-        } while (true);
+        // hand over whatever is left in our run queue before we stop working
+        if (workQueue)
+            manager->flushWorkQueue(workQueue);
 
         // this thread is about to be deleted, do not wait or expire
         if (!manager->allThreads.contains(this)) {
@@ -142,10 +163,26 @@ void QThreadPoolThread::run()
         if (manager->tooManyThreadsActive()) {
             manager->expiredThreads.enqueue(this);
             registerThreadInactive();
+            manager->updateStealingHints();
             return;
         }
         manager->waitingThreads.enqueue(this);
         registerThreadInactive();
+        manager->updateStealingHints();
+
+        if (workQueue) {
+            // Pairs with the fence in tryEnqueueLocalTask(): either the
+            // worker that pushed a task sees that we are about to wait,
+            // or we see its task here.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if ((runnable = manager->stealTask(workQueue))) {
+                manager->waitingThreads.removeOne(this);
+                ++manager->activeThreads;
+                manager->updateStealingHints();
+                continue;
+            }
+        }
+
         // wait for work, exiting after the expiry timeout is reached
         runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
         // this thread is about to be deleted, do not work or expire
@@ -155,6 +192,7 @@ void QThreadPoolThread::run()
         }
         if (manager->waitingThreads.removeOne(this)) {
             manager->expiredThreads.enqueue(this);
+            manager->updateStealingHints();
             return;
         }
         ++manager->activeThreads;
@@ -174,6 +212,12 @@ void QThreadPoolThread::registerThreadInactive()
 QThreadPoolPrivate:: QThreadPoolPrivate()
 { }
 
+QThreadPoolPrivate::~QThreadPoolPrivate()
+{
+    for (int i = 0; i < workQueueCount.loadRelaxed(); ++i)
+        delete workQueues[i].loadRelaxed();
+}
+
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
 {
     Q_ASSERT(task != nullptr);
@@ -259,6 +303,205 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
     }
 }
 
+/*!
+    \internal
+
+    Pushes \a task onto the run queue of the calling thread, if it is a
+    worker of this pool running in work-stealing mode, and makes sure that
+    an idle thread is woken up if there is one. Returns \c false if the
+    task has to go through the shared queue instead.
+*/
+bool QThreadPoolPrivate::tryEnqueueLocalTask(QRunnable *task)
+{
+    QThreadPoolWorkQueue *local = currentWorkQueue;
+    if (!local || local->pool != this || !workStealing.loadRelaxed())
+        return false;
+    if (!local->push(task))
+        return false;
+
+    // Pairs with the fence in QThreadPoolThread::run(): either we see the
+    // spare thread, or the thread going to sleep sees our task.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (spareThreadsHint.loadRelaxed()) {
+        QMutexLocker locker(&mutex);
+        if (!areAllThreadsActive()) {
+            // hand the newest task over to the shared queue and wake
+            // up (or start) a thread for it; thieves take the older ones
+            if (QRunnable *r = local->pop()) {
+                if (!tryStart(r))
+                    enqueueTask(r);
+            }
+        }
+        updateStealingHints();
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Returns the next task for \a thread that can be found without taking
+    the lock: one from its own run queue, or one stolen from another
+    worker. Returns \c nullptr if there is none, or if the shared queue
+    needs to be looked at first.
+*/
+QRunnable *QThreadPoolPrivate::takeTaskUnlocked(QThreadPoolThread *thread)
+{
+    if (tooManyThreadsHint.loadRelaxed())
+        return nullptr;
+
+    // tasks with a raised priority, and every now and then any task in the
+    // shared queue, go before our own ones
+    const int queuedPriority = queuedPriorityHint.loadRelaxed();
+    if (queuedPriority != INT_MIN
+            && (queuedPriority > 0 || ++thread->localRuns % FairnessInterval == 0)) {
+        return nullptr;
+    }
+
+    if (QRunnable *r = thread->workQueue->pop())
+        return r;
+    return stealTask(thread->workQueue);
+}
+
+/*!
+    \internal
+
+    Returns the next task for \a thread, or \c nullptr if there is no work
+    left. Called with the lock held.
+
+    In work-stealing mode, a thread taking from the shared queue also moves
+    a few more tasks of the same priority into its own run queue, so that
+    the lock is taken less often; idle workers steal them from there.
+*/
+QRunnable *QThreadPoolPrivate::takeTask(QThreadPoolThread *thread)
+{
+    QThreadPoolWorkQueue *local = thread->workQueue;
+    QRunnable *r = nullptr;
+    if (!queue.isEmpty()) {
+        QueuePage *page = queue.first();
+        r = page->pop();
+
+        if (local) {
+            for (int i = 0; i < MaxBatchSize && !page->isFinished(); ++i) {
+                if (!local->push(page->first()))
+                    break;
+                page->pop();
+            }
+        }
+
+        if (page->isFinished()) {
+            queue.removeFirst();
+            delete page;
+        }
+        updateStealingHints();
+    } else if (local) {
+        r = local->pop();
+        if (!r)
+            r = stealTask(local);
+    }
+    return r;
+}
+
+/*!
+    \internal
+
+    Steals a task from the run queue of any worker but \a self.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(const QThreadPoolWorkQueue *self)
+{
+    const int count = workQueueCount.loadAcquire();
+    // start with our neighbour, so that thieves spread over the victims
+    int start = 0;
+    while (start < count && workQueues[start].loadRelaxed() != self)
+        ++start;
+
+    // give up after a couple of rounds of lost races
+    for (int round = 0; round < 2; ++round) {
+        bool contended = false;
+        for (int i = 1; i <= count; ++i) {
+            QThreadPoolWorkQueue *victim = workQueues[(start + i) % count].loadAcquire();
+            if (victim == self || victim->isEmpty())
+                continue;
+            if (QRunnable *r = victim->steal())
+                return r;
+            contended = true;
+        }
+        if (!contended)
+            break;
+    }
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Removes \a runnable from the run queue of any worker. Called with the
+    lock held.
+*/
+bool QThreadPoolPrivate::tryTakeLocalTask(QRunnable *runnable)
+{
+    const int count = workQueueCount.loadAcquire();
+    for (int i = 0; i < count; ++i) {
+        if (workQueues[i].loadAcquire()->tryTake(runnable))
+            return true;
+    }
+    return false;
+}
+
+/*!
+    \internal
+
+    Moves the tasks left in \a workQueue to the shared queue. Called with
+    the lock held by the owner of \a workQueue before it stops working.
+*/
+void QThreadPoolPrivate::flushWorkQueue(QThreadPoolWorkQueue *workQueue)
+{
+    while (!workQueue->isEmpty()) {
+        if (QRunnable *r = workQueue->pop())
+            enqueueTask(r);
+    }
+    updateStealingHints();
+}
+
+/*!
+    \internal
+
+    Returns a run queue that is not used by any other worker, creating one
+    if needed, or \c nullptr if the limit is reached. Run queues are only
+    deleted with the pool, so thieves never see a dangling one. Called with
+    the lock held.
+*/
+QThreadPoolWorkQueue *QThreadPoolPrivate::acquireWorkQueue()
+{
+    const int count = workQueueCount.loadRelaxed();
+    for (int i = 0; i < count; ++i) {
+        QThreadPoolWorkQueue *workQueue = workQueues[i].loadRelaxed();
+        if (workQueue->inUse.testAndSetAcquire(0, 1))
+            return workQueue;
+    }
+    if (count == MaxWorkQueues)
+        return nullptr;
+
+    auto workQueue = new QThreadPoolWorkQueue(this);
+    workQueue->inUse.storeRelaxed(1);
+    workQueues[count].storeRelease(workQueue);
+    workQueueCount.storeRelease(count + 1);
+    return workQueue;
+}
+
+/*!
+    \internal
+
+    Publishes the state that workers check without holding the lock.
+    Called with the lock held after anything that affects it.
+*/
+void QThreadPoolPrivate::updateStealingHints()
+{
+    spareThreadsHint.storeRelaxed(!areAllThreadsActive());
+    tooManyThreadsHint.storeRelaxed(tooManyThreadsActive());
+    queuedPriorityHint.storeRelaxed(queue.isEmpty() ? INT_MIN : queue.constFirst()->priority());
+}
+
 bool QThreadPoolPrivate::areAllThreadsActive() const
 {
     const int activeThreadCount = this->activeThreadCount();
@@ -357,6 +600,21 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+
+    // runnables in the workers' run queues have not been started either
+    const int count = workQueueCount.loadAcquire();
+    for (int i = 0; i < count; ++i) {
+        QThreadPoolWorkQueue *workQueue = workQueues[i].loadAcquire();
+        while (!workQueue->isEmpty()) {
+            QRunnable *r = workQueue->steal();
+            if (r && r->autoDelete()) {
+                locker.unlock();
+                delete r;
+                locker.relock();
+            }
+        }
+    }
+    updateStealingHints();
 }
 
 /*!
@@ -390,11 +648,12 @@ bool QThreadPool::tryTake(QRunnable *runnable)
                 d->queue.removeOne(page);
                 delete page;
             }
+            d->updateStealingHints();
             return true;
         }
     }
 
-    return false;
+    return d->tryTakeLocalTask(runnable);
 }
 
     /*!
@@ -464,6 +723,14 @@ void QThreadPoolPrivate::stealAndRunRunnable(QRunnable *runnable)
     implementing time-consuming operations that are not visible to the
     QThreadPool.
 
+    By default, all runnables go through a single queue shared by all
+    threads. When many short runnables are started, in particular from
+    within other runnables, the synchronization on that queue can limit how
+    well the work scales with the number of threads. Enabling the
+    workStealingEnabled property gives each worker thread its own run queue
+    instead: runnables started from a worker thread go to the worker's
+    queue, and idle workers take work from the other workers' queues.
+
     Note that QThreadPool is a low-level class for managing threads, see
     the Qt Concurrent module for higher level alternatives.
 
@@ -505,8 +772,11 @@ QThreadPool *QThreadPool::globalInstance()
     Q_CONSTINIT static QBasicMutex theMutex;
 
     const QMutexLocker locker(&theMutex);
-    if (theInstance.isNull() && !QCoreApplication::closingDown())
+    if (theInstance.isNull() && !QCoreApplication::closingDown()) {
         theInstance = new QThreadPool();
+        if (qEnvironmentVariableIntValue("QT_THREADPOOL_WORK_STEALING"))
+            theInstance->setWorkStealingEnabled(true);
+    }
     return theInstance;
 }
 
@@ -531,10 +801,14 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0 && d->tryEnqueueLocalTask(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
         d->enqueueTask(runnable, priority);
+    d->updateStealingHints();
 }
 
 /*!
@@ -576,8 +850,10 @@ bool QThreadPool::tryStart(QRunnable *runnable)
 
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
-    if (d->tryStart(runnable))
+    if (d->tryStart(runnable)) {
+        d->updateStealingHints();
         return true;
+    }
 
     return false;
 }
@@ -602,8 +878,10 @@ bool QThreadPool::tryStart(std::function<void()> functionToRun)
         return false;
 
     QRunnable *runnable = QRunnable::create(std::move(functionToRun));
-    if (d->tryStart(runnable))
+    if (d->tryStart(runnable)) {
+        d->updateStealingHints();
         return true;
+    }
     delete runnable;
     return false;
 }
@@ -665,6 +943,7 @@ void QThreadPool::setMaxThreadCount(int maxThreadCount)
 
     d->requestedMaxThreadCount = maxThreadCount;
     d->tryToStartMoreThreads();
+    d->updateStealingHints();
 }
 
 /*! \property QThreadPool::activeThreadCount
@@ -704,6 +983,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateStealingHints();
 }
 
 /*! \property QThreadPool::stackSize
@@ -756,6 +1036,48 @@ QThread::Priority QThreadPool::threadPriority() const
     return d->threadPriority;
 }
 
+/*! \property QThreadPool::workStealingEnabled
+    \brief whether the worker threads use work stealing.
+
+    When enabled, each worker thread gets a run queue of its own. A
+    runnable started with the default priority from one of the pool's
+    worker threads, for instance a nested QtConcurrent::run() call, is
+    put into that queue without taking the lock of the shared queue, and
+    the worker keeps taking runnables from it, without locking, until it
+    runs dry. Idle workers steal runnables from the queues of busy
+    workers, and a worker taking runnables from the shared queue moves a
+    few of them into its own queue at once.
+
+    Runnables with a priority other than 0, runnables started from threads
+    that do not belong to the pool, and runnables that do not fit into the
+    worker's queue still go through the shared queue. Workers check the
+    shared queue first as long as it holds runnables with a raised
+    priority, and regularly otherwise, so that no runnable waits there
+    indefinitely. The order in which runnables of the same priority start
+    is unspecified in this mode. reserveThread(), maxThreadCount() and the
+    expiry of idle threads behave as before.
+
+    The default value is \c false. For globalInstance(), which is also used
+    by Qt Concurrent, it can be enabled by setting the environment variable
+    \c QT_THREADPOOL_WORK_STEALING to \c 1.
+
+    \since 6.4
+*/
+
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->workStealing.storeRelaxed(enabled);
+    d->updateStealingHints();
+}
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.loadRelaxed();
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -774,6 +1096,7 @@ void QThreadPool::releaseThread()
     QMutexLocker locker(&d->mutex);
     --d->reservedThreads;
     d->tryToStartMoreThreads();
+    d->updateStealingHints();
 }
 
 /*!
@@ -810,6 +1133,7 @@ void QThreadPool::startOnReservedThread(QRunnable *runnable)
         // and something took the one minimum thread.
         d->enqueueTask(runnable, INT_MAX);
     }
+    d->updateStealingHints();
 }
 
 /*!
@@ -58,6 +58,7 @@
 #include "QtCore/qthreadpool.h"
 #include "QtCore/qset.h"
 #include "QtCore/qqueue.h"
+#include "QtCore/qatomic.h"
 #include "private/qobject_p.h"
 
 QT_REQUIRE_CONFIG(thread);
@@ -143,6 +144,99 @@ private:
     QRunnable *m_entries[MaxPageSize];
 };
 
+/*
+    Per-worker run queue used in work-stealing mode.
+
+    The owning worker pushes and pops at the bottom without taking the
+    pool lock; other workers steal from the top (Chase-Lev). The ring has
+    a fixed capacity: when it is full, tasks go to the shared queue.
+    Every slot that is not null holds a task that has not been claimed
+    yet, and all claims go through an atomic exchange of the slot, so
+    tryTake() can remove a task from any thread.
+*/
+class QThreadPoolWorkQueue
+{
+public:
+    enum {
+        Capacity = 256
+    };
+
+    explicit QThreadPoolWorkQueue(const QThreadPoolPrivate *pool) : pool(pool) { }
+
+    bool isEmpty() const
+    { return qptrdiff(bottom.loadAcquire() - top.loadAcquire()) <= 0; }
+
+    // owner only
+    bool push(QRunnable *runnable)
+    {
+        Q_ASSERT(runnable != nullptr);
+        const quintptr b = bottom.loadRelaxed();
+        const quintptr t = top.loadAcquire();
+        QAtomicPointer<QRunnable> &slot = entries[b % Capacity];
+        // a thief may still be about to claim the slot we would wrap onto
+        if (qptrdiff(b - t) >= Capacity || slot.loadAcquire() != nullptr)
+            return false;
+        slot.storeRelaxed(runnable);
+        bottom.storeRelease(b + 1);
+        return true;
+    }
+
+    // owner only
+    QRunnable *pop()
+    {
+        for (;;) {
+            const quintptr b = bottom.loadRelaxed() - 1;
+            bottom.storeRelaxed(b);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const quintptr t = top.loadRelaxed();
+            if (qptrdiff(b - t) < 0) {
+                bottom.storeRelaxed(b + 1);
+                return nullptr;
+            }
+            if (b == t) {
+                // last task, race the thieves for it
+                const bool won = top.testAndSetOrdered(t, t + 1);
+                bottom.storeRelaxed(b + 1);
+                return won ? entries[b % Capacity].fetchAndStoreAcquire(nullptr) : nullptr;
+            }
+            // a null slot was taken by tryTake(), move on to the next one
+            if (QRunnable *runnable = entries[b % Capacity].fetchAndStoreAcquire(nullptr))
+                return runnable;
+        }
+    }
+
+    // any thread; returns nullptr if empty or if another thread won the race
+    QRunnable *steal()
+    {
+        const quintptr t = top.loadAcquire();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const quintptr b = bottom.loadAcquire();
+        if (qptrdiff(b - t) <= 0)
+            return nullptr;
+        if (!top.testAndSetOrdered(t, t + 1))
+            return nullptr;
+        return entries[t % Capacity].fetchAndStoreAcquire(nullptr);
+    }
+
+    // any thread
+    bool tryTake(QRunnable *runnable)
+    {
+        for (QAtomicPointer<QRunnable> &slot : entries) {
+            if (slot.testAndSetOrdered(runnable, nullptr))
+                return true;
+        }
+        return false;
+    }
+
+    const QThreadPoolPrivate * const pool;
+    QAtomicInt inUse = 0;
+
+private:
+    alignas(64) QAtomicInteger<quintptr> top = 0;
+    alignas(64) QAtomicInteger<quintptr> bottom = 0;
+    alignas(64) QAtomicPointer<QRunnable> entries[Capacity] = {};
+};
+
 class QThreadPoolThread;
 class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 {
@@ -151,6 +245,7 @@ class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 
 public:
     QThreadPoolPrivate();
+    ~QThreadPoolPrivate();
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
@@ -170,6 +265,15 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    bool tryEnqueueLocalTask(QRunnable *task);
+    QRunnable *takeTaskUnlocked(QThreadPoolThread *thread);
+    QRunnable *takeTask(QThreadPoolThread *thread);
+    QRunnable *stealTask(const QThreadPoolWorkQueue *self);
+    bool tryTakeLocalTask(QRunnable *runnable);
+    void flushWorkQueue(QThreadPoolWorkQueue *workQueue);
+    QThreadPoolWorkQueue *acquireWorkQueue();
+    void updateStealingHints();
+
     mutable QMutex mutex;
     QSet<QThreadPoolThread *> allThreads;
     QQueue<QThreadPoolThread *> waitingThreads;
@@ -184,6 +288,20 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+
+    // work-stealing mode; the hints mirror state protected by the mutex
+    // so that workers can keep going without taking it
+    enum {
+        MaxWorkQueues = 256,
+        FairnessInterval = 61,
+        MaxBatchSize = 8
+    };
+    QAtomicInt workStealing = 0;
+    QAtomicInt workQueueCount = 0;
+    QAtomicPointer<QThreadPoolWorkQueue> workQueues[MaxWorkQueues] = {};
+    QAtomicInt spareThreadsHint = 0;
+    QAtomicInt tooManyThreadsHint = 0;
+    QAtomicInt queuedPriorityHint = INT_MIN;
 };
 
 QT_END_NAMESPACE
@@ -39,6 +39,8 @@
 ****************************************************************************/
 
 #include <QtCore/qarraydata.h>
+#include <QtCore/private/qarraydataarena_p.h>
+#include <QtCore/private/qlocking_p.h>
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/private/qtools_p.h>
 #include <QtCore/qmath.h>
@@ -46,6 +48,9 @@
 #include <QtCore/qbytearray.h>  // QBA::value_type
 #include <QtCore/qstring.h>  // QString::value_type
 
+#include <limits>
+#include <map>
+
 #include <stdlib.h>
 
 QT_BEGIN_NAMESPACE
@@ -175,7 +180,13 @@ static inline qsizetype calculateBlockSize(qsizetype &capacity, qsizetype object
 
 static QArrayData *allocateData(qsizetype allocSize)
 {
-    QArrayData *header = static_cast<QArrayData *>(::malloc(size_t(allocSize)));
+    QArrayData *header = nullptr;
+    if (Q_UNLIKELY(QArrayDataArena::isActive())) {
+        if (QArrayDataArena *arena = QArrayDataArena::current())
+            header = static_cast<QArrayData *>(arena->allocate(allocSize));
+    }
+    if (!header)
+        header = static_cast<QArrayData *>(::malloc(size_t(allocSize)));
     if (header) {
         header->ref_.storeRelaxed(1);
         header->flags = {};
@@ -184,6 +195,29 @@ static QArrayData *allocateData(qsizetype allocSize)
     return header;
 }
 
+static QPair<QArrayData *, void *>
+reallocateArenaData(QArrayData *data, qptrdiff offset, qsizetype capacity, qsizetype allocSize) noexcept
+{
+    // grow or shrink in place if this is the last block of the current arena
+    if (QArrayDataArena::isActive()) {
+        QArrayDataArena *arena = QArrayDataArena::current();
+        if (arena && arena->tryResize(data, allocSize)) {
+            data->alloc = capacity;
+            return qMakePair(data, static_cast<void *>(reinterpret_cast<char *>(data) + offset));
+        }
+    }
+
+    // otherwise copy, like realloc() would
+    QArrayData *header = allocateData(allocSize);
+    if (!header)
+        return qMakePair<QArrayData *, void *>(nullptr, nullptr);
+    const qsizetype oldSize = QArrayDataArena::blockSize(data);
+    ::memcpy(static_cast<void *>(header), data, size_t(qMin(allocSize, oldSize)));
+    header->alloc = capacity;
+    QArrayDataArena::release(data);
+    return qMakePair(header, static_cast<void *>(reinterpret_cast<char *>(header) + offset));
+}
+
 
 namespace {
 // QArrayData with strictest alignment requirements supported by malloc()
@@ -257,6 +291,9 @@ QArrayData::reallocateUnaligned(QArrayData *data, void *dataPointer,
     if (Q_UNLIKELY(allocSize < 0))  // handle overflow. cannot reallocate reliably
         return qMakePair(data, dataPointer);
 
+    if (Q_UNLIKELY(data && QArrayDataArena::owns(data)))
+        return reallocateArenaData(data, offset, capacity, allocSize);
+
     QArrayData *header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
     if (header) {
         header->alloc = capacity;
@@ -276,7 +313,231 @@ void QArrayData::deallocate(QArrayData *data, qsizetype objectSize,
     Q_UNUSED(objectSize);
     Q_UNUSED(alignment);
 
-    ::free(data);
+    if (Q_UNLIKELY(data && QArrayDataArena::owns(data)))
+        QArrayDataArena::release(data);
+    else
+        ::free(data);
+}
+
+/*
+    Arena blocks are preceded by a BlockPrefix, so that they can be found
+    in their chunk when they are resized or released. Chunks, prefixes and
+    blocks are all aligned like malloc() would align them.
+
+    Whether a block belongs to an arena at all is decided by its address:
+    all chunks that are alive are registered in a map keyed by their
+    address, which only has to be searched while there are any.
+*/
+struct alignas(std::max_align_t) QArrayDataArenaChunk
+{
+    // While the arena allocates from the chunk, ref is Bias minus the
+    // number of blocks released so far. When the arena retires the chunk,
+    // it adds the number of blocks it allocated and removes the bias, so
+    // that the last one of the arena and the blocks frees the chunk.
+    static constexpr qsizetype Bias = (std::numeric_limits<qsizetype>::max)() / 2;
+
+    QBasicAtomicInteger<qsizetype> ref;
+    qsizetype allocations;
+    char *top;
+    char *end;
+};
+
+namespace {
+struct alignas(std::max_align_t) BlockPrefix
+{
+    QArrayDataArenaChunk *chunk;
+    qsizetype size;
+};
+
+constexpr qsizetype BlockAlignment = alignof(std::max_align_t);
+
+BlockPrefix *prefixOf(const void *block) noexcept
+{
+    return const_cast<BlockPrefix *>(static_cast<const BlockPrefix *>(block) - 1);
+}
+} // unnamed namespace
+
+Q_CONSTINIT static QBasicAtomicInt activeArenas = Q_BASIC_ATOMIC_INITIALIZER(0);
+Q_CONSTINIT static QBasicAtomicInteger<qsizetype> liveChunks = Q_BASIC_ATOMIC_INITIALIZER(0);
+Q_CONSTINIT static QBasicMutex chunkMapMutex;
+// created with the first chunk and deleted with the last one
+Q_CONSTINIT static std::map<quintptr, QArrayDataArenaChunk *> *chunkMap = nullptr;
+
+static bool registerChunk(QArrayDataArenaChunk *chunk) noexcept
+{
+    const auto locker = qt_scoped_lock(chunkMapMutex);
+    QT_TRY {
+        if (!chunkMap)
+            chunkMap = new std::map<quintptr, QArrayDataArenaChunk *>;
+        chunkMap->emplace(quintptr(chunk), chunk);
+    } QT_CATCH (...) {
+        if (chunkMap && chunkMap->empty()) {
+            delete chunkMap;
+            chunkMap = nullptr;
+        }
+        return false;
+    }
+    liveChunks.ref();
+    return true;
+}
+
+static void freeChunk(QArrayDataArenaChunk *chunk) noexcept
+{
+    {
+        const auto locker = qt_scoped_lock(chunkMapMutex);
+        chunkMap->erase(quintptr(chunk));
+        if (chunkMap->empty()) {
+            delete chunkMap;
+            chunkMap = nullptr;
+        }
+        liveChunks.deref();
+    }
+    ::free(chunk);
+}
+Q_CONSTINIT static thread_local QArrayDataArena *currentArena = nullptr;
+
+QArrayDataArena::QArrayDataArena(qsizetype chunkSize)
+    : previous(currentArena),
+      chunkSize(qMax(chunkSize, qsizetype(1024)))
+{
+    currentArena = this;
+    activeArenas.ref();
+}
+
+QArrayDataArena::~QArrayDataArena()
+{
+    Q_ASSERT_X(currentArena == this, "QArrayDataArena",
+               "arenas must be destroyed in reverse order, on the thread that created them");
+    retireChunk();
+    currentArena = previous;
+    activeArenas.deref();
+}
+
+/*
+    Returns the current arena of the calling thread, or nullptr if there
+    is none.
+*/
+QArrayDataArena *QArrayDataArena::current() noexcept
+{
+    return currentArena;
+}
+
+/*
+    Returns whether any thread has a current arena. This is a cheap check
+    that lets the common case skip the thread-local lookup in current().
+*/
+bool QArrayDataArena::isActive() noexcept
+{
+    return activeArenas.loadRelaxed() != 0;
+}
+
+/*
+    Returns whether \a block lies in a chunk of any arena. This may be
+    called on any thread, and after the arena the block was allocated in
+    is gone. It is cheap as long as no arena chunk is alive.
+*/
+bool QArrayDataArena::owns(const void *block) noexcept
+{
+    // A block that was allocated in an arena keeps its chunk alive, and
+    // was handed to this thread with the synchronization that implies.
+    if (liveChunks.loadRelaxed() == 0)
+        return false;
+
+    const quintptr address = quintptr(block);
+    const auto locker = qt_scoped_lock(chunkMapMutex);
+    if (!chunkMap)
+        return false;
+    auto it = chunkMap->upper_bound(address);
+    if (it == chunkMap->begin())
+        return false;
+    --it;
+    return address < quintptr(it->second->end);
+}
+
+/*
+    Allocates a block of \a size bytes, or returns nullptr if the block
+    should come from the heap instead. Large blocks always do, so that
+    they don't waste most of a chunk.
+*/
+void *QArrayDataArena::allocate(qsizetype size)
+{
+    Q_ASSERT(currentArena == this);
+    if (size > chunkSize / 8)
+        return nullptr;
+
+    size = (size + BlockAlignment - 1) & ~(BlockAlignment - 1);
+    const qsizetype total = size + qsizetype(sizeof(BlockPrefix));
+    if (!chunk || chunk->end - chunk->top < total) {
+        retireChunk();
+        void *memory = ::malloc(sizeof(QArrayDataArenaChunk) + size_t(chunkSize));
+        if (!memory)
+            return nullptr;
+        QArrayDataArenaChunk *c = new (memory) QArrayDataArenaChunk;
+        c->ref.storeRelaxed(QArrayDataArenaChunk::Bias);
+        c->allocations = 0;
+        c->top = reinterpret_cast<char *>(c + 1);
+        c->end = c->top + chunkSize;
+        if (!registerChunk(c)) {
+            ::free(memory);
+            return nullptr;
+        }
+        chunk = c;
+    }
+
+    BlockPrefix *prefix = new (chunk->top) BlockPrefix{ chunk, size };
+    chunk->top += total;
+    ++chunk->allocations;
+    return prefix + 1;
+}
+
+/*
+    Resizes \a block to \a size bytes in place, which is possible if it is
+    the last block allocated from this arena's current chunk and the
+    chunk has enough room.
+*/
+bool QArrayDataArena::tryResize(void *block, qsizetype size) noexcept
+{
+    BlockPrefix *prefix = prefixOf(block);
+    if (!chunk || prefix->chunk != chunk)
+        return false;
+    char *start = static_cast<char *>(block);
+    if (start + prefix->size != chunk->top)
+        return false;
+
+    size = (size + BlockAlignment - 1) & ~(BlockAlignment - 1);
+    if (chunk->end - start < size)
+        return false;
+    chunk->top = start + size;
+    prefix->size = size;
+    return true;
+}
+
+qsizetype QArrayDataArena::blockSize(const void *block) noexcept
+{
+    return prefixOf(block)->size;
+}
+
+/*
+    Releases \a block. This may be called on any thread, and after the
+    arena the block was allocated in is gone.
+*/
+void QArrayDataArena::release(void *block) noexcept
+{
+    QArrayDataArenaChunk *c = prefixOf(block)->chunk;
+    if (c->ref.fetchAndSubOrdered(1) == 1)
+        freeChunk(c);
+}
+
+void QArrayDataArena::retireChunk() noexcept
+{
+    if (!chunk)
+        return;
+    const qsizetype allocations = chunk->allocations;
+    if (chunk->ref.fetchAndAddOrdered(allocations - QArrayDataArenaChunk::Bias)
+            == QArrayDataArenaChunk::Bias - allocations) {
+        freeChunk(chunk);
+    }
+    chunk = nullptr;
 }
 
 QT_END_NAMESPACE
@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QARRAYDATAARENA_P_H
+#define QARRAYDATAARENA_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qarraydata.h>
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+struct QArrayDataArenaChunk;
+
+/*
+  QArrayDataArena is a scoped bump allocator for the storage of
+  QArrayData based containers (QByteArray, QString and QList).
+
+  While an arena is alive, it is the current arena of the thread that
+  created it, and small blocks that QArrayData allocates on that thread
+  are carved out of chunks of chunkSize bytes owned by the arena, instead
+  of being allocated with malloc(). Arenas nest: destroying an arena makes
+  the previously current one current again. They must be destroyed in the
+  reverse order of their creation, on the thread that created them.
+
+  Data allocated in an arena may outlive it and may be freed on any
+  thread. Each chunk counts the blocks that are still alive in it and is
+  released once the arena is done with it and its last block has been
+  freed, so that in the common case of request-scoped data, all the
+  memory is released en masse when the arena goes away.
+
+  Blocks that have to grow are extended in place if they are the last
+  block of the arena's current chunk; otherwise they are copied to a new
+  block, which comes from the heap when no arena is current, e.g. when
+  data allocated in the arena is detached after the arena is gone.
+*/
+class Q_CORE_EXPORT QArrayDataArena
+{
+    Q_DISABLE_COPY_MOVE(QArrayDataArena)
+public:
+    enum : qsizetype { DefaultChunkSize = 64 * 1024 };
+
+    explicit QArrayDataArena(qsizetype chunkSize = DefaultChunkSize);
+    ~QArrayDataArena();
+
+    static QArrayDataArena *current() noexcept;
+
+    // used by QArrayData
+    static bool isActive() noexcept;
+    static bool owns(const void *block) noexcept;
+    void *allocate(qsizetype size);
+    bool tryResize(void *block, qsizetype size) noexcept;
+    static qsizetype blockSize(const void *block) noexcept;
+    static void release(void *block) noexcept;
+
+private:
+    void retireChunk() noexcept;
+
+    QArrayDataArenaChunk *chunk = nullptr;
+    QArrayDataArena *previous;
+    qsizetype chunkSize;
+};
+
+QT_END_NAMESPACE
+
+#endif // QARRAYDATAARENA_P_H
@@ -40,6 +40,11 @@
 
 #include <qcryptographichash.h>
 #include <qiodevice.h>
+#include <qvarlengtharray.h>
+#ifndef QT_BOOTSTRAPPED
+#include <qfiledevice.h>
+#include <private/qsimd_p.h>
+#endif
 
 #include "../../3rdparty/sha1/sha1.cpp"
 
@@ -134,10 +139,621 @@ static inline int SHA384_512AddLength(SHA512Context *context, unsigned int lengt
 #include "../../3rdparty/blake2/src/blake2b-ref.c"
 #include "../../3rdparty/blake2/src/blake2s-ref.c"
 #endif
+
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#endif
 #endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
 
 QT_BEGIN_NAMESPACE
 
+/*
+    SHA-1 and SHA-256 using the SHA extensions of x86 and ARMv8. Each of
+    these functions runs the compression function over \a blocks blocks of
+    64 bytes at \a data, updating the hash \a state in place.
+*/
+#ifdef QT_BOOTSTRAPPED
+// no CPU feature detection
+#elif defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SHA) \
+    && QT_COMPILER_SUPPORTS_HERE(SSE4_1)
+#  define QT_CRYPTOGRAPHICHASH_SHA_X86
+#  define QT_FUNCTION_TARGET_STRING_SHA_SSE4_1 QT_FUNCTION_TARGET_STRING_SHA "," \
+                                               QT_FUNCTION_TARGET_STRING_SSE4_1
+
+static bool hasShaInstructions() noexcept
+{
+    return qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1);
+}
+
+// the five groups of four rounds each that use the round function F
+template <int F>
+static inline void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha1RoundsX86(__m128i &abcd, __m128i (&e)[2], __m128i (&msg)[4])
+{
+    for (int g = 5 * F; g < 5 * F + 5; ++g) {
+        if (g == 0)
+            e[0] = _mm_add_epi32(e[0], msg[0]);
+        else
+            e[g & 1] = _mm_sha1nexte_epu32(e[g & 1], msg[g & 3]);
+        e[~g & 1] = abcd;
+        // the message schedule, four words at a time
+        if (g >= 3 && g <= 18)
+            msg[(g + 1) & 3] = _mm_sha1msg2_epu32(msg[(g + 1) & 3], msg[g & 3]);
+        abcd = _mm_sha1rnds4_epu32(abcd, e[g & 1], F);
+        if (g >= 1 && g <= 16)
+            msg[(g - 1) & 3] = _mm_sha1msg1_epu32(msg[(g - 1) & 3], msg[g & 3]);
+        if (g >= 2 && g <= 17)
+            msg[(g - 2) & 3] = _mm_xor_si128(msg[(g - 2) & 3], msg[g & 3]);
+    }
+}
+
+static void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha1BlocksX86(quint32 *state, const uchar *data, qsizetype blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)),
+                                     0x1b);
+    __m128i e0 = _mm_set_epi32(int(state[4]), 0, 0, 0);
+
+    for (; blocks; --blocks, data += 64) {
+        const __m128i abcdSave = abcd;
+        const __m128i e0Save = e0;
+        __m128i msg[4];
+        for (int i = 0; i < 4; ++i) {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data) + i),
+                                      byteSwap);
+        }
+        __m128i e[2] = { e0, e0 };
+        sha1RoundsX86<0>(abcd, e, msg);
+        sha1RoundsX86<1>(abcd, e, msg);
+        sha1RoundsX86<2>(abcd, e, msg);
+        sha1RoundsX86<3>(abcd, e, msg);
+        e0 = _mm_sha1nexte_epu32(e[0], e0Save);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = quint32(_mm_extract_epi32(e0, 3));
+}
+
+#  ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+alignas(16) static const quint32 sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha256BlocksX86(quint32 *state, const uchar *data, qsizetype blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    // the instructions want the state as ABEF and CDGH
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)),
+                                    0xb1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4)),
+                                       0x1b);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    for (; blocks; --blocks, data += 64) {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+        __m128i msg[4];
+        for (int i = 0; i < 4; ++i) {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data) + i),
+                                      byteSwap);
+        }
+        for (int g = 0; g < 16; ++g) {
+            const __m128i k = _mm_load_si128(reinterpret_cast<const __m128i *>(sha256RoundConstants) + g);
+            __m128i msgK = _mm_add_epi32(msg[g & 3], k);
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msgK);
+            // the message schedule, four words at a time
+            if (g >= 3 && g <= 14) {
+                tmp = _mm_alignr_epi8(msg[g & 3], msg[(g - 1) & 3], 4);
+                msg[(g + 1) & 3] = _mm_sha256msg2_epu32(_mm_add_epi32(msg[(g + 1) & 3], tmp),
+                                                        msg[g & 3]);
+            }
+            msgK = _mm_shuffle_epi32(msgK, 0x0e);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msgK);
+            if (g >= 1 && g <= 12)
+                msg[(g - 1) & 3] = _mm_sha256msg1_epu32(msg[(g - 1) & 3], msg[g & 3]);
+        }
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_blend_epi16(tmp, state1, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), _mm_alignr_epi8(state1, tmp, 8));
+}
+#  endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+#elif defined(Q_PROCESSOR_ARM_64) && QT_COMPILER_SUPPORTS_HERE(AES)
+#  define QT_CRYPTOGRAPHICHASH_SHA_ARM
+
+static bool hasShaInstructions() noexcept
+{
+    // the cryptographic extension brings the SHA-1 and SHA-256 instructions along
+    return qCpuHasFeature(AES);
+}
+
+static void QT_FUNCTION_TARGET(AES)
+sha1BlocksArm(quint32 *state, const uchar *data, qsizetype blocks)
+{
+    static const quint32 roundConstants[4] = { 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6 };
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32_t e = state[4];
+
+    for (; blocks; --blocks, data += 64) {
+        const uint32x4_t abcdSave = abcd;
+        const uint32_t eSave = e;
+        uint32x4_t msg[4];
+        for (int i = 0; i < 4; ++i)
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+        for (int g = 0; g < 20; ++g) {
+            const uint32x4_t msgK = vaddq_u32(msg[g & 3], vdupq_n_u32(roundConstants[g / 5]));
+            // the message schedule, four words at a time
+            if (g < 16) {
+                msg[g & 3] = vsha1su1q_u32(vsha1su0q_u32(msg[g & 3], msg[(g + 1) & 3],
+                                                         msg[(g + 2) & 3]),
+                                           msg[(g + 3) & 3]);
+            }
+            const uint32_t nextE = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+            if (g < 5)
+                abcd = vsha1cq_u32(abcd, e, msgK);
+            else if (g >= 10 && g < 15)
+                abcd = vsha1mq_u32(abcd, e, msgK);
+            else
+                abcd = vsha1pq_u32(abcd, e, msgK);
+            e = nextE;
+        }
+        abcd = vaddq_u32(abcd, abcdSave);
+        e += eSave;
+    }
+
+    vst1q_u32(state, abcd);
+    state[4] = e;
+}
+
+#  ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+static const quint32 sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static void QT_FUNCTION_TARGET(AES)
+sha256BlocksArm(quint32 *state, const uchar *data, qsizetype blocks)
+{
+    uint32x4_t state0 = vld1q_u32(state);
+    uint32x4_t state1 = vld1q_u32(state + 4);
+
+    for (; blocks; --blocks, data += 64) {
+        const uint32x4_t abcdSave = state0;
+        const uint32x4_t efghSave = state1;
+        uint32x4_t msg[4];
+        for (int i = 0; i < 4; ++i)
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+        for (int g = 0; g < 16; ++g) {
+            const uint32x4_t msgK = vaddq_u32(msg[g & 3], vld1q_u32(sha256RoundConstants + 4 * g));
+            // the message schedule, four words at a time
+            if (g < 12)
+                msg[g & 3] = vsha256su0q_u32(msg[g & 3], msg[(g + 1) & 3]);
+            const uint32x4_t abcd = state0;
+            state0 = vsha256hq_u32(state0, state1, msgK);
+            state1 = vsha256h2q_u32(state1, abcd, msgK);
+            if (g < 12)
+                msg[g & 3] = vsha256su1q_u32(msg[g & 3], msg[(g + 2) & 3], msg[(g + 3) & 3]);
+        }
+        state0 = vaddq_u32(state0, abcdSave);
+        state1 = vaddq_u32(state1, efghSave);
+    }
+
+    vst1q_u32(state, state0);
+    vst1q_u32(state + 4, state1);
+}
+#  endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+#endif
+
+#if defined(QT_CRYPTOGRAPHICHASH_SHA_X86) || defined(QT_CRYPTOGRAPHICHASH_SHA_ARM)
+static void sha1Blocks(Sha1State *state, const uchar *data, qsizetype blocks)
+{
+    quint32 h[5] = { state->h0, state->h1, state->h2, state->h3, state->h4 };
+#  ifdef QT_CRYPTOGRAPHICHASH_SHA_X86
+    sha1BlocksX86(h, data, blocks);
+#  else
+    sha1BlocksArm(h, data, blocks);
+#  endif
+    state->h0 = h[0];
+    state->h1 = h[1];
+    state->h2 = h[2];
+    state->h3 = h[3];
+    state->h4 = h[4];
+}
+#endif
+
+// Like sha1Update(), but with the SHA instructions of the CPU where available
+static void sha1AddData(Sha1State *state, const uchar *data, qsizetype length)
+{
+#if defined(QT_CRYPTOGRAPHICHASH_SHA_X86) || defined(QT_CRYPTOGRAPHICHASH_SHA_ARM)
+    if (hasShaInstructions()) {
+        // complete the block that is buffered already
+        const qsizetype rest = qsizetype(state->messageSize & 63);
+        if (rest) {
+            const qsizetype n = qMin(64 - rest, length);
+            sha1Update(state, data, n);
+            data += n;
+            length -= n;
+        }
+        const qsizetype blocks = length / 64;
+        if (blocks) {
+            sha1Blocks(state, data, blocks);
+            state->messageSize += quint64(blocks) * 64;
+            data += blocks * 64;
+            length -= blocks * 64;
+        }
+    }
+#endif
+    if (length)
+        sha1Update(state, data, length);
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+/*
+    Like SHA224Input() and SHA256Input(), which process the data one byte at
+    a time. Whole blocks go to the compression function directly instead,
+    with the SHA instructions of the CPU where available.
+*/
+static void sha256AddData(SHA256Context *context, const uchar *data, qsizetype length)
+{
+    // complete the block that is buffered already
+    if (context->Message_Block_Index) {
+        const qsizetype n = qMin(SHA256_Message_Block_Size - context->Message_Block_Index, length);
+        SHA256Input(context, data, uint(n));
+        data += n;
+        length -= n;
+    }
+
+    const qsizetype blocks = length / SHA256_Message_Block_Size;
+    if (blocks && !context->Computed && !context->Corrupted) {
+        bool done = false;
+#if defined(QT_CRYPTOGRAPHICHASH_SHA_X86)
+        if (hasShaInstructions()) {
+            sha256BlocksX86(context->Intermediate_Hash, data, blocks);
+            done = true;
+        }
+#elif defined(QT_CRYPTOGRAPHICHASH_SHA_ARM)
+        if (hasShaInstructions()) {
+            sha256BlocksArm(context->Intermediate_Hash, data, blocks);
+            done = true;
+        }
+#endif
+        for (qsizetype i = 0; !done && i < blocks; ++i) {
+            memcpy(context->Message_Block, data + i * SHA256_Message_Block_Size,
+                   SHA256_Message_Block_Size);
+            SHA224_256ProcessMessageBlock(context);
+        }
+        const quint64 bits = (quint64(context->Length_High) << 32 | context->Length_Low)
+                + quint64(blocks) * SHA256_Message_Block_Size * 8;
+        context->Length_High = uint32_t(bits >> 32);
+        context->Length_Low = uint32_t(bits);
+        data += blocks * SHA256_Message_Block_Size;
+        length -= blocks * SHA256_Message_Block_Size;
+    }
+
+    if (length)
+        SHA256Input(context, data, uint(length));
+}
+
+/*
+    BLAKE3, as specified in https://github.com/BLAKE3-team/BLAKE3-specs.
+
+    The input is split into chunks of 1 KiB, which are the leaves of a
+    binary tree. Each parent node hashes the chaining values of its two
+    children, and the root gives the result. A subtree is the same no
+    matter in which order its nodes are computed, so large inputs are
+    split into subtrees that are hashed by the threads of the global
+    QThreadPool.
+*/
+namespace Blake3 {
+static constexpr quint32 ChunkStart = 1 << 0;
+static constexpr quint32 ChunkEnd = 1 << 1;
+static constexpr quint32 Parent = 1 << 2;
+static constexpr quint32 Root = 1 << 3;
+static constexpr qsizetype BlockLength = 64;
+static constexpr qsizetype ChunkLength = 1024;
+static constexpr int MaxDepth = 54; // 2^64 bytes of input in chunks
+// subtrees smaller than this are not worth handing to another thread
+static constexpr quint64 MinParallelChunks = 256;
+
+using ChainingValue = std::array<quint32, 8>;
+
+static constexpr ChainingValue Iv = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+struct State
+{
+    ChainingValue cv;               // of the chunk read currently
+    quint64 chunkCounter;
+    uchar block[BlockLength];
+    quint8 blockLength;
+    quint8 blocksCompressed;
+    quint8 stackSize;
+    ChainingValue stack[MaxDepth + 1]; // of the complete subtrees to the left
+};
+
+// a node whose chaining value or root output has not been computed yet
+struct Node
+{
+    ChainingValue cv;
+    quint32 block[16];
+    quint64 counter;
+    quint32 blockLength;
+    quint32 flags;
+};
+
+static inline quint64 floorPowerOfTwo(quint64 v)
+{
+    return v ? quint64(1) << (63 - qCountLeadingZeroBits(v)) : 0;
+}
+
+static inline quint32 rotr(quint32 x, int n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+static inline void g(quint32 *v, int a, int b, int c, int d, quint32 x, quint32 y)
+{
+    v[a] = v[a] + v[b] + x;
+    v[d] = rotr(v[d] ^ v[a], 16);
+    v[c] = v[c] + v[d];
+    v[b] = rotr(v[b] ^ v[c], 12);
+    v[a] = v[a] + v[b] + y;
+    v[d] = rotr(v[d] ^ v[a], 8);
+    v[c] = v[c] + v[d];
+    v[b] = rotr(v[b] ^ v[c], 7);
+}
+
+// returns the first eight words of the output, which is all but the root needs
+static void compress(quint32 *out, const ChainingValue &cv, const quint32 *block,
+                     quint64 counter, quint32 blockLength, quint32 flags, bool full = false)
+{
+    static const quint8 schedule[7][16] = {
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+        { 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 },
+        { 3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1 },
+        { 10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6 },
+        { 12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4 },
+        { 9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7 },
+        { 11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13 },
+    };
+    quint32 v[16] = {
+        cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+        Iv[0], Iv[1], Iv[2], Iv[3], quint32(counter), quint32(counter >> 32), blockLength, flags
+    };
+    for (const quint8 *m : schedule) {
+        g(v, 0, 4, 8, 12, block[m[0]], block[m[1]]);
+        g(v, 1, 5, 9, 13, block[m[2]], block[m[3]]);
+        g(v, 2, 6, 10, 14, block[m[4]], block[m[5]]);
+        g(v, 3, 7, 11, 15, block[m[6]], block[m[7]]);
+        g(v, 0, 5, 10, 15, block[m[8]], block[m[9]]);
+        g(v, 1, 6, 11, 12, block[m[10]], block[m[11]]);
+        g(v, 2, 7, 8, 13, block[m[12]], block[m[13]]);
+        g(v, 3, 4, 9, 14, block[m[14]], block[m[15]]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        out[i] = v[i] ^ v[i + 8];
+        if (full)
+            out[i + 8] = v[i + 8] ^ cv[i];
+    }
+}
+
+static inline void loadBlock(quint32 *words, const uchar *data)
+{
+    for (int i = 0; i < 16; ++i)
+        words[i] = qFromLittleEndian<quint32>(data + 4 * i);
+}
+
+static ChainingValue chainingValue(const Node &node)
+{
+    ChainingValue cv;
+    compress(cv.data(), node.cv, node.block, node.counter, node.blockLength, node.flags);
+    return cv;
+}
+
+static Node parentNode(const ChainingValue &left, const ChainingValue &right)
+{
+    Node node;
+    node.cv = Iv;
+    std::copy(left.begin(), left.end(), node.block);
+    std::copy(right.begin(), right.end(), node.block + 8);
+    node.counter = 0;
+    node.blockLength = BlockLength;
+    node.flags = Parent;
+    return node;
+}
+
+static ChainingValue chunkChainingValue(const uchar *data, quint64 counter)
+{
+    ChainingValue cv = Iv;
+    quint32 block[16];
+    for (int i = 0; i < ChunkLength / BlockLength; ++i) {
+        loadBlock(block, data + i * BlockLength);
+        const quint32 flags = (i == 0 ? ChunkStart : 0)
+                | (i == ChunkLength / BlockLength - 1 ? ChunkEnd : 0);
+        compress(cv.data(), cv, block, counter, BlockLength, flags);
+    }
+    return cv;
+}
+
+// the chaining value of the subtree of \a chunks (a power of two) whole chunks
+static ChainingValue subtreeChainingValue(const uchar *data, quint64 chunks, quint64 counter)
+{
+    if (chunks == 1)
+        return chunkChainingValue(data, counter);
+    const quint64 half = chunks / 2;
+    const ChainingValue left = subtreeChainingValue(data, half, counter);
+    const ChainingValue right = subtreeChainingValue(data + half * ChunkLength, half,
+                                                     counter + half);
+    return chainingValue(parentNode(left, right));
+}
+
+static ChainingValue parallelSubtreeChainingValue(const uchar *data, quint64 chunks,
+                                                  quint64 counter)
+{
+#if QT_CONFIG(thread)
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    quint64 segments = floorPowerOfTwo(qMin(chunks / MinParallelChunks,
+                                            quint64(threadPool->maxThreadCount())));
+    if (segments <= 1 || threadPool->contains(QThread::currentThread()))
+        return subtreeChainingValue(data, chunks, counter);
+
+    QVarLengthArray<ChainingValue, 64> cvs(segments);
+    const quint64 segmentChunks = chunks / segments;
+    QSemaphore semaphore;
+    for (quint64 i = 0; i < segments; ++i) {
+        threadPool->start([&, i]() {
+            cvs[i] = subtreeChainingValue(data + i * segmentChunks * ChunkLength, segmentChunks,
+                                          counter + i * segmentChunks);
+            semaphore.release(1);
+        });
+    }
+    semaphore.acquire(int(segments));
+
+    for (; segments > 1; segments /= 2) {
+        for (quint64 i = 0; i < segments / 2; ++i)
+            cvs[i] = chainingValue(parentNode(cvs[2 * i], cvs[2 * i + 1]));
+    }
+    return cvs[0];
+#else
+    return subtreeChainingValue(data, chunks, counter);
+#endif
+}
+
+static void init(State *state)
+{
+    state->cv = Iv;
+    state->chunkCounter = 0;
+    state->blockLength = 0;
+    state->blocksCompressed = 0;
+    state->stackSize = 0;
+}
+
+static inline qsizetype chunkLength(const State *state)
+{
+    return state->blocksCompressed * BlockLength + state->blockLength;
+}
+
+static Node chunkNode(const State *state)
+{
+    Node node;
+    node.cv = state->cv;
+    uchar block[BlockLength] = {};
+    memcpy(block, state->block, state->blockLength);
+    loadBlock(node.block, block);
+    node.counter = state->chunkCounter;
+    node.blockLength = state->blockLength;
+    node.flags = (state->blocksCompressed ? 0 : ChunkStart) | ChunkEnd;
+    return node;
+}
+
+// Merges the subtrees on the stack that are complete once \a chunks chunks
+// have been read, which leaves one subtree per bit set in \a chunks.
+static void mergeStack(State *state, quint64 chunks)
+{
+    while (state->stackSize > qPopulationCount(chunks)) {
+        ChainingValue &left = state->stack[state->stackSize - 2];
+        left = chainingValue(parentNode(left, state->stack[state->stackSize - 1]));
+        --state->stackSize;
+    }
+}
+
+// Pushes the chaining value of the subtree starting at chunk \a counter.
+static void pushChainingValue(State *state, const ChainingValue &cv, quint64 counter)
+{
+    mergeStack(state, counter);
+    state->stack[state->stackSize++] = cv;
+}
+
+static void update(State *state, const uchar *data, qsizetype length)
+{
+    while (length) {
+        // a chunk is finished only once more input follows, as the last one
+        // may have to be the root
+        if (chunkLength(state) == ChunkLength) {
+            pushChainingValue(state, chainingValue(chunkNode(state)), state->chunkCounter);
+            ++state->chunkCounter;
+            state->cv = Iv;
+            state->blockLength = 0;
+            state->blocksCompressed = 0;
+        }
+
+        if (chunkLength(state) == 0 && length > ChunkLength) {
+            // hash the largest subtree that the input covers and that
+            // starts at this chunk, leaving at least one byte
+            quint64 chunks = floorPowerOfTwo(quint64(length - 1) / ChunkLength);
+            if (state->chunkCounter)
+                chunks = qMin(chunks, state->chunkCounter & (~state->chunkCounter + 1));
+            const ChainingValue cv = parallelSubtreeChainingValue(data, chunks,
+                                                                  state->chunkCounter);
+            pushChainingValue(state, cv, state->chunkCounter);
+            state->chunkCounter += chunks;
+            data += chunks * ChunkLength;
+            length -= chunks * ChunkLength;
+            continue;
+        }
+
+        if (state->blockLength == BlockLength) {
+            quint32 block[16];
+            loadBlock(block, state->block);
+            compress(state->cv.data(), state->cv, block, state->chunkCounter, BlockLength,
+                     state->blocksCompressed ? 0 : ChunkStart);
+            ++state->blocksCompressed;
+            state->blockLength = 0;
+        }
+        const qsizetype n = qMin(qMin(BlockLength - state->blockLength,
+                                      ChunkLength - chunkLength(state)), length);
+        memcpy(state->block + state->blockLength, data, n);
+        state->blockLength += quint8(n);
+        data += n;
+        length -= n;
+    }
+    // finalize() merges the current chunk with each subtree on the stack in turn
+    mergeStack(state, state->chunkCounter);
+}
+
+static void finalize(const State *state, uchar *out, qsizetype outLength)
+{
+    Node node = chunkNode(state);
+    for (int i = state->stackSize; i > 0; --i)
+        node = parentNode(state->stack[i - 1], chainingValue(node));
+
+    quint32 words[16];
+    for (quint64 counter = 0; outLength > 0; ++counter) {
+        compress(words, node.cv, node.block, counter, node.blockLength, node.flags | Root, true);
+        for (int i = 0; i < 16 && outLength > 0; ++i, out += 4, outLength -= 4) {
+            uchar bytes[4];
+            qToLittleEndian(words[i], bytes);
+            memcpy(out, bytes, qMin<qsizetype>(4, outLength));
+        }
+    }
+}
+} // namespace Blake3
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
 static constexpr qsizetype MaxHashLength = 64;
 
 static constexpr int hashLengthInternal(QCryptographicHash::Algorithm method) noexcept
@@ -171,6 +787,7 @@ static constexpr int hashLengthInternal(QCryptographicHash::Algorithm method) no
     case QCryptographicHash::Keccak_256:
     case QCryptographicHash::Blake2b_256:
     case QCryptographicHash::Blake2s_256:
+    case QCryptographicHash::Blake3_256:
         static_assert(256 / 8 <= MaxHashLength);
         return 256 / 8;
     case QCryptographicHash::RealSha3_384:
@@ -216,6 +833,7 @@ public:
         SHA3Context sha3Context;
         blake2b_state blake2bContext;
         blake2s_state blake2sContext;
+        Blake3::State blake3Context;
 #endif
     };
 #ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -337,6 +955,9 @@ void QCryptographicHashPrivate::sha3Finish(int bitCount, Sha3Variant sha3Variant
   \value Blake2s_160 Generate a BLAKE2s-160 hash sum. Introduced in Qt 6.0
   \value Blake2s_224 Generate a BLAKE2s-224 hash sum. Introduced in Qt 6.0
   \value Blake2s_256 Generate a BLAKE2s-256 hash sum. Introduced in Qt 6.0
+  \value Blake3_256 Generate a BLAKE3 hash sum of the default length, 256 bits.
+         Large amounts of data passed at once are hashed by the threads of
+         the global QThreadPool. Introduced in Qt 6.4
   \omitvalue RealSha3_224
   \omitvalue RealSha3_256
   \omitvalue RealSha3_384
@@ -429,6 +1050,10 @@ void QCryptographicHashPrivate::reset() noexcept
         new (&blake2sContext) blake2s_state;
         blake2s_init(&blake2sContext, hashLengthInternal(method));
         break;
+    case QCryptographicHash::Blake3_256:
+        new (&blake3Context) Blake3::State;
+        Blake3::init(&blake3Context);
+        break;
 #endif
     }
     result.clear();
@@ -476,7 +1101,7 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
 #endif
         switch (method) {
         case QCryptographicHash::Sha1:
-            sha1Update(&sha1Context, (const unsigned char *)data, length);
+            sha1AddData(&sha1Context, reinterpret_cast<const uchar *>(data), length);
             break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
         default:
@@ -491,10 +1116,10 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
             MD5Update(&md5Context, (const unsigned char *)data, length);
             break;
         case QCryptographicHash::Sha224:
-            SHA224Input(&sha224Context, reinterpret_cast<const unsigned char *>(data), length);
+            sha256AddData(&sha224Context, reinterpret_cast<const uchar *>(data), length);
             break;
         case QCryptographicHash::Sha256:
-            SHA256Input(&sha256Context, reinterpret_cast<const unsigned char *>(data), length);
+            sha256AddData(&sha256Context, reinterpret_cast<const uchar *>(data), length);
             break;
         case QCryptographicHash::Sha384:
             SHA384Input(&sha384Context, reinterpret_cast<const unsigned char *>(data), length);
@@ -524,6 +1149,9 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
         case QCryptographicHash::Blake2s_256:
             blake2s_update(&blake2sContext, reinterpret_cast<const uint8_t *>(data), length);
             break;
+        case QCryptographicHash::Blake3_256:
+            Blake3::update(&blake3Context, reinterpret_cast<const uchar *>(data), length);
+            break;
 #endif
         }
     }
@@ -533,6 +1161,9 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
 /*!
   Reads the data from the open QIODevice \a device until it ends
   and hashes it. Returns \c true if reading was successful.
+
+  Large files are mapped into memory and hashed without being copied,
+  if possible.
   \since 5.0
  */
 bool QCryptographicHash::addData(QIODevice *device)
@@ -543,11 +1174,35 @@ bool QCryptographicHash::addData(QIODevice *device)
     if (!device->isOpen())
         return false;
 
-    char buffer[1024];
-    int length;
+#ifndef QT_BOOTSTRAPPED
+    // Mapping costs more than reading for small files, and a window of
+    // the file at a time keeps the address space needed bounded.
+    constexpr qint64 MinMapSize = 1024 * 1024;
+    constexpr qint64 MapWindowSize = 64 * 1024 * 1024;
+    QFileDevice *file = qobject_cast<QFileDevice *>(device);
+    if (file && !file->isSequential() && !file->isTextModeEnabled()
+            && file->size() - file->pos() >= MinMapSize) {
+        qint64 pos = file->pos();
+        const qint64 size = file->size();
+        while (pos < size) {
+            const qint64 windowSize = qMin(size - pos, MapWindowSize);
+            uchar *map = file->map(pos, windowSize);
+            if (!map)
+                break; // read the rest
+            d->addData({reinterpret_cast<const char *>(map), qsizetype(windowSize)});
+            file->unmap(map);
+            pos += windowSize;
+        }
+        if (!file->seek(pos))
+            return false;
+    }
+#endif
+
+    QVarLengthArray<char, 4096> buffer(qBound(qint64(4096), device->bytesAvailable(), qint64(64 * 1024)));
+    qint64 length;
 
-    while ((length = device->read(buffer, sizeof(buffer))) > 0)
-        d->addData({buffer, length});
+    while ((length = device->read(buffer.data(), buffer.size())) > 0)
+        d->addData({buffer.data(), qsizetype(length)});
 
     return device->atEnd();
 }
@@ -668,6 +1323,12 @@ void QCryptographicHashPrivate::finalize() noexcept
         blake2s_final(&copy, reinterpret_cast<uint8_t *>(result.data()), length);
         break;
     }
+    case QCryptographicHash::Blake3_256: {
+        const auto length = hashLengthInternal(method);
+        result.resizeForOverwrite(length);
+        Blake3::finalize(&blake3Context, reinterpret_cast<uchar *>(result.data()), length);
+        break;
+    }
 #endif
     }
 }
@@ -95,6 +95,7 @@ public:
         Blake2s_160,
         Blake2s_224,
         Blake2s_256,
+        Blake3_256,
 #endif
     };
     Q_ENUM(Algorithm)
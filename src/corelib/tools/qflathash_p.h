@@ -0,0 +1,834 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATHASH_P_H
+#define QFLATHASH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qendian.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmath.h>
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/private/qsimd_p.h>
+
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  QFlatHash is an unordered associative container that hashes keys the
+  same way as QHash (qHash() with the per-table seed from QHashSeed) and
+  is implicitly shared like QHash, but uses a flat open addressing table
+  in the style of Abseil's "Swiss tables".
+
+  Next to the array of key/value nodes, the table keeps one control byte
+  per bucket, which is either empty, deleted, or holds the low 7 bits of
+  the hash of the key stored in the bucket. Lookups compare a group of 16
+  control bytes at a time (with SSE2 where available, otherwise as two
+  64-bit words) and only look at the nodes whose control byte matches, so
+  a lookup that misses the cache usually costs one miss in the control
+  bytes and one in the nodes.
+
+  Nodes are stored inline, so QFlatHash works best for small keys and
+  values. Inserting an element may move all other elements, which
+  invalidates all iterators and references into the container; removing
+  an element only invalidates iterators and references to that element.
+*/
+
+namespace QFlatHashPrivate {
+
+using ctrl_t = qint8;
+
+// the control byte of a bucket holding a node is the low 7 bits of its
+// hash, so it is never negative
+enum : ctrl_t {
+    Empty = -128,
+    Deleted = -2
+};
+
+constexpr inline bool isFull(ctrl_t c) noexcept { return c >= 0; }
+
+constexpr inline size_t h1(size_t hash) noexcept { return hash >> 7; }
+constexpr inline ctrl_t h2(size_t hash) noexcept { return ctrl_t(hash & 0x7f); }
+
+// one bit per control byte of a Group
+struct BitMask
+{
+    uint mask;
+
+    explicit operator bool() const noexcept { return mask != 0; }
+    uint lowest() const noexcept { return qCountTrailingZeroBits(mask); }
+    void removeLowest() noexcept { mask &= mask - 1; }
+    uint trailingZeros() const noexcept { return mask ? qCountTrailingZeroBits(mask) : 16; }
+    uint leadingZeros() const noexcept { return qCountLeadingZeroBits(quint16(mask)); }
+};
+
+struct Group
+{
+    static constexpr size_t Width = 16;
+
+#if defined(__SSE2__)
+    __m128i ctrl;
+
+    explicit Group(const ctrl_t *p) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)))
+    {}
+
+    BitMask match(ctrl_t h) const noexcept
+    {
+        return { uint(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), ctrl))) };
+    }
+    BitMask matchEmptyOrDeleted() const noexcept
+    {
+        // Empty and Deleted are the only control bytes with the sign bit set
+        return { uint(_mm_movemask_epi8(ctrl)) };
+    }
+#else
+    // Without SSE2, the group is handled as two 64-bit words, one byte
+    // per control byte, with the usual SWAR bit tricks.
+    quint64 ctrl[2];
+
+    static constexpr quint64 Lsbs = Q_UINT64_C(0x0101010101010101);
+    static constexpr quint64 Msbs = Lsbs << 7;
+
+    explicit Group(const ctrl_t *p) noexcept
+        : ctrl{ qFromLittleEndian<quint64>(p), qFromLittleEndian<quint64>(p + 8) }
+    {}
+
+    // gathers the high bits of the eight bytes of w into the low eight bits
+    static uint highBits(quint64 w) noexcept
+    {
+        return uint((((w & Msbs) >> 7) * Q_UINT64_C(0x0102040810204080)) >> 56);
+    }
+    static uint matchWord(quint64 w, ctrl_t h) noexcept
+    {
+        const quint64 x = w ^ (Lsbs * quint8(h));
+        // sets the high bit of exactly those bytes of x that are zero
+        return highBits(~(((x & ~Msbs) + ~Msbs) | x));
+    }
+
+    BitMask match(ctrl_t h) const noexcept
+    {
+        return { matchWord(ctrl[0], h) | matchWord(ctrl[1], h) << 8 };
+    }
+    BitMask matchEmptyOrDeleted() const noexcept
+    {
+        // Empty and Deleted are the only control bytes with the sign bit set
+        return { highBits(ctrl[0]) | highBits(ctrl[1]) << 8 };
+    }
+#endif
+    BitMask matchEmpty() const noexcept { return match(Empty); }
+};
+
+template <typename Node>
+struct Data
+{
+    using Key = typename Node::KeyType;
+    using T = typename Node::ValueType;
+
+    QtPrivate::RefCount ref = {{1}};
+    size_t size = 0;
+    size_t numBuckets = 0;
+    size_t growthLeft = 0;
+    size_t seed = 0;
+    // numBuckets + Group::Width control bytes; the last Group::Width bytes
+    // mirror the first ones, so that a Group can be loaded at any bucket
+    ctrl_t *ctrl = nullptr;
+    Node *nodes = nullptr;
+
+    static constexpr size_t maxLoad(size_t buckets) noexcept
+    {
+        // keep the load factor at or below 7/8
+        return buckets - buckets / 8;
+    }
+    static size_t bucketsForCapacity(size_t requestedCapacity) noexcept
+    {
+        if (requestedCapacity <= maxLoad(Group::Width))
+            return Group::Width;
+        return size_t(qNextPowerOfTwo(quint64(requestedCapacity + requestedCapacity / 7)));
+    }
+
+    Data(size_t reserve = 0)
+    {
+        allocate(bucketsForCapacity(reserve));
+        seed = QHashSeed::globalSeed();
+    }
+    Data(const Data &other)
+        : size(other.size), seed(other.seed)
+    {
+        // same layout, so that bucket indexes stay valid across a detach
+        allocate(other.numBuckets);
+        growthLeft = other.growthLeft;
+        memcpy(ctrl, other.ctrl, numBuckets + Group::Width);
+        for (size_t i = 0; i < numBuckets; ++i) {
+            if (isFull(ctrl[i]))
+                new (nodes + i) Node(other.nodes[i]);
+        }
+    }
+    Data(const Data &other, size_t reserved)
+        : size(other.size), seed(other.seed)
+    {
+        allocate(bucketsForCapacity(qMax(size, reserved)));
+        growthLeft -= size;
+        for (size_t i = 0; i < other.numBuckets; ++i) {
+            if (!isFull(other.ctrl[i]))
+                continue;
+            const Node &n = other.nodes[i];
+            size_t hash = QHashPrivate::calculateHash(n.key, seed);
+            size_t bucket = findInsertSlot(hash);
+            new (nodes + bucket) Node(n);
+            setCtrl(bucket, h2(hash));
+        }
+    }
+    ~Data()
+    {
+        destroyNodes(ctrl, nodes, numBuckets);
+        deallocate(ctrl, nodes, numBuckets);
+    }
+
+    static Data *detached(Data *d)
+    {
+        if (!d)
+            return new Data;
+        Data *dd = new Data(*d);
+        if (!d->ref.deref())
+            delete d;
+        return dd;
+    }
+    static Data *detached(Data *d, size_t size)
+    {
+        if (!d)
+            return new Data(size);
+        Data *dd = new Data(*d, size);
+        if (!d->ref.deref())
+            delete d;
+        return dd;
+    }
+
+    void allocate(size_t buckets)
+    {
+        numBuckets = buckets;
+        growthLeft = maxLoad(buckets);
+        nodes = std::allocator<Node>().allocate(buckets);
+        ctrl = new ctrl_t[buckets + Group::Width];
+        memset(ctrl, Empty, buckets + Group::Width);
+    }
+    static void destroyNodes(ctrl_t *ctrl, Node *nodes, size_t buckets)
+    {
+        if constexpr (!std::is_trivially_destructible<Node>::value) {
+            for (size_t i = 0; i < buckets; ++i) {
+                if (isFull(ctrl[i]))
+                    nodes[i].~Node();
+            }
+        }
+    }
+    static void deallocate(ctrl_t *ctrl, Node *nodes, size_t buckets)
+    {
+        delete[] ctrl;
+        std::allocator<Node>().deallocate(nodes, buckets);
+    }
+
+    void setCtrl(size_t bucket, ctrl_t c) noexcept
+    {
+        ctrl[bucket] = c;
+        if (bucket < Group::Width)
+            ctrl[bucket + numBuckets] = c;
+    }
+
+    // Probes groups of buckets starting at the bucket selected by the hash.
+    // The distance between the groups grows by one group in every step,
+    // which visits every group once as numBuckets is a power of two.
+    template <typename Visitor>
+    size_t probe(size_t hash, Visitor visitor) const
+    {
+        const size_t mask = numBuckets - 1;
+        size_t pos = h1(hash) & mask;
+        size_t step = 0;
+        while (true) {
+            const Group g(ctrl + pos);
+            size_t bucket;
+            if (visitor(g, pos, bucket))
+                return bucket;
+            step += Group::Width;
+            pos = (pos + step) & mask;
+            Q_ASSERT(step <= numBuckets);
+        }
+    }
+
+    size_t findNode(const Key &key, size_t hash) const
+    {
+        const ctrl_t h = h2(hash);
+        const size_t mask = numBuckets - 1;
+        return probe(hash, [&](const Group &g, size_t pos, size_t &bucket) {
+            for (BitMask m = g.match(h); m; m.removeLowest()) {
+                bucket = (pos + m.lowest()) & mask;
+                if (qHashEquals(nodes[bucket].key, key))
+                    return true;
+            }
+            bucket = numBuckets;
+            return bool(g.matchEmpty());
+        });
+    }
+    size_t find(const Key &key) const
+    {
+        if (!size)
+            return numBuckets;
+        return findNode(key, QHashPrivate::calculateHash(key, seed));
+    }
+
+    size_t findInsertSlot(size_t hash) const noexcept
+    {
+        const size_t mask = numBuckets - 1;
+        return probe(hash, [&](const Group &g, size_t pos, size_t &bucket) {
+            const BitMask m = g.matchEmptyOrDeleted();
+            bucket = (pos + m.lowest()) & mask;
+            return bool(m);
+        });
+    }
+
+    struct InsertionResult
+    {
+        size_t bucket;
+        size_t hash;
+        bool initialized;
+    };
+    // Finds the bucket holding key or the bucket a node for key has to be
+    // constructed in, followed by a call to commitInsert().
+    InsertionResult findOrInsert(const Key &key)
+    {
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        size_t bucket = size ? findNode(key, hash) : numBuckets;
+        if (bucket != numBuckets)
+            return { bucket, hash, true };
+        bucket = findInsertSlot(hash);
+        if (growthLeft == 0 && ctrl[bucket] != Deleted) {
+            rehash(size + 1);
+            bucket = findInsertSlot(hash);
+        }
+        return { bucket, hash, false };
+    }
+    void commitInsert(const InsertionResult &r) noexcept
+    {
+        if (ctrl[r.bucket] == Empty)
+            --growthLeft;
+        setCtrl(r.bucket, h2(r.hash));
+        ++size;
+    }
+    bool shouldGrow() const noexcept
+    {
+        return growthLeft == 0;
+    }
+
+    void rehash(size_t sizeHint = 0)
+    {
+        ctrl_t *oldCtrl = ctrl;
+        Node *oldNodes = nodes;
+        const size_t oldBuckets = numBuckets;
+
+        // at the same number of buckets, this only drops the deleted markers
+        allocate(bucketsForCapacity(qMax(size, sizeHint)));
+        growthLeft -= size;
+        for (size_t i = 0; i < oldBuckets; ++i) {
+            if (!isFull(oldCtrl[i]))
+                continue;
+            Node &n = oldNodes[i];
+            size_t hash = QHashPrivate::calculateHash(n.key, seed);
+            size_t bucket = findInsertSlot(hash);
+            new (nodes + bucket) Node(std::move(n));
+            setCtrl(bucket, h2(hash));
+        }
+        destroyNodes(oldCtrl, oldNodes, oldBuckets);
+        deallocate(oldCtrl, oldNodes, oldBuckets);
+    }
+
+    void erase(size_t bucket) noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        Q_ASSERT(isFull(ctrl[bucket]));
+        nodes[bucket].~Node();
+        --size;
+
+        // If no group of Group::Width buckets around this one has ever been
+        // full, no probe sequence can have continued past it, and the
+        // bucket can be marked empty again instead of deleted.
+        const size_t before = (bucket - Group::Width) & (numBuckets - 1);
+        const BitMask emptyAfter = Group(ctrl + bucket).matchEmpty();
+        const BitMask emptyBefore = Group(ctrl + before).matchEmpty();
+        const bool wasNeverFull = emptyBefore && emptyAfter
+                && emptyAfter.trailingZeros() + emptyBefore.leadingZeros() < Group::Width;
+        setCtrl(bucket, wasNeverFull ? Empty : Deleted);
+        if (wasNeverFull)
+            ++growthLeft;
+    }
+
+    size_t nextFull(size_t bucket) const noexcept
+    {
+        while (bucket < numBuckets && !isFull(ctrl[bucket]))
+            ++bucket;
+        return bucket;
+    }
+};
+
+} // namespace QFlatHashPrivate
+
+template <typename Key, typename T>
+class QFlatHash
+{
+    using Node = QHashPrivate::Node<Key, T>;
+    using Data = QFlatHashPrivate::Data<Node>;
+
+    Data *d = nullptr;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = T;
+    using size_type = qsizetype;
+    using difference_type = qsizetype;
+    using reference = T &;
+    using const_reference = const T &;
+
+    QFlatHash() noexcept = default;
+    QFlatHash(std::initializer_list<std::pair<Key, T>> list)
+        : d(new Data(list.size()))
+    {
+        for (auto it = list.begin(); it != list.end(); ++it)
+            insert(it->first, it->second);
+    }
+    QFlatHash(const QFlatHash &other) noexcept
+        : d(other.d)
+    {
+        if (d)
+            d->ref.ref();
+    }
+    ~QFlatHash()
+    {
+        if (d && !d->ref.deref())
+            delete d;
+    }
+
+    QFlatHash &operator=(const QFlatHash &other) noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        if (d != other.d) {
+            Data *o = other.d;
+            if (o)
+                o->ref.ref();
+            if (d && !d->ref.deref())
+                delete d;
+            d = o;
+        }
+        return *this;
+    }
+
+    QFlatHash(QFlatHash &&other) noexcept
+        : d(std::exchange(other.d, nullptr))
+    {
+    }
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_MOVE_AND_SWAP(QFlatHash)
+
+    void swap(QFlatHash &other) noexcept { qt_ptr_swap(d, other.d); }
+
+    template <typename AKey = Key, typename AT = T>
+    QTypeTraits::compare_eq_result_container<QFlatHash, AKey, AT> operator==(const QFlatHash &other) const noexcept
+    {
+        if (d == other.d)
+            return true;
+        if (size() != other.size())
+            return false;
+
+        for (const_iterator it = other.begin(); it != other.end(); ++it) {
+            const_iterator i = find(it.key());
+            if (i == end() || !i.node()->valuesEqual(it.node()))
+                return false;
+        }
+        // all values must be the same as size is the same
+        return true;
+    }
+    template <typename AKey = Key, typename AT = T>
+    QTypeTraits::compare_eq_result_container<QFlatHash, AKey, AT> operator!=(const QFlatHash &other) const noexcept
+    { return !(*this == other); }
+
+    inline qsizetype size() const noexcept { return d ? qsizetype(d->size) : 0; }
+    inline qsizetype count() const noexcept { return size(); }
+    inline bool isEmpty() const noexcept { return !d || d->size == 0; }
+    inline bool empty() const noexcept { return isEmpty(); }
+
+    inline qsizetype capacity() const noexcept { return d ? qsizetype(Data::maxLoad(d->numBuckets)) : 0; }
+    void reserve(qsizetype size)
+    {
+        if (isDetached())
+            d->rehash(size);
+        else
+            d = Data::detached(d, size_t(size));
+    }
+    inline void squeeze()
+    {
+        if (capacity())
+            reserve(0);
+    }
+
+    inline void detach()
+    {
+        if (!d || d->ref.isShared())
+            d = Data::detached(d);
+    }
+    inline bool isDetached() const noexcept { return d && !d->ref.isShared(); }
+    bool isSharedWith(const QFlatHash &other) const noexcept { return d == other.d; }
+
+    void clear() noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        if (d && !d->ref.deref())
+            delete d;
+        d = nullptr;
+    }
+
+    bool remove(const Key &key)
+    {
+        if (isEmpty()) // prevents detaching shared null
+            return false;
+        // the layout survives the detach, so the bucket index stays valid
+        size_t bucket = d->find(key);
+        if (bucket == d->numBuckets)
+            return false;
+        detach();
+        d->erase(bucket);
+        return true;
+    }
+    T take(const Key &key)
+    {
+        if (isEmpty()) // prevents detaching shared null
+            return T();
+        size_t bucket = d->find(key);
+        if (bucket == d->numBuckets)
+            return T();
+        detach();
+        T value = d->nodes[bucket].takeValue();
+        d->erase(bucket);
+        return value;
+    }
+
+    bool contains(const Key &key) const noexcept
+    {
+        if (!d)
+            return false;
+        return d->find(key) != d->numBuckets;
+    }
+    qsizetype count(const Key &key) const noexcept
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    T value(const Key &key) const noexcept
+    {
+        if (d) {
+            size_t bucket = d->find(key);
+            if (bucket != d->numBuckets)
+                return d->nodes[bucket].value;
+        }
+        return T();
+    }
+    T value(const Key &key, const T &defaultValue) const noexcept
+    {
+        if (d) {
+            size_t bucket = d->find(key);
+            if (bucket != d->numBuckets)
+                return d->nodes[bucket].value;
+        }
+        return defaultValue;
+    }
+
+    T &operator[](const Key &key)
+    {
+        const auto copy = isDetached() ? QFlatHash() : *this; // keep 'key' alive across the detach
+        detach();
+        auto result = d->findOrInsert(key);
+        if (!result.initialized) {
+            Node::createInPlace(d->nodes + result.bucket, key, T());
+            d->commitInsert(result);
+        }
+        return d->nodes[result.bucket].value;
+    }
+    const T operator[](const Key &key) const noexcept
+    {
+        return value(key);
+    }
+
+    QList<Key> keys() const { return QList<Key>(keyBegin(), keyEnd()); }
+    QList<T> values() const { return QList<T>(begin(), end()); }
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class QFlatHash;
+        friend class const_iterator;
+
+        Data *d = nullptr;
+        size_t bucket = 0;
+
+        iterator(Data *d, size_t bucket) noexcept : d(d), bucket(bucket) {}
+        Node *node() const noexcept { return d->nodes + bucket; }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        constexpr iterator() noexcept = default;
+
+        inline const Key &key() const noexcept { return node()->key; }
+        inline T &value() const noexcept { return node()->value; }
+        inline T &operator*() const noexcept { return node()->value; }
+        inline T *operator->() const noexcept { return &node()->value; }
+        inline bool operator==(const iterator &o) const noexcept { return d == o.d && bucket == o.bucket; }
+        inline bool operator!=(const iterator &o) const noexcept { return !(*this == o); }
+
+        inline iterator &operator++() noexcept
+        {
+            bucket = d->nextFull(bucket + 1);
+            return *this;
+        }
+        inline iterator operator++(int) noexcept
+        {
+            iterator r = *this;
+            ++(*this);
+            return r;
+        }
+
+        inline bool operator==(const const_iterator &o) const noexcept { return const_iterator(*this) == o; }
+        inline bool operator!=(const const_iterator &o) const noexcept { return !(*this == o); }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class QFlatHash;
+
+        const Data *d = nullptr;
+        size_t bucket = 0;
+
+        const_iterator(const Data *d, size_t bucket) noexcept : d(d), bucket(bucket) {}
+        const Node *node() const noexcept { return d->nodes + bucket; }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        constexpr const_iterator() noexcept = default;
+        inline const_iterator(const iterator &o) noexcept : d(o.d), bucket(o.bucket) {}
+
+        inline const Key &key() const noexcept { return node()->key; }
+        inline const T &value() const noexcept { return node()->value; }
+        inline const T &operator*() const noexcept { return node()->value; }
+        inline const T *operator->() const noexcept { return &node()->value; }
+        inline bool operator==(const const_iterator &o) const noexcept { return d == o.d && bucket == o.bucket; }
+        inline bool operator!=(const const_iterator &o) const noexcept { return !(*this == o); }
+
+        inline const_iterator &operator++() noexcept
+        {
+            bucket = d->nextFull(bucket + 1);
+            return *this;
+        }
+        inline const_iterator operator++(int) noexcept
+        {
+            const_iterator r = *this;
+            ++(*this);
+            return r;
+        }
+    };
+    friend class const_iterator;
+
+    class key_iterator
+    {
+        const_iterator i;
+
+    public:
+        typedef typename const_iterator::iterator_category iterator_category;
+        typedef qptrdiff difference_type;
+        typedef Key value_type;
+        typedef const Key *pointer;
+        typedef const Key &reference;
+
+        key_iterator() noexcept = default;
+        explicit key_iterator(const_iterator o) noexcept : i(o) { }
+
+        const Key &operator*() const noexcept { return i.key(); }
+        const Key *operator->() const noexcept { return &i.key(); }
+        bool operator==(key_iterator o) const noexcept { return i == o.i; }
+        bool operator!=(key_iterator o) const noexcept { return i != o.i; }
+
+        inline key_iterator &operator++() noexcept { ++i; return *this; }
+        inline key_iterator operator++(int) noexcept { return key_iterator(i++);}
+        const_iterator base() const noexcept { return i; }
+    };
+
+    // STL style
+    inline iterator begin() { detach(); return iterator(d, d->nextFull(0)); }
+    inline const_iterator begin() const noexcept { return constBegin(); }
+    inline const_iterator cbegin() const noexcept { return constBegin(); }
+    inline const_iterator constBegin() const noexcept
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d, d->nextFull(0));
+    }
+    inline iterator end() noexcept { return d ? iterator(d, d->numBuckets) : iterator(); }
+    inline const_iterator end() const noexcept { return constEnd(); }
+    inline const_iterator cend() const noexcept { return constEnd(); }
+    inline const_iterator constEnd() const noexcept
+    {
+        return d ? const_iterator(d, d->numBuckets) : const_iterator();
+    }
+    inline key_iterator keyBegin() const noexcept { return key_iterator(begin()); }
+    inline key_iterator keyEnd() const noexcept { return key_iterator(end()); }
+
+    iterator erase(const_iterator it)
+    {
+        Q_ASSERT(it != constEnd());
+        // the layout survives the detach, so the bucket index stays valid
+        const size_t bucket = it.bucket;
+        detach();
+        d->erase(bucket);
+        return iterator(d, d->nextFull(bucket + 1));
+    }
+
+    iterator find(const Key &key)
+    {
+        if (isEmpty()) // prevents detaching shared null
+            return end();
+        size_t bucket = d->find(key);
+        if (bucket == d->numBuckets)
+            return end();
+        detach();
+        return iterator(d, bucket);
+    }
+    const_iterator find(const Key &key) const noexcept
+    {
+        return constFind(key);
+    }
+    const_iterator constFind(const Key &key) const noexcept
+    {
+        if (!d)
+            return constEnd();
+        return const_iterator(d, d->find(key));
+    }
+
+    iterator insert(const Key &key, const T &value)
+    {
+        return emplace(key, value);
+    }
+    void insert(const QFlatHash &other)
+    {
+        if (d == other.d || !other.d)
+            return;
+        if (!d) {
+            *this = other;
+            return;
+        }
+
+        detach();
+        for (auto it = other.begin(); it != other.end(); ++it)
+            emplace(it.key(), it.value());
+    }
+
+    template <typename ...Args>
+    iterator emplace(const Key &key, Args &&... args)
+    {
+        Key copy = key; // Needs to be explicit for MSVC 2019
+        return emplace(std::move(copy), std::forward<Args>(args)...);
+    }
+
+    template <typename ...Args>
+    iterator emplace(Key &&key, Args &&... args)
+    {
+        if (isDetached()) {
+            if (d->shouldGrow()) // Construct the value now so that no dangling references are used
+                return emplace_helper(std::move(key), T(std::forward<Args>(args)...));
+            return emplace_helper(std::move(key), std::forward<Args>(args)...);
+        }
+        // else: we must detach
+        const auto copy = *this; // keep 'args' alive across the detach/growth
+        detach();
+        return emplace_helper(std::move(key), std::forward<Args>(args)...);
+    }
+
+private:
+    template <typename ...Args>
+    iterator emplace_helper(Key &&key, Args &&... args)
+    {
+        auto result = d->findOrInsert(key);
+        Node *n = d->nodes + result.bucket;
+        if (!result.initialized) {
+            Node::createInPlace(n, std::move(key), std::forward<Args>(args)...);
+            d->commitInsert(result);
+        } else {
+            n->emplaceValue(std::forward<Args>(args)...);
+        }
+        return iterator(d, result.bucket);
+    }
+};
+
+template <typename Key, typename T>
+inline void swap(QFlatHash<Key, T> &lhs, QFlatHash<Key, T> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+QT_END_NAMESPACE
+
+#endif // QFLATHASH_P_H
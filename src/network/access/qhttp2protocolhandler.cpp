@@ -379,9 +379,11 @@ bool QHttp2ProtocolHandler::sendRequest()
 
     m_channel->state = QHttpNetworkConnectionChannel::WritingState;
     // Check what was promised/pushed, maybe we do not have to send a request
-    // and have a response already?
+    // and have a response already? We get here every time a stream finishes,
+    // so don't build a key for each queued request if nothing was promised.
 
-    for (auto it = requests.begin(), endIt = requests.end(); it != endIt;) {
+    for (auto it = requests.begin(), endIt = requests.end();
+         !promisedData.isEmpty() && it != endIt;) {
         const auto key = urlkey_from_request(it->first).toString();
         if (!promisedData.contains(key)) {
             ++it;
@@ -1358,6 +1360,7 @@ quint32 QHttp2ProtocolHandler::createNewStream(const HttpMessagePair &message, b
     replyPrivate->connection = m_connection;
     replyPrivate->connectionChannel = m_channel;
     reply->setHttp2WasUsed(true);
+    m_connection->d_func()->requestDispatched(reply);
     streamIDs.insert(reply, newStreamID);
     connect(reply, SIGNAL(destroyed(QObject*)),
             this, SLOT(_q_replyDestroyed(QObject*)));
@@ -0,0 +1,493 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qhttpconnectionpool.h"
+#include "qhttpconnectionpool_p.h"
+
+#include "qdebug.h"
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QHttpConnectionPoolConfiguration
+    \brief The QHttpConnectionPoolConfiguration class controls how
+    QNetworkAccessManager pools its HTTP connections.
+    \since 6.4
+
+    \reentrant
+    \inmodule QtNetwork
+    \ingroup network
+    \ingroup shared
+
+    QNetworkAccessManager keeps the connections it opens to a host in a pool
+    and reuses them for later requests to the same host. For each host
+    (identified by scheme, host name, port and proxy) there is one pool entry,
+    which in turn owns a number of parallel TCP connections.
+
+    QHttpConnectionPoolConfiguration controls:
+
+    \list
+      \li The number of parallel connections opened to a single host for
+          HTTP/1.1. Requests that cannot be sent on one of those connections
+          are queued until a connection becomes free. HTTP/2 multiplexes all
+          requests over a single connection and is not affected.
+      \li The number of idle hosts whose pool entries are kept open, and for
+          how long an idle entry is kept before its connections are closed.
+      \li How many requests are pipelined on one HTTP/1.1 connection when
+          QNetworkRequest::HttpPipeliningAllowedAttribute is set.
+      \li How many connections QNetworkAccessManager::connectToHost() and
+          QNetworkAccessManager::connectToHostEncrypted() open ahead of time.
+    \endlist
+
+    \note The per-host parameters only apply to connections that are created
+    after the configuration was set with
+    QNetworkAccessManager::setConnectionPoolConfiguration(). Call
+    QNetworkAccessManager::clearConnectionCache() to apply them to hosts that
+    are already in the pool.
+
+    \sa QNetworkAccessManager::setConnectionPoolConfiguration(), QHttpConnectionPoolStatistics
+*/
+
+class QHttpConnectionPoolConfigurationPrivate : public QSharedData
+{
+public:
+    // Same as QHttpNetworkConnectionPrivate::defaultHttpChannelCount.
+    qsizetype maximumConnectionsPerHost = 6;
+    qsizetype maximumIdleHosts = -1;
+    // Same as the expiry time of QNetworkAccessCache.
+    std::chrono::seconds idleTimeout = std::chrono::seconds(120);
+    // Same as QHttpNetworkConnectionPrivate::defaultPipelineLength.
+    qsizetype pipeliningDepth = 3;
+    qsizetype preConnectCount = 1;
+};
+
+/*!
+    Default constructs a QHttpConnectionPoolConfiguration object.
+
+    Such a configuration has the following values:
+    \list
+        \li At most 6 connections are opened per host
+        \li There is no limit on the number of idle hosts
+        \li Idle pool entries are closed after 120 seconds
+        \li Up to 3 requests are pipelined behind the one in flight
+        \li Pre-connecting opens one connection
+    \endlist
+*/
+QHttpConnectionPoolConfiguration::QHttpConnectionPoolConfiguration()
+    : d(new QHttpConnectionPoolConfigurationPrivate)
+{
+}
+
+/*!
+    Copy-constructs this QHttpConnectionPoolConfiguration.
+*/
+QHttpConnectionPoolConfiguration::QHttpConnectionPoolConfiguration(const QHttpConnectionPoolConfiguration &) = default;
+
+/*!
+    Move-constructs this QHttpConnectionPoolConfiguration from \a other
+*/
+QHttpConnectionPoolConfiguration::QHttpConnectionPoolConfiguration(QHttpConnectionPoolConfiguration &&other) noexcept
+{
+    swap(other);
+}
+
+/*!
+    Copy-assigns \a other to this QHttpConnectionPoolConfiguration.
+*/
+QHttpConnectionPoolConfiguration &QHttpConnectionPoolConfiguration::operator=(const QHttpConnectionPoolConfiguration &) = default;
+
+/*!
+    Move-assigns \a other to this QHttpConnectionPoolConfiguration.
+*/
+QHttpConnectionPoolConfiguration &QHttpConnectionPoolConfiguration::operator=(QHttpConnectionPoolConfiguration &&) noexcept = default;
+
+/*!
+    Destructor.
+*/
+QHttpConnectionPoolConfiguration::~QHttpConnectionPoolConfiguration()
+{
+}
+
+/*!
+    Sets the maximum number of parallel HTTP/1.1 connections opened to a
+    single host to \a count. \a count must be between 1 and 65535.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa maximumConnectionsPerHost()
+*/
+bool QHttpConnectionPoolConfiguration::setMaximumConnectionsPerHost(qsizetype count)
+{
+    if (count < 1 || count > std::numeric_limits<quint16>::max()) {
+        qWarning("QHttpConnectionPoolConfiguration: invalid number of connections per host");
+        return false;
+    }
+
+    d->maximumConnectionsPerHost = count;
+    return true;
+}
+
+/*!
+    Returns the maximum number of parallel HTTP/1.1 connections opened to a
+    single host. The default value is 6.
+*/
+qsizetype QHttpConnectionPoolConfiguration::maximumConnectionsPerHost() const
+{
+    return d->maximumConnectionsPerHost;
+}
+
+/*!
+    Sets the maximum number of idle hosts kept in the pool to \a count. The
+    limit counts pool entries, not connections: an idle host may still have
+    several connections open.
+
+    When a host has no requests in flight anymore, its connections stay in
+    the pool until idleTimeout() expires. If more than \a count hosts are idle
+    at the same time, the connections of the entries that would expire first
+    are closed right away. A value of 0 closes the connections as soon as
+    they become idle; a negative value means there is no limit.
+
+    \sa maximumIdleHosts(), setIdleTimeout()
+*/
+void QHttpConnectionPoolConfiguration::setMaximumIdleHosts(qsizetype count)
+{
+    d->maximumIdleHosts = count < 0 ? -1 : count;
+}
+
+/*!
+    Returns the maximum number of idle hosts kept in the pool, or -1 if
+    there is no limit. The default value is -1.
+*/
+qsizetype QHttpConnectionPoolConfiguration::maximumIdleHosts() const
+{
+    return d->maximumIdleHosts;
+}
+
+/*!
+    Sets the time an idle pool entry is kept before its connections are closed
+    to \a timeout. \a timeout must not be negative.
+
+    QNetworkRequest::ConnectionCacheExpiryTimeoutSecondsAttribute, if set on
+    the first request to a host, takes precedence over this value.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa idleTimeout()
+*/
+bool QHttpConnectionPoolConfiguration::setIdleTimeout(std::chrono::seconds timeout)
+{
+    if (timeout.count() < 0) {
+        qWarning("QHttpConnectionPoolConfiguration: invalid idle timeout");
+        return false;
+    }
+
+    d->idleTimeout = timeout;
+    return true;
+}
+
+/*!
+    Returns the time an idle pool entry is kept before its connections are
+    closed. The default value is 120 seconds.
+*/
+std::chrono::seconds QHttpConnectionPoolConfiguration::idleTimeout() const
+{
+    return d->idleTimeout;
+}
+
+/*!
+    Sets the number of requests that can be pipelined behind the request in
+    flight on one HTTP/1.1 connection to \a depth. A \a depth of 0 disables
+    pipelining, even for requests that set
+    QNetworkRequest::HttpPipeliningAllowedAttribute.
+
+    Returns \c true on success, \c false if \a depth is negative.
+
+    \sa pipeliningDepth()
+*/
+bool QHttpConnectionPoolConfiguration::setPipeliningDepth(qsizetype depth)
+{
+    if (depth < 0) {
+        qWarning("QHttpConnectionPoolConfiguration: invalid pipelining depth");
+        return false;
+    }
+
+    d->pipeliningDepth = depth;
+    return true;
+}
+
+/*!
+    Returns the number of requests that can be pipelined behind the request
+    in flight on one HTTP/1.1 connection. The default value is 3.
+*/
+qsizetype QHttpConnectionPoolConfiguration::pipeliningDepth() const
+{
+    return d->pipeliningDepth;
+}
+
+/*!
+    Sets the number of connections QNetworkAccessManager::connectToHost() and
+    QNetworkAccessManager::connectToHostEncrypted() open to \a count. The
+    connections, including their TLS handshakes, are established in parallel
+    and are limited by maximumConnectionsPerHost(). \a count must be at
+    least 1.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa preConnectCount()
+*/
+bool QHttpConnectionPoolConfiguration::setPreConnectCount(qsizetype count)
+{
+    if (count < 1) {
+        qWarning("QHttpConnectionPoolConfiguration: invalid pre-connect count");
+        return false;
+    }
+
+    d->preConnectCount = count;
+    return true;
+}
+
+/*!
+    Returns the number of connections QNetworkAccessManager::connectToHost()
+    and QNetworkAccessManager::connectToHostEncrypted() open. The default
+    value is 1.
+*/
+qsizetype QHttpConnectionPoolConfiguration::preConnectCount() const
+{
+    return d->preConnectCount;
+}
+
+/*!
+    Swaps this configuration with the \a other configuration.
+*/
+void QHttpConnectionPoolConfiguration::swap(QHttpConnectionPoolConfiguration &other) noexcept
+{
+    d.swap(other.d);
+}
+
+/*!
+    \fn bool QHttpConnectionPoolConfiguration::operator==(const QHttpConnectionPoolConfiguration &lhs, const QHttpConnectionPoolConfiguration &rhs) noexcept
+    Returns \c true if \a lhs and \a rhs have the same set of parameters.
+*/
+
+/*!
+    \fn bool QHttpConnectionPoolConfiguration::operator!=(const QHttpConnectionPoolConfiguration &lhs, const QHttpConnectionPoolConfiguration &rhs) noexcept
+    Returns \c true if \a lhs and \a rhs do not have the same set of
+    parameters.
+*/
+
+/*!
+    \internal
+*/
+bool QHttpConnectionPoolConfiguration::isEqual(const QHttpConnectionPoolConfiguration &other) const noexcept
+{
+    if (d == other.d)
+        return true;
+
+    return d->maximumConnectionsPerHost == other.d->maximumConnectionsPerHost
+           && d->maximumIdleHosts == other.d->maximumIdleHosts
+           && d->idleTimeout == other.d->idleTimeout
+           && d->pipeliningDepth == other.d->pipeliningDepth
+           && d->preConnectCount == other.d->preConnectCount;
+}
+
+/*!
+    \class QHttpConnectionPoolStatistics
+    \brief The QHttpConnectionPoolStatistics class holds counters describing
+    how QNetworkAccessManager used its HTTP connection pool.
+    \since 6.4
+
+    \reentrant
+    \inmodule QtNetwork
+    \ingroup network
+    \ingroup shared
+
+    A QHttpConnectionPoolStatistics object is a snapshot taken by
+    QNetworkAccessManager::connectionPoolStatistics(). The counters are
+    cumulative over the lifetime of the manager; subtract two snapshots to
+    obtain the values for an interval.
+
+    \sa QHttpConnectionPoolConfiguration
+*/
+
+class QHttpConnectionPoolStatisticsPrivate : public QSharedData
+{
+public:
+    quint64 poolHits = 0;
+    quint64 poolMisses = 0;
+    quint64 connectionsOpened = 0;
+    quint64 requestsDispatched = 0;
+    std::chrono::nanoseconds totalQueueWaitTime{0};
+    std::chrono::nanoseconds maximumQueueWaitTime{0};
+};
+
+/*!
+    Constructs a QHttpConnectionPoolStatistics object with all counters
+    set to zero.
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics()
+    : d(new QHttpConnectionPoolStatisticsPrivate)
+{
+}
+
+/*!
+    Copy-constructs this QHttpConnectionPoolStatistics.
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics(const QHttpConnectionPoolStatistics &) = default;
+
+/*!
+    Move-constructs this QHttpConnectionPoolStatistics from \a other
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics(QHttpConnectionPoolStatistics &&other) noexcept
+{
+    swap(other);
+}
+
+/*!
+    Copy-assigns \a other to this QHttpConnectionPoolStatistics.
+*/
+QHttpConnectionPoolStatistics &QHttpConnectionPoolStatistics::operator=(const QHttpConnectionPoolStatistics &) = default;
+
+/*!
+    Move-assigns \a other to this QHttpConnectionPoolStatistics.
+*/
+QHttpConnectionPoolStatistics &QHttpConnectionPoolStatistics::operator=(QHttpConnectionPoolStatistics &&) noexcept = default;
+
+/*!
+    Destructor.
+*/
+QHttpConnectionPoolStatistics::~QHttpConnectionPoolStatistics()
+{
+}
+
+/*!
+    Returns the number of requests, including pre-connects, that found an
+    entry for their host in the pool.
+
+    \sa poolMisses()
+*/
+quint64 QHttpConnectionPoolStatistics::poolHits() const
+{
+    return d->poolHits;
+}
+
+/*!
+    Returns the number of requests, including pre-connects, for which a new
+    pool entry had to be created because their host was not in the pool.
+
+    \sa poolHits()
+*/
+quint64 QHttpConnectionPoolStatistics::poolMisses() const
+{
+    return d->poolMisses;
+}
+
+/*!
+    Returns the number of TCP connections that were opened, including the
+    connections opened by pre-connecting.
+*/
+quint64 QHttpConnectionPoolStatistics::connectionsOpened() const
+{
+    return d->connectionsOpened;
+}
+
+/*!
+    Returns the number of requests that were taken from the queue of their
+    host and sent on a connection.
+
+    \sa totalQueueWaitTime()
+*/
+quint64 QHttpConnectionPoolStatistics::requestsDispatched() const
+{
+    return d->requestsDispatched;
+}
+
+/*!
+    Returns the total time the dispatched requests spent queued, waiting for
+    a connection (or, for HTTP/2, a stream) to become available.
+
+    \sa requestsDispatched(), maximumQueueWaitTime()
+*/
+std::chrono::nanoseconds QHttpConnectionPoolStatistics::totalQueueWaitTime() const
+{
+    return d->totalQueueWaitTime;
+}
+
+/*!
+    Returns the longest time a single request spent queued.
+
+    \sa totalQueueWaitTime()
+*/
+std::chrono::nanoseconds QHttpConnectionPoolStatistics::maximumQueueWaitTime() const
+{
+    return d->maximumQueueWaitTime;
+}
+
+/*!
+    Swaps these statistics with \a other.
+*/
+void QHttpConnectionPoolStatistics::swap(QHttpConnectionPoolStatistics &other) noexcept
+{
+    d.swap(other.d);
+}
+
+void QHttpConnectionPoolCounters::recordQueueWait(qint64 nsecs)
+{
+    requestsDispatched.fetchAndAddRelaxed(1);
+    totalQueueWaitNSecs.fetchAndAddRelaxed(nsecs);
+    qint64 maximum = maximumQueueWaitNSecs.loadRelaxed();
+    while (nsecs > maximum && !maximumQueueWaitNSecs.testAndSetRelaxed(maximum, nsecs, maximum))
+        ;
+}
+
+QHttpConnectionPoolStatistics QHttpConnectionPoolCounters::snapshot() const
+{
+    QHttpConnectionPoolStatistics statistics;
+    statistics.d->poolHits = poolHits.loadRelaxed();
+    statistics.d->poolMisses = poolMisses.loadRelaxed();
+    statistics.d->connectionsOpened = connectionsOpened.loadRelaxed();
+    statistics.d->requestsDispatched = requestsDispatched.loadRelaxed();
+    statistics.d->totalQueueWaitTime = std::chrono::nanoseconds(totalQueueWaitNSecs.loadRelaxed());
+    statistics.d->maximumQueueWaitTime = std::chrono::nanoseconds(maximumQueueWaitNSecs.loadRelaxed());
+    return statistics;
+}
+
+QT_END_NAMESPACE
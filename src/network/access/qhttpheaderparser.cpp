@@ -62,6 +62,8 @@ void QHttpHeaderParser::clear()
     majorVersion = 0;
     minorVersion = 0;
     reasonPhrase.clear();
+    requestMethod.clear();
+    requestTarget.clear();
     fields.clear();
 }
 
@@ -167,6 +169,45 @@ bool QHttpHeaderParser::parseStatus(QByteArrayView status)
     return ok && uint(majorVersion) <= 9 && uint(minorVersion) <= 9;
 }
 
+bool QHttpHeaderParser::parseRequestLine(QByteArrayView line)
+{
+    // from RFC 7230:
+    //        request-line   = method SP request-target SP HTTP-version CRLF
+    //        HTTP-version   = "HTTP" "/" DIGIT "." DIGIT
+    // that makes: 'METHOD target HTTP/n.n'
+    static const int versionLength = 8;
+    static const char httpMagic[] = "HTTP/";
+
+    if (line.endsWith('\n'))
+        line.chop(line.endsWith("\r\n") ? 2 : 1);
+
+    const qsizetype methodEnd = line.indexOf(' ');
+    const qsizetype targetEnd = line.lastIndexOf(' ');
+    if (methodEnd <= 0 || targetEnd <= methodEnd + 1)
+        return false;
+
+    const QByteArrayView method = line.first(methodEnd);
+    const QByteArrayView target = line.sliced(methodEnd + 1, targetEnd - methodEnd - 1);
+    const QByteArrayView version = line.sliced(targetEnd + 1);
+    if (!fieldNameCheck(method) || version.size() != versionLength
+        || !version.startsWith(httpMagic) || version.at(6) != '.') {
+        return false;
+    }
+
+    // The request-target is a URI or '*'; it cannot contain whitespace
+    // or control characters:
+    const auto invalidTargetChar = [](char c) { return uchar(c) <= ' ' || c == 0x7f; };
+    if (std::any_of(target.begin(), target.end(), invalidTargetChar))
+        return false;
+
+    majorVersion = version.at(5) - '0';
+    minorVersion = version.at(7) - '0';
+    requestMethod = method.toByteArray();
+    requestTarget = target.toByteArray();
+
+    return uint(majorVersion) <= 9 && uint(minorVersion) <= 9;
+}
+
 const QList<QPair<QByteArray, QByteArray> >& QHttpHeaderParser::headers() const
 {
     return fields;
@@ -270,4 +311,14 @@ void QHttpHeaderParser::setReasonPhrase(const QString &reason)
     reasonPhrase = reason;
 }
 
+QByteArray QHttpHeaderParser::getRequestMethod() const
+{
+    return requestMethod;
+}
+
+QByteArray QHttpHeaderParser::getRequestTarget() const
+{
+    return requestTarget;
+}
+
 QT_END_NAMESPACE
@@ -68,6 +68,7 @@ public:
     void clear();
     bool parseHeaders(QByteArrayView headers);
     bool parseStatus(QByteArrayView status);
+    bool parseRequestLine(QByteArrayView line);
 
     const QList<QPair<QByteArray, QByteArray> >& headers() const;
     void setStatusCode(int code);
@@ -78,6 +79,8 @@ public:
     void setMinorVersion(int version);
     QString getReasonPhrase() const;
     void setReasonPhrase(const QString &reason);
+    QByteArray getRequestMethod() const;
+    QByteArray getRequestTarget() const;
 
     QByteArray firstHeaderField(const QByteArray &name,
                                 const QByteArray &defaultValue = QByteArray()) const;
@@ -93,6 +96,8 @@ public:
 private:
     QList<QPair<QByteArray, QByteArray> > fields;
     QString reasonPhrase;
+    QByteArray requestMethod;
+    QByteArray requestTarget;
     int statusCode;
     int majorVersion;
     int minorVersion;
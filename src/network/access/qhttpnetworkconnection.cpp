@@ -87,10 +87,13 @@ QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(const QString &host
                        || type == QHttpNetworkConnection::ConnectionTypeHTTP2Direct
                        ? 1 : defaultHttpChannelCount)
   , channelCount(defaultHttpChannelCount)
+  , pipelineLength(defaultPipelineLength)
+  , rePipelineLength(defaultRePipelineLength)
 #ifndef QT_NO_NETWORKPROXY
   , networkProxy(QNetworkProxy::NoProxy)
 #endif
   , preConnectRequests(0)
+  , preConnectCount(1)
   , connectionType(type)
 {
     // We allocate all 6 channels even if it's HTTP/2 enabled connection:
@@ -105,13 +108,20 @@ QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(quint16 connectionC
                                                              QHttpNetworkConnection::ConnectionType type)
 : state(RunningState), networkLayerState(Unknown),
   hostName(hostName), port(port), encrypt(encrypt), delayIpv4(true),
-  activeChannelCount(connectionCount), channelCount(connectionCount)
+  activeChannelCount(type == QHttpNetworkConnection::ConnectionTypeHTTP2
+                     || type == QHttpNetworkConnection::ConnectionTypeHTTP2Direct
+                     ? 1 : connectionCount),
+  channelCount(connectionCount),
+  pipelineLength(defaultPipelineLength),
+  rePipelineLength(defaultRePipelineLength)
 #ifndef QT_NO_NETWORKPROXY
   , networkProxy(QNetworkProxy::NoProxy)
 #endif
   , preConnectRequests(0)
+  , preConnectCount(1)
   , connectionType(type)
 {
+    // As above, the other channels are the fall-back when HTTP/2 is not negotiated.
     channels = new QHttpNetworkConnectionChannel[channelCount];
 }
 
@@ -644,6 +654,8 @@ QHttpNetworkReply* QHttpNetworkConnectionPrivate::queueRequest(const QHttpNetwor
 
     if (request.isPreConnect())
         preConnectRequests++;
+    else if (poolCounters)
+        reply->d_func()->queueTimer.start();
 
     if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP
         || (!encrypt && connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2 && !channels[0].switchedToHttp2)) {
@@ -753,6 +765,18 @@ void QHttpNetworkConnectionPrivate::updateChannel(int i, const HttpMessagePair &
     // Now that reply is assigned a channel, correct reply to channel association
     // previously set in queueRequest.
     channels[i].reply->d_func()->connectionChannel = &channels[i];
+    requestDispatched(messagePair.second);
+}
+
+void QHttpNetworkConnectionPrivate::requestDispatched(QHttpNetworkReply *reply)
+{
+    QElapsedTimer &queueTimer = reply->d_func()->queueTimer;
+    if (!queueTimer.isValid())
+        return;
+    // Requests that are re-queued (e.g. after the pipeline broke) count only once.
+    if (poolCounters)
+        poolCounters->recordQueueWait(queueTimer.nsecsElapsed());
+    queueTimer.invalidate();
 }
 
 QHttpNetworkRequest QHttpNetworkConnectionPrivate::predictNextRequest() const
@@ -786,7 +810,8 @@ void QHttpNetworkConnectionPrivate::fillPipeline(QAbstractSocket *socket)
     if (channels[i].reply == nullptr)
         return;
 
-    if (! (defaultPipelineLength - channels[i].alreadyPipelinedRequests.length() >= defaultRePipelineLength)) {
+    if (pipelineLength == 0
+        || pipelineLength - channels[i].alreadyPipelinedRequests.length() < rePipelineLength) {
         return;
     }
 
@@ -830,7 +855,7 @@ void QHttpNetworkConnectionPrivate::fillPipeline(QAbstractSocket *socket)
         lengthBefore = channels[i].alreadyPipelinedRequests.length();
         fillPipeline(highPriorityQueue, channels[i]);
 
-        if (channels[i].alreadyPipelinedRequests.length() >= defaultPipelineLength) {
+        if (channels[i].alreadyPipelinedRequests.length() >= pipelineLength) {
             channels[i].pipelineFlush();
             return;
         }
@@ -843,7 +868,7 @@ void QHttpNetworkConnectionPrivate::fillPipeline(QAbstractSocket *socket)
         lengthBefore = channels[i].alreadyPipelinedRequests.length();
         fillPipeline(lowPriorityQueue, channels[i]);
 
-        if (channels[i].alreadyPipelinedRequests.length() >= defaultPipelineLength) {
+        if (channels[i].alreadyPipelinedRequests.length() >= pipelineLength) {
             channels[i].pipelineFlush();
             return;
         }
@@ -885,6 +910,7 @@ bool QHttpNetworkConnectionPrivate::fillPipeline(QList<HttpMessagePair> &queue,
         // actually send it
         if (!messagePair.second->d_func()->requestIsPrepared)
             prepareRequest(messagePair);
+        requestDispatched(messagePair.second);
         channel.pipelineInto(messagePair);
 
         // return false because we processed something and need to process again
@@ -1133,11 +1159,12 @@ void QHttpNetworkConnectionPrivate::_q_startNextRequest()
     int queuedRequests = highPriorityQueue.count() + lowPriorityQueue.count();
 
     // in case we have in-flight preconnect requests and normal requests,
-    // we only need one socket for each (preconnect, normal request) pair
+    // we only need one socket for each (preconnect, normal request) pair;
+    // preconnecting opens preConnectCount sockets at once
     int neededOpenChannels = queuedRequests;
     if (preConnectRequests > 0) {
         int normalRequests = queuedRequests - preConnectRequests;
-        neededOpenChannels = qMax(normalRequests, preConnectRequests);
+        neededOpenChannels = qMax(normalRequests, qMax(preConnectRequests, preConnectCount));
     }
 
     if (neededOpenChannels <= 0)
@@ -1470,6 +1497,25 @@ void QHttpNetworkConnection::setHttp2Parameters(const QHttp2Configuration &param
     d->http2Parameters = params;
 }
 
+void QHttpNetworkConnection::setPipelineLength(int length)
+{
+    Q_D(QHttpNetworkConnection);
+    d->pipelineLength = length;
+    d->rePipelineLength = qMin(length, QHttpNetworkConnectionPrivate::defaultRePipelineLength);
+}
+
+void QHttpNetworkConnection::setPreConnectCount(int count)
+{
+    Q_D(QHttpNetworkConnection);
+    d->preConnectCount = count;
+}
+
+void QHttpNetworkConnection::setPoolCounters(std::shared_ptr<QHttpConnectionPoolCounters> counters)
+{
+    Q_D(QHttpNetworkConnection);
+    d->poolCounters = std::move(counters);
+}
+
 // SSL support below
 #ifndef QT_NO_SSL
 void QHttpNetworkConnection::setSslConfiguration(const QSslConfiguration &config)
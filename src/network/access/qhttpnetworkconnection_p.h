@@ -72,6 +72,9 @@
 #include <private/http2protocol_p.h>
 
 #include <private/qhttpnetworkconnectionchannel_p.h>
+#include <private/qhttpconnectionpool_p.h>
+
+#include <memory>
 
 QT_REQUIRE_CONFIG(http);
 
@@ -134,6 +137,10 @@ public:
     QHttp2Configuration http2Parameters() const;
     void setHttp2Parameters(const QHttp2Configuration &params);
 
+    void setPipelineLength(int length);
+    void setPreConnectCount(int count);
+    void setPoolCounters(std::shared_ptr<QHttpConnectionPoolCounters> counters);
+
 #ifndef QT_NO_SSL
     void setSslConfiguration(const QSslConfiguration &config);
     void ignoreSslErrors(int channel = -1);
@@ -219,6 +226,9 @@ public:
     void fillPipeline(QAbstractSocket *socket);
     bool fillPipeline(QList<HttpMessagePair> &queue, QHttpNetworkConnectionChannel &channel);
 
+    // called when a queued request is sent on a channel or HTTP/2 stream
+    void requestDispatched(QHttpNetworkReply *reply);
+
     // read more HTTP body after the next event loop spin
     void readMoreLater(QHttpNetworkReply *reply);
 
@@ -250,6 +260,9 @@ public:
     int activeChannelCount;
     // The total number of channels we reserved:
     const int channelCount;
+    // The pipeline length and the number of free slots needed to re-fill it:
+    int pipelineLength;
+    int rePipelineLength;
     QTimer delayedConnectionTimer;
     QHttpNetworkConnectionChannel *channels; // parallel connections to the server
     bool shouldEmitChannelError(QAbstractSocket *socket);
@@ -278,6 +291,8 @@ public:
     QList<HttpMessagePair> lowPriorityQueue;
 
     int preConnectRequests;
+    // The number of channels opened for a pre-connect request:
+    int preConnectCount;
 
     QHttpNetworkConnection::ConnectionType connectionType;
 
@@ -287,6 +302,8 @@ public:
 
     QHttp2Configuration http2Parameters;
 
+    std::shared_ptr<QHttpConnectionPoolCounters> poolCounters;
+
     QString peerVerifyName;
     // If network status monitoring is enabled, we activate connectionMonitor
     // as soons as one of channels managed to connect to host (and we
@@ -395,6 +395,9 @@ bool QHttpNetworkConnectionChannel::ensureConnection()
             }
         }
 #endif
+        if (const auto &counters = connection->d_func()->poolCounters)
+            counters->connectionsOpened.fetchAndAddRelaxed(1);
+
         if (ssl) {
 #ifndef QT_NO_SSL
             QSslSocket *sslSocket = qobject_cast<QSslSocket*>(socket);
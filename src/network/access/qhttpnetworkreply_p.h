@@ -63,6 +63,7 @@
 #include <QtNetwork/qnetworkrequest.h>
 #include <QtNetwork/qnetworkreply.h>
 #include <qbuffer.h>
+#include <qelapsedtimer.h>
 
 #include <private/qobject_p.h>
 #include <private/qhttpnetworkheader_p.h>
@@ -277,6 +278,9 @@ public:
 
     char* userProvidedDownloadBuffer;
     QUrl redirectUrl;
+
+    // Time spent in the connection's queue, for the pool statistics
+    QElapsedTimer queueTimer;
 };
 
 
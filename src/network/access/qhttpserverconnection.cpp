@@ -0,0 +1,1447 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qhttpserverconnection_p.h"
+#include "qnetworkhttpserver_p.h"
+
+#include "http2/bitstreams_p.h"
+
+#include <QtNetwork/qabstractsocket.h>
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qtimer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Http2;
+
+namespace
+{
+
+// Limits on what a client can make us buffer. The request line limit matches
+// MAX_HEADER_FIELD_SIZE in qhttpheaderparser.cpp.
+const qint64 maxRequestLineSize = 8 * 1024;
+const qint64 maxHeaderBlockSize = 64 * 1024;
+const qint64 socketReadBufferSize = 64 * 1024;
+const qint64 maxBufferedRequestBody = 256 * 1024;
+const qint64 socketWriteHighWaterMark = 256 * 1024;
+const qsizetype maxPipelinedRequests = 16;
+
+bool hasToken(const QByteArray &list, QByteArrayView token)
+{
+    for (const QByteArray &element : list.split(',')) {
+        if (element.trimmed().compare(token, Qt::CaseInsensitive) == 0)
+            return true;
+    }
+    return false;
+}
+
+bool isEmptyLine(const QByteArray &line)
+{
+    return line == "\r\n" || line == "\n";
+}
+
+QByteArray reasonPhrase(int statusCode)
+{
+    switch (statusCode) {
+    case 100: return "Continue";
+    case 101: return "Switching Protocols";
+    case 200: return "OK";
+    case 201: return "Created";
+    case 202: return "Accepted";
+    case 204: return "No Content";
+    case 206: return "Partial Content";
+    case 301: return "Moved Permanently";
+    case 302: return "Found";
+    case 303: return "See Other";
+    case 304: return "Not Modified";
+    case 307: return "Temporary Redirect";
+    case 308: return "Permanent Redirect";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 408: return "Request Timeout";
+    case 411: return "Length Required";
+    case 413: return "Content Too Large";
+    case 414: return "URI Too Long";
+    case 415: return "Unsupported Media Type";
+    case 417: return "Expectation Failed";
+    case 429: return "Too Many Requests";
+    case 431: return "Request Header Fields Too Large";
+    case 500: return "Internal Server Error";
+    case 501: return "Not Implemented";
+    case 502: return "Bad Gateway";
+    case 503: return "Service Unavailable";
+    case 504: return "Gateway Timeout";
+    case 505: return "HTTP Version Not Supported";
+    default: return "Unknown";
+    }
+}
+
+bool hasNoContent(int statusCode)
+{
+    return statusCode < 200 || statusCode == 204 || statusCode == 304;
+}
+
+} // unnamed namespace
+
+QHttpServerConnection::QHttpServerConnection(QAbstractSocket *socket,
+                                             const QHttpServerSettings &settings, QObject *parent)
+    : QObject(parent),
+      socket(socket),
+      settings(settings)
+{
+    socket->setParent(this);
+}
+
+void QHttpServerConnection::responseDataAvailable()
+{
+    scheduleWrite();
+}
+
+QNetworkHttpServerExchange *QHttpServerConnection::createExchange()
+{
+    auto exchange = new QNetworkHttpServerExchange(this);
+    exchange->peer = socket->peerAddress();
+    exchange->port = socket->peerPort();
+    exchange->scheme = settings.encrypted ? "https" : "http";
+    return exchange;
+}
+
+void QHttpServerConnection::dispatch(QNetworkHttpServerExchange *exchange)
+{
+    if (settings.requestHandler && *settings.requestHandler)
+        (*settings.requestHandler)(exchange);
+    else
+        exchange->respond(404);
+}
+
+void QHttpServerConnection::scheduleWrite()
+{
+    // Coalesce everything the handlers write in one event loop iteration,
+    // which also batches the responses to pipelined requests and streams:
+    if (writeScheduled)
+        return;
+    writeScheduled = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        writeScheduled = false;
+        writeResponses();
+    }, Qt::QueuedConnection);
+}
+
+void QHttpServerConnection::restartIdleTimer()
+{
+    if (settings.keepAliveTimeout > 0)
+        idleTimer.start(settings.keepAliveTimeout, this);
+    else
+        idleTimer.stop();
+}
+
+void QHttpServerConnection::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != idleTimer.timerId())
+        return QObject::timerEvent(event);
+
+    idleTimer.stop();
+    idleTimeout();
+}
+
+QHttp1ServerConnection::QHttp1ServerConnection(QAbstractSocket *socket,
+                                               const QHttpServerSettings &settings,
+                                               QObject *parent)
+    : QHttpServerConnection(socket, settings, parent)
+{
+}
+
+QHttp1ServerConnection::~QHttp1ServerConnection()
+{
+    for (QNetworkHttpServerExchange *exchange : std::as_const(pipeline))
+        exchange->abort();
+}
+
+void QHttp1ServerConnection::start()
+{
+    // With a limited read buffer, a client sending faster than the handler
+    // consumes the request body is throttled by TCP flow control:
+    socket->setReadBufferSize(socketReadBufferSize);
+    connect(socket, &QIODevice::readyRead, this, &QHttp1ServerConnection::readRequests);
+    connect(socket, &QIODevice::bytesWritten, this, &QHttp1ServerConnection::socketBytesWritten);
+    connect(socket, &QAbstractSocket::disconnected, this, &QObject::deleteLater);
+
+    if (socket->state() != QAbstractSocket::ConnectedState) {
+        deleteLater();
+        return;
+    }
+
+    restartIdleTimer();
+    if (socket->bytesAvailable())
+        readRequests();
+}
+
+void QHttp1ServerConnection::requestDataConsumed(QNetworkHttpServerExchange *exchange)
+{
+    if (exchange == reading && exchange->requestBody.byteAmount() < maxBufferedRequestBody)
+        scheduleRead();
+}
+
+void QHttp1ServerConnection::scheduleRead()
+{
+    if (readScheduled)
+        return;
+    readScheduled = true;
+    QMetaObject::invokeMethod(this, &QHttp1ServerConnection::readRequests, Qt::QueuedConnection);
+}
+
+void QHttp1ServerConnection::readRequests()
+{
+    readScheduled = false;
+
+    for (bool progress = true; progress;) {
+        switch (state) {
+        case ReadingRequestLine:
+            if (pipeline.size() >= maxPipelinedRequests)
+                return; // resumed by writeResponses()
+            if (firstRequest && settings.http2Enabled && !settings.encrypted && !readPreface())
+                return;
+            progress = readRequestLine();
+            break;
+        case ReadingHeaders:
+            progress = readHeaders();
+            break;
+        case ReadingBody:
+        case ReadingChunkData:
+            progress = readBody();
+            break;
+        case ReadingChunkSize:
+            progress = readChunkSize();
+            break;
+        case ReadingChunkEnd:
+            progress = readChunkEnd();
+            break;
+        case ReadingTrailers:
+            progress = readTrailers();
+            break;
+        case Closing:
+            return;
+        }
+    }
+}
+
+bool QHttp1ServerConnection::readPreface()
+{
+    // A client with prior knowledge of HTTP/2 support sends the connection
+    // preface instead of a request line (RFC 7540, 3.4):
+    char buffer[clientPrefaceLength];
+    const qint64 size = socket->peek(buffer, clientPrefaceLength);
+    if (size <= 0)
+        return false;
+
+    if (std::memcmp(buffer, Http2clientPreface, size) != 0) {
+        firstRequest = false;
+        return true;
+    }
+
+    if (size == clientPrefaceLength)
+        switchToHttp2(nullptr, QByteArray());
+    return false;
+}
+
+void QHttp1ServerConnection::switchToHttp2(QNetworkHttpServerExchange *upgraded,
+                                           const QByteArray &clientSettings)
+{
+    Q_ASSERT(pipeline.isEmpty());
+
+    state = Closing;
+    idleTimer.stop();
+    disconnect(socket, nullptr, this, nullptr);
+
+    auto connection = new QHttp2ServerConnection(socket, settings, parent());
+    if (upgraded)
+        connection->startWithUpgrade(upgraded, clientSettings);
+    else
+        connection->start();
+    deleteLater();
+}
+
+bool QHttp1ServerConnection::readRequestLine()
+{
+    if (!socket->canReadLine()) {
+        if (socket->bytesAvailable() > maxRequestLineSize)
+            rejectRequest(414);
+        return false;
+    }
+
+    const QByteArray line = socket->readLine();
+    firstRequest = false;
+    // RFC 9112, 2.2: empty lines before a request line are ignored.
+    if (isEmptyLine(line))
+        return true;
+    if (line.size() > maxRequestLineSize) {
+        rejectRequest(414);
+        return false;
+    }
+
+    parser.clear();
+    if (!parser.parseRequestLine(line)) {
+        rejectRequest(400);
+        return false;
+    }
+    if (parser.getMajorVersion() != 1) {
+        rejectRequest(505);
+        return false;
+    }
+
+    headerBlock.clear();
+    state = ReadingHeaders;
+    return true;
+}
+
+bool QHttp1ServerConnection::readHeaders()
+{
+    while (socket->canReadLine()) {
+        const QByteArray line = socket->readLine();
+        headerBlock += line;
+        if (headerBlock.size() > maxHeaderBlockSize) {
+            rejectRequest(431);
+            return false;
+        }
+        if (isEmptyLine(line)) {
+            if (!parser.parseHeaders(headerBlock)) {
+                rejectRequest(400);
+                return false;
+            }
+            startRequest();
+            return true;
+        }
+    }
+
+    if (headerBlock.size() + socket->bytesAvailable() > maxHeaderBlockSize)
+        rejectRequest(431);
+    return false;
+}
+
+void QHttp1ServerConnection::startRequest()
+{
+    const bool http10 = parser.getMinorVersion() == 0;
+
+    // RFC 9112, 3.2: HTTP/1.1 requests must have exactly one Host header.
+    const QList<QByteArray> hosts = parser.headerFieldValues("host");
+    if (!http10 && hosts.size() != 1)
+        return rejectRequest(400);
+
+    qint64 contentLength = 0;
+    bool chunked = false;
+    const QByteArray transferEncoding = parser.combinedHeaderValue("transfer-encoding");
+    if (!transferEncoding.isEmpty()) {
+        // RFC 9112, 6.3: without chunked as the final coding the length of
+        // a request body cannot be determined.
+        const QList<QByteArray> codings = transferEncoding.split(',');
+        if (http10 || codings.constLast().trimmed().compare("chunked", Qt::CaseInsensitive) != 0)
+            return rejectRequest(400);
+        chunked = true;
+    } else {
+        const QList<QByteArray> lengths = parser.headerFieldValues("content-length");
+        for (const QByteArray &value : lengths) {
+            bool ok = false;
+            const qint64 length = value.trimmed().toLongLong(&ok);
+            if (!ok || length < 0 || (length != contentLength && &value != &lengths.constFirst()))
+                return rejectRequest(400);
+            contentLength = length;
+        }
+    }
+
+    auto exchange = createExchange();
+    exchange->requestProtocol = http10 ? QNetworkHttpServerExchange::Protocol::Http1_0
+                                       : QNetworkHttpServerExchange::Protocol::Http1_1;
+    exchange->requestMethod = parser.getRequestMethod();
+    exchange->requestTarget = parser.getRequestTarget();
+    exchange->requestFields = parser.headers();
+    if (!hosts.isEmpty())
+        exchange->authority = hosts.constFirst();
+
+    const QByteArray connectionHeader = parser.combinedHeaderValue("connection");
+    exchange->closeConnection = http10 ? !hasToken(connectionHeader, "keep-alive")
+                                       : hasToken(connectionHeader, "close");
+    exchange->expectContinue = !http10 && (chunked || contentLength > 0)
+                               && hasToken(parser.combinedHeaderValue("expect"), "100-continue");
+
+    idleTimer.stop();
+
+    if (!chunked && !contentLength && pipeline.isEmpty() && upgradeToHttp2(exchange))
+        return;
+
+    pipeline.append(exchange);
+    reading = exchange;
+    if (exchange->expectContinue)
+        scheduleWrite();
+    if (chunked) {
+        state = ReadingChunkSize;
+    } else if (contentLength) {
+        bodyRemaining = contentLength;
+        state = ReadingBody;
+    } else {
+        finishRequest();
+    }
+
+    dispatch(exchange);
+}
+
+bool QHttp1ServerConnection::upgradeToHttp2(QNetworkHttpServerExchange *exchange)
+{
+    // RFC 7540, 3.2: a cleartext HTTP/1.1 request can ask to continue with
+    // HTTP/2; the request becomes stream 1 and its response is sent over
+    // HTTP/2. Requests with a body are served over HTTP/1.1 instead.
+    if (!settings.http2Enabled || settings.encrypted
+        || exchange->requestProtocol != QNetworkHttpServerExchange::Protocol::Http1_1) {
+        return false;
+    }
+
+    const QByteArray connectionHeader = parser.combinedHeaderValue("connection");
+    if (!hasToken(parser.combinedHeaderValue("upgrade"), "h2c")
+        || !hasToken(connectionHeader, "upgrade") || !hasToken(connectionHeader, "http2-settings")) {
+        return false;
+    }
+
+    const QList<QByteArray> http2Settings = parser.headerFieldValues("http2-settings");
+    if (http2Settings.size() != 1)
+        return false;
+    const auto decoded = QByteArray::fromBase64Encoding(http2Settings.constFirst().trimmed(),
+                                                        QByteArray::Base64UrlEncoding
+                                                            | QByteArray::AbortOnBase64DecodingErrors);
+    if (!decoded || decoded.decoded.size() % 6)
+        return false;
+
+    socket->write("HTTP/1.1 101 Switching Protocols\r\n"
+                  "Connection: Upgrade\r\n"
+                  "Upgrade: h2c\r\n\r\n");
+    exchange->requestComplete = true;
+    switchToHttp2(exchange, decoded.decoded);
+    return true;
+}
+
+bool QHttp1ServerConnection::readBody()
+{
+    if (reading && reading->requestBody.byteAmount() >= maxBufferedRequestBody)
+        return false; // resumed by requestDataConsumed()
+
+    const qint64 size = qMin(socket->bytesAvailable(), bodyRemaining);
+    if (size <= 0)
+        return false;
+
+    QByteArray data = socket->read(size);
+    bodyRemaining -= data.size();
+    // Once the response has been sent, the rest of the body is discarded:
+    if (reading)
+        reading->appendRequestData(std::move(data));
+
+    if (!bodyRemaining) {
+        if (state == ReadingChunkData)
+            state = ReadingChunkEnd;
+        else
+            finishRequest();
+    }
+    return true;
+}
+
+bool QHttp1ServerConnection::readChunkSize()
+{
+    if (!socket->canReadLine()) {
+        if (socket->bytesAvailable() > maxRequestLineSize)
+            rejectRequest(400);
+        return false;
+    }
+
+    QByteArray line = socket->readLine();
+    // Chunk extensions are ignored (RFC 9112, 7.1.1):
+    const qsizetype extensions = line.indexOf(';');
+    if (extensions != -1)
+        line.truncate(extensions);
+
+    bool ok = false;
+    const qint64 size = line.trimmed().toLongLong(&ok, 16);
+    if (!ok || size < 0) {
+        rejectRequest(400);
+        return false;
+    }
+
+    if (size) {
+        bodyRemaining = size;
+        state = ReadingChunkData;
+    } else {
+        headerBlock.clear();
+        state = ReadingTrailers;
+    }
+    return true;
+}
+
+bool QHttp1ServerConnection::readChunkEnd()
+{
+    if (!socket->canReadLine()) {
+        if (socket->bytesAvailable() > 2)
+            rejectRequest(400);
+        return false;
+    }
+
+    if (!isEmptyLine(socket->readLine())) {
+        rejectRequest(400);
+        return false;
+    }
+    state = ReadingChunkSize;
+    return true;
+}
+
+bool QHttp1ServerConnection::readTrailers()
+{
+    // Trailer fields are read and dropped:
+    while (socket->canReadLine()) {
+        const QByteArray line = socket->readLine();
+        if (isEmptyLine(line)) {
+            finishRequest();
+            return true;
+        }
+        headerBlock += line;
+        if (headerBlock.size() > maxHeaderBlockSize) {
+            rejectRequest(431);
+            return false;
+        }
+    }
+    return false;
+}
+
+void QHttp1ServerConnection::finishRequest()
+{
+    state = ReadingRequestLine;
+    if (QNetworkHttpServerExchange *exchange = std::exchange(reading, nullptr)) {
+        if (exchange->closeConnection)
+            state = Closing;
+        exchange->finishRequest();
+    }
+}
+
+void QHttp1ServerConnection::rejectRequest(int statusCode)
+{
+    if (QNetworkHttpServerExchange *exchange = std::exchange(reading, nullptr)) {
+        pipeline.removeOne(exchange);
+        exchange->abort();
+    }
+
+    auto exchange = createExchange();
+    exchange->status = statusCode;
+    exchange->requestComplete = true;
+    exchange->responseStarted = true;
+    exchange->responseFinished = true;
+    exchange->closeConnection = true;
+    pipeline.append(exchange);
+
+    state = Closing;
+    scheduleWrite();
+}
+
+void QHttp1ServerConnection::writeResponses()
+{
+    while (!pipeline.isEmpty()) {
+        QNetworkHttpServerExchange *exchange = pipeline.constFirst();
+        if (!exchange->responseStarted) {
+            // RFC 9110, 10.1.1: the client waits for this before sending the body.
+            if (exchange->expectContinue && !exchange->requestComplete) {
+                socket->write("HTTP/1.1 100 Continue\r\n\r\n");
+                exchange->expectContinue = false;
+            }
+            break;
+        }
+
+        if (!exchange->headersWritten)
+            writeResponseHeaders(exchange);
+
+        while (!exchange->responseBody.isEmpty()) {
+            if (socket->bytesToWrite() >= socketWriteHighWaterMark)
+                return; // resumed by socketBytesWritten()
+            const QByteArray data = exchange->responseBody.read();
+            if (exchange->omitBody)
+                continue;
+            if (exchange->chunked) {
+                socket->write(QByteArray::number(data.size(), 16) + "\r\n");
+                socket->write(data);
+                socket->write("\r\n");
+            } else {
+                socket->write(data);
+            }
+            emit exchange->bytesWritten(data.size());
+        }
+
+        if (!exchange->responseFinished)
+            break;
+
+        if (exchange->chunked)
+            socket->write("0\r\n\r\n");
+        pipeline.removeFirst();
+        if (reading == exchange)
+            reading = nullptr;
+        exchange->connection = nullptr;
+        emit exchange->finished();
+        exchange->deleteLater();
+
+        if (exchange->closeConnection)
+            return closeConnection();
+    }
+
+    if (state == Closing)
+        return;
+    if (pipeline.isEmpty())
+        restartIdleTimer();
+    if (state == ReadingRequestLine && socket->bytesAvailable())
+        scheduleRead();
+}
+
+void QHttp1ServerConnection::writeResponseHeaders(QNetworkHttpServerExchange *exchange)
+{
+    const int status = exchange->status;
+    exchange->omitBody = exchange->requestMethod == "HEAD" || hasNoContent(status);
+    // Without a 100 (Continue) the client may never send the body we would
+    // have to skip:
+    if (exchange->expectContinue && !exchange->requestComplete)
+        exchange->closeConnection = true;
+
+    QByteArray header = "HTTP/1.1 " + QByteArray::number(status) + ' ' + reasonPhrase(status)
+                        + "\r\n";
+    bool hasContentLength = false;
+    for (const auto &field : std::as_const(exchange->responseFields)) {
+        // The framing of the response is ours to decide:
+        if (field.first.compare("connection", Qt::CaseInsensitive) == 0) {
+            exchange->closeConnection |= hasToken(field.second, "close");
+            continue;
+        }
+        if (field.first.compare("transfer-encoding", Qt::CaseInsensitive) == 0)
+            continue;
+        if (field.first.compare("content-length", Qt::CaseInsensitive) == 0)
+            hasContentLength = true;
+        header += field.first + ": " + field.second + "\r\n";
+    }
+
+    if (!hasContentLength && !hasNoContent(status)) {
+        if (exchange->responseFinished) {
+            header += "Content-Length: " + QByteArray::number(exchange->responseBody.byteAmount())
+                      + "\r\n";
+        } else if (exchange->omitBody) {
+            // A HEAD response has no body to frame.
+        } else if (exchange->requestProtocol == QNetworkHttpServerExchange::Protocol::Http1_1) {
+            exchange->chunked = true;
+            header += "Transfer-Encoding: chunked\r\n";
+        } else {
+            // An HTTP/1.0 client reads until the connection is closed.
+            exchange->closeConnection = true;
+        }
+    }
+
+    if (exchange->closeConnection)
+        header += "Connection: close\r\n";
+    else if (exchange->requestProtocol == QNetworkHttpServerExchange::Protocol::Http1_0)
+        header += "Connection: keep-alive\r\n";
+    header += "\r\n";
+
+    socket->write(header);
+    exchange->headersWritten = true;
+}
+
+void QHttp1ServerConnection::socketBytesWritten()
+{
+    if (socket->bytesToWrite() < socketWriteHighWaterMark)
+        writeResponses();
+}
+
+void QHttp1ServerConnection::closeConnection()
+{
+    state = Closing;
+    idleTimer.stop();
+    if (socket->state() == QAbstractSocket::UnconnectedState)
+        deleteLater();
+    else
+        socket->disconnectFromHost();
+}
+
+void QHttp1ServerConnection::idleTimeout()
+{
+    if (pipeline.isEmpty())
+        closeConnection();
+}
+
+QHttp2ServerConnection::QHttp2ServerConnection(QAbstractSocket *socket,
+                                               const QHttpServerSettings &settings,
+                                               QObject *parent)
+    : QHttpServerConnection(socket, settings, parent),
+      encoder(HPack::FieldLookupTable::DefaultSize,
+              settings.http2Configuration.huffmanCompressionEnabled()),
+      decoder(HPack::FieldLookupTable::DefaultSize)
+{
+    const QHttp2Configuration &configuration = settings.http2Configuration;
+    maxRecvFrameSize = configuration.maxFrameSize();
+    streamRecvWindowSize = qint32(configuration.streamReceiveWindowSize());
+    sessionRecvWindowSize = qint32(configuration.sessionReceiveWindowSize());
+}
+
+QHttp2ServerConnection::~QHttp2ServerConnection()
+{
+    for (auto &[streamID, stream] : streams)
+        stream.exchange->abort();
+}
+
+void QHttp2ServerConnection::start()
+{
+    connect(socket, &QIODevice::readyRead, this, &QHttp2ServerConnection::readFrames);
+    connect(socket, &QIODevice::bytesWritten, this, &QHttp2ServerConnection::socketBytesWritten);
+    connect(socket, &QAbstractSocket::disconnected, this, &QObject::deleteLater);
+
+    if (socket->state() != QAbstractSocket::ConnectedState) {
+        deleteLater();
+        return;
+    }
+
+    // The server connection preface (RFC 7540, 3.5):
+    sendServerSettings();
+    restartIdleTimer();
+    if (socket->bytesAvailable())
+        QMetaObject::invokeMethod(this, &QHttp2ServerConnection::readFrames, Qt::QueuedConnection);
+}
+
+void QHttp2ServerConnection::startWithUpgrade(QNetworkHttpServerExchange *exchange,
+                                              const QByteArray &clientSettings)
+{
+    exchange->setParent(this);
+    exchange->connection = this;
+    exchange->requestProtocol = QNetworkHttpServerExchange::Protocol::Http2;
+    exchange->streamId = 1;
+
+    // RFC 7540, 3.2: the upgraded request is stream 1, half-closed (remote).
+    lastStreamID = 1;
+    Stream &stream = streams[1];
+    stream.exchange = exchange;
+    stream.sendWindow = initialSendWindow;
+    stream.recvWindow = streamRecvWindowSize;
+    stream.remoteClosed = true;
+
+    start();
+    if (goingAway || !applySettings(reinterpret_cast<const uchar *>(clientSettings.constData()),
+                                    quint32(clientSettings.size()))) {
+        return;
+    }
+
+    idleTimer.stop();
+    exchange->finishRequest();
+    dispatch(exchange);
+}
+
+void QHttp2ServerConnection::requestDataConsumed(QNetworkHttpServerExchange *exchange)
+{
+    const auto it = streams.find(exchange->streamId);
+    if (it == streams.end() || it->second.remoteClosed)
+        return;
+
+    // Only what the handler has read is given back to the client, so a slow
+    // handler throttles its stream without affecting the others:
+    Stream &stream = it->second;
+    const qint64 consumed = qint64(streamRecvWindowSize) - stream.recvWindow
+                            - exchange->requestBody.byteAmount();
+    if (consumed >= streamRecvWindowSize / 2) {
+        sendWINDOW_UPDATE(it->first, quint32(consumed));
+        stream.recvWindow += qint32(consumed);
+    }
+}
+
+void QHttp2ServerConnection::readFrames()
+{
+    while (!goingAway) {
+        if (waitingForPreface && !readPreface())
+            return;
+
+        switch (frameReader.read(*socket)) {
+        case FrameStatus::incompleteFrame:
+            return;
+        case FrameStatus::protocolError:
+            return connectionError(PROTOCOL_ERROR, "invalid frame");
+        case FrameStatus::sizeError:
+            return connectionError(FRAME_SIZE_ERROR, "invalid frame size");
+        default:
+            break;
+        }
+
+        inboundFrame = std::move(frameReader.inboundFrame());
+        if (inboundFrame.payloadSize() > maxRecvFrameSize)
+            return connectionError(FRAME_SIZE_ERROR, "frame exceeds SETTINGS_MAX_FRAME_SIZE");
+
+        handleFrame();
+    }
+}
+
+bool QHttp2ServerConnection::readPreface()
+{
+    if (socket->bytesAvailable() < clientPrefaceLength)
+        return false;
+
+    char buffer[clientPrefaceLength];
+    socket->read(buffer, clientPrefaceLength);
+    if (std::memcmp(buffer, Http2clientPreface, clientPrefaceLength) != 0) {
+        connectionError(PROTOCOL_ERROR, "invalid connection preface");
+        return false;
+    }
+
+    waitingForPreface = false;
+    return true;
+}
+
+void QHttp2ServerConnection::handleFrame()
+{
+    const FrameType type = inboundFrame.type();
+    if (!continuedFrames.empty() && type != FrameType::CONTINUATION)
+        return connectionError(PROTOCOL_ERROR, "CONTINUATION expected");
+
+    switch (type) {
+    case FrameType::DATA:
+        handleDATA();
+        break;
+    case FrameType::HEADERS:
+        handleHEADERS();
+        break;
+    case FrameType::PRIORITY:
+        handlePRIORITY();
+        break;
+    case FrameType::RST_STREAM:
+        handleRST_STREAM();
+        break;
+    case FrameType::SETTINGS:
+        handleSETTINGS();
+        break;
+    case FrameType::PUSH_PROMISE:
+        connectionError(PROTOCOL_ERROR, "PUSH_PROMISE from a client");
+        break;
+    case FrameType::PING:
+        handlePING();
+        break;
+    case FrameType::GOAWAY:
+        handleGOAWAY();
+        break;
+    case FrameType::WINDOW_UPDATE:
+        handleWINDOW_UPDATE();
+        break;
+    case FrameType::CONTINUATION:
+        handleCONTINUATION();
+        break;
+    case FrameType::LAST_FRAME_TYPE:
+        // Frames of unknown types are ignored (RFC 7540, 4.1).
+        break;
+    }
+}
+
+void QHttp2ServerConnection::handleDATA()
+{
+    const quint32 streamID = inboundFrame.streamID();
+    if (streamID == connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "DATA on the connection stream");
+
+    // Flow control covers the whole payload, padding included (RFC 7540, 6.9.1):
+    const qint32 payloadSize = qint32(inboundFrame.payloadSize());
+    if (sessionRecvWindow < payloadSize)
+        return connectionError(FLOW_CONTROL_ERROR, "session receive window exceeded");
+    sessionRecvWindow -= payloadSize;
+
+    const auto it = streams.find(streamID);
+    if (it == streams.end() || it->second.remoteClosed) {
+        if (streamID > lastStreamID)
+            return connectionError(PROTOCOL_ERROR, "DATA on an idle stream");
+        if (it == streams.end())
+            sendRST_STREAM(streamID, STREAM_CLOSED);
+        else
+            resetStream(it, STREAM_CLOSED);
+    } else if (it->second.recvWindow < payloadSize) {
+        resetStream(it, FLOW_CONTROL_ERROR);
+    } else {
+        Stream &stream = it->second;
+        stream.recvWindow -= payloadSize;
+        QNetworkHttpServerExchange *exchange = stream.exchange;
+        if (const quint32 size = inboundFrame.dataSize()) {
+            exchange->appendRequestData(QByteArray(reinterpret_cast<const char *>(inboundFrame.dataBegin()),
+                                                   size));
+        }
+        if (inboundFrame.flags().testFlag(FrameFlag::END_STREAM)) {
+            stream.remoteClosed = true;
+            exchange->finishRequest();
+            if (stream.localClosed)
+                scheduleWrite();
+        }
+    }
+
+    // Backpressure is applied per stream, the session window is given back
+    // right away:
+    if (sessionRecvWindow < sessionRecvWindowSize / 2) {
+        sendWINDOW_UPDATE(connectionStreamID, quint32(sessionRecvWindowSize - sessionRecvWindow));
+        sessionRecvWindow = sessionRecvWindowSize;
+    }
+}
+
+void QHttp2ServerConnection::handleHEADERS()
+{
+    const quint32 streamID = inboundFrame.streamID();
+    if (streamID == connectionStreamID || !(streamID & 1))
+        return connectionError(PROTOCOL_ERROR, "HEADERS on an invalid stream");
+
+    if (streamID <= lastStreamID) {
+        // Only trailers can follow on a stream we know about:
+        const auto it = streams.find(streamID);
+        if (it == streams.end() || it->second.remoteClosed)
+            return connectionError(STREAM_CLOSED, "HEADERS on a closed stream");
+    }
+
+    quint32 dependency = 0;
+    if (inboundFrame.priority(&dependency) && dependency == streamID)
+        return connectionError(PROTOCOL_ERROR, "stream depends on itself");
+
+    const bool endHeaders = inboundFrame.flags().testFlag(FrameFlag::END_HEADERS);
+    continuedFrames.push_back(std::move(inboundFrame));
+    if (endHeaders)
+        handleContinuedHEADERS();
+}
+
+void QHttp2ServerConnection::handlePRIORITY()
+{
+    // Priorities are advisory and responses are interleaved round-robin.
+    if (inboundFrame.streamID() == connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "PRIORITY on the connection stream");
+}
+
+void QHttp2ServerConnection::handleRST_STREAM()
+{
+    const quint32 streamID = inboundFrame.streamID();
+    if (streamID == connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "RST_STREAM on the connection stream");
+    if (streamID > lastStreamID)
+        return connectionError(PROTOCOL_ERROR, "RST_STREAM on an idle stream");
+
+    const auto it = streams.find(streamID);
+    if (it == streams.end())
+        return;
+
+    QNetworkHttpServerExchange *exchange = it->second.exchange;
+    streams.erase(it);
+    exchange->abort();
+    if (streams.empty())
+        restartIdleTimer();
+}
+
+void QHttp2ServerConnection::handleSETTINGS()
+{
+    if (inboundFrame.streamID() != connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "SETTINGS on an invalid stream");
+
+    // Frame::validatePayload() has already checked the payload size.
+    if (inboundFrame.flags().testFlag(FrameFlag::ACK))
+        return;
+
+    if (!applySettings(inboundFrame.dataBegin(), inboundFrame.dataSize()))
+        return;
+
+    frameWriter.start(FrameType::SETTINGS, FrameFlag::ACK, connectionStreamID);
+    frameWriter.write(*socket);
+}
+
+void QHttp2ServerConnection::handlePING()
+{
+    if (inboundFrame.streamID() != connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "PING on an invalid stream");
+    if (inboundFrame.flags().testFlag(FrameFlag::ACK))
+        return;
+
+    frameWriter.start(FrameType::PING, FrameFlag::ACK, connectionStreamID);
+    frameWriter.append(inboundFrame.dataBegin(), inboundFrame.dataBegin() + 8);
+    frameWriter.write(*socket);
+}
+
+void QHttp2ServerConnection::handleGOAWAY()
+{
+    if (inboundFrame.streamID() != connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "GOAWAY on an invalid stream");
+
+    // The client opens no more streams; those in progress are completed.
+    if (streams.empty()) {
+        goingAway = true;
+        socket->disconnectFromHost();
+    }
+}
+
+void QHttp2ServerConnection::handleWINDOW_UPDATE()
+{
+    const quint32 delta = qFromBigEndian<quint32>(inboundFrame.dataBegin());
+    const bool valid = delta && delta <= quint32(std::numeric_limits<qint32>::max());
+    const quint32 streamID = inboundFrame.streamID();
+
+    if (streamID == connectionStreamID) {
+        if (!valid)
+            return connectionError(PROTOCOL_ERROR, "invalid WINDOW_UPDATE delta");
+        if (qint64(sessionSendWindow) + delta > std::numeric_limits<qint32>::max())
+            return connectionError(FLOW_CONTROL_ERROR, "session send window overflow");
+        sessionSendWindow += qint32(delta);
+    } else {
+        if (streamID > lastStreamID)
+            return connectionError(PROTOCOL_ERROR, "WINDOW_UPDATE on an idle stream");
+        const auto it = streams.find(streamID);
+        if (it == streams.end())
+            return;
+        if (!valid)
+            return resetStream(it, PROTOCOL_ERROR);
+        if (qint64(it->second.sendWindow) + delta > std::numeric_limits<qint32>::max())
+            return resetStream(it, FLOW_CONTROL_ERROR);
+        it->second.sendWindow += qint32(delta);
+    }
+
+    scheduleWrite();
+}
+
+void QHttp2ServerConnection::handleCONTINUATION()
+{
+    if (continuedFrames.empty() || inboundFrame.streamID() != continuedFrames.front().streamID())
+        return connectionError(PROTOCOL_ERROR, "unexpected CONTINUATION");
+
+    const bool endHeaders = inboundFrame.flags().testFlag(FrameFlag::END_HEADERS);
+    continuedFrames.push_back(std::move(inboundFrame));
+
+    quint64 blockSize = 0;
+    for (const Frame &frame : continuedFrames)
+        blockSize += frame.hpackBlockSize();
+    if (blockSize > quint64(maxHeaderBlockSize))
+        return connectionError(ENHANCE_YOUR_CALM, "header block too large");
+
+    if (endHeaders)
+        handleContinuedHEADERS();
+}
+
+void QHttp2ServerConnection::handleContinuedHEADERS()
+{
+    const std::vector<Frame> frames = std::exchange(continuedFrames, {});
+    const quint32 streamID = frames.front().streamID();
+    const bool endStream = frames.front().flags().testFlag(FrameFlag::END_STREAM);
+
+    std::vector<uchar> hpackBlock;
+    for (const Frame &frame : frames) {
+        if (const quint32 size = frame.hpackBlockSize())
+            hpackBlock.insert(hpackBlock.end(), frame.hpackBlockBegin(), frame.hpackBlockBegin() + size);
+    }
+
+    // Even a block we are going to ignore updates the decoder's state:
+    HPack::HttpHeader header;
+    if (!hpackBlock.empty()) {
+        HPack::BitIStream inputStream(&hpackBlock[0], &hpackBlock[0] + hpackBlock.size());
+        if (!decoder.decodeHeaderFields(inputStream))
+            return connectionError(COMPRESSION_ERROR, "HPACK decompression failed");
+        header = decoder.decodedHeader();
+    }
+
+    // The limit we advertise as SETTINGS_MAX_HEADER_LIST_SIZE applies to the
+    // decoded fields (RFC 7540, 6.5.2), which the dynamic table can make far
+    // larger than the block itself.
+    const HPack::HeaderSize headerListSize = HPack::header_size(header);
+    const bool headerListTooLarge = !headerListSize.first
+                                    || headerListSize.second > quint64(maxHeaderBlockSize);
+
+    const auto it = streams.find(streamID);
+    if (it != streams.end()) {
+        // Trailers; not exposed to the handler.
+        if (!endStream || headerListTooLarge)
+            return resetStream(it, PROTOCOL_ERROR);
+        it->second.remoteClosed = true;
+        it->second.exchange->finishRequest();
+        if (it->second.localClosed)
+            scheduleWrite();
+        return;
+    }
+
+    lastStreamID = streamID;
+    if (goingAway)
+        return;
+    if (headerListTooLarge)
+        return sendRST_STREAM(streamID, PROTOCOL_ERROR);
+    if (streams.size() >= size_t(maxConcurrentStreams))
+        return sendRST_STREAM(streamID, REFUSE_STREAM);
+
+    startStream(streamID, header, endStream);
+}
+
+bool QHttp2ServerConnection::applySettings(const uchar *src, quint32 size)
+{
+    Q_ASSERT(size % 6 == 0);
+
+    for (const uchar *end = src + size; src != end; src += 6) {
+        const auto identifier = Settings(qFromBigEndian<quint16>(src));
+        const quint32 value = qFromBigEndian<quint32>(src + 2);
+
+        switch (identifier) {
+        case Settings::HEADER_TABLE_SIZE_ID:
+            // Our encoder's table never grows beyond the default size; a
+            // change is announced at the start of the next header block.
+            pendingTableSize = std::min<quint32>(value, HPack::FieldLookupTable::DefaultSize);
+            tableSizeUpdatePending = pendingTableSize != encoderTableSize;
+            break;
+        case Settings::ENABLE_PUSH_ID:
+            if (value > 1) {
+                connectionError(PROTOCOL_ERROR, "invalid SETTINGS_ENABLE_PUSH");
+                return false;
+            }
+            break;
+        case Settings::INITIAL_WINDOW_SIZE_ID: {
+            if (value > quint32(std::numeric_limits<qint32>::max())) {
+                connectionError(FLOW_CONTROL_ERROR, "invalid SETTINGS_INITIAL_WINDOW_SIZE");
+                return false;
+            }
+            const qint64 delta = qint64(value) - initialSendWindow;
+            for (auto &[streamID, stream] : streams) {
+                if (stream.sendWindow + delta > std::numeric_limits<qint32>::max()) {
+                    connectionError(FLOW_CONTROL_ERROR, "stream send window overflow");
+                    return false;
+                }
+                stream.sendWindow = qint32(stream.sendWindow + delta);
+            }
+            initialSendWindow = qint32(value);
+            if (delta > 0)
+                scheduleWrite();
+            break;
+        }
+        case Settings::MAX_FRAME_SIZE_ID:
+            if (value < minPayloadLimit || value > maxPayloadSize) {
+                connectionError(PROTOCOL_ERROR, "invalid SETTINGS_MAX_FRAME_SIZE");
+                return false;
+            }
+            maxSendFrameSize = value;
+            break;
+        default:
+            // MAX_CONCURRENT_STREAMS only limits pushed streams and
+            // MAX_HEADER_LIST_SIZE is advisory.
+            break;
+        }
+    }
+
+    return true;
+}
+
+void QHttp2ServerConnection::startStream(quint32 streamID, const HPack::HttpHeader &header,
+                                         bool endStream)
+{
+    auto exchange = createExchange();
+    exchange->requestProtocol = QNetworkHttpServerExchange::Protocol::Http2;
+    exchange->streamId = streamID;
+
+    // RFC 7540, 8.1.2.1: pseudo-header fields precede all regular ones.
+    bool valid = true;
+    for (const HPack::HeaderField &field : header) {
+        if (!field.name.startsWith(':')) {
+            exchange->requestFields.append(qMakePair(field.name, field.value));
+            continue;
+        }
+        if (!exchange->requestFields.isEmpty())
+            valid = false;
+        else if (field.name == ":method")
+            exchange->requestMethod = field.value;
+        else if (field.name == ":scheme")
+            exchange->scheme = field.value;
+        else if (field.name == ":authority")
+            exchange->authority = field.value;
+        else if (field.name == ":path")
+            exchange->requestTarget = field.value;
+        else
+            valid = false;
+    }
+    if (exchange->authority.isEmpty())
+        exchange->authority = exchange->requestHeader("host");
+    if (exchange->requestMethod.isEmpty()
+        || (exchange->requestTarget.isEmpty() && exchange->requestMethod != "CONNECT")) {
+        valid = false;
+    }
+
+    if (!valid) {
+        delete exchange;
+        return sendRST_STREAM(streamID, PROTOCOL_ERROR);
+    }
+
+    Stream &stream = streams[streamID];
+    stream.exchange = exchange;
+    stream.sendWindow = initialSendWindow;
+    stream.recvWindow = streamRecvWindowSize;
+
+    idleTimer.stop();
+    if (endStream) {
+        stream.remoteClosed = true;
+        exchange->finishRequest();
+    }
+    dispatch(exchange);
+}
+
+void QHttp2ServerConnection::writeResponses()
+{
+    // Streams take turns, one frame each, until all are blocked on flow
+    // control or the socket has enough queued:
+    for (bool progress = true; progress && !goingAway;) {
+        progress = false;
+        for (auto it = streams.begin(); it != streams.end() && !goingAway;) {
+            if (socket->bytesToWrite() >= socketWriteHighWaterMark)
+                return; // resumed by socketBytesWritten()
+
+            Stream &stream = it->second;
+            progress |= writeStream(it->first, stream);
+            if (goingAway)
+                return;
+            if (!stream.localClosed) {
+                ++it;
+                continue;
+            }
+            // RFC 7540, 8.1: the rest of the request body is not needed anymore.
+            if (!stream.remoteClosed)
+                sendRST_STREAM(it->first, HTTP2_NO_ERROR);
+            it = closeStream(it);
+        }
+    }
+}
+
+bool QHttp2ServerConnection::writeStream(quint32 streamID, Stream &stream)
+{
+    QNetworkHttpServerExchange *exchange = stream.exchange;
+    if (!exchange->responseStarted || stream.localClosed)
+        return false;
+
+    if (!stream.headersSent)
+        return sendHEADERS(streamID, stream);
+
+    if (exchange->omitBody)
+        exchange->responseBody.clear();
+
+    if (!exchange->responseBody.isEmpty()) {
+        const qint32 window = std::min(stream.sendWindow, sessionSendWindow);
+        if (window <= 0)
+            return false; // resumed by WINDOW_UPDATE
+
+        const QByteArrayView data = exchange->responseBody.readPointer();
+        const quint32 size = quint32(std::min({qint64(window), qint64(maxSendFrameSize),
+                                               qint64(data.size())}));
+        const bool endStream = exchange->responseFinished
+                               && exchange->responseBody.byteAmount() == size;
+        sendDATA(streamID, reinterpret_cast<const uchar *>(data.data()), size, endStream);
+        exchange->responseBody.advanceReadPointer(size);
+        stream.sendWindow -= qint32(size);
+        sessionSendWindow -= qint32(size);
+        stream.localClosed = endStream;
+        emit exchange->bytesWritten(size);
+        return true;
+    }
+
+    if (exchange->responseFinished) {
+        sendDATA(streamID, nullptr, 0, true);
+        stream.localClosed = true;
+        return true;
+    }
+
+    return false;
+}
+
+bool QHttp2ServerConnection::sendHEADERS(quint32 streamID, Stream &stream)
+{
+    QNetworkHttpServerExchange *exchange = stream.exchange;
+    const int status = exchange->status;
+    exchange->omitBody = exchange->requestMethod == "HEAD" || hasNoContent(status);
+
+    HPack::HttpHeader header;
+    header.push_back({":status", QByteArray::number(status)});
+    bool hasContentLength = false;
+    for (const auto &field : std::as_const(exchange->responseFields)) {
+        const QByteArray name = field.first.toLower();
+        // RFC 7540, 8.1.2.2: no connection-specific header fields.
+        if (name == "connection" || name == "keep-alive" || name == "proxy-connection"
+            || name == "transfer-encoding" || name == "upgrade") {
+            continue;
+        }
+        hasContentLength |= name == "content-length";
+        header.push_back({name, field.second});
+    }
+    if (!hasContentLength && exchange->responseFinished && !hasNoContent(status))
+        header.push_back({"content-length", QByteArray::number(exchange->responseBody.byteAmount())});
+
+    if (exchange->omitBody)
+        exchange->responseBody.clear();
+    const bool endStream = exchange->responseFinished && exchange->responseBody.isEmpty();
+
+    FrameFlags flags = FrameFlag::END_HEADERS;
+    if (endStream)
+        flags |= FrameFlag::END_STREAM;
+    frameWriter.start(FrameType::HEADERS, flags, streamID);
+    HPack::BitOStream outputStream(frameWriter.outboundFrame().buffer);
+    if (tableSizeUpdatePending) {
+        encoder.setMaxDynamicTableSize(pendingTableSize);
+        if (!encoder.encodeSizeUpdate(outputStream, pendingTableSize)) {
+            connectionError(INTERNAL_ERROR, "HPACK table size update failed");
+            return false;
+        }
+        encoderTableSize = pendingTableSize;
+        tableSizeUpdatePending = false;
+    }
+    if (!encoder.encodeResponse(outputStream, header)) {
+        connectionError(INTERNAL_ERROR, "HPACK compression failed");
+        return false;
+    }
+    frameWriter.writeHEADERS(*socket, maxSendFrameSize);
+
+    stream.headersSent = true;
+    stream.localClosed = endStream;
+    return true;
+}
+
+void QHttp2ServerConnection::sendDATA(quint32 streamID, const uchar *src, quint32 size,
+                                      bool endStream)
+{
+    // One frame per call, so END_STREAM is only set on the last one:
+    Q_ASSERT(size <= maxSendFrameSize);
+    frameWriter.start(FrameType::DATA, endStream ? FrameFlag::END_STREAM : FrameFlag::EMPTY,
+                      streamID);
+    if (size)
+        frameWriter.writeDATA(*socket, maxSendFrameSize, src, size);
+    else
+        frameWriter.write(*socket);
+}
+
+void QHttp2ServerConnection::sendServerSettings()
+{
+    frameWriter.start(FrameType::SETTINGS, FrameFlag::EMPTY, connectionStreamID);
+    frameWriter.append(Settings::MAX_CONCURRENT_STREAMS_ID);
+    frameWriter.append(quint32(maxConcurrentStreams));
+    frameWriter.append(Settings::INITIAL_WINDOW_SIZE_ID);
+    frameWriter.append(quint32(streamRecvWindowSize));
+    frameWriter.append(Settings::MAX_FRAME_SIZE_ID);
+    frameWriter.append(maxRecvFrameSize);
+    frameWriter.append(Settings::MAX_HEADER_LIST_SIZE_ID);
+    frameWriter.append(quint32(maxHeaderBlockSize));
+    frameWriter.write(*socket);
+
+    // The session window can only be changed with WINDOW_UPDATE:
+    if (sessionRecvWindowSize > sessionRecvWindow) {
+        sendWINDOW_UPDATE(connectionStreamID, quint32(sessionRecvWindowSize - sessionRecvWindow));
+        sessionRecvWindow = sessionRecvWindowSize;
+    }
+}
+
+void QHttp2ServerConnection::sendRST_STREAM(quint32 streamID, quint32 errorCode)
+{
+    frameWriter.start(FrameType::RST_STREAM, FrameFlag::EMPTY, streamID);
+    frameWriter.append(errorCode);
+    frameWriter.write(*socket);
+}
+
+void QHttp2ServerConnection::sendWINDOW_UPDATE(quint32 streamID, quint32 delta)
+{
+    frameWriter.start(FrameType::WINDOW_UPDATE, FrameFlag::EMPTY, streamID);
+    frameWriter.append(delta);
+    frameWriter.write(*socket);
+}
+
+void QHttp2ServerConnection::sendGOAWAY(quint32 errorCode)
+{
+    frameWriter.start(FrameType::GOAWAY, FrameFlag::EMPTY, connectionStreamID);
+    frameWriter.append(lastStreamID);
+    frameWriter.append(errorCode);
+    frameWriter.write(*socket);
+}
+
+void QHttp2ServerConnection::socketBytesWritten()
+{
+    if (socket->bytesToWrite() < socketWriteHighWaterMark)
+        writeResponses();
+}
+
+QHttp2ServerConnection::StreamIterator QHttp2ServerConnection::closeStream(StreamIterator it)
+{
+    QNetworkHttpServerExchange *exchange = it->second.exchange;
+    it = streams.erase(it);
+
+    exchange->connection = nullptr;
+    emit exchange->finished();
+    exchange->deleteLater();
+
+    if (streams.empty())
+        restartIdleTimer();
+    return it;
+}
+
+void QHttp2ServerConnection::resetStream(StreamIterator it, quint32 errorCode)
+{
+    sendRST_STREAM(it->first, errorCode);
+    QNetworkHttpServerExchange *exchange = it->second.exchange;
+    streams.erase(it);
+    exchange->abort();
+    if (streams.empty())
+        restartIdleTimer();
+}
+
+void QHttp2ServerConnection::connectionError(quint32 errorCode, const char *message)
+{
+    qCDebug(QT_HTTP2, "HTTP/2 server connection error: %s", message);
+
+    goingAway = true;
+    idleTimer.stop();
+    sendGOAWAY(errorCode);
+    for (auto &[streamID, stream] : std::exchange(streams, {}))
+        stream.exchange->abort();
+
+    if (socket->state() == QAbstractSocket::UnconnectedState)
+        deleteLater();
+    else
+        socket->disconnectFromHost();
+}
+
+void QHttp2ServerConnection::idleTimeout()
+{
+    if (!streams.empty())
+        return;
+
+    goingAway = true;
+    sendGOAWAY(HTTP2_NO_ERROR);
+    socket->disconnectFromHost();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,246 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QHTTPSERVERCONNECTION_P_H
+#define QHTTPSERVERCONNECTION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include <QtNetwork/qhttp2configuration.h>
+#include <QtNetwork/private/qhttpheaderparser_p.h>
+#include <private/http2protocol_p.h>
+#include <private/http2frames_p.h>
+#include <private/hpack_p.h>
+
+#include <QtCore/qbasictimer.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qobject.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+QT_REQUIRE_CONFIG(http);
+
+QT_BEGIN_NAMESPACE
+
+class QAbstractSocket;
+class QNetworkHttpServerExchange;
+
+struct QHttpServerSettings
+{
+    // Shared by all connections, which call it from their worker threads:
+    std::shared_ptr<const std::function<void(QNetworkHttpServerExchange *)>> requestHandler;
+    QHttp2Configuration http2Configuration;
+    int keepAliveTimeout = 5000;
+    bool http2Enabled = true;
+    bool encrypted = false;
+};
+
+class QHttpServerConnection : public QObject
+{
+public:
+    QHttpServerConnection(QAbstractSocket *socket, const QHttpServerSettings &settings,
+                          QObject *parent);
+
+    // Called by QNetworkHttpServerExchange:
+    void responseDataAvailable();
+    virtual void requestDataConsumed(QNetworkHttpServerExchange *exchange) = 0;
+
+protected:
+    QNetworkHttpServerExchange *createExchange();
+    void dispatch(QNetworkHttpServerExchange *exchange);
+    void scheduleWrite();
+    void restartIdleTimer();
+    void timerEvent(QTimerEvent *event) override;
+
+    virtual void writeResponses() = 0;
+    virtual void idleTimeout() = 0;
+
+    QAbstractSocket *socket;
+    QHttpServerSettings settings;
+    QBasicTimer idleTimer;
+    bool writeScheduled = false;
+};
+
+class QHttp1ServerConnection : public QHttpServerConnection
+{
+public:
+    QHttp1ServerConnection(QAbstractSocket *socket, const QHttpServerSettings &settings,
+                           QObject *parent);
+    ~QHttp1ServerConnection() override;
+
+    void start();
+
+    void requestDataConsumed(QNetworkHttpServerExchange *exchange) override;
+
+private:
+    enum State {
+        ReadingRequestLine,
+        ReadingHeaders,
+        ReadingBody,
+        ReadingChunkSize,
+        ReadingChunkData,
+        ReadingChunkEnd,
+        ReadingTrailers,
+        Closing
+    };
+
+    void readRequests();
+    void scheduleRead();
+    bool readPreface();
+    void switchToHttp2(QNetworkHttpServerExchange *upgraded, const QByteArray &clientSettings);
+    bool readRequestLine();
+    bool readHeaders();
+    void startRequest();
+    bool upgradeToHttp2(QNetworkHttpServerExchange *exchange);
+    bool readBody();
+    bool readChunkSize();
+    bool readChunkEnd();
+    bool readTrailers();
+    void finishRequest();
+    void rejectRequest(int statusCode);
+    void writeResponses() override;
+    void writeResponseHeaders(QNetworkHttpServerExchange *exchange);
+    void socketBytesWritten();
+    void closeConnection();
+    void idleTimeout() override;
+
+    QList<QNetworkHttpServerExchange *> pipeline;
+    QNetworkHttpServerExchange *reading = nullptr;
+    QHttpHeaderParser parser;
+    QByteArray headerBlock;
+    qint64 bodyRemaining = 0;
+    State state = ReadingRequestLine;
+    bool readScheduled = false;
+    bool firstRequest = true;
+};
+
+class QHttp2ServerConnection : public QHttpServerConnection
+{
+public:
+    QHttp2ServerConnection(QAbstractSocket *socket, const QHttpServerSettings &settings,
+                           QObject *parent);
+    ~QHttp2ServerConnection() override;
+
+    void start();
+    void startWithUpgrade(QNetworkHttpServerExchange *exchange, const QByteArray &clientSettings);
+
+    void requestDataConsumed(QNetworkHttpServerExchange *exchange) override;
+
+private:
+    struct Stream
+    {
+        QNetworkHttpServerExchange *exchange = nullptr;
+        qint32 sendWindow = 0;
+        qint32 recvWindow = 0;
+        bool headersSent = false;
+        bool remoteClosed = false;
+        bool localClosed = false;
+    };
+
+    void readFrames();
+    bool readPreface();
+    void handleFrame();
+    void handleDATA();
+    void handleHEADERS();
+    void handlePRIORITY();
+    void handleRST_STREAM();
+    void handleSETTINGS();
+    void handlePING();
+    void handleGOAWAY();
+    void handleWINDOW_UPDATE();
+    void handleCONTINUATION();
+    void handleContinuedHEADERS();
+    bool applySettings(const uchar *src, quint32 size);
+    void startStream(quint32 streamID, const HPack::HttpHeader &header, bool endStream);
+
+    void writeResponses() override;
+    bool writeStream(quint32 streamID, Stream &stream);
+    bool sendHEADERS(quint32 streamID, Stream &stream);
+    void sendDATA(quint32 streamID, const uchar *src, quint32 size, bool endStream);
+    void sendServerSettings();
+    void sendRST_STREAM(quint32 streamID, quint32 errorCode);
+    void sendWINDOW_UPDATE(quint32 streamID, quint32 delta);
+    void sendGOAWAY(quint32 errorCode);
+    void socketBytesWritten();
+    using StreamIterator = std::map<quint32, Stream>::iterator;
+    StreamIterator closeStream(StreamIterator it);
+    void resetStream(StreamIterator it, quint32 errorCode);
+    void connectionError(quint32 errorCode, const char *message);
+    void idleTimeout() override;
+
+    std::map<quint32, Stream> streams;
+    Http2::FrameReader frameReader;
+    Http2::Frame inboundFrame;
+    Http2::FrameWriter frameWriter;
+    std::vector<Http2::Frame> continuedFrames;
+    HPack::Encoder encoder;
+    HPack::Decoder decoder;
+
+    quint32 lastStreamID = 0;
+    quint32 maxRecvFrameSize = Http2::minPayloadLimit;
+    quint32 maxSendFrameSize = Http2::minPayloadLimit;
+    qint32 streamRecvWindowSize = Http2::defaultSessionWindowSize;
+    qint32 sessionRecvWindowSize = Http2::defaultSessionWindowSize;
+    qint32 sessionRecvWindow = Http2::defaultSessionWindowSize;
+    qint32 sessionSendWindow = Http2::defaultSessionWindowSize;
+    qint32 initialSendWindow = Http2::defaultSessionWindowSize;
+    quint32 encoderTableSize = HPack::FieldLookupTable::DefaultSize;
+    quint32 pendingTableSize = 0;
+    bool tableSizeUpdatePending = false;
+    bool waitingForPreface = true;
+    bool goingAway = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QHTTPSERVERCONNECTION_P_H
@@ -181,9 +181,10 @@ class QNetworkAccessCachedHttpConnection: public QHttpNetworkConnection,
 {
     // Q_OBJECT
 public:
-    QNetworkAccessCachedHttpConnection(const QString &hostName, quint16 port, bool encrypt,
+    QNetworkAccessCachedHttpConnection(quint16 connectionCount, const QString &hostName,
+                                       quint16 port, bool encrypt,
                                        QHttpNetworkConnection::ConnectionType connectionType)
-        : QHttpNetworkConnection(hostName, port, encrypt, connectionType)
+        : QHttpNetworkConnection(connectionCount, hostName, port, encrypt, nullptr, connectionType)
     {
         setExpires(true);
         setShareable(true);
@@ -277,6 +278,8 @@ void QHttpThreadDelegate::startRequest()
     if (!connections.hasLocalData()) {
         connections.setLocalData(new QNetworkAccessCache());
     }
+    connections.localData()->setMaximumIdleEntries(
+            connectionPoolConfiguration.maximumIdleHosts());
 
     // check if we have an open connection to this host
     QUrl urlCopy = httpRequest.url();
@@ -331,10 +334,16 @@ void QHttpThreadDelegate::startRequest()
     // the http object is actually a QHttpNetworkConnection
     httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connections.localData()->requestEntryNow(cacheKey));
     if (!httpConnection) {
+        if (connectionPoolCounters)
+            connectionPoolCounters->poolMisses.fetchAndAddRelaxed(1);
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
-        httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
-                                                                connectionType);
+        httpConnection = new QNetworkAccessCachedHttpConnection(
+                quint16(connectionPoolConfiguration.maximumConnectionsPerHost()),
+                urlCopy.host(), urlCopy.port(), ssl, connectionType);
+        httpConnection->setPipelineLength(int(connectionPoolConfiguration.pipeliningDepth()));
+        httpConnection->setPreConnectCount(int(connectionPoolConfiguration.preConnectCount()));
+        httpConnection->setPoolCounters(connectionPoolCounters);
         if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2
             || connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
             httpConnection->setHttp2Parameters(http2Parameters);
@@ -351,8 +360,13 @@ void QHttpThreadDelegate::startRequest()
 #endif
         httpConnection->setPeerVerifyName(httpRequest.peerVerifyName());
         // cache the QHttpNetworkConnection corresponding to this cache key
-        connections.localData()->addEntry(cacheKey, httpConnection, connectionCacheExpiryTimeoutSeconds);
+        const qint64 expiryTimeoutSeconds = connectionCacheExpiryTimeoutSeconds > -1
+                ? connectionCacheExpiryTimeoutSeconds
+                : qint64(connectionPoolConfiguration.idleTimeout().count());
+        connections.localData()->addEntry(cacheKey, httpConnection, expiryTimeoutSeconds);
     } else {
+        if (connectionPoolCounters)
+            connectionPoolCounters->poolHits.fetchAndAddRelaxed(1);
         if (httpRequest.withCredentials()) {
             QNetworkAuthenticationCredential credential = authenticationManager->fetchCachedCredentials(httpRequest.url(), nullptr);
             if (!credential.user.isEmpty() && !credential.password.isEmpty()) {
@@ -63,6 +63,7 @@
 #include "qhttpnetworkrequest_p.h"
 #include "qhttpnetworkconnection_p.h"
 #include "qhttp2configuration.h"
+#include "qhttpconnectionpool_p.h"
 #include <QSharedPointer>
 #include <QScopedPointer>
 #include "private/qnoncontiguousbytedevice_p.h"
@@ -119,6 +120,8 @@ public:
     QNetworkReply::NetworkError incomingErrorCode;
     QString incomingErrorDetail;
     QHttp2Configuration http2Parameters;
+    QHttpConnectionPoolConfiguration connectionPoolConfiguration;
+    std::shared_ptr<QHttpConnectionPoolCounters> connectionPoolCounters;
 
     bool isCompressed;
 
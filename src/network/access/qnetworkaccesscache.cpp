@@ -128,6 +128,7 @@ void QNetworkAccessCache::clear()
     timer.stop();
 
     firstExpiringNode = lastExpiringNode = nullptr;
+    idleEntryCount = 0;
 }
 
 /*!
@@ -187,6 +188,7 @@ void QNetworkAccessCache::linkEntry(const QByteArray &key)
         // there are no entries, so this is the next-to-expire too
         firstExpiringNode = node;
     }
+    ++idleEntryCount;
     Q_ASSERT(firstExpiringNode->previous == nullptr);
     Q_ASSERT(lastExpiringNode->next == nullptr);
 }
@@ -201,6 +203,9 @@ bool QNetworkAccessCache::unlinkEntry(const QByteArray &key)
     if (!node)
         return false;
 
+    if (node->previous || node == firstExpiringNode)
+        --idleEntryCount;
+
     bool wasFirst = false;
     if (node == firstExpiringNode) {
         firstExpiringNode = node->next;
@@ -250,20 +255,48 @@ bool QNetworkAccessCache::emitEntryReady(Node *node, QObject *target, const char
 
 void QNetworkAccessCache::timerEvent(QTimerEvent *)
 {
-    while (firstExpiringNode && firstExpiringNode->timer.hasExpired()) {
-        Node *next = firstExpiringNode->next;
-        firstExpiringNode->object->dispose();
-        hash.remove(firstExpiringNode->key); // `firstExpiringNode` gets deleted
-        delete firstExpiringNode;
-        firstExpiringNode = next;
-    }
+    while (firstExpiringNode && firstExpiringNode->timer.hasExpired())
+        disposeFirstExpiringNode();
+
+    updateTimer();
+}
+
+void QNetworkAccessCache::disposeFirstExpiringNode()
+{
+    Node *next = firstExpiringNode->next;
+    firstExpiringNode->object->dispose();
+    hash.remove(firstExpiringNode->key); // `firstExpiringNode` gets deleted
+    delete firstExpiringNode;
+    firstExpiringNode = next;
+    --idleEntryCount;
 
     // fixup the list
     if (firstExpiringNode)
         firstExpiringNode->previous = nullptr;
     else
         lastExpiringNode = nullptr;
+}
+
+/*!
+    Limits the number of entries that are not in use to \a count. When more
+    entries become unused, the ones closest to expiry are disposed of right
+    away. A negative \a count means no limit.
+ */
+void QNetworkAccessCache::setMaximumIdleEntries(qsizetype count)
+{
+    if (count == maximumIdleEntries)
+        return;
+    maximumIdleEntries = count;
+    trimIdleEntries();
+}
+
+void QNetworkAccessCache::trimIdleEntries()
+{
+    if (maximumIdleEntries < 0 || idleEntryCount <= maximumIdleEntries)
+        return;
 
+    while (idleEntryCount > maximumIdleEntries)
+        disposeFirstExpiringNode();
     updateTimer();
 }
 
@@ -344,6 +377,7 @@ void QNetworkAccessCache::releaseEntry(const QByteArray &key)
 
         if (firstExpiringNode == node)
             updateTimer();
+        trimIdleEntries();
     }
 }
 
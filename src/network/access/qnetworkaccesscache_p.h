@@ -101,6 +101,8 @@ public:
     void releaseEntry(const QByteArray &key);
     void removeEntry(const QByteArray &key);
 
+    void setMaximumIdleEntries(qsizetype count);
+
 signals:
     void entryReady(QNetworkAccessCache::CacheableObject *);
 
@@ -114,10 +116,14 @@ private:
     Node *lastExpiringNode = nullptr;
 
     QBasicTimer timer;
+    qsizetype idleEntryCount = 0; // the nodes in the expiring list
+    qsizetype maximumIdleEntries = -1;
 
     void linkEntry(const QByteArray &key);
     bool unlinkEntry(const QByteArray &key);
     void updateTimer();
+    void disposeFirstExpiringNode();
+    void trimIdleEntries();
     bool emitEntryReady(Node *node, QObject *target, const char *member);
 };
 
@@ -71,6 +71,7 @@
 #include "QtNetwork/private/http2protocol_p.h"
 
 #if QT_CONFIG(http)
+#include "qhttpconnectionpool.h"
 #include "qhttpmultipart.h"
 #include "qhttpmultipart_p.h"
 #include "qnetworkreplyhttpimpl_p.h"
@@ -941,6 +942,9 @@ QNetworkReply *QNetworkAccessManager::deleteResource(const QNetworkRequest &requ
     enough, i.e. calling this method multiple times per host will not result in faster
     network transactions.
 
+    Since Qt 6.4, the number of connections opened is set by
+    QHttpConnectionPoolConfiguration::setPreConnectCount().
+
     \note This function has no possibility to report errors.
 
     \sa connectToHost(), get(), post(), put(), deleteResource()
@@ -967,6 +971,9 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
     enough, i.e. calling this method multiple times per host will not result in faster
     network transactions.
 
+    Since Qt 6.4, the number of connections opened is set by
+    QHttpConnectionPoolConfiguration::setPreConnectCount().
+
     \note This function has no possibility to report errors.
 
     \sa connectToHost(), get(), post(), put(), deleteResource()
@@ -1001,6 +1008,9 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
     This function is useful to complete the TCP handshake
     to a host before the HTTP request is made, resulting in a lower network latency.
 
+    Since Qt 6.4, the number of connections opened is set by
+    QHttpConnectionPoolConfiguration::setPreConnectCount().
+
     \note This function has no possibility to report errors.
 
     \sa connectToHostEncrypted(), get(), post(), put(), deleteResource()
@@ -1432,6 +1442,56 @@ void QNetworkAccessManager::setTransferTimeout(int timeout)
     d_func()->transferTimeout = timeout;
 }
 
+#if QT_CONFIG(http)
+/*!
+    \since 6.4
+
+    Returns the policy the manager uses to pool its HTTP connections.
+
+    \sa setConnectionPoolConfiguration(), connectionPoolStatistics()
+*/
+QHttpConnectionPoolConfiguration QNetworkAccessManager::connectionPoolConfiguration() const
+{
+    return d_func()->connectionPoolConfiguration;
+}
+
+/*!
+    \since 6.4
+
+    Sets the policy the manager uses to pool its HTTP connections to
+    \a configuration.
+
+    The number of connections per host, the pipelining depth and the number
+    of connections opened by pre-connecting are fixed when the manager first
+    connects to a host; they only apply to hosts the manager has no pooled
+    connections to yet. The limit on idle hosts applies from the next
+    request on.
+
+    \sa connectionPoolConfiguration(), clearConnectionCache()
+*/
+void QNetworkAccessManager::setConnectionPoolConfiguration(const QHttpConnectionPoolConfiguration &configuration)
+{
+    d_func()->connectionPoolConfiguration = configuration;
+}
+
+/*!
+    \since 6.4
+
+    Returns a snapshot of the counters describing how the manager used its
+    HTTP connection pool: how often a request found its host in the pool,
+    how many connections were opened, and how long requests waited for a
+    free connection.
+
+    The counters are not reset by clearConnectionCache().
+
+    \sa connectionPoolConfiguration()
+*/
+QHttpConnectionPoolStatistics QNetworkAccessManager::connectionPoolStatistics() const
+{
+    return d_func()->connectionPoolCounters->snapshot();
+}
+#endif // QT_CONFIG(http)
+
 void QNetworkAccessManagerPrivate::_q_replyFinished(QNetworkReply *reply)
 {
     Q_Q(QNetworkAccessManager);
@@ -66,6 +66,10 @@
 #include "qhstsstore_p.h"
 #endif // QT_CONFIG(settings)
 
+#if QT_CONFIG(http)
+#include "qhttpconnectionpool_p.h"
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QAuthenticator;
@@ -169,6 +173,12 @@ public:
 
     int transferTimeout = 0;
 
+#if QT_CONFIG(http)
+    QHttpConnectionPoolConfiguration connectionPoolConfiguration;
+    std::shared_ptr<QHttpConnectionPoolCounters> connectionPoolCounters
+        = std::make_shared<QHttpConnectionPoolCounters>();
+#endif
+
     Q_DECLARE_PUBLIC(QNetworkAccessManager)
 };
 
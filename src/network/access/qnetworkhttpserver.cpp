@@ -0,0 +1,711 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qnetworkhttpserver_p.h"
+#include "qhttpserverconnection_p.h"
+
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+#if QT_CONFIG(ssl)
+#include <QtNetwork/qsslsocket.h>
+#endif
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qthread.h>
+#include <QtCore/private/qobject_p.h>
+#ifdef Q_OS_WIN
+#include <QtCore/qt_windows.h>
+#include <winsock2.h>
+#else
+#include <QtCore/private/qcore_unix_p.h>
+#endif
+
+#include <utility>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QNetworkHttpServerExchange
+    \internal
+    \inmodule QtNetwork
+    \since 6.4
+
+    \brief A single request received by QNetworkHttpServer and its response.
+
+    The request body is read through the QIODevice interface; readyRead() is
+    emitted as body data arrives and readChannelFinished() once the complete
+    request has been received. The response is produced with setStatusCode(),
+    setResponseHeader() and write(), and completed with finish(). Until the
+    response is finished, HTTP/1.1 responses are sent with chunked transfer
+    coding and HTTP/2 responses as a sequence of DATA frames; a response that
+    is finished before any of it was sent gets a Content-Length header.
+
+    An exchange belongs to the worker thread of its connection and must only
+    be used from that thread. It is deleted once finished() has been emitted,
+    which happens when the response has been handed to the socket or the
+    connection has been lost.
+*/
+
+/*!
+    \enum QNetworkHttpServerExchange::Protocol
+
+    \value Http1_0 The request was received over HTTP/1.0.
+    \value Http1_1 The request was received over HTTP/1.1.
+    \value Http2 The request was received over HTTP/2, either directly or after
+           an upgrade from HTTP/1.1.
+*/
+
+/*!
+    \fn void QNetworkHttpServerExchange::finished()
+
+    This signal is emitted when the response has been completely written to
+    the connection, or when the connection was lost before that. The exchange
+    is deleted afterwards.
+*/
+
+QNetworkHttpServerExchange::QNetworkHttpServerExchange(QHttpServerConnection *connection)
+    : QIODevice(connection),
+      connection(connection)
+{
+    open(QIODevice::ReadWrite | QIODevice::Unbuffered);
+}
+
+QNetworkHttpServerExchange::~QNetworkHttpServerExchange()
+    = default;
+
+/*!
+    Returns the URL of the request, made up from the scheme of the connection,
+    the request's authority (or \c Host header) and its target.
+*/
+QUrl QNetworkHttpServerExchange::url() const
+{
+    if (!requestTarget.startsWith('/'))
+        return QUrl::fromEncoded(requestTarget);
+    return QUrl::fromEncoded(scheme + "://" + authority + requestTarget);
+}
+
+/*!
+    Returns the value of the request header \a name, compared
+    case-insensitively. The values of repeated headers are joined by commas.
+*/
+QByteArray QNetworkHttpServerExchange::requestHeader(const QByteArray &name) const
+{
+    QByteArray result;
+    for (const auto &field : requestFields) {
+        if (name.compare(field.first, Qt::CaseInsensitive) != 0)
+            continue;
+        if (!result.isEmpty())
+            result += ", ";
+        result += field.second;
+    }
+    return result;
+}
+
+bool QNetworkHttpServerExchange::isSequential() const
+{
+    return true;
+}
+
+qint64 QNetworkHttpServerExchange::bytesAvailable() const
+{
+    return requestBody.byteAmount() + QIODevice::bytesAvailable();
+}
+
+/*!
+    Returns the number of response body bytes that have been written but not
+    yet handed to the socket, because of TCP or HTTP/2 flow control.
+*/
+qint64 QNetworkHttpServerExchange::bytesToWrite() const
+{
+    return responseBody.byteAmount();
+}
+
+bool QNetworkHttpServerExchange::atEnd() const
+{
+    return requestComplete && bytesAvailable() == 0;
+}
+
+/*!
+    Sets the status code of the response to \a code. This has no effect once
+    the response headers have been sent.
+*/
+void QNetworkHttpServerExchange::setStatusCode(int code)
+{
+    if (responseStarted) {
+        qWarning("QNetworkHttpServerExchange::setStatusCode: response already started");
+        return;
+    }
+    status = code;
+}
+
+/*!
+    Sets the response header \a name to \a value, replacing any header of the
+    same name.
+*/
+void QNetworkHttpServerExchange::setResponseHeader(const QByteArray &name, const QByteArray &value)
+{
+    if (responseStarted) {
+        qWarning("QNetworkHttpServerExchange::setResponseHeader: response already started");
+        return;
+    }
+    responseFields.removeIf([&name](const QPair<QByteArray, QByteArray> &field) {
+        return name.compare(field.first, Qt::CaseInsensitive) == 0;
+    });
+    responseFields.append(qMakePair(name, value));
+}
+
+/*!
+    Adds the response header \a name with \a value, keeping any headers of the
+    same name.
+*/
+void QNetworkHttpServerExchange::addResponseHeader(const QByteArray &name, const QByteArray &value)
+{
+    if (responseStarted) {
+        qWarning("QNetworkHttpServerExchange::addResponseHeader: response already started");
+        return;
+    }
+    responseFields.append(qMakePair(name, value));
+}
+
+/*!
+    Sends the status line and headers without waiting for body data. Writing
+    to the exchange does this implicitly.
+*/
+void QNetworkHttpServerExchange::sendResponseHeaders()
+{
+    startResponse();
+}
+
+/*!
+    Convenience function that sends a complete response with status \a
+    statusCode, the body \a body and, if not empty, the \c Content-Type \a
+    contentType.
+*/
+void QNetworkHttpServerExchange::respond(int statusCode, const QByteArray &body,
+                                         const QByteArray &contentType)
+{
+    setStatusCode(statusCode);
+    if (!contentType.isEmpty())
+        setResponseHeader("Content-Type", contentType);
+    if (!body.isEmpty())
+        write(body);
+    finish();
+}
+
+/*!
+    Completes the response. No more data can be written afterwards.
+*/
+void QNetworkHttpServerExchange::finish()
+{
+    if (responseFinished)
+        return;
+    responseFinished = true;
+    startResponse();
+}
+
+qint64 QNetworkHttpServerExchange::readData(char *data, qint64 maxSize)
+{
+    if (requestBody.isEmpty())
+        return requestComplete ? -1 : 0;
+    const qint64 read = requestBody.read(data, maxSize);
+    if (connection)
+        connection->requestDataConsumed(this);
+    return read;
+}
+
+qint64 QNetworkHttpServerExchange::writeData(const char *data, qint64 maxSize)
+{
+    if (responseFinished || !connection) {
+        setErrorString(tr("The response has already been finished"));
+        return -1;
+    }
+    if (maxSize > 0)
+        responseBody.append(QByteArray(data, maxSize));
+    startResponse();
+    return maxSize;
+}
+
+void QNetworkHttpServerExchange::appendRequestData(QByteArray &&data)
+{
+    requestBody.append(std::move(data));
+    emit readyRead();
+}
+
+void QNetworkHttpServerExchange::finishRequest()
+{
+    if (requestComplete)
+        return;
+    requestComplete = true;
+    emit readChannelFinished();
+}
+
+void QNetworkHttpServerExchange::startResponse()
+{
+    responseStarted = true;
+    if (connection)
+        connection->responseDataAvailable();
+}
+
+void QNetworkHttpServerExchange::abort()
+{
+    connection = nullptr;
+    requestComplete = true;
+    responseFinished = true;
+    responseBody.clear();
+    emit finished();
+    deleteLater();
+}
+
+class QNetworkHttpServerPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QNetworkHttpServer)
+public:
+    class Listener : public QTcpServer
+    {
+    public:
+        explicit Listener(QNetworkHttpServerPrivate *d) : d(d) {}
+
+    protected:
+        void incomingConnection(qintptr socketDescriptor) override
+        {
+            d->dispatchConnection(socketDescriptor);
+        }
+
+    private:
+        QNetworkHttpServerPrivate *d;
+    };
+
+    struct Worker
+    {
+        QThread *thread;
+        QObject *context;
+    };
+
+    void startWorkers();
+    void stopWorkers();
+    void dispatchConnection(qintptr socketDescriptor);
+
+    Listener listener{this};
+    QObject localContext;
+    std::vector<Worker> workers;
+    size_t nextWorker = 0;
+    int workerThreadCount = QThread::idealThreadCount();
+    QHttpServerSettings settings;
+#if QT_CONFIG(ssl)
+    QSslConfiguration sslConfiguration;
+#endif
+};
+
+void QNetworkHttpServerPrivate::startWorkers()
+{
+    Q_ASSERT(workers.empty());
+    for (int i = 0; i < workerThreadCount; ++i) {
+        auto thread = new QThread;
+        thread->setObjectName(QStringLiteral("QNetworkHttpServer worker %1").arg(i));
+        auto context = new QObject;
+        context->moveToThread(thread);
+        QObject::connect(thread, &QThread::finished, context, &QObject::deleteLater);
+        thread->start();
+        workers.push_back({thread, context});
+    }
+    nextWorker = 0;
+}
+
+void QNetworkHttpServerPrivate::stopWorkers()
+{
+    // Connections that were accepted but not yet started are dropped along
+    // with the queued calls that would start them; see PendingDescriptor.
+    // Those of the workers go when the worker contexts are deleted.
+    for (const Worker &worker : workers) {
+        worker.thread->quit();
+        worker.thread->wait();
+        delete worker.thread;
+    }
+    workers.clear();
+    QCoreApplication::removePostedEvents(&localContext, QEvent::MetaCall);
+    qDeleteAll(localContext.children());
+}
+
+namespace {
+// Owns an accepted socket descriptor until a socket has adopted it, so that
+// a connection whose start is still queued when the server closes is not
+// leaked.
+class PendingDescriptor
+{
+public:
+    explicit PendingDescriptor(qintptr descriptor) : descriptor(descriptor) {}
+    PendingDescriptor(PendingDescriptor &&other) noexcept
+        : descriptor(std::exchange(other.descriptor, -1))
+    {}
+    ~PendingDescriptor()
+    {
+        if (descriptor == -1)
+            return;
+#ifdef Q_OS_WIN
+        ::closesocket(SOCKET(descriptor));
+#else
+        qt_safe_close(int(descriptor));
+#endif
+    }
+
+    qintptr get() const { return descriptor; }
+    void release() { descriptor = -1; }
+
+private:
+    qintptr descriptor;
+};
+} // unnamed namespace
+
+static void startHttpConnection(QAbstractSocket *socket, const QHttpServerSettings &settings,
+                                QObject *context)
+{
+#if QT_CONFIG(ssl)
+    if (settings.encrypted && settings.http2Enabled
+        && static_cast<QSslSocket *>(socket)->sslConfiguration().nextNegotiatedProtocol()
+               == QSslConfiguration::ALPNProtocolHTTP2) {
+        auto connection = new QHttp2ServerConnection(socket, settings, context);
+        connection->start();
+        return;
+    }
+#endif
+    auto connection = new QHttp1ServerConnection(socket, settings, context);
+    connection->start();
+}
+
+void QNetworkHttpServerPrivate::dispatchConnection(qintptr socketDescriptor)
+{
+    QObject *context = &localContext;
+    if (!workers.empty()) {
+        context = workers[nextWorker].context;
+        nextWorker = (nextWorker + 1) % workers.size();
+    }
+
+#if QT_CONFIG(ssl)
+    QSslConfiguration ssl = sslConfiguration;
+    if (settings.encrypted) {
+        // Offer what startHttpConnection() will speak, with the settings
+        // the connection is accepted with
+        QList<QByteArray> protocols = ssl.allowedNextProtocols();
+        if (protocols.isEmpty()) {
+            protocols = {QSslConfiguration::ALPNProtocolHTTP2,
+                         QSslConfiguration::NextProtocolHttp1_1};
+        }
+        if (!settings.http2Enabled)
+            protocols.removeAll(QSslConfiguration::ALPNProtocolHTTP2);
+        ssl.setAllowedNextProtocols(protocols);
+    }
+#endif
+    QMetaObject::invokeMethod(context, [context, descriptor = PendingDescriptor(socketDescriptor),
+                                        settings = settings
+#if QT_CONFIG(ssl)
+                                        , ssl
+#endif
+                                        ]() mutable {
+#if QT_CONFIG(ssl)
+        if (settings.encrypted) {
+            auto socket = new QSslSocket(context);
+            if (!socket->setSocketDescriptor(descriptor.get())) {
+                qWarning("QNetworkHttpServer: cannot adopt the accepted socket: %ls",
+                         qUtf16Printable(socket->errorString()));
+                delete socket;
+                return;
+            }
+            descriptor.release();
+            socket->setSslConfiguration(ssl);
+            QObject::connect(socket, &QSslSocket::encrypted, context, [=]() {
+                // From now on the connection owns the socket:
+                QObject::disconnect(socket, &QAbstractSocket::disconnected,
+                                    socket, &QObject::deleteLater);
+                startHttpConnection(socket, settings, context);
+            });
+            QObject::connect(socket, &QAbstractSocket::disconnected, socket, &QObject::deleteLater);
+            socket->startServerEncryption();
+            return;
+        }
+#endif
+        auto socket = new QTcpSocket(context);
+        if (!socket->setSocketDescriptor(descriptor.get())) {
+            qWarning("QNetworkHttpServer: cannot adopt the accepted socket: %ls",
+                     qUtf16Printable(socket->errorString()));
+            delete socket;
+            return;
+        }
+        descriptor.release();
+        startHttpConnection(socket, settings, context);
+    }, Qt::QueuedConnection);
+}
+
+/*!
+    \class QNetworkHttpServer
+    \internal
+    \inmodule QtNetwork
+    \since 6.4
+
+    \brief The QNetworkHttpServer class is an embedded HTTP/1.1 and HTTP/2
+    server.
+
+    The server accepts connections on a QTcpServer and distributes them
+    round-robin over a pool of worker threads, each running its own event
+    loop. Every request is passed to the request handler in the worker thread
+    that owns the connection, as a QNetworkHttpServerExchange; see
+    setRequestHandler(). The handler must therefore be thread-safe when more
+    than one worker thread is used.
+
+    HTTP/1.1 connections support keep-alive, pipelining, chunked request and
+    response bodies, and \c{Expect: 100-continue}. HTTP/2 is reused from the
+    QtNetwork client implementation (framing and HPACK) and is negotiated
+    with ALPN on encrypted connections, by prior knowledge, or by an upgrade
+    from HTTP/1.1 (\c h2c) on cleartext connections. Request and response
+    bodies are streamed and subject to HTTP/2 flow control, so slow
+    handlers or clients do not cause unbounded buffering.
+*/
+
+/*!
+    \typealias QNetworkHttpServer::RequestHandler
+
+    The type of the function that is called for every request received.
+*/
+
+/*!
+    Constructs a QNetworkHttpServer with the given \a parent.
+*/
+QNetworkHttpServer::QNetworkHttpServer(QObject *parent)
+    : QObject(*new QNetworkHttpServerPrivate, parent)
+{
+}
+
+/*!
+    Destroys the server, closing all connections and stopping the worker
+    threads.
+*/
+QNetworkHttpServer::~QNetworkHttpServer()
+{
+    close();
+}
+
+/*!
+    Starts listening on \a address and \a port; a \a port of 0 picks one
+    automatically. Returns \c true on success.
+
+    \sa serverPort(), errorString()
+*/
+bool QNetworkHttpServer::listen(const QHostAddress &address, quint16 port)
+{
+    Q_D(QNetworkHttpServer);
+    if (d->listener.isListening()) {
+        qWarning("QNetworkHttpServer::listen() called when already listening");
+        return false;
+    }
+    if (!d->listener.listen(address, port))
+        return false;
+    d->startWorkers();
+    return true;
+}
+
+/*!
+    Returns \c true if the server is listening for connections.
+*/
+bool QNetworkHttpServer::isListening() const
+{
+    Q_D(const QNetworkHttpServer);
+    return d->listener.isListening();
+}
+
+/*!
+    Stops listening, closes all connections and stops the worker threads.
+*/
+void QNetworkHttpServer::close()
+{
+    Q_D(QNetworkHttpServer);
+    d->listener.close();
+    d->stopWorkers();
+}
+
+/*!
+    Returns the address the server is listening on.
+*/
+QHostAddress QNetworkHttpServer::serverAddress() const
+{
+    Q_D(const QNetworkHttpServer);
+    return d->listener.serverAddress();
+}
+
+/*!
+    Returns the port the server is listening on.
+*/
+quint16 QNetworkHttpServer::serverPort() const
+{
+    Q_D(const QNetworkHttpServer);
+    return d->listener.serverPort();
+}
+
+/*!
+    Returns a description of the last error that occurred in listen().
+*/
+QString QNetworkHttpServer::errorString() const
+{
+    Q_D(const QNetworkHttpServer);
+    return d->listener.errorString();
+}
+
+/*!
+    Sets the function that is called for every request received to \a
+    handler. It is called in a worker thread as soon as the request's headers
+    are complete; the request body, if any, may still be arriving. The
+    response does not need to be produced before the handler returns, as the
+    exchange stays valid until QNetworkHttpServerExchange::finished() is
+    emitted. Without a handler, every request is answered with 404 Not Found.
+
+    The server owns \a handler. Connections accepted afterwards use it, and it
+    is destroyed once they and the server are gone; no worker thread calls it
+    after close() has returned.
+*/
+void QNetworkHttpServer::setRequestHandler(RequestHandler handler)
+{
+    Q_D(QNetworkHttpServer);
+    d->settings.requestHandler = std::make_shared<const RequestHandler>(std::move(handler));
+}
+
+/*!
+    Sets the number of worker threads to \a count. The default is
+    QThread::idealThreadCount(). With a \a count of 0, connections are
+    handled in the thread the server lives in. Takes effect on the next call
+    to listen().
+*/
+void QNetworkHttpServer::setWorkerThreadCount(int count)
+{
+    Q_D(QNetworkHttpServer);
+    d->workerThreadCount = qMax(0, count);
+}
+
+/*!
+    Returns the number of worker threads.
+*/
+int QNetworkHttpServer::workerThreadCount() const
+{
+    Q_D(const QNetworkHttpServer);
+    return d->workerThreadCount;
+}
+
+/*!
+    Enables or disables HTTP/2 support, according to \a enable. It is enabled
+    by default. Affects connections accepted afterwards.
+*/
+void QNetworkHttpServer::setHttp2Enabled(bool enable)
+{
+    Q_D(QNetworkHttpServer);
+    d->settings.http2Enabled = enable;
+}
+
+/*!
+    Returns \c true if HTTP/2 is enabled.
+*/
+bool QNetworkHttpServer::isHttp2Enabled() const
+{
+    Q_D(const QNetworkHttpServer);
+    return d->settings.http2Enabled;
+}
+
+/*!
+    Sets the parameters used for HTTP/2 connections to \a configuration: the
+    receive window sizes, the maximum frame size and whether response headers
+    are Huffman-encoded. Server push is never used.
+*/
+void QNetworkHttpServer::setHttp2Configuration(const QHttp2Configuration &configuration)
+{
+    Q_D(QNetworkHttpServer);
+    d->settings.http2Configuration = configuration;
+}
+
+/*!
+    Returns the HTTP/2 configuration.
+*/
+QHttp2Configuration QNetworkHttpServer::http2Configuration() const
+{
+    Q_D(const QNetworkHttpServer);
+    return d->settings.http2Configuration;
+}
+
+/*!
+    Sets the time in milliseconds an idle connection is kept open to \a msecs.
+    The default is 5 seconds; 0 disables the timeout.
+*/
+void QNetworkHttpServer::setKeepAliveTimeout(int msecs)
+{
+    Q_D(QNetworkHttpServer);
+    d->settings.keepAliveTimeout = qMax(0, msecs);
+}
+
+/*!
+    Returns the keep-alive timeout in milliseconds.
+*/
+int QNetworkHttpServer::keepAliveTimeout() const
+{
+    Q_D(const QNetworkHttpServer);
+    return d->settings.keepAliveTimeout;
+}
+
+#if QT_CONFIG(ssl)
+/*!
+    Makes the server accept TLS connections only, using \a configuration. If
+    \a configuration allows no protocols for ALPN, \c h2 and \c http/1.1
+    are offered; \c h2 is never offered while HTTP/2 is disabled.
+*/
+void QNetworkHttpServer::setSslConfiguration(const QSslConfiguration &configuration)
+{
+    Q_D(QNetworkHttpServer);
+    d->sslConfiguration = configuration;
+    d->settings.encrypted = !configuration.isNull();
+}
+
+/*!
+    Returns the TLS configuration of the server.
+*/
+QSslConfiguration QNetworkHttpServer::sslConfiguration() const
+{
+    Q_D(const QNetworkHttpServer);
+    return d->sslConfiguration;
+}
+#endif // QT_CONFIG(ssl)
+
+QT_END_NAMESPACE
+
+#include "moc_qnetworkhttpserver_p.cpp"
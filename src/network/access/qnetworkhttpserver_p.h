@@ -0,0 +1,206 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QNETWORKHTTPSERVER_P_H
+#define QNETWORKHTTPSERVER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include <QtNetwork/qhostaddress.h>
+#include <QtNetwork/qhttp2configuration.h>
+#if QT_CONFIG(ssl)
+#include <QtNetwork/qsslconfiguration.h>
+#endif
+
+#include <QtCore/qiodevice.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qurl.h>
+#include <QtCore/private/qbytedata_p.h>
+
+#include <functional>
+
+QT_REQUIRE_CONFIG(http);
+
+QT_BEGIN_NAMESPACE
+
+class QHttpServerConnection;
+class QHttp1ServerConnection;
+class QHttp2ServerConnection;
+class QNetworkHttpServerPrivate;
+
+class Q_NETWORK_PRIVATE_EXPORT QNetworkHttpServerExchange : public QIODevice
+{
+    Q_OBJECT
+public:
+    enum class Protocol {
+        Http1_0,
+        Http1_1,
+        Http2
+    };
+
+    ~QNetworkHttpServerExchange() override;
+
+    Protocol protocol() const { return requestProtocol; }
+    QByteArray method() const { return requestMethod; }
+    QByteArray target() const { return requestTarget; }
+    QUrl url() const;
+    const QList<QPair<QByteArray, QByteArray>> &requestHeaders() const { return requestFields; }
+    QByteArray requestHeader(const QByteArray &name) const;
+    QHostAddress peerAddress() const { return peer; }
+    quint16 peerPort() const { return port; }
+    bool isRequestFinished() const { return requestComplete; }
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+    qint64 bytesToWrite() const override;
+    bool atEnd() const override;
+
+    void setStatusCode(int code);
+    int statusCode() const { return status; }
+    void setResponseHeader(const QByteArray &name, const QByteArray &value);
+    void addResponseHeader(const QByteArray &name, const QByteArray &value);
+    const QList<QPair<QByteArray, QByteArray>> &responseHeaders() const { return responseFields; }
+    void sendResponseHeaders();
+    bool isResponseStarted() const { return responseStarted; }
+
+    void respond(int statusCode, const QByteArray &body = QByteArray(),
+                 const QByteArray &contentType = QByteArray());
+    void finish();
+    bool isFinished() const { return responseFinished; }
+
+Q_SIGNALS:
+    void finished();
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    friend class QHttpServerConnection;
+    friend class QHttp1ServerConnection;
+    friend class QHttp2ServerConnection;
+
+    explicit QNetworkHttpServerExchange(QHttpServerConnection *connection);
+    void appendRequestData(QByteArray &&data);
+    void finishRequest();
+    void startResponse();
+    void abort();
+
+    QPointer<QHttpServerConnection> connection;
+    quint32 streamId = 0;
+    Protocol requestProtocol = Protocol::Http1_1;
+    QByteArray requestMethod;
+    QByteArray requestTarget;
+    QByteArray scheme;
+    QByteArray authority;
+    QList<QPair<QByteArray, QByteArray>> requestFields;
+    QHostAddress peer;
+    quint16 port = 0;
+    QByteDataBuffer requestBody;
+
+    int status = 200;
+    QList<QPair<QByteArray, QByteArray>> responseFields;
+    QByteDataBuffer responseBody;
+
+    bool requestComplete = false;
+    bool responseStarted = false;
+    bool responseFinished = false;
+    // HTTP/1.x framing of the response:
+    bool headersWritten = false;
+    bool chunked = false;
+    bool omitBody = false;
+    bool closeConnection = false;
+    bool expectContinue = false;
+};
+
+class Q_NETWORK_PRIVATE_EXPORT QNetworkHttpServer : public QObject
+{
+    Q_OBJECT
+public:
+    using RequestHandler = std::function<void(QNetworkHttpServerExchange *exchange)>;
+
+    explicit QNetworkHttpServer(QObject *parent = nullptr);
+    ~QNetworkHttpServer() override;
+
+    bool listen(const QHostAddress &address = QHostAddress::Any, quint16 port = 0);
+    bool isListening() const;
+    void close();
+    QHostAddress serverAddress() const;
+    quint16 serverPort() const;
+    QString errorString() const;
+
+    void setRequestHandler(RequestHandler handler);
+
+    void setWorkerThreadCount(int count);
+    int workerThreadCount() const;
+
+    void setHttp2Enabled(bool enable);
+    bool isHttp2Enabled() const;
+    void setHttp2Configuration(const QHttp2Configuration &configuration);
+    QHttp2Configuration http2Configuration() const;
+
+    void setKeepAliveTimeout(int msecs);
+    int keepAliveTimeout() const;
+
+#if QT_CONFIG(ssl)
+    void setSslConfiguration(const QSslConfiguration &configuration);
+    QSslConfiguration sslConfiguration() const;
+#endif
+
+private:
+    Q_DECLARE_PRIVATE(QNetworkHttpServer)
+    Q_DISABLE_COPY_MOVE(QNetworkHttpServer)
+};
+
+QT_END_NAMESPACE
+
+#endif // QNETWORKHTTPSERVER_P_H
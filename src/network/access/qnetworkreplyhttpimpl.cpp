@@ -854,6 +854,10 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     // from HTTP thread to user thread in some cases.
     delegate->authenticationManager = managerPrivate->authenticationManager;
 
+    // The pool policy and counters of the manager, for the connection cache of the HTTP thread.
+    delegate->connectionPoolConfiguration = managerPrivate->connectionPoolConfiguration;
+    delegate->connectionPoolCounters = managerPrivate->connectionPoolCounters;
+
     if (!synchronous) {
         // Tell our zerocopy policy to the delegate
         QVariant downloadBufferMaximumSizeAttribute = newHttpRequest.attribute(QNetworkRequest::MaximumDownloadBufferSizeAttribute);
@@ -476,6 +476,7 @@
 #include <qpointer.h>
 #include <qtimer.h>
 #include <qelapsedtimer.h>
+#include <qfile.h>
 #include <qscopedvaluerollback.h>
 #include <qvarlengtharray.h>
 
@@ -551,6 +552,7 @@ void QAbstractSocketPrivate::resetSocketLayer()
 #endif
 
     hasPendingData = false;
+    pendingFiles.clear();
     if (socketEngine) {
         socketEngine->close();
         socketEngine->disconnect();
@@ -777,7 +779,7 @@ void QAbstractSocketPrivate::connectionNotification()
 bool QAbstractSocketPrivate::writeToSocket()
 {
     Q_Q(QAbstractSocket);
-    if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
+    if (!socketEngine || !socketEngine->isValid() || (!hasPendingWrites()
         && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::writeToSocket() nothing to do: valid ? %s, writeBuffer.isEmpty() ? %s",
@@ -795,11 +797,42 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
+    qint64 written;
+    if (!pendingFiles.isEmpty() && pendingFiles.constFirst().bufferedBefore == 0) {
+        written = writeFileToSocket();
+        if (written == -2)
+            return false;
+    } else {
+        // Gather the buffered blocks up to the next file, if any, and
+        // attempt to write them all with one call.
+        constexpr qsizetype MaxBlocks = 16;
+        QByteArrayView blocks[MaxBlocks];
+        qsizetype blockCount = 0;
+        const qint64 limit = pendingFiles.isEmpty() ? writeBuffer.size()
+                                                    : pendingFiles.constFirst().bufferedBefore;
+        for (qint64 pos = 0; pos < limit && blockCount < MaxBlocks; ) {
+            qint64 blockSize;
+            const char *ptr = writeBuffer.readPointerAtPosition(pos, blockSize);
+            blockSize = qMin(blockSize, limit - pos);
+            blocks[blockCount++] = QByteArrayView(ptr, blockSize);
+            pos += blockSize;
+        }
+
+        if (blockCount == 0)
+            written = 0;
+        else if (blockCount == 1)
+            written = socketEngine->write(blocks[0].data(), blocks[0].size());
+        else
+            written = socketEngine->writeVectored(blocks, blockCount);
+
+        if (written > 0) {
+            // Remove what we wrote so far.
+            writeBuffer.free(written);
+            if (!pendingFiles.isEmpty())
+                pendingFiles.first().bufferedBefore -= written;
+        }
+    }
 
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -816,15 +849,11 @@ bool QAbstractSocketPrivate::writeToSocket()
            written);
 #endif
 
-    if (written > 0) {
-        // Remove what we wrote so far.
-        writeBuffer.free(written);
-
-        // Emit notifications.
+    // Emit notifications.
+    if (written > 0)
         emitBytesWritten(written);
-    }
 
-    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
+    if (!hasPendingWrites() && socketEngine && !socketEngine->bytesToWrite())
         socketEngine->setWriteNotificationEnabled(false);
     if (state == QAbstractSocket::ClosingState)
         q->disconnectFromHost();
@@ -832,6 +861,62 @@ bool QAbstractSocketPrivate::writeToSocket()
     return written > 0;
 }
 
+/*! \internal
+
+    Writes the next part of the first file queued with
+    QTcpSocket::sendFile() to the socket and returns the number of bytes
+    written, or -1 if the socket engine reported an error. The file is sent
+    with QAbstractSocketEngine::sendFile() if possible. Otherwise, a block
+    of it is read and written as usual.
+
+    If the file cannot be read anymore, the error is reported, the socket
+    is aborted and -2 is returned.
+*/
+qint64 QAbstractSocketPrivate::writeFileToSocket()
+{
+    Q_Q(QAbstractSocket);
+    PendingFile &pending = pendingFiles.first();
+    if (!pending.file || !pending.file->isReadable()) {
+        setErrorAndEmit(QAbstractSocket::UnknownSocketError,
+                        QAbstractSocket::tr("The file was closed before it was sent"));
+        q->abort();
+        return -2;
+    }
+
+    qint64 written = -1;
+    if (pending.sendDirectly && pending.file->handle() != -1) {
+        written = socketEngine->sendFile(pending.file->handle(), pending.offset, pending.size);
+        if (written < 0 && socketEngine->error() == QAbstractSocket::UnsupportedSocketOperationError)
+            pending.sendDirectly = false;
+        else if (written < 0)
+            return -1;
+        else if (written == 0)
+            written = -1; // the socket is full, or the file has shrunk: reading it tells
+    }
+
+    if (written < 0) {
+        QVarLengthArray<char, 4096> block(qMin(pending.size, qint64(QABSTRACTSOCKET_BUFFERSIZE)));
+        qint64 blockSize = -1;
+        if (pending.file->seek(pending.offset))
+            blockSize = pending.file->read(block.data(), block.size());
+        if (blockSize <= 0) {
+            setErrorAndEmit(QAbstractSocket::UnknownSocketError,
+                            QAbstractSocket::tr("The file could not be read"));
+            q->abort();
+            return -2;
+        }
+        written = socketEngine->write(block.constData(), blockSize);
+        if (written < 0)
+            return -1;
+    }
+
+    pending.offset += written;
+    pending.size -= written;
+    if (pending.size == 0)
+        pendingFiles.removeFirst();
+    return written;
+}
+
 /*! \internal
 
     Writes pending data in the write buffers to the socket. The function
@@ -842,12 +927,51 @@ bool QAbstractSocketPrivate::flush()
 {
     bool dataWasWritten = false;
 
-    while (!allWriteBuffersEmpty() && writeToSocket())
+    while ((!allWriteBuffersEmpty() || !pendingFiles.isEmpty()) && writeToSocket())
         dataWasWritten = true;
 
     return dataWasWritten;
 }
 
+/*! \internal
+
+    Returns the number of bytes of the files queued with
+    QTcpSocket::sendFile() that have not been written yet.
+*/
+qint64 QAbstractSocketPrivate::pendingFileBytes() const
+{
+    qint64 bytes = 0;
+    for (const PendingFile &pending : pendingFiles)
+        bytes += pending.size;
+    return bytes;
+}
+
+/*! \internal
+
+    Queues \a size bytes of \a file, starting at \a offset, to be written
+    after the data that is already in the write buffer, and returns \a
+    size. QSslSocketPrivate reimplements this function, because it needs
+    to encrypt the file contents.
+*/
+qint64 QAbstractSocketPrivate::sendFile(QFile *file, qint64 offset, qint64 size)
+{
+    if (state == QAbstractSocket::UnconnectedState) {
+        setError(QAbstractSocket::UnknownSocketError, QAbstractSocket::tr("Socket is not connected"));
+        return -1;
+    }
+    if (size == 0)
+        return 0;
+
+    qint64 bufferedBefore = writeBuffer.size();
+    for (const PendingFile &pending : qAsConst(pendingFiles))
+        bufferedBefore -= pending.bufferedBefore;
+    pendingFiles.append({file, offset, size, bufferedBefore, true});
+
+    if (socketEngine)
+        socketEngine->setWriteNotificationEnabled(true);
+    return size;
+}
+
 #ifndef QT_NO_NETWORKPROXY
 /*! \internal
 
@@ -1767,7 +1891,8 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
 */
 qint64 QAbstractSocket::bytesToWrite() const
 {
-    const qint64 pendingBytes = QIODevice::bytesToWrite();
+    Q_D(const QAbstractSocket);
+    const qint64 pendingBytes = QIODevice::bytesToWrite() + d->pendingFileBytes();
 #if defined(QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::bytesToWrite() == %lld", pendingBytes);
 #endif
@@ -2195,7 +2320,7 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
 
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, d->hasPendingWrites(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2247,7 +2372,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (!d->hasPendingWrites())
         return false;
 
     QElapsedTimer stopWatch;
@@ -2264,7 +2389,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite,
                                   !d->readBufferMaxSize || d->buffer.size() < d->readBufferMaxSize,
-                                  !d->writeBuffer.isEmpty(),
+                                  d->hasPendingWrites(),
                                   qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForBytesWritten(%i) failed (%i, %s)",
@@ -2344,7 +2469,7 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               d->hasPendingWrites(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2381,6 +2506,7 @@ void QAbstractSocket::abort()
     qDebug("QAbstractSocket::abort()");
 #endif
     d->setWriteChannelCount(0);
+    d->pendingFiles.clear();
     d->abortCalled = true;
     close();
 }
@@ -2463,7 +2589,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     }
 
     if (!d->isBuffered && d->socketType == TcpSocket
-        && d->socketEngine && d->writeBuffer.isEmpty()) {
+        && d->socketEngine && !d->hasPendingWrites()) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = size ? d->socketEngine->write(data, size) : Q_INT64_C(0);
         if (written < 0) {
@@ -2691,7 +2817,7 @@ void QAbstractSocket::disconnectFromHost()
 
         // Wait for pending data to be written.
         if (d->socketEngine && d->socketEngine->isValid() && (!d->allWriteBuffersEmpty()
-            || d->socketEngine->bytesToWrite() > 0)) {
+            || !d->pendingFiles.isEmpty() || d->socketEngine->bytesToWrite() > 0)) {
             d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined(QABSTRACTSOCKET_DEBUG)
@@ -55,6 +55,7 @@
 #include "QtNetwork/qabstractsocket.h"
 #include "QtCore/qbytearray.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qpointer.h"
 #include "QtCore/qtimer.h"
 #include "private/qiodevice_p.h"
 #include "private/qabstractsocketengine_p.h"
@@ -62,6 +63,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QFile;
 class QHostInfo;
 
 class QAbstractSocketPrivate : public QIODevicePrivate, public QAbstractSocketEngineReceiver
@@ -137,6 +139,8 @@ public:
     void fetchConnectionParameters();
     bool readFromSocket();
     virtual bool writeToSocket();
+    qint64 writeFileToSocket();
+    virtual qint64 sendFile(QFile *file, qint64 offset, qint64 size);
     void emitReadyRead(int channel = 0);
     void emitBytesWritten(qint64 bytes, int channel = 0);
 
@@ -147,6 +151,21 @@ public:
     bool isBuffered = false;
     bool hasPendingData = false;
 
+    // Files queued by QTcpSocket::sendFile(), in the order they are sent.
+    // bufferedBefore is the number of bytes of writeBuffer that have to
+    // be written before the file.
+    struct PendingFile
+    {
+        QPointer<QFile> file;
+        qint64 offset;
+        qint64 size;
+        qint64 bufferedBefore;
+        bool sendDirectly;
+    };
+    QList<PendingFile> pendingFiles;
+    qint64 pendingFileBytes() const;
+    bool hasPendingWrites() const { return !writeBuffer.isEmpty() || !pendingFiles.isEmpty(); }
+
     QTimer *connectTimer = nullptr;
 
     int hostLookupId = -1;
@@ -259,6 +259,106 @@ void QAbstractSocketEngine::setPeerPort(quint16 port)
     d_func()->peerPort = port;
 }
 
+/*!
+    Writes the \a count blocks in \a buffers to the socket, in order.
+    Returns the number of bytes written, or -1 if an error occurred.
+
+    The default implementation calls write() for each block and stops
+    at the first block that could not be written completely. Engines
+    that can write several blocks at once reimplement this function.
+*/
+qint64 QAbstractSocketEngine::writeVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    qint64 total = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 written = write(buffers[i].data(), buffers[i].size());
+        if (written < 0)
+            return total ? total : written;
+        total += written;
+        if (written < buffers[i].size())
+            break;
+    }
+    return total;
+}
+
+/*!
+    Writes up to \a len bytes of the file \a fileDescriptor, starting at
+    \a offset, to the socket without copying them through user space.
+    The file position of \a fileDescriptor is not changed. Returns the
+    number of bytes written, or -1 if an error occurred.
+
+    The default implementation fails with
+    QAbstractSocket::UnsupportedSocketOperationError, in which case the
+    caller has to read the file and write() its contents.
+*/
+qint64 QAbstractSocketEngine::sendFile(qintptr fileDescriptor, qint64 offset, qint64 len)
+{
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(len);
+    setError(QAbstractSocket::UnsupportedSocketOperationError,
+             tr("Operation on socket is not supported"));
+    return -1;
+}
+
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Reads up to \a count datagrams from the socket into \a datagrams.
+    The data buffer of each entry must be sized to the maximum number of
+    bytes to read into it. The buffers of the datagrams that were read are
+    truncated to the number of bytes received, and their headers are
+    filled in according to \a options.
+
+    Returns the number of datagrams read, -2 if no datagram was pending,
+    or -1 if an error occurred.
+
+    The default implementation calls readDatagram() as long as
+    hasPendingDatagrams() returns \c true. Engines that can receive
+    several datagrams at once reimplement this function.
+*/
+qsizetype QAbstractSocketEngine::readDatagrams(QNetworkDatagramPrivate *const *datagrams,
+                                               qsizetype count, PacketHeaderOptions options)
+{
+    qsizetype received = 0;
+    for (; received < count; ++received) {
+        if (received && !hasPendingDatagrams())
+            break;
+        QByteArray &buffer = datagrams[received]->data;
+        const qint64 readBytes = readDatagram(buffer.isEmpty() ? nullptr : buffer.data(),
+                                              buffer.size(), &datagrams[received]->header,
+                                              options);
+        if (readBytes < 0)
+            return received ? received : qsizetype(readBytes);
+        buffer.truncate(readBytes);
+    }
+    return received;
+}
+
+/*!
+    Writes the \a count datagrams in \a datagrams to the socket, in order.
+    Returns the number of datagrams sent, -2 if the first datagram could
+    not be sent because the operation would block, or -1 if an error
+    occurred.
+
+    The default implementation calls writeDatagram() for each datagram
+    and stops at the first one that fails. Engines that can send several
+    datagrams at once reimplement this function.
+*/
+qsizetype QAbstractSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                                qsizetype count)
+{
+    qsizetype sent = 0;
+    for (; sent < count; ++sent) {
+        const QNetworkDatagramPrivate *datagram = datagrams[sent];
+        const qint64 written = writeDatagram(datagram->data.constData(), datagram->data.size(),
+                                             datagram->header);
+        if (written < 0)
+            return sent ? sent : qsizetype(written);
+    }
+    return sent;
+}
+#endif // QT_NO_UDPSOCKET
+
 int QAbstractSocketEngine::inboundStreamCount() const
 {
     return d_func()->inboundStreamCount;
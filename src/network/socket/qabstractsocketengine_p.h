@@ -107,7 +107,8 @@ public:
         ReceivePacketInformation,
         ReceiveHopLimit,
         MaxStreamsSocketOption,
-        PathMtuInformation
+        PathMtuInformation,
+        PortReusable
     };
 
     enum PacketHeaderOption {
@@ -141,6 +142,8 @@ public:
 
     virtual qint64 read(char *data, qint64 maxlen) = 0;
     virtual qint64 write(const char *data, qint64 len) = 0;
+    virtual qint64 writeVectored(const QByteArrayView *buffers, qsizetype count);
+    virtual qint64 sendFile(qintptr fileDescriptor, qint64 offset, qint64 len);
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -154,6 +157,9 @@ public:
 
     virtual bool hasPendingDatagrams() const = 0;
     virtual qint64 pendingDatagramSize() const = 0;
+    virtual qsizetype readDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                                    PacketHeaderOptions = WantNone);
+    virtual qsizetype writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, qsizetype count);
 #endif // QT_NO_UDPSOCKET
 
     virtual qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader *header = nullptr,
@@ -842,6 +842,58 @@ qint64 QNativeSocketEngine::pendingDatagramSize() const
 
     return d->nativePendingDatagramSize();
 }
+
+/*!
+    Reads up to \a count datagrams into \a datagrams, filling in their
+    headers according to \a options. Returns the number of datagrams read,
+    -2 if none was pending, or -1 if an error occurred.
+
+    On Linux, the datagrams are received with as few recvmmsg() calls as
+    possible.
+
+    \sa QAbstractSocketEngine::readDatagrams()
+*/
+qsizetype QNativeSocketEngine::readDatagrams(QNetworkDatagramPrivate *const *datagrams,
+                                             qsizetype count, PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::readDatagrams(), QAbstractSocket::UdpSocket, -1);
+
+#ifdef Q_OS_LINUX
+    return d->nativeReceiveDatagrams(datagrams, count, options);
+#else
+    return QAbstractSocketEngine::readDatagrams(datagrams, count, options);
+#endif
+}
+
+/*!
+    Writes the \a count datagrams in \a datagrams to the destinations
+    contained in their headers. Returns the number of datagrams sent, -2 if
+    the operation would block, or -1 if an error occurred.
+
+    On Linux, the datagrams are sent with as few sendmmsg() calls as
+    possible.
+
+    \sa QAbstractSocketEngine::writeDatagrams()
+*/
+qsizetype QNativeSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                              qsizetype count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::UdpSocket, -1);
+
+#ifdef Q_OS_LINUX
+    return d->nativeSendDatagrams(datagrams, count);
+#else
+    return QAbstractSocketEngine::writeDatagrams(datagrams, count);
+#endif
+}
 #endif // QT_NO_UDPSOCKET
 
 /*!
@@ -918,6 +970,34 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+/*!
+    Writes the \a count blocks in \a buffers to the socket with a single
+    system call. Returns the number of bytes written, or -1 if an error
+    occurred.
+*/
+qint64 QNativeSocketEngine::writeVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeVectored(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeVectored(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteVectored(buffers, count);
+}
+
+/*!
+    Writes up to \a len bytes of the file \a fileDescriptor, starting at
+    \a offset, to the socket. Returns the number of bytes written, or -1
+    if an error occurred. If the platform cannot send files directly,
+    error() returns QAbstractSocket::UnsupportedSocketOperationError.
+*/
+qint64 QNativeSocketEngine::sendFile(qintptr fileDescriptor, qint64 offset, qint64 len)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::sendFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::sendFile(), QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::sendFile(), QAbstractSocket::TcpSocket, -1);
+    return d->nativeSendFile(fileDescriptor, offset, len);
+}
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
@@ -146,6 +146,8 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+    qint64 writeVectored(const QByteArrayView *buffers, qsizetype count) override;
+    qint64 sendFile(qintptr fileDescriptor, qint64 offset, qint64 len) override;
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -159,6 +161,9 @@ public:
 
     bool hasPendingDatagrams() const override;
     qint64 pendingDatagramSize() const override;
+    qsizetype readDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                            PacketHeaderOptions = WantNone) override;
+    qsizetype writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, qsizetype count) override;
 #endif // QT_NO_UDPSOCKET
 
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
@@ -277,8 +282,15 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#ifdef Q_OS_LINUX
+    qsizetype nativeReceiveDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                                     QAbstractSocketEngine::PacketHeaderOptions options);
+    qsizetype nativeSendDatagrams(const QNetworkDatagramPrivate *const *datagrams, qsizetype count);
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+    qint64 nativeWriteVectored(const QByteArrayView *buffers, qsizetype count);
+    qint64 nativeSendFile(qintptr fileDescriptor, qint64 offset, qint64 length);
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
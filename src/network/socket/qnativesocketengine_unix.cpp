@@ -62,6 +62,9 @@
 #ifdef Q_OS_INTEGRITY
 #include <sys/uio.h>
 #endif
+#ifdef Q_OS_LINUX
+#include <sys/sendfile.h>
+#endif
 
 #if defined QNATIVESOCKETENGINE_DEBUG
 #include <private/qdebug_p.h>
@@ -208,6 +211,17 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
 #endif
         }
         break;
+
+    case QNativeSocketEngine::PortReusable:
+        // Only use the variants that make the kernel distribute incoming
+        // connections between the sockets sharing the port. Elsewhere, plain
+        // SO_REUSEPORT allows the binding but does not balance the load.
+#if defined(SO_REUSEPORT_LB)
+        n = SO_REUSEPORT_LB;
+#elif defined(SO_REUSEPORT) && defined(Q_OS_LINUX)
+        n = SO_REUSEPORT;
+#endif
+        break;
     }
 }
 
@@ -905,173 +919,191 @@ qint64 QNativeSocketEnginePrivate::nativePendingDatagramSize() const
     return qint64(recvResult);
 }
 
-qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
-                                                         QAbstractSocketEngine::PacketHeaderOptions options)
-{
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+namespace {
+// we use quintptr to force the alignment
+using ReceiveControlBuffer = quintptr[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
 #if !defined(IP_PKTINFO) && defined(IP_RECVIF) && defined(Q_OS_BSD4)
-                   + CMSG_SPACE(sizeof(sockaddr_dl))
+                                      + CMSG_SPACE(sizeof(sockaddr_dl))
 #endif
 #ifndef QT_NO_SCTP
-                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+                                      + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
 #endif
-                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+                                      + sizeof(quintptr) - 1) / sizeof(quintptr)];
 
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
-    char c;
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
+using SendControlBuffer = quintptr[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+#ifndef QT_NO_SCTP
+                                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+#endif
+                                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+} // unnamed namespace
+
+static void qt_socket_setupReceiveMessage(struct msghdr *msg, struct iovec *vec, qt_sockaddr *aa,
+                                          ReceiveControlBuffer &cbuf, char *data, qint64 maxSize,
+                                          char *discard, QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    memset(msg, 0, sizeof(*msg));
+    memset(aa, 0, sizeof(*aa));
 
     // we need to receive at least one byte, even if our user isn't interested in it
-    vec.iov_base = maxSize ? data : &c;
-    vec.iov_len = maxSize ? maxSize : 1;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
+    vec->iov_base = maxSize ? data : discard;
+    vec->iov_len = maxSize ? maxSize : 1;
+    msg->msg_iov = vec;
+    msg->msg_iovlen = 1;
     if (options & QAbstractSocketEngine::WantDatagramSender) {
-        msg.msg_name = &aa;
-        msg.msg_namelen = sizeof(aa);
+        msg->msg_name = aa;
+        msg->msg_namelen = sizeof(*aa);
     }
     if (options & (QAbstractSocketEngine::WantDatagramHopLimit | QAbstractSocketEngine::WantDatagramDestination
                    | QAbstractSocketEngine::WantStreamNumber)) {
-        msg.msg_control = cbuf;
-        msg.msg_controllen = sizeof(cbuf);
+        msg->msg_control = cbuf;
+        msg->msg_controllen = sizeof(cbuf);
     }
+}
 
-    ssize_t recvResult = 0;
-    do {
-        recvResult = ::recvmsg(socketDescriptor, &msg, 0);
-    } while (recvResult == -1 && errno == EINTR);
-
-    if (recvResult == -1) {
-        switch (errno) {
-#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
-#endif
-        case EAGAIN:
-            // No datagram was available for reading
-            recvResult = -2;
-            break;
-        case ECONNREFUSED:
-            setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+static void qt_socket_readPacketHeader(struct msghdr *msg, const qt_sockaddr *aa, QIpPacketHeader *header)
+{
+    qt_socket_getPortAndAddress(aa, &header->senderPort, &header->senderAddress);
+    header->endOfRecord = (msg->msg_flags & MSG_EOR) != 0;
+
+    // parse the ancillary data
+    struct cmsghdr *cmsgptr;
+    QT_WARNING_PUSH
+    QT_WARNING_DISABLE_CLANG("-Wsign-compare")
+    for (cmsgptr = CMSG_FIRSTHDR(msg); cmsgptr != nullptr;
+         cmsgptr = CMSG_NXTHDR(msg, cmsgptr)) {
+        QT_WARNING_POP
+        if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
+            in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
+            header->ifindex = info->ipi6_ifindex;
+            if (header->ifindex)
+                header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
         }
-        if (header)
-            header->clear();
-    } else if (options != QAbstractSocketEngine::WantNone) {
-        Q_ASSERT(header);
-        qt_socket_getPortAndAddress(&aa, &header->senderPort, &header->senderAddress);
-        header->destinationPort = localPort;
-        header->endOfRecord = (msg.msg_flags & MSG_EOR) != 0;
-
-        // parse the ancillary data
-        struct cmsghdr *cmsgptr;
-        QT_WARNING_PUSH
-        QT_WARNING_DISABLE_CLANG("-Wsign-compare")
-        for (cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != nullptr;
-             cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
-            QT_WARNING_POP
-            if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
-                in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
-                header->ifindex = info->ipi6_ifindex;
-                if (header->ifindex)
-                    header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
-            }
 
 #ifdef IP_PKTINFO
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
-                in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
+            in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
 
-                header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
-                header->ifindex = info->ipi_ifindex;
-            }
+            header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
+            header->ifindex = info->ipi_ifindex;
+        }
 #else
 #  ifdef IP_RECVDSTADDR
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
-                in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
+            in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
 
-                header->destinationAddress.setAddress(ntohl(addr->s_addr));
-            }
+            header->destinationAddress.setAddress(ntohl(addr->s_addr));
+        }
 #  endif
 #  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
-                sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
-                header->ifindex = sdl->sdl_index;
-            }
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
+            sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
+            header->ifindex = sdl->sdl_index;
+        }
 #  endif
 #endif
 
-            if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
-                    && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
-                        || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
-                static_assert(sizeof(header->hopLimit) == sizeof(int));
-                memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
-            }
+        if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
+                && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
+                    || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
+            static_assert(sizeof(header->hopLimit) == sizeof(int));
+            memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
+        }
 
 #ifndef QT_NO_SCTP
-            if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
-                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
-                sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
+            && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
+            sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
 
-                header->streamNumber = int(rcvInfo->sinfo_stream);
-            }
-#endif
+            header->streamNumber = int(rcvInfo->sinfo_stream);
         }
+#endif
+    }
+}
+
+static qint64 qt_socket_receiveDatagramError(const QNativeSocketEnginePrivate *d)
+{
+    switch (errno) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+    case EAGAIN:
+        // No datagram was available for reading
+        return -2;
+    case ECONNREFUSED:
+        d->setError(QAbstractSocket::ConnectionRefusedError, QNativeSocketEnginePrivate::ConnectionRefusedErrorString);
+        break;
+    default:
+        d->setError(QAbstractSocket::NetworkError, QNativeSocketEnginePrivate::ReceiveDatagramErrorString);
+    }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
+                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    ReceiveControlBuffer cbuf;
+    struct msghdr msg;
+    struct iovec vec;
+    qt_sockaddr aa;
+    char c;
+    qt_socket_setupReceiveMessage(&msg, &vec, &aa, cbuf, data, maxSize, &c, options);
+
+    ssize_t recvResult = 0;
+    do {
+        recvResult = ::recvmsg(socketDescriptor, &msg, 0);
+    } while (recvResult == -1 && errno == EINTR);
+
+    if (recvResult == -1) {
+        recvResult = qt_socket_receiveDatagramError(this);
+        if (header)
+            header->clear();
+    } else if (options != QAbstractSocketEngine::WantNone) {
+        Q_ASSERT(header);
+        qt_socket_readPacketHeader(&msg, &aa, header);
+        header->destinationPort = localPort;
     }
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
     qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagram(%p \"%s\", %lli, %s, %i) == %lli",
            data, QtDebugUtils::toPrintable(data, recvResult, 16).constData(), maxSize,
-           (recvResult != -1 && options != QAbstractSocketEngine::WantNone)
+           (recvResult >= 0 && options != QAbstractSocketEngine::WantNone)
            ? header->senderAddress.toString().toLatin1().constData() : "(unknown)",
-           (recvResult != -1 && options != QAbstractSocketEngine::WantNone)
+           (recvResult >= 0 && options != QAbstractSocketEngine::WantNone)
            ? header->senderPort : 0, (qint64) recvResult);
 #endif
 
     return qint64((maxSize || recvResult < 0) ? recvResult : Q_INT64_C(0));
 }
 
-qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+static void qt_socket_setupSendMessage(QNativeSocketEnginePrivate *d, struct msghdr *msg,
+                                       struct iovec *vec, qt_sockaddr *aa, SendControlBuffer &cbuf,
+                                       const char *data, qint64 len, const QIpPacketHeader &header)
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
-#ifndef QT_NO_SCTP
-                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
-#endif
-                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
-
     struct cmsghdr *cmsgptr = reinterpret_cast<struct cmsghdr *>(cbuf);
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
 
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
-    vec.iov_base = const_cast<char *>(data);
-    vec.iov_len = len;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
-    msg.msg_control = &cbuf;
+    memset(msg, 0, sizeof(*msg));
+    memset(aa, 0, sizeof(*aa));
+    vec->iov_base = const_cast<char *>(data);
+    vec->iov_len = len;
+    msg->msg_iov = vec;
+    msg->msg_iovlen = 1;
+    msg->msg_control = cbuf;
 
     if (header.destinationPort != 0) {
-        msg.msg_name = &aa.a;
-        setPortAndAddress(header.destinationPort, header.destinationAddress,
-                          &aa, &msg.msg_namelen);
+        msg->msg_name = &aa->a;
+        d->setPortAndAddress(header.destinationPort, header.destinationAddress,
+                             aa, &msg->msg_namelen);
     }
 
-    if (msg.msg_namelen == sizeof(aa.a6)) {
+    if (msg->msg_namelen == sizeof(aa->a6)) {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_HOPLIMIT;
@@ -1081,7 +1113,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         if (header.ifindex != 0 || !header.senderAddress.isNull()) {
             struct in6_pktinfo *data = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
             memset(data, 0, sizeof(*data));
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_PKTINFO;
@@ -1093,7 +1125,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         }
     } else {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IP;
             cmsgptr->cmsg_type = IP_TTL;
@@ -1115,7 +1147,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
             data->s_addr = htonl(header.senderAddress.toIPv4Address());
 #  endif
             cmsgptr->cmsg_level = IPPROTO_IP;
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr = reinterpret_cast<cmsghdr *>(reinterpret_cast<char *>(cmsgptr) + CMSG_SPACE(sizeof(*data)));
         }
@@ -1126,7 +1158,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     if (header.streamNumber != -1) {
         struct sctp_sndrcvinfo *data = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
         memset(data, 0, sizeof(*data));
-        msg.msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
+        msg->msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_len = CMSG_LEN(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_level = IPPROTO_SCTP;
         cmsgptr->cmsg_type =  SCTP_SNDRCV;
@@ -1135,28 +1167,41 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     }
 #endif
 
-    if (msg.msg_controllen == 0)
-        msg.msg_control = nullptr;
-    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (msg->msg_controllen == 0)
+        msg->msg_control = nullptr;
+}
 
-    if (sentBytes < 0) {
-        switch (errno) {
+static qint64 qt_socket_sendDatagramError(const QNativeSocketEnginePrivate *d)
+{
+    switch (errno) {
 #if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
+    case EWOULDBLOCK:
 #endif
-        case EAGAIN:
-            sentBytes = -2;
-            break;
-        case EMSGSIZE:
-            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
-            break;
-        case ECONNRESET:
-            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
-        }
+    case EAGAIN:
+        return -2;
+    case EMSGSIZE:
+        d->setError(QAbstractSocket::DatagramTooLargeError, QNativeSocketEnginePrivate::DatagramTooLargeErrorString);
+        break;
+    case ECONNRESET:
+        d->setError(QAbstractSocket::RemoteHostClosedError, QNativeSocketEnginePrivate::RemoteHostClosedErrorString);
+        break;
+    default:
+        d->setError(QAbstractSocket::NetworkError, QNativeSocketEnginePrivate::SendDatagramErrorString);
     }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+{
+    SendControlBuffer cbuf;
+    struct msghdr msg;
+    struct iovec vec;
+    qt_sockaddr aa;
+    qt_socket_setupSendMessage(this, &msg, &vec, &aa, cbuf, data, len, header);
+
+    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (sentBytes < 0)
+        sentBytes = qt_socket_sendDatagramError(this);
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
     qDebug("QNativeSocketEngine::sendDatagram(%p \"%s\", %lli, \"%s\", %i) == %lli", data,
@@ -1168,6 +1213,103 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     return qint64(sentBytes);
 }
 
+#ifdef Q_OS_LINUX
+// recvmmsg() and sendmmsg() accept up to UIO_MAXIOV messages per call; we
+// use smaller batches so that the message headers fit on the stack.
+static constexpr qsizetype MaxDatagramBatchSize = 32;
+
+qsizetype QNativeSocketEnginePrivate::nativeReceiveDatagrams(QNetworkDatagramPrivate *const *datagrams,
+                                                             qsizetype count,
+                                                             QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    qsizetype received = 0;
+    while (received < count) {
+        const qsizetype batchSize = qMin(count - received, MaxDatagramBatchSize);
+        struct mmsghdr msgs[MaxDatagramBatchSize];
+        struct iovec vecs[MaxDatagramBatchSize];
+        qt_sockaddr addrs[MaxDatagramBatchSize];
+        ReceiveControlBuffer cbufs[MaxDatagramBatchSize];
+        char c;
+
+        for (qsizetype i = 0; i < batchSize; ++i) {
+            QByteArray &buffer = datagrams[received + i]->data;
+            qt_socket_setupReceiveMessage(&msgs[i].msg_hdr, &vecs[i], &addrs[i], cbufs[i],
+                                          buffer.isEmpty() ? nullptr : buffer.data(), buffer.size(),
+                                          &c, options);
+            msgs[i].msg_len = 0;
+        }
+
+        int result;
+        EINTR_LOOP(result, ::recvmmsg(socketDescriptor, msgs, uint(batchSize), 0, nullptr));
+        if (result == -1) {
+            if (received)
+                break;
+            return qt_socket_receiveDatagramError(this);
+        }
+
+        for (int i = 0; i < result; ++i) {
+            QNetworkDatagramPrivate *datagram = datagrams[received + i];
+            if (!datagram->data.isEmpty())
+                datagram->data.truncate(msgs[i].msg_len);
+            if (options != QAbstractSocketEngine::WantNone) {
+                qt_socket_readPacketHeader(&msgs[i].msg_hdr, &addrs[i], &datagram->header);
+                datagram->header.destinationPort = localPort;
+            }
+        }
+        received += result;
+        if (result < batchSize)
+            break;
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagrams(%p, %lli) == %lli",
+           datagrams, qint64(count), qint64(received));
+#endif
+
+    return received;
+}
+
+qsizetype QNativeSocketEnginePrivate::nativeSendDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                                          qsizetype count)
+{
+    qsizetype sent = 0;
+    while (sent < count) {
+        const qsizetype batchSize = qMin(count - sent, MaxDatagramBatchSize);
+        struct mmsghdr msgs[MaxDatagramBatchSize];
+        struct iovec vecs[MaxDatagramBatchSize];
+        qt_sockaddr addrs[MaxDatagramBatchSize];
+        SendControlBuffer cbufs[MaxDatagramBatchSize];
+
+        for (qsizetype i = 0; i < batchSize; ++i) {
+            const QNetworkDatagramPrivate *datagram = datagrams[sent + i];
+            qt_socket_setupSendMessage(this, &msgs[i].msg_hdr, &vecs[i], &addrs[i], cbufs[i],
+                                       datagram->data.constData(), datagram->data.size(),
+                                       datagram->header);
+            msgs[i].msg_len = 0;
+        }
+
+        int result;
+        EINTR_LOOP(result, ::sendmmsg(socketDescriptor, msgs, uint(batchSize), MSG_NOSIGNAL));
+        if (result == -1) {
+            if (sent)
+                break;
+            return qt_socket_sendDatagramError(this);
+        }
+
+        sent += result;
+        if (result < batchSize)
+            break;
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendDatagrams(%p, %lli) == %lli",
+           datagrams, qint64(count), qint64(sent));
+#endif
+
+    return sent;
+}
+#endif // Q_OS_LINUX
+
 bool QNativeSocketEnginePrivate::fetchConnectionParameters()
 {
     localPort = 0;
@@ -1332,6 +1474,101 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 
     return qint64(writtenBytes);
 }
+
+qint64 QNativeSocketEnginePrivate::nativeWriteVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    Q_Q(QNativeSocketEngine);
+
+    constexpr qsizetype MaxVectors = 64;
+    count = qMin(count, MaxVectors);
+    struct iovec vec[MaxVectors];
+    for (qsizetype i = 0; i < count; ++i) {
+        vec[i].iov_base = const_cast<char *>(buffers[i].data());
+        vec[i].iov_len = size_t(buffers[i].size());
+    }
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = vec;
+    msg.msg_iovlen = int(count);
+
+    ssize_t writtenBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        default:
+            setError(QAbstractSocket::NetworkError, WriteErrorString);
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteVectored(%lld blocks) == %lld",
+           qint64(count), qint64(writtenBytes));
+#endif
+
+    return qint64(writtenBytes);
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendFile(qintptr fileDescriptor, qint64 offset, qint64 length)
+{
+#if defined(Q_OS_LINUX)
+    Q_Q(QNativeSocketEngine);
+
+    // sendfile() transfers at most 0x7ffff000 bytes per call
+    off_t fileOffset = off_t(offset);
+    const size_t count = size_t(qMin(length, qint64(0x7ffff000)));
+    ssize_t writtenBytes;
+    qt_ignore_sigpipe();
+    EINTR_LOOP(writtenBytes, ::sendfile(socketDescriptor, int(fileDescriptor), &fileOffset, count));
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        case EINVAL:
+        case ENOSYS:
+        case EOPNOTSUPP:
+            // the file cannot be mapped, e.g. because it lives on a
+            // filesystem that does not support sendfile()
+            setError(QAbstractSocket::UnsupportedSocketOperationError,
+                     OperationUnsupportedErrorString);
+            break;
+        default:
+            setError(QAbstractSocket::NetworkError, WriteErrorString);
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendFile(%d, %lld, %lld) == %lld",
+           int(fileDescriptor), offset, length, qint64(writtenBytes));
+#endif
+
+    return qint64(writtenBytes);
+#else
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(length);
+    setError(QAbstractSocket::UnsupportedSocketOperationError, OperationUnsupportedErrorString);
+    return -1;
+#endif
+}
+
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
@@ -255,6 +255,7 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
         break;
 
     case QAbstractSocketEngine::PathMtuInformation:
+    case QAbstractSocketEngine::PortReusable:
         break;          // not supported on Windows
     }
 }
@@ -1420,6 +1421,59 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
     return ret;
 }
 
+qint64 QNativeSocketEnginePrivate::nativeWriteVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    Q_Q(QNativeSocketEngine);
+
+    constexpr qsizetype MaxBuffers = 64;
+    count = qMin(count, MaxBuffers);
+    WSABUF buf[MaxBuffers];
+    for (qsizetype i = 0; i < count; ++i) {
+        buf[i].buf = const_cast<char *>(buffers[i].data());
+        buf[i].len = ULONG(buffers[i].size());
+    }
+
+    qint64 ret = 0;
+    DWORD bytesWritten = 0;
+    if (::WSASend(socketDescriptor, buf, DWORD(count), &bytesWritten, 0, 0, 0) != SOCKET_ERROR) {
+        ret = qint64(bytesWritten);
+    } else {
+        const int err = WSAGetLastError();
+        switch (err) {
+        case WSAEWOULDBLOCK:
+        case WSAENOBUFS:
+            break;
+        case WSAECONNRESET:
+        case WSAECONNABORTED:
+            WS_ERROR_DEBUG(err);
+            ret = -1;
+            setError(QAbstractSocket::NetworkError, WriteErrorString);
+            q->close();
+            break;
+        default:
+            WS_ERROR_DEBUG(err);
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteVectored(%lli blocks) == %lli",
+           qint64(count), ret);
+#endif
+
+    return ret;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendFile(qintptr fileDescriptor, qint64 offset, qint64 length)
+{
+    // TransmitFile() blocks on non-overlapped sockets
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(length);
+    setError(QAbstractSocket::UnsupportedSocketOperationError, OperationUnsupportedErrorString);
+    return -1;
+}
+
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxLength)
 {
     qint64 ret = -1;
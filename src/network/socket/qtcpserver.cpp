@@ -77,6 +77,14 @@
     use waitForNewConnection(), which blocks until either a
     connection is available or a timeout expires.
 
+    A single QTcpServer accepts all connections in the thread it lives
+    in. To spread the accepting work over several threads, enable port
+    sharing with setPortSharingEnabled() and create one QTcpServer per
+    thread, each listening on the same address and port from its own
+    thread. The operating system then distributes the incoming connections
+    between the servers, and each connection can be handled in the thread
+    that accepted it.
+
     \sa QTcpSocket, {Fortune Server Example}, {Threaded Fortune Server Example},
         {Loopback Example}, {Torrent Example}
 */
@@ -325,6 +333,12 @@ bool QTcpServer::listen(const QHostAddress &address, quint16 port)
 
     d->configureCreatedSocket();
 
+    if (d->portSharing && !d->socketEngine->setOption(QAbstractSocketEngine::PortReusable, 1)) {
+        d->serverSocketError = QAbstractSocket::UnsupportedSocketOperationError;
+        d->serverSocketErrorString = tr("Sharing the listening port is not supported");
+        return false;
+    }
+
     if (!d->socketEngine->bind(addr, port)) {
         d->serverSocketError = d->socketEngine->error();
         d->serverSocketErrorString = d->socketEngine->errorString();
@@ -677,6 +691,42 @@ int QTcpServer::listenBacklogSize() const
     return d_func()->listenBacklog;
 }
 
+/*!
+    \since 6.4
+
+    If \a enabled is true, the server allows other servers that enable port
+    sharing as well to listen on the same address and port, and the
+    operating system distributes the incoming connections between them.
+    This allows accepting and handling connections in several threads, each
+    of them running its own QTcpServer. By default, port sharing is
+    disabled.
+
+    Port sharing is supported on Linux (including Android) and on systems
+    that provide \c SO_REUSEPORT_LB, such as FreeBSD. On other systems,
+    listen() fails with QAbstractSocket::UnsupportedSocketOperationError
+    when port sharing is enabled.
+
+    \note This property must be set prior to calling listen().
+
+    \sa isPortSharingEnabled(), listen()
+*/
+void QTcpServer::setPortSharingEnabled(bool enabled)
+{
+    d_func()->portSharing = enabled;
+}
+
+/*!
+    \since 6.4
+
+    Returns \c true if port sharing is enabled; otherwise returns \c false.
+
+    \sa setPortSharingEnabled()
+*/
+bool QTcpServer::isPortSharingEnabled() const
+{
+    return d_func()->portSharing;
+}
+
 /*!
     Returns an error code for the last error that occurred.
 
@@ -58,6 +58,10 @@
 
     \note TCP sockets cannot be opened in QIODevice::Unbuffered mode.
 
+    To send the contents of a file, use sendFile(). Where the platform
+    allows it, the kernel copies the file to the network directly, without
+    reading it into memory first.
+
     \sa QTcpServer, QUdpSocket, QNetworkAccessManager,
     {Fortune Server Example}, {Fortune Client Example},
     {Threaded Fortune Server Example}, {Blocking Fortune Client Example},
@@ -66,6 +70,7 @@
 
 #include "qtcpsocket.h"
 #include "qtcpsocket_p.h"
+#include "qfile.h"
 #include "qlist.h"
 #include "qhostaddress.h"
 
@@ -118,6 +123,60 @@ QTcpSocket::QTcpSocket(QAbstractSocket::SocketType socketType,
 {
 }
 
+/*!
+    \since 6.4
+
+    Queues \a size bytes of \a file, starting at \a offset, to be written
+    to the socket after any data that was written before. If \a size is
+    -1, the rest of the file is sent. Returns the number of bytes queued,
+    or -1 if an error occurred.
+
+    The bytes are sent when control goes back to the event loop, or when
+    flush() or waitForBytesWritten() are called, and the bytesWritten()
+    signal is emitted as they are sent. They are included in
+    bytesToWrite().
+
+    On Linux, the file is sent with the \c sendfile() system call, so the
+    contents do not pass through the memory of the application. On other
+    platforms, and for files that are not backed by a file descriptor, the
+    file is read in blocks while it is sent, instead of being buffered as a
+    whole. An encrypted QSslSocket reads the whole range immediately and
+    writes it like write() does.
+
+    \a file must be open for reading and must stay open until all of it
+    has been sent; otherwise, the socket is aborted with
+    QAbstractSocket::UnknownSocketError. The current position of \a file
+    is undefined while it is sent.
+
+    \sa write(), bytesToWrite()
+*/
+qint64 QTcpSocket::sendFile(QFile *file, qint64 offset, qint64 size)
+{
+    Q_D(QTcpSocket);
+    if (!isWritable()) {
+        qWarning("QTcpSocket::sendFile: device not open for writing");
+        return -1;
+    }
+    if (!file || !file->isReadable() || file->isSequential()) {
+        qWarning("QTcpSocket::sendFile: file not open for reading");
+        return -1;
+    }
+    if (socketType() != TcpSocket) {
+        d->setError(UnsupportedSocketOperationError, tr("Operation on socket is not supported"));
+        return -1;
+    }
+
+    const qint64 fileSize = file->size();
+    if (offset < 0 || offset > fileSize) {
+        qWarning("QTcpSocket::sendFile: offset %lld is out of range", offset);
+        return -1;
+    }
+    if (size < 0 || size > fileSize - offset)
+        size = fileSize - offset;
+
+    return d->sendFile(file, offset, size);
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qtcpsocket.cpp"
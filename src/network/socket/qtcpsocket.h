@@ -49,6 +49,7 @@ QT_BEGIN_NAMESPACE
 
 
 class QTcpSocketPrivate;
+class QFile;
 
 class Q_NETWORK_EXPORT QTcpSocket : public QAbstractSocket
 {
@@ -64,6 +65,8 @@ public:
     { return bind(QHostAddress(addr), port, mode); }
 #endif
 
+    qint64 sendFile(QFile *file, qint64 offset = 0, qint64 size = -1);
+
 protected:
     QTcpSocket(QTcpSocketPrivate &dd, QObject *parent = nullptr);
     QTcpSocket(QAbstractSocket::SocketType socketType, QTcpSocketPrivate &dd,
@@ -76,6 +76,10 @@
 
     \snippet code/src_network_socket_qudpsocket.cpp 0
 
+    Applications that exchange many datagrams can use writeDatagrams() and
+    readDatagrams() to send or receive a batch of datagrams with a single
+    call, which reduces the number of system calls per datagram.
+
     QUdpSocket also supports UDP multicast. Use joinMulticastGroup() and
     leaveMulticastGroup() to control group membership, and
     QAbstractSocket::MulticastTtlOption and
@@ -102,6 +106,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -431,6 +436,63 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 6.4
+
+    Sends the \a count datagrams in \a datagrams, in order, each to the
+    destination and with the header settings it contains, as
+    writeDatagram(const QNetworkDatagram &) does. On Linux, the datagrams
+    are passed to the operating system with as few system calls as
+    possible, which considerably lowers the cost per datagram when sending
+    many small datagrams.
+
+    Returns the number of datagrams sent, or -1 if no datagram could be
+    sent. The number of datagrams sent can be less than \a count if the
+    socket's send buffer is full or if sending one of the later datagrams
+    failed; the error for it is reported when you try to send it again.
+
+    All datagrams must have destinations of the same network layer
+    protocol.
+
+    \sa readDatagrams(), writeDatagram()
+*/
+qsizetype QUdpSocket::writeDatagrams(const QNetworkDatagram *datagrams, qsizetype count)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%p, %lld)", datagrams, qint64(count));
+#endif
+    if (count <= 0)
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams[0].destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    QVarLengthArray<const QNetworkDatagramPrivate *, 64> privates(count);
+    for (qsizetype i = 0; i < count; ++i)
+        privates[i] = datagrams[i].d;
+
+    const qsizetype sent = d->socketEngine->writeDatagrams(privates.constData(), count);
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent >= 0) {
+        qint64 bytes = 0;
+        for (qsizetype i = 0; i < sent; ++i)
+            bytes += datagrams[i].d->data.size();
+        emit bytesWritten(bytes);
+    } else {
+        if (sent == -2) {
+            // Socket engine reports EAGAIN. Treat as a temporary error.
+            d->setErrorAndEmit(QAbstractSocket::TemporaryError,
+                               tr("Unable to send a datagram"));
+            return -1;
+        }
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+    }
+    return sent;
+}
+
 /*!
     \since 5.8
 
@@ -528,6 +590,76 @@ qint64 QUdpSocket::readDatagram(char *data, qint64 maxSize, QHostAddress *addres
     return readBytes;
 }
 
+/*!
+    \since 6.4
+
+    Receives up to \a count pending datagrams, each no larger than \a
+    maxSize bytes, into \a datagrams. The sender's and, if possible, the
+    destination's address and port, and the hop count of each datagram are
+    stored in it, as with receiveDatagram(). On Linux, the datagrams are
+    fetched from the operating system with as few system calls as possible,
+    which considerably lowers the cost per datagram when receiving many
+    small datagrams.
+
+    The data buffers of the datagrams in \a datagrams are reused: if a
+    datagram's data is not shared with another QByteArray and its capacity
+    is at least \a maxSize bytes, receiving into it does not allocate
+    memory. Passing the same array to every call therefore avoids an
+    allocation per datagram. Datagrams that were not filled are left
+    empty.
+
+    If \a maxSize is -1 (the default), each buffer is made large enough
+    for the largest datagram UDP can carry, 65527 bytes. If a datagram is
+    larger than \a maxSize, the rest of it is lost. If \a maxSize is 0,
+    the datagrams are discarded.
+
+    Returns the number of datagrams received, or -1 if no datagram could be
+    read.
+
+    \sa writeDatagrams(), receiveDatagram(), hasPendingDatagrams()
+*/
+qsizetype QUdpSocket::readDatagrams(QNetworkDatagram *datagrams, qsizetype count, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::readDatagrams(%p, %lld, %lld)", datagrams, qint64(count), maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::readDatagrams()", -1);
+
+    if (count <= 0)
+        return 0;
+    if (maxSize < 0)
+        maxSize = 65535 - 8; // the UDP length field includes the 8-byte header
+
+    QVarLengthArray<QNetworkDatagramPrivate *, 64> privates(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        QNetworkDatagramPrivate *datagram = datagrams[i].d;
+        datagram->data.resize(maxSize);
+        datagram->header.clear();
+        privates[i] = datagram;
+    }
+
+    qsizetype received = d->socketEngine->readDatagrams(privates.constData(), count,
+                                                        QAbstractSocketEngine::WantAll);
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+
+    for (qsizetype i = qMax(received, qsizetype(0)); i < count; ++i)
+        privates[i]->data.truncate(0);
+
+    if (received < 0) {
+        if (received == -2) {
+            // No pending datagram. Treat as a temporary error.
+            d->setErrorAndEmit(QAbstractSocket::TemporaryError,
+                               tr("No datagram available for reading"));
+            return -1;
+        }
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+    }
+    return received;
+}
+
 #endif // QT_NO_UDPSOCKET
 
 QT_END_NAMESPACE
@@ -83,11 +83,13 @@ public:
     qint64 pendingDatagramSize() const;
     QNetworkDatagram receiveDatagram(qint64 maxSize = -1);
     qint64 readDatagram(char *data, qint64 maxlen, QHostAddress *host = nullptr, quint16 *port = nullptr);
+    qsizetype readDatagrams(QNetworkDatagram *datagrams, qsizetype count, qint64 maxSize = -1);
 
     qint64 writeDatagram(const QNetworkDatagram &datagram);
     qint64 writeDatagram(const char *data, qint64 len, const QHostAddress &host, quint16 port);
     inline qint64 writeDatagram(const QByteArray &datagram, const QHostAddress &host, quint16 port)
         { return writeDatagram(datagram.constData(), datagram.size(), host, port); }
+    qsizetype writeDatagrams(const QNetworkDatagram *datagrams, qsizetype count);
 
 private:
     Q_DISABLE_COPY_MOVE(QUdpSocket)
@@ -391,6 +391,7 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qelapsedtimer.h>
@@ -1991,6 +1992,32 @@ qint64 QSslSocket::writeData(const char *data, qint64 len)
     return len;
 }
 
+/*!
+    \internal
+
+    Unencrypted files are sent by the plain socket. Otherwise, the file
+    has to be encrypted like any other data.
+*/
+qint64 QSslSocketPrivate::sendFile(QFile *file, qint64 offset, qint64 size)
+{
+    Q_Q(QSslSocket);
+    if (mode == QSslSocket::UnencryptedMode && !autoStartHandshake)
+        return plainSocket->sendFile(file, offset, size);
+
+    constexpr qint64 BlockSize = 64 * 1024;
+    if (!file->seek(offset))
+        return -1;
+    qint64 written = 0;
+    while (written < size) {
+        const QByteArray block = file->read(qMin(size - written, BlockSize));
+        if (block.isEmpty())
+            break;
+        q->write(block);
+        written += block.size();
+    }
+    return written > 0 || size == 0 ? written : -1;
+}
+
 bool QSslSocketPrivate::s_loadRootCertsOnDemand = false;
 
 /*!
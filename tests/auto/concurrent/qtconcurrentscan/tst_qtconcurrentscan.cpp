@@ -0,0 +1,193 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtconcurrentscan.h>
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <numeric>
+#include <vector>
+
+class tst_QtConcurrentScan : public QObject
+{
+    Q_OBJECT
+private slots:
+    void inclusiveScan_data();
+    void inclusiveScan();
+    void exclusiveScan_data();
+    void exclusiveScan();
+    void threadPool();
+    void iterators();
+    void customOperation();
+    void nonCommutativeOperation();
+    void progress();
+};
+
+static QList<qint64> randomList(qsizetype size)
+{
+    QRandomGenerator generator(size);
+    QList<qint64> list(size);
+    for (qint64 &value : list)
+        value = generator.bounded(-1000, 1000);
+    return list;
+}
+
+static void addSizes()
+{
+    QTest::addColumn<QList<qint64>>("list");
+
+    QTest::newRow("empty") << QList<qint64>();
+    QTest::newRow("one") << QList<qint64>{ 7 };
+    QTest::newRow("small") << QList<qint64>{ 1, 2, 3, 4, 5 };
+    QTest::newRow("one-chunk") << randomList(2047);
+    QTest::newRow("two-chunks") << randomList(2048);
+    QTest::newRow("odd-chunks") << randomList(7 * 1024 + 3);
+    QTest::newRow("large") << randomList(200000);
+}
+
+void tst_QtConcurrentScan::inclusiveScan_data()
+{
+    addSizes();
+}
+
+void tst_QtConcurrentScan::inclusiveScan()
+{
+    QFETCH(QList<qint64>, list);
+    QList<qint64> expected(list.size());
+    std::partial_sum(list.cbegin(), list.cend(), expected.begin());
+
+    QList<qint64> result = list;
+    QtConcurrent::inclusiveScan(result).waitForFinished();
+    QCOMPARE(result, expected);
+
+    result = list;
+    QtConcurrent::blockingInclusiveScan(result);
+    QCOMPARE(result, expected);
+}
+
+void tst_QtConcurrentScan::exclusiveScan_data()
+{
+    addSizes();
+}
+
+void tst_QtConcurrentScan::exclusiveScan()
+{
+    QFETCH(QList<qint64>, list);
+    QList<qint64> expected(list.size());
+    qint64 sum = 100;
+    for (qsizetype i = 0; i < list.size(); ++i) {
+        expected[i] = sum;
+        sum += list.at(i);
+    }
+
+    QList<qint64> result = list;
+    QtConcurrent::exclusiveScan(result, qint64(100)).waitForFinished();
+    QCOMPARE(result, expected);
+
+    result = list;
+    QtConcurrent::blockingExclusiveScan(result, 100);
+    QCOMPARE(result, expected);
+}
+
+void tst_QtConcurrentScan::threadPool()
+{
+    const QList<qint64> list = randomList(60000);
+    QList<qint64> expected(list.size());
+    std::partial_sum(list.cbegin(), list.cend(), expected.begin());
+
+    for (int threadCount : { 1, 2, 5 }) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(threadCount);
+
+        QList<qint64> result = list;
+        QtConcurrent::inclusiveScan(&pool, result).waitForFinished();
+        QCOMPARE(result, expected);
+
+        result = list;
+        QtConcurrent::blockingExclusiveScan(&pool, result, qint64(0));
+        QCOMPARE(result.first(), 0);
+        QVERIFY(std::equal(result.cbegin() + 1, result.cend(), expected.cbegin()));
+    }
+}
+
+void tst_QtConcurrentScan::iterators()
+{
+    std::vector<int> vector(50000, 1);
+
+    QtConcurrent::blockingInclusiveScan(vector.begin() + 1, vector.end());
+    QCOMPARE(vector.front(), 1);
+    for (size_t i = 1; i < vector.size(); ++i)
+        QCOMPARE(vector[i], int(i));
+
+    std::fill(vector.begin(), vector.end(), 1);
+    QtConcurrent::exclusiveScan(vector.data(), vector.data() + vector.size(), 0).waitForFinished();
+    for (size_t i = 0; i < vector.size(); ++i)
+        QCOMPARE(vector[i], int(i));
+}
+
+void tst_QtConcurrentScan::customOperation()
+{
+    QList<qint64> list = randomList(30000);
+    QList<qint64> expected(list.size());
+    const auto maximum = [](qint64 a, qint64 b) { return qMax(a, b); };
+    std::partial_sum(list.cbegin(), list.cend(), expected.begin(), maximum);
+
+    QtConcurrent::blockingInclusiveScan(list, maximum);
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentScan::nonCommutativeOperation()
+{
+    // concatenation is associative, but not commutative
+    QStringList list;
+    for (int i = 0; i < 5000; ++i)
+        list.append(QString(QChar(u'a' + i % 26)));
+    QStringList expected = list;
+    std::partial_sum(expected.cbegin(), expected.cend(), expected.begin());
+
+    QtConcurrent::blockingInclusiveScan(list);
+    QCOMPARE(list, expected);
+
+    list.fill(QStringLiteral("x"));
+    QtConcurrent::blockingExclusiveScan(list, QStringLiteral(">"));
+    QCOMPARE(list.first(), QStringLiteral(">"));
+    QCOMPARE(list.last(), QStringLiteral(">") + QString(list.size() - 1, u'x'));
+}
+
+void tst_QtConcurrentScan::progress()
+{
+    QList<qint64> list = randomList(100000);
+    QFuture<void> future = QtConcurrent::inclusiveScan(list);
+    future.waitForFinished();
+
+    QVERIFY(future.progressMaximum() > 0);
+    QCOMPARE(future.progressValue(), future.progressMaximum());
+}
+
+QTEST_MAIN(tst_QtConcurrentScan)
+#include "tst_qtconcurrentscan.moc"
@@ -0,0 +1,300 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtconcurrentsort.h>
+
+#include <QFutureWatcher>
+#include <QRandomGenerator>
+#include <QSemaphore>
+#include <QTest>
+
+#include <algorithm>
+#include <vector>
+
+class tst_QtConcurrentSort : public QObject
+{
+    Q_OBJECT
+private slots:
+    void sort_data();
+    void sort();
+    void sortThreadPool();
+    void sortIterators();
+    void sortCustomLessThan();
+    void stableSort_data();
+    void stableSort();
+    void partition_data();
+    void partition();
+    void partitionIterators();
+    void progress();
+    void cancel();
+};
+
+static QList<int> randomList(qsizetype size, int bound)
+{
+    QRandomGenerator generator(size);
+    QList<int> list(size);
+    for (int &value : list)
+        value = generator.bounded(bound);
+    return list;
+}
+
+void tst_QtConcurrentSort::sort_data()
+{
+    QTest::addColumn<QList<int>>("list");
+
+    QTest::newRow("empty") << QList<int>();
+    QTest::newRow("one") << QList<int>{ 1 };
+    QTest::newRow("small") << QList<int>{ 5, 3, 9, 1, 1, 0, -4, 8 };
+    QTest::newRow("one-chunk") << randomList(1000, 100);
+    QTest::newRow("odd-chunks") << randomList(5 * 1024 + 17, 1000);
+    QTest::newRow("large") << randomList(100000, 1 << 30);
+    QTest::newRow("duplicates") << randomList(100000, 4);
+
+    QList<int> sorted = randomList(20000, 1 << 30);
+    std::sort(sorted.begin(), sorted.end());
+    QTest::newRow("sorted") << sorted;
+    std::reverse(sorted.begin(), sorted.end());
+    QTest::newRow("reversed") << sorted;
+}
+
+void tst_QtConcurrentSort::sort()
+{
+    QFETCH(QList<int>, list);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QList<int> result = list;
+    QtConcurrent::sort(result).waitForFinished();
+    QCOMPARE(result, expected);
+
+    result = list;
+    QtConcurrent::blockingSort(result);
+    QCOMPARE(result, expected);
+
+    result = list;
+    QtConcurrent::stableSort(result).waitForFinished();
+    QCOMPARE(result, expected);
+
+    result = list;
+    QtConcurrent::blockingStableSort(result);
+    QCOMPARE(result, expected);
+}
+
+void tst_QtConcurrentSort::sortThreadPool()
+{
+    const QList<int> list = randomList(50000, 1 << 30);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    for (int threadCount : { 1, 3, 8 }) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(threadCount);
+
+        QList<int> result = list;
+        QtConcurrent::sort(&pool, result).waitForFinished();
+        QCOMPARE(result, expected);
+
+        result = list;
+        QtConcurrent::blockingSort(&pool, result);
+        QCOMPARE(result, expected);
+
+        result = list;
+        QtConcurrent::blockingStableSort(&pool, result.begin(), result.end());
+        QCOMPARE(result, expected);
+    }
+}
+
+void tst_QtConcurrentSort::sortIterators()
+{
+    std::vector<double> vector(30000);
+    QRandomGenerator generator(42);
+    for (double &value : vector)
+        value = generator.generateDouble();
+    std::vector<double> expected = vector;
+    std::sort(expected.begin(), expected.end());
+
+    // only sort the middle part
+    std::vector<double> result = vector;
+    QtConcurrent::sort(result.begin() + 100, result.end() - 100).waitForFinished();
+    QVERIFY(std::equal(result.begin(), result.begin() + 100, vector.begin()));
+    QVERIFY(std::equal(result.end() - 100, result.end(), vector.end() - 100));
+    QVERIFY(std::is_sorted(result.begin() + 100, result.end() - 100));
+
+    result = vector;
+    QtConcurrent::blockingSort(result.data(), result.data() + result.size());
+    QCOMPARE(result, expected);
+}
+
+void tst_QtConcurrentSort::sortCustomLessThan()
+{
+    QList<int> list = randomList(40000, 1 << 30);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+
+    QtConcurrent::blockingSort(list, std::greater<>());
+    QCOMPARE(list, expected);
+
+    QStringList strings;
+    for (int i = 0; i < 10000; ++i)
+        strings.append(QString::number(i * 7919 % 10000));
+    QStringList expectedStrings = strings;
+    const auto byLength = [](const QString &a, const QString &b) { return a.size() < b.size(); };
+    std::sort(expectedStrings.begin(), expectedStrings.end());
+    std::stable_sort(expectedStrings.begin(), expectedStrings.end(), byLength);
+
+    QtConcurrent::blockingSort(strings);
+    QtConcurrent::stableSort(strings, byLength).waitForFinished();
+    QCOMPARE(strings, expectedStrings);
+}
+
+void tst_QtConcurrentSort::stableSort_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("keys");
+
+    QTest::newRow("small") << 100 << 10;
+    QTest::newRow("large") << 100000 << 16;
+    QTest::newRow("equal") << 20000 << 1;
+}
+
+void tst_QtConcurrentSort::stableSort()
+{
+    QFETCH(int, size);
+    QFETCH(int, keys);
+
+    // the second member records the original position
+    QRandomGenerator generator(size);
+    QList<std::pair<int, int>> list(size);
+    for (int i = 0; i < size; ++i)
+        list[i] = std::make_pair(int(generator.bounded(keys)), i);
+
+    const auto byKey = [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+        return a.first < b.first;
+    };
+    QList<std::pair<int, int>> expected = list;
+    std::stable_sort(expected.begin(), expected.end(), byKey);
+
+    QtConcurrent::blockingStableSort(list, byKey);
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentSort::partition_data()
+{
+    QTest::addColumn<QList<int>>("list");
+
+    QTest::newRow("empty") << QList<int>();
+    QTest::newRow("small") << QList<int>{ 1, 2, 3, 4, 5, 6, 7 };
+    QTest::newRow("large") << randomList(100000, 1000);
+    QTest::newRow("all-even") << QList<int>(10000, 2);
+    QTest::newRow("all-odd") << QList<int>(10000, 3);
+}
+
+void tst_QtConcurrentSort::partition()
+{
+    QFETCH(QList<int>, list);
+
+    const auto isEven = [](int value) { return value % 2 == 0; };
+    QList<int> expected = list;
+    const qsizetype expectedPoint =
+            std::stable_partition(expected.begin(), expected.end(), isEven) - expected.begin();
+
+    QList<int> result = list;
+    QFuture<qsizetype> future = QtConcurrent::partition(result, isEven);
+    QCOMPARE(future.result(), expectedPoint);
+    QCOMPARE(result, expected);
+
+    result = list;
+    QCOMPARE(QtConcurrent::blockingPartition(result, isEven), expectedPoint);
+    QCOMPARE(result, expected);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(3);
+    result = list;
+    QCOMPARE(QtConcurrent::blockingPartition(&pool, result, isEven), expectedPoint);
+    QCOMPARE(result, expected);
+}
+
+void tst_QtConcurrentSort::partitionIterators()
+{
+    QList<int> list = randomList(30000, 100);
+    const auto isSmall = [](int value) { return value < 30; };
+    QList<int> expected = list;
+    const qsizetype expectedPoint =
+            std::stable_partition(expected.begin() + 10, expected.end(), isSmall)
+            - (expected.begin() + 10);
+
+    QCOMPARE(QtConcurrent::partition(list.begin() + 10, list.end(), isSmall).result(),
+             expectedPoint);
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentSort::progress()
+{
+    QList<int> list = randomList(100000, 1 << 30);
+
+    QFutureWatcher<void> watcher;
+    int maximum = 0;
+    int lastValue = 0;
+    connect(&watcher, &QFutureWatcher<void>::progressRangeChanged,
+            [&](int, int max) { maximum = max; });
+    connect(&watcher, &QFutureWatcher<void>::progressValueChanged,
+            [&](int value) { QVERIFY(value >= lastValue); lastValue = value; });
+
+    QFuture<void> future = QtConcurrent::sort(list);
+    watcher.setFuture(future);
+    watcher.waitForFinished();
+    QCoreApplication::processEvents();
+
+    QVERIFY(std::is_sorted(list.cbegin(), list.cend()));
+    QVERIFY(future.progressMaximum() > 0);
+    QCOMPARE(future.progressValue(), future.progressMaximum());
+    QCOMPARE(maximum, future.progressMaximum());
+    QCOMPARE(lastValue, maximum);
+}
+
+void tst_QtConcurrentSort::cancel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+
+    // occupy the only thread, so that the sort cannot start before it is canceled
+    QSemaphore semaphore;
+    pool.start([&semaphore] { semaphore.acquire(); });
+
+    const QList<int> list = randomList(50000, 1 << 30);
+    QList<int> result = list;
+    QFuture<void> future = QtConcurrent::sort(&pool, result);
+    future.cancel();
+    semaphore.release();
+    future.waitForFinished();
+
+    QVERIFY(future.isCanceled());
+    QVERIFY(std::is_permutation(result.cbegin(), result.cend(), list.cbegin()));
+}
+
+QTEST_MAIN(tst_QtConcurrentSort)
+#include "tst_qtconcurrentsort.moc"
@@ -36,6 +36,7 @@
 #include <qstringlist.h>
 #include <QSet>
 #include <QString>
+#include <QTemporaryDir>
 
 #include <QtCore/private/qfsfileengine_p.h>
 
@@ -109,6 +110,9 @@ private slots:
     void longPath();
     void dirorder();
     void relativePaths();
+    void parallelTraversal_data();
+    void parallelTraversal();
+    void parallelTraversalEarlyExit();
 #if defined(Q_OS_WIN)
     void uncPaths_data();
     void uncPaths();
@@ -334,6 +338,17 @@ void tst_QDirIterator::iterateRelativeDirectory_data()
                    "entrylist/directory/dummy,"
                    "entrylist/writable").split(',');
 
+    QTest::newRow("QDir::Subdirectories | ParallelTraversal / QDir::Files")
+        << QString("entrylist")
+        << QDirIterator::IteratorFlags(QDirIterator::Subdirectories | QDirIterator::ParallelTraversal)
+        << QDir::Filters(QDir::Files) << QStringList("*")
+        << QString("entrylist/directory/dummy,"
+                   "entrylist/file,"
+#ifndef Q_NO_SYMLINKS
+                   "entrylist/linktofile.lnk,"
+#endif
+                   "entrylist/writable").split(',');
+
     QTest::newRow("empty, default")
         << QString("empty") << QDirIterator::IteratorFlags{}
         << QDir::Filters(QDir::NoFilter) << QStringList("*")
@@ -583,6 +598,95 @@ void tst_QDirIterator::relativePaths()
     }
 }
 
+static QStringList sortedEntries(QDirIterator &it)
+{
+    // symbolic links may lead to the same directory in a different order
+    QStringList list;
+    while (it.hasNext())
+        list << it.nextFileInfo().canonicalFilePath();
+    list.sort();
+    return list;
+}
+
+void tst_QDirIterator::parallelTraversal_data()
+{
+    QTest::addColumn<QDirIterator::IteratorFlags>("flags");
+    QTest::addColumn<QDir::Filters>("filters");
+    QTest::addColumn<QStringList>("nameFilters");
+
+    const QDirIterator::IteratorFlags recursive = QDirIterator::Subdirectories;
+    QTest::newRow("default") << recursive << QDir::Filters(QDir::NoFilter) << QStringList();
+    QTest::newRow("files") << recursive << QDir::Filters(QDir::Files) << QStringList();
+    QTest::newRow("dirs, hidden")
+        << recursive << QDir::Filters(QDir::Dirs | QDir::Hidden | QDir::NoDotAndDotDot)
+        << QStringList();
+    QTest::newRow("name filters")
+        << recursive << QDir::Filters(QDir::Files | QDir::AllDirs | QDir::NoDotAndDotDot)
+        << QStringList("*3.txt");
+    QTest::newRow("follow symlinks")
+        << (recursive | QDirIterator::FollowSymlinks) << QDir::Filters(QDir::Files)
+        << QStringList();
+    QTest::newRow("flat") << QDirIterator::IteratorFlags{} << QDir::Filters(QDir::NoFilter)
+                          << QStringList();
+}
+
+void tst_QDirIterator::parallelTraversal()
+{
+    QFETCH(QDirIterator::IteratorFlags, flags);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QStringList, nameFilters);
+
+    QTemporaryDir tree;
+    QVERIFY2(tree.isValid(), qPrintable(tree.errorString()));
+    QDir root(tree.path());
+    for (int i = 0; i < 6; ++i) {
+        const QString dir = QString::fromLatin1("dir%1").arg(i);
+        for (int j = 0; j < 6; ++j) {
+            const QString subDir = dir + QString::fromLatin1(i % 2 ? "/.sub%1" : "/sub%1").arg(j);
+            QVERIFY(root.mkpath(subDir));
+            for (int k = 0; k < 10; ++k) {
+                QFile file(root.filePath(subDir + QString::fromLatin1("/file%1.txt").arg(k)));
+                QVERIFY(file.open(QIODevice::WriteOnly));
+            }
+        }
+    }
+#ifndef Q_NO_SYMLINKS
+    QVERIFY(QFile::link(root.filePath("dir0"), root.filePath("dir1/link")));
+    QVERIFY(QFile::link(tree.path(), root.filePath("dir2/loop")));
+#endif
+
+    QDirIterator serial(tree.path(), nameFilters, filters, flags);
+    const QStringList expected = sortedEntries(serial);
+    QVERIFY(!expected.isEmpty());
+
+    QDirIterator parallel(tree.path(), nameFilters, filters,
+                          flags | QDirIterator::ParallelTraversal);
+    QCOMPARE(sortedEntries(parallel), expected);
+    QVERIFY(!parallel.hasNext());
+    QVERIFY(parallel.next().isEmpty());
+}
+
+void tst_QDirIterator::parallelTraversalEarlyExit()
+{
+    QTemporaryDir tree;
+    QVERIFY2(tree.isValid(), qPrintable(tree.errorString()));
+    QDir root(tree.path());
+    for (int i = 0; i < 20; ++i) {
+        const QString dir = QString::fromLatin1("dir%1").arg(i);
+        QVERIFY(root.mkpath(dir));
+        for (int k = 0; k < 100; ++k) {
+            QFile file(root.filePath(dir + QString::fromLatin1("/file%1").arg(k)));
+            QVERIFY(file.open(QIODevice::WriteOnly));
+        }
+    }
+
+    // destroying the iterator while the workers are still busy must not hang or crash
+    QDirIterator it(tree.path(), QDir::Files,
+                    QDirIterator::Subdirectories | QDirIterator::ParallelTraversal);
+    QVERIFY(it.hasNext());
+    QVERIFY(it.nextFileInfo().isFile());
+}
+
 #if defined(Q_OS_WIN)
 void tst_QDirIterator::uncPaths_data()
 {
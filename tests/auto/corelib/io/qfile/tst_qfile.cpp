@@ -38,6 +38,7 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QFuture>
 #include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QOperatingSystemVersion>
@@ -272,6 +273,12 @@ private slots:
     void mapOpenMode();
     void mapWrittenFile_data();
     void mapWrittenFile();
+    void memoryMappedRead_data();
+    void memoryMappedRead();
+    void memoryMappedViews();
+    void memoryMappedFallback();
+    void readWriteAsync();
+    void readAsyncResource();
 
     void openStandardStreamsFileDescriptors();
     void openStandardStreamsBufferedStreams();
@@ -3401,6 +3408,188 @@ void tst_QFile::mapWrittenFile()
     file.remove();
 }
 
+static bool writeTestFile(const QString &fileName, const QByteArray &content)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            && file.write(content) == content.size();
+}
+
+void tst_QFile::memoryMappedRead_data()
+{
+    QTest::addColumn<QByteArray>("content");
+    QTest::addColumn<bool>("textMode");
+
+    QByteArray lines;
+    for (int i = 0; i < 5000; ++i)
+        lines += "line " + QByteArray::number(i) + (i % 7 ? "\n" : "\r\n");
+
+    QTest::newRow("lines") << lines << false;
+    QTest::newRow("lines,Text") << lines << true;
+    QTest::newRow("no-newline") << QByteArray("a single line without a terminator") << false;
+    QTest::newRow("binary") << QByteArray("\0\n\0\r\n\xff", 6) << false;
+}
+
+void tst_QFile::memoryMappedRead()
+{
+    QFETCH(QByteArray, content);
+    QFETCH(bool, textMode);
+
+    const QString fileName = QDir::currentPath() + '/' + "qfile_memorymapped_testfile";
+    QVERIFY(writeTestFile(fileName, content));
+
+    const QIODevice::OpenMode mode = textMode ? QIODevice::ReadOnly | QIODevice::Text
+                                              : QIODevice::ReadOnly;
+    QFile reference(fileName);
+    QFile mapped(fileName);
+    QVERIFY2(reference.open(mode), msgOpenFailed(mode, reference).constData());
+    QVERIFY2(mapped.open(mode | QIODevice::MemoryMapped),
+             msgOpenFailed(mode | QIODevice::MemoryMapped, mapped).constData());
+    QVERIFY(mapped.openMode() & QIODevice::MemoryMapped);
+    QCOMPARE(mapped.size(), reference.size());
+
+    while (!reference.atEnd()) {
+        QVERIFY(!mapped.atEnd());
+        QCOMPARE(mapped.peek(3), reference.peek(3));
+        QCOMPARE(mapped.readLine(), reference.readLine());
+        QCOMPARE(mapped.read(2), reference.read(2));
+        QCOMPARE(mapped.pos(), reference.pos());
+    }
+    QVERIFY(mapped.atEnd());
+    QVERIFY(mapped.read(1).isEmpty());
+
+    const qint64 offset = content.size() / 3;
+    QVERIFY(reference.seek(offset));
+    QVERIFY(mapped.seek(offset));
+    QCOMPARE(mapped.readAll(), reference.readAll());
+
+    QVERIFY(reference.seek(0));
+    QVERIFY(mapped.seek(0));
+    QCOMPARE(mapped.readAll(), reference.readAll());
+    QCOMPARE(mapped.error(), QFile::NoError);
+}
+
+void tst_QFile::memoryMappedViews()
+{
+    const QString fileName = QDir::currentPath() + '/' + "qfile_memorymapped_testfile";
+    QVERIFY(writeTestFile(fileName, "first\nsecond\r\n\nlast"));
+
+    QFile file(fileName);
+    QVERIFY(file.peekView(1).isNull());
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::MemoryMapped));
+
+    QCOMPARE(file.peekView(3).toByteArray(), QByteArray("fir"));
+    QCOMPARE(file.pos(), qint64(0));
+    QCOMPARE(file.readLineView().toByteArray(), QByteArray("first\n"));
+    QCOMPARE(file.readLineView(3).toByteArray(), QByteArray("sec"));
+    QCOMPARE(file.readLineView().toByteArray(), QByteArray("ond\r\n"));
+    // views and copying reads can be mixed freely
+    QCOMPARE(file.readLine(), QByteArray("\n"));
+    QCOMPARE(file.readView(100).toByteArray(), QByteArray("last"));
+    QVERIFY(file.atEnd());
+
+    const QByteArrayView end = file.readLineView();
+    QVERIFY(!end.isNull());
+    QVERIFY(end.isEmpty());
+
+    QVERIFY(file.seek(6));
+    QCOMPARE(file.readView(6).toByteArray(), QByteArray("second"));
+    QCOMPARE(file.read(2), QByteArray("\r\n"));
+
+    // data put back into the device is not part of the mapping
+    file.ungetChar('\n');
+    QVERIFY(file.peekView(1).isNull());
+    QCOMPARE(file.read(1), QByteArray("\n"));
+    QCOMPARE(file.peekView(1).toByteArray(), QByteArray("\n"));
+
+    file.close();
+    QVERIFY(file.readView(1).isNull());
+
+    // views cannot translate line endings
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::MemoryMapped | QIODevice::Text));
+    QVERIFY(file.peekView(1).isNull());
+    QCOMPARE(file.readAll(), QByteArray("first\nsecond\n\nlast"));
+}
+
+void tst_QFile::memoryMappedFallback()
+{
+    const QString fileName = QDir::currentPath() + '/' + "qfile_memorymapped_testfile";
+
+    // empty files cannot be mapped
+    QVERIFY(writeTestFile(fileName, QByteArray()));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::MemoryMapped));
+    QVERIFY(file.peekView(1).isNull());
+    QVERIFY(file.atEnd());
+    QVERIFY(file.readAll().isEmpty());
+    QCOMPARE(file.error(), QFile::NoError);
+    file.close();
+
+    // the flag is ignored for writable files
+    QVERIFY(file.open(QIODevice::ReadWrite | QIODevice::MemoryMapped));
+    QCOMPARE(file.write("data\n"), qint64(5));
+    QVERIFY(file.seek(0));
+    QVERIFY(file.readLineView().isNull());
+    QCOMPARE(file.readLine(), QByteArray("data\n"));
+    file.close();
+
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::MemoryMapped));
+    QCOMPARE(file.readLineView().toByteArray(), QByteArray("data\n"));
+}
+
+void tst_QFile::readWriteAsync()
+{
+    const QString fileName = QDir::currentPath() + '/' + "qfile_async_testfile";
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite | QIODevice::Truncate));
+    // still in the write buffer, so readAsync() has to flush it
+    QCOMPARE(file.write("0123456789"), qint64(10));
+
+    QFuture<QByteArray> read = file.readAsync(2, 5);
+    QCOMPARE(read.result(), QByteArray("23456"));
+    QCOMPARE(file.pos(), qint64(10));
+
+    QFuture<qint64> written = file.writeAsync(4, "abcd");
+    QCOMPARE(written.result(), qint64(4));
+    QCOMPARE(file.pos(), qint64(10));
+    QCOMPARE(file.readAsync(0, 100).result(), QByteArray("0123abcd89"));
+
+    read = file.readAsync(20, 4);
+    read.waitForFinished();
+    QVERIFY(!read.isCanceled());
+    QCOMPARE(read.result(), QByteArray());
+
+    // the QFile may be closed while the read is in flight
+    read = file.readAsync(0, 3);
+    file.close();
+    QCOMPARE(read.result(), QByteArray("012"));
+
+    QTest::ignoreMessage(QtWarningMsg, "QFile::readAsync: File not open for reading");
+    QVERIFY(file.readAsync(0, 1).isCanceled());
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg, "QFile::writeAsync: File not open for writing");
+    QVERIFY(file.writeAsync(0, "x").isCanceled());
+    QVERIFY(file.readAsync(-1, 1).isCanceled());
+    file.close();
+
+    QVERIFY(file.open(QIODevice::Append));
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QFile::writeAsync: Files opened in Append mode do not support positional writes");
+    QVERIFY(file.writeAsync(0, "x").isCanceled());
+}
+
+void tst_QFile::readAsyncResource()
+{
+    // not backed by a native handle, so the worker reopens it by name
+    QFile file(":/tst_qfileinfo/resources/file1.ext1");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray contents = file.readAll();
+    QVERIFY(!contents.isEmpty());
+    QCOMPARE(file.readAsync(0, contents.size() + 10).result(), contents);
+    QCOMPARE(file.readAsync(1, 1).result(), contents.mid(1, 1));
+}
+
 void tst_QFile::openDirectory()
 {
     QFile f1(m_resourcesDir);
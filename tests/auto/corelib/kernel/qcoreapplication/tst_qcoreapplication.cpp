@@ -517,6 +517,78 @@ public:
     }
 };
 
+void tst_QCoreApplication::postQueuedCalls()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    EventSpy spy;
+    QObject receiver;
+    receiver.installEventFilter(&spy);
+    QList<int> calls;
+
+    // queued calls at normal priority bypass the post event list's lock;
+    // they must still keep their place among the other events
+    QScopedPointer<QThread> thread(QThread::create([&] {
+        QMetaObject::invokeMethod(&receiver, [&] { calls << 1; }, Qt::QueuedConnection);
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::Type(QEvent::User + 1)));
+        QMetaObject::invokeMethod(&receiver, [&] { calls << 2; }, Qt::QueuedConnection);
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::Type(QEvent::User + 2)), 1);
+        QMetaObject::invokeMethod(&receiver, [&] { calls << 3; }, Qt::QueuedConnection);
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QCOMPARE(QObjectPrivate::get(&receiver)->postedEvents.loadRelaxed(), 5);
+
+    QCoreApplication::sendPostedEvents();
+    const QList<int> expected = { QEvent::User + 2, QEvent::MetaCall, QEvent::User + 1,
+                                  QEvent::MetaCall, QEvent::MetaCall };
+    QCOMPARE(spy.recordedEvents, expected);
+    QCOMPARE(calls, QList<int>({ 1, 2, 3 }));
+    QCOMPARE(QObjectPrivate::get(&receiver)->postedEvents.loadRelaxed(), 0);
+
+    // calls that were not delivered yet can be removed
+    calls.clear();
+    thread.reset(QThread::create([&] {
+        for (int i = 0; i < 10; ++i)
+            QMetaObject::invokeMethod(&receiver, [&] { calls << 0; }, Qt::QueuedConnection);
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QCoreApplication::removePostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(QObjectPrivate::get(&receiver)->postedEvents.loadRelaxed(), 0);
+    QCoreApplication::sendPostedEvents();
+    QVERIFY(calls.isEmpty());
+
+    // other events of the same type take the locked path
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::MetaCall));
+    QCOMPARE(QObjectPrivate::get(&receiver)->postedEvents.loadRelaxed(), 1);
+    QCoreApplication::removePostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(QObjectPrivate::get(&receiver)->postedEvents.loadRelaxed(), 0);
+}
+
+void tst_QCoreApplication::postQueuedCallsToMovedObject()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    QThread thread;
+    QObject receiver;
+    QAtomicPointer<QThread> calledIn;
+    QMetaObject::invokeMethod(&receiver, [&] {
+        calledIn.storeRelaxed(QThread::currentThread());
+        QThread::currentThread()->quit();
+    }, Qt::QueuedConnection);
+
+    // pending queued calls move along with the object
+    receiver.moveToThread(&thread);
+    thread.start();
+    QVERIFY(thread.wait(30000));
+    QCOMPARE(calledIn.loadRelaxed(), &thread);
+}
+
 void tst_QCoreApplication::deliverInDefinedOrder()
 {
     int argc = 1;
@@ -44,6 +44,8 @@ private slots:
     void postEvent();
     void removePostedEvents();
 #if QT_CONFIG(thread)
+    void postQueuedCalls();
+    void postQueuedCallsToMovedObject();
     void deliverInDefinedOrder();
 #endif
     void applicationPid();
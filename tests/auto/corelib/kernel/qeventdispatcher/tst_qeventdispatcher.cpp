@@ -63,6 +63,10 @@ public:
           isGuiEventDispatcher(QCoreApplication::instance()->inherits("QGuiApplication"))
     { }
 
+#ifdef QT_TEST_EPOLL_DISPATCHER
+    static void initMain() { qputenv("QT_EVENT_DISPATCHER_EPOLL", "1"); }
+#endif
+
 private slots:
     void initTestCase();
     void cleanup();
@@ -106,6 +110,10 @@ bool tst_QEventDispatcher::event(QEvent *e)
 // drain the system event queue after the test starts to avoid destabilizing the test functions
 void tst_QEventDispatcher::initTestCase()
 {
+#ifdef QT_TEST_EPOLL_DISPATCHER
+    QVERIFY(eventDispatcher->inherits("QEventDispatcherEpoll"));
+#endif
+
     QElapsedTimer elapsedTimer;
     elapsedTimer.start();
     while (!elapsedTimer.hasExpired(CoarseTimerInterval) && eventDispatcher->processEvents(QEventLoop::AllEvents)) {
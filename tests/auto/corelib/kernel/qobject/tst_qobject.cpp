@@ -170,6 +170,7 @@ private slots:
     void functorReferencesConnection();
     void disconnectDisconnects();
     void singleShotConnection();
+    void coalescedConnection();
     void objectNameBinding();
     void emitToDestroyedClass();
 };
@@ -8173,6 +8174,106 @@ void tst_QObject::singleShotConnection()
     }
 }
 
+void tst_QObject::coalescedConnection()
+{
+    {
+        // Direct emissions are not affected
+        SenderObject sender;
+        int called = 0;
+        connect(&sender, &SenderObject::signal1, &sender, [&] { ++called; },
+                Qt::CoalescedConnection);
+        sender.emitSignal1();
+        sender.emitSignal1();
+        QCOMPARE(called, 2);
+    }
+
+    {
+        // Pending emissions are replaced by the latest one
+        SenderObject sender;
+        QList<int> values;
+        QStringList strings;
+        QObject context;
+        connect(&sender, &SenderObject::signal7, &context,
+                [&](int i, const QString &s) { values << i; strings << s; },
+                static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::CoalescedConnection));
+        for (int i = 0; i < 100; ++i)
+            emit sender.signal7(i, QString::number(i));
+        QVERIFY(values.isEmpty());
+        QCoreApplication::processEvents();
+        QCOMPARE(values, QList<int>{99});
+        QCOMPARE(strings, QStringList{"99"});
+
+        // the next emission posts again
+        emit sender.signal7(100, QString());
+        QCoreApplication::processEvents();
+        QCOMPARE(values, (QList<int>{99, 100}));
+    }
+
+    {
+        // String based connections, combined with a plain queued connection
+        SenderObject sender;
+        ReceiverObject receiver;
+        connect(&sender, SIGNAL(signal1()), &receiver, SLOT(slot1()),
+                static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::CoalescedConnection));
+        connect(&sender, SIGNAL(signal1()), &receiver, SLOT(slot2()), Qt::QueuedConnection);
+        for (int i = 0; i < 10; ++i)
+            sender.emitSignal1();
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver.count_slot1, 1);
+        QCOMPARE(receiver.count_slot2, 10);
+    }
+
+    {
+        // A removed event does not block later emissions
+        SenderObject sender;
+        QObject context;
+        int called = 0;
+        connect(&sender, &SenderObject::signal1, &context, [&] { ++called; },
+                static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::CoalescedConnection));
+        sender.emitSignal1();
+        QCoreApplication::removePostedEvents(&context, QEvent::MetaCall);
+        QCoreApplication::processEvents();
+        QCOMPARE(called, 0);
+        sender.emitSignal1();
+        sender.emitSignal1();
+        QCoreApplication::processEvents();
+        QCOMPARE(called, 1);
+    }
+
+    {
+        // Deleting the receiver drops the pending call
+        SenderObject sender;
+        auto context = std::make_unique<QObject>();
+        int called = 0;
+        connect(&sender, &SenderObject::signal1, context.get(), [&] { ++called; },
+                static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::CoalescedConnection));
+        sender.emitSignal1();
+        context.reset();
+        sender.emitSignal1();
+        QCoreApplication::processEvents();
+        QCOMPARE(called, 0);
+    }
+
+    {
+        // Emissions from another thread
+        SenderObject sender;
+        QObject context;
+        int last = -1;
+        int called = 0;
+        connect(&sender, &SenderObject::signal7, &context,
+                [&](int i) { last = i; ++called; }, Qt::CoalescedConnection);
+        std::unique_ptr<QThread> thread(QThread::create([&] {
+            for (int i = 0; i < 1000; ++i)
+                emit sender.signal7(i, QString());
+        }));
+        thread->start();
+        QVERIFY(thread->wait());
+        QCoreApplication::processEvents();
+        QCOMPARE(last, 999);
+        QCOMPARE(called, 1);
+    }
+}
+
 void tst_QObject::objectNameBinding()
 {
     QObject obj;
@@ -53,6 +53,11 @@
 class tst_QSocketNotifier : public QObject
 {
     Q_OBJECT
+public:
+#ifdef QT_TEST_EPOLL_DISPATCHER
+    static void initMain() { qputenv("QT_EVENT_DISPATCHER_EPOLL", "1"); }
+#endif
+
 private slots:
     void constructing();
     void unexpectedDisconnection();
@@ -76,6 +76,7 @@ private slots:
     void timerFiresOnlyOncePerProcessEvents();
     void timerIdPersistsAfterThreadExit();
     void cancelLongTimer();
+    void timersAcrossWheelLevels();
     void singleShotStaticFunctionZeroTimeout();
     void recurseOnTimeoutAndStopTimer();
     void singleShotToFunctors();
@@ -728,6 +729,40 @@ void tst_QTimer::cancelLongTimer()
     QVERIFY(!timer.isActive());
 }
 
+void tst_QTimer::timersAcrossWheelLevels()
+{
+    // the intervals land in different levels of the timer wheel and need to
+    // be cascaded down before they fire
+    const int intervals[] = { 10, 270, 530 };
+    QList<int> fired;
+    QList<qint64> firedAt;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    for (int interval : intervals) {
+        QTimer::singleShot(interval, Qt::PreciseTimer, this, [&, interval] {
+            fired << interval;
+            firedAt << elapsed.elapsed();
+        });
+    }
+
+    // timers far beyond the root level report their remaining time correctly
+    QTimer hours;
+    hours.setTimerType(Qt::PreciseTimer);
+    hours.start(2 * 60 * 60 * 1000);
+    QTimer days;
+    days.setTimerType(Qt::VeryCoarseTimer);
+    days.start(2 * 24 * 60 * 60 * 1000);
+    QVERIFY(qAbs(hours.remainingTime() - 2 * 60 * 60 * 1000) < 1000);
+    QVERIFY(qAbs(days.remainingTime() - 2 * 24 * 60 * 60 * 1000) < 2000);
+
+    QTRY_COMPARE(fired.size(), 3);
+    QCOMPARE(fired, QList<int>({ 10, 270, 530 }));
+    for (int i = 0; i < fired.size(); ++i)
+        QVERIFY2(firedAt.at(i) >= fired.at(i), qPrintable(QString::number(firedAt.at(i))));
+    QVERIFY(hours.isActive());
+    QVERIFY(days.isActive());
+}
+
 class TimeoutCounter : public QObject
 {
     Q_OBJECT
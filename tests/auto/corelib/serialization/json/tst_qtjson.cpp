@@ -146,6 +146,7 @@ private Q_SLOTS:
     void nesting();
 
     void longStrings();
+    void parseAcrossBlocks();
 
     void arrayInitializerList();
     void objectInitializerList();
@@ -3176,6 +3177,65 @@ void tst_QtJson::testJsonValueRefDefault()
     QCOMPARE(empty["n/a"].toDouble(42.0), 42.0);
 }
 
+void tst_QtJson::parseAcrossBlocks()
+{
+    // the parser scans strings and whitespace in blocks of bytes, so check
+    // that special characters are found at every offset within a block
+    const struct {
+        const char *json;
+        const char16_t *text;
+    } specials[] = {
+        { "\\n", u"\n" },
+        { "\\\"", u"\"" },
+        { "\\u00e9", u"\u00e9" },
+        { "\xc3\xa9", u"\u00e9" },
+        { "\xe2\x82\xac", u"\u20ac" },
+    };
+    for (int length = 0; length < 40; ++length) {
+        for (int pos = 0; pos <= length; ++pos) {
+            for (const auto &special : specials) {
+                QByteArray json = "[\"" + QByteArray(length, 'a') + "\"]";
+                json.insert(2 + pos, special.json);
+                QString expected(length, u'a');
+                expected.insert(pos, QStringView(special.text));
+
+                QJsonParseError error;
+                const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+                QCOMPARE(error.error, QJsonParseError::NoError);
+                QCOMPARE(doc.array().at(0).toString(), expected);
+            }
+
+            // invalid UTF-8 is reported where it is
+            QByteArray json = "[\"" + QByteArray(length, 'a') + "\"]";
+            json.insert(2 + pos, '\xff');
+            QJsonParseError error;
+            QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::IllegalUTF8String);
+            QCOMPARE(error.offset, 2 + pos);
+        }
+
+        // unterminated strings
+        QJsonParseError error;
+        QJsonDocument::fromJson("[\"" + QByteArray(length, 'a'), &error);
+        QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+    }
+
+    for (int spaces = 0; spaces < 40; ++spaces) {
+        const QByteArray ws = QByteArray(" \t\r\n").repeated(spaces).left(spaces);
+        const QByteArray json = ws + "[" + ws + "1" + ws + "," + ws + "{" + ws + "\"a\""
+                + ws + ":" + ws + "true" + ws + "}" + ws + "]" + ws;
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(doc.array().at(0).toInt(), 1);
+        QCOMPARE(doc.array().at(1).toObject().value("a").toBool(), true);
+
+        QJsonDocument::fromJson(json + ws + "x", &error);
+        QCOMPARE(error.error, QJsonParseError::GarbageAtEnd);
+        QCOMPARE(error.offset, json.size() + ws.size());
+    }
+}
+
 void tst_QtJson::arrayInitializerList()
 {
     QVERIFY(QJsonArray{}.isEmpty());
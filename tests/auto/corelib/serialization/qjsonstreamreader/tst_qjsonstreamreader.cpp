@@ -0,0 +1,375 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamReader>
+
+using namespace Qt::StringLiterals;
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void scalars_data();
+    void scalars();
+    void objects();
+    void skipping();
+    void readValue_data();
+    void readValue();
+    void device();
+    void errors_data();
+    void errors();
+    void incremental_data() { readValue_data(); }
+    void incremental();
+    void deepNesting();
+};
+
+// Walks the document, producing a compact rendering of the tokens. When the
+// reader runs out of data, feeds it the next byte of \a rest.
+static QByteArray tokens(QJsonStreamReader &reader, QByteArray rest = QByteArray())
+{
+    QByteArray result;
+    forever {
+        if (reader.lastError().error != QJsonParseError::NoError) {
+            if (rest.isEmpty())
+                break;
+            reader.addData(rest.left(1));
+            rest.remove(0, 1);
+            continue;
+        }
+
+        const int depth = reader.containerDepth();
+        switch (reader.type()) {
+        case QJsonStreamReader::Invalid: {
+            if (depth == 0)
+                return result;
+            const bool isObject = reader.parentContainerType() == QJsonStreamReader::Object;
+            if (reader.leaveContainer())
+                result += isObject ? "}" : "]";
+            break;
+        }
+        case QJsonStreamReader::Array:
+        case QJsonStreamReader::Object:
+            reader.enterContainer();
+            if (reader.containerDepth() == depth + 1)
+                result += reader.parentContainerType() == QJsonStreamReader::Object ? "{" : "[";
+            break;
+        case QJsonStreamReader::String: {
+            const QString s = reader.readString();
+            if (!s.isNull())
+                result += '"' + s.toUtf8() + '"';
+            break;
+        }
+        case QJsonStreamReader::Null:
+            result += "null";
+            reader.next();
+            break;
+        case QJsonStreamReader::Bool:
+            result += reader.toBool() ? "true" : "false";
+            reader.next();
+            break;
+        case QJsonStreamReader::Integer:
+            result += QByteArray::number(reader.toInteger());
+            reader.next();
+            break;
+        case QJsonStreamReader::Double:
+            result += QByteArray::number(reader.toDouble());
+            reader.next();
+            break;
+        }
+    }
+    return result;
+}
+
+void tst_QJsonStreamReader::scalars_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<int>("type");
+    QTest::addColumn<QVariant>("expected");
+
+    QTest::newRow("null") << "null"_ba << int(QJsonStreamReader::Null) << QVariant();
+    QTest::newRow("true") << "true"_ba << int(QJsonStreamReader::Bool) << QVariant(true);
+    QTest::newRow("false") << "false"_ba << int(QJsonStreamReader::Bool) << QVariant(false);
+    QTest::newRow("zero") << "0"_ba << int(QJsonStreamReader::Integer) << QVariant(qint64(0));
+    QTest::newRow("integer") << "-1234"_ba << int(QJsonStreamReader::Integer) << QVariant(qint64(-1234));
+    QTest::newRow("max") << "9223372036854775807"_ba << int(QJsonStreamReader::Integer)
+                         << QVariant(std::numeric_limits<qint64>::max());
+    QTest::newRow("integral-double") << "1.0"_ba << int(QJsonStreamReader::Integer) << QVariant(qint64(1));
+    QTest::newRow("double") << "1.5"_ba << int(QJsonStreamReader::Double) << QVariant(1.5);
+    QTest::newRow("exponent") << "-2.5e-3"_ba << int(QJsonStreamReader::Double) << QVariant(-2.5e-3);
+    QTest::newRow("empty-string") << "\"\""_ba << int(QJsonStreamReader::String) << QVariant(u""_s);
+    QTest::newRow("string") << "\"Hello\""_ba << int(QJsonStreamReader::String) << QVariant(u"Hello"_s);
+    QTest::newRow("utf8") << "\"D\xc3\xbcsseldorf\""_ba << int(QJsonStreamReader::String)
+                          << QVariant(u"Düsseldorf"_s);
+    QTest::newRow("escapes") << "\"a\\\"b\\\\c\\/\\n\\u00e9\\ud83d\\ude00\""_ba
+                             << int(QJsonStreamReader::String)
+                             << QVariant(u"a\"b\\c/\né\U0001F600"_s);
+}
+
+void tst_QJsonStreamReader::scalars()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(int, type);
+    QFETCH(QVariant, expected);
+
+    QJsonStreamReader reader("[ " + json + " ]");
+    QVERIFY(reader.isArray());
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Invalid);
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.containerDepth(), 1);
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Array);
+    QCOMPARE(int(reader.type()), type);
+    QCOMPARE(reader.currentOffset(), 2);
+
+    switch (reader.type()) {
+    case QJsonStreamReader::Null:
+        QVERIFY(reader.next());
+        break;
+    case QJsonStreamReader::Bool:
+        QCOMPARE(reader.toBool(), expected.toBool());
+        QVERIFY(reader.next());
+        break;
+    case QJsonStreamReader::Integer:
+        QCOMPARE(reader.toInteger(), expected.toLongLong());
+        QCOMPARE(reader.toDouble(), expected.toDouble());
+        QVERIFY(reader.next());
+        break;
+    case QJsonStreamReader::Double:
+        QCOMPARE(reader.toDouble(), expected.toDouble());
+        QVERIFY(reader.next());
+        break;
+    case QJsonStreamReader::String:
+        QCOMPARE(reader.readString(), expected.toString());
+        break;
+    default:
+        QFAIL("Unexpected type");
+    }
+
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.containerDepth(), 0);
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(reader.currentOffset(), json.size() + 4);
+}
+
+void tst_QJsonStreamReader::objects()
+{
+    QJsonStreamReader reader(R"({"a": 1, "b": [true, null], "c": {"d": "e"}})"_ba);
+    QVERIFY(reader.isObject());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Object);
+
+    QVERIFY(reader.isString());
+    QCOMPARE(reader.readString(), u"a"_s);
+    QVERIFY(reader.isInteger());
+    QCOMPARE(reader.toInteger(), 1);
+    QVERIFY(reader.next());
+
+    QCOMPARE(reader.readString(), u"b"_s);
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.isBool());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isNull());
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+
+    QCOMPARE(reader.readString(), u"c"_s);
+    QCOMPARE(reader.readValue(), QJsonValue(QJsonObject{{u"d"_s, u"e"_s}}));
+
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QJsonStreamReader::skipping()
+{
+    QJsonStreamReader reader(R"([ {"a": [1, [2, {}]], "b": "x\"]"}, [[]], "s", 3.5, null ])"_ba);
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.isObject());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isString());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isDouble());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isNull());
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.next());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+
+    // leaving skips whatever was not read
+    reader.clear();
+    reader.addData(R"({"a": [1, 2, 3], "b": {"c": 4}} )"_ba);
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.readString(), u"a"_s);
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.readString(), u"b"_s);
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.containerDepth(), 0);
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QJsonStreamReader::readValue_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("empty-array") << "[]"_ba;
+    QTest::newRow("empty-object") << " { } "_ba;
+    QTest::newRow("bom") << "\xef\xbb\xbf[1]"_ba;
+    QTest::newRow("nested") << R"([[[]], {"a": {"b": [null]}}, []])"_ba;
+    QTest::newRow("duplicates") << R"({"a": 1, "b": 2, "a": 3})"_ba;
+    QTest::newRow("whitespace") << "\t[\r\n 1 ,\n\"two\"\t,  3.25 ,true,false , null ]\n"_ba;
+    QTest::newRow("strings") << R"(["", "\\", "\"", "Aé中", "café été"])"_ba;
+
+    QFile file(QFINDTESTDATA("../json/test.json"));
+    if (file.open(QIODevice::ReadOnly))
+        QTest::newRow("test.json") << file.readAll();
+}
+
+void tst_QJsonStreamReader::readValue()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QJsonStreamReader reader(json);
+    const QJsonValue value = reader.readValue();
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(value, doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object()));
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.containerDepth(), 0);
+}
+
+void tst_QJsonStreamReader::device()
+{
+    // a document larger than the read buffer
+    QJsonArray array;
+    QByteArray json = "[";
+    for (int i = 0; i < 20000; ++i) {
+        const QString s = u"element %1 \"quoted\""_s.arg(i);
+        array.append(s);
+        json += QJsonDocument(QJsonArray{s}).toJson(QJsonDocument::Compact).mid(1).chopped(1);
+        json += i == 19999 ? "]" : ",";
+    }
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    QVERIFY(reader.enterContainer());
+    for (int i = 0; i < array.size(); ++i) {
+        QVERIFY(reader.isString());
+        QCOMPARE(reader.readString(), array.at(i).toString());
+    }
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(reader.currentOffset(), json.size());
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("empty") << ""_ba;
+    QTest::newRow("scalar") << "1"_ba;
+    QTest::newRow("garbage") << "[] x"_ba;
+    QTest::newRow("unterminated-array") << "[1, 2"_ba;
+    QTest::newRow("unterminated-object") << R"({"a": 1)"_ba;
+    QTest::newRow("unterminated-string") << R"(["abc)"_ba;
+    QTest::newRow("missing-separator") << "[1 2]"_ba;
+    QTest::newRow("missing-name-separator") << R"({"a" 1})"_ba;
+    QTest::newRow("trailing-comma-array") << "[1,]"_ba;
+    QTest::newRow("trailing-comma-object") << R"({"a": 1,})"_ba;
+    QTest::newRow("non-string-name") << "{1: 2}"_ba;
+    QTest::newRow("missing-value") << R"({"a": , "b": 1})"_ba;
+    QTest::newRow("illegal-value") << "[nul]"_ba;
+    QTest::newRow("illegal-number") << "[-]"_ba;
+    QTest::newRow("bad-escape") << R"(["\u12x4"])"_ba;
+    QTest::newRow("bad-utf8") << "[\"\xc3\"]"_ba;
+    QTest::newRow("termination-by-number") << "[1"_ba;
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonParseError error;
+    QVERIFY(QJsonDocument::fromJson(json, &error).isNull());
+
+    QJsonStreamReader reader(json);
+    tokens(reader);
+    QCOMPARE(reader.lastError().error, error.error);
+    QVERIFY(reader.isInvalid());
+
+    // the error is reported again
+    reader.reparse();
+    tokens(reader);
+    QCOMPARE(reader.lastError().error, error.error);
+}
+
+void tst_QJsonStreamReader::incremental()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonStreamReader complete(json);
+    const QByteArray expected = tokens(complete);
+    QCOMPARE(complete.lastError().error, QJsonParseError::NoError);
+
+    // the same tokens come out when the data arrives one byte at a time
+    QJsonStreamReader reader;
+    const QByteArray actual = tokens(reader, json);
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(actual, expected);
+}
+
+void tst_QJsonStreamReader::deepNesting()
+{
+    const QByteArray json = QByteArray(2000, '[') + QByteArray(2000, ']');
+    QJsonStreamReader reader(json);
+    reader.readValue();
+    QCOMPARE(reader.lastError().error, QJsonParseError::DeepNesting);
+}
+
+QTEST_MAIN(tst_QJsonStreamReader)
+
+#include "tst_qjsonstreamreader.moc"
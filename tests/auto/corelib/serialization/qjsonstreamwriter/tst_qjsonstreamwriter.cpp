@@ -0,0 +1,244 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamWriter>
+
+using namespace Qt::StringLiterals;
+
+Q_DECLARE_METATYPE(QJsonDocument::JsonFormat)
+
+class tst_QJsonStreamWriter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase_data();
+    void scalars_data();
+    void scalars();
+    void documents_data();
+    void documents();
+    void appendValue_data() { documents_data(); }
+    void appendValue();
+    void device();
+    void structure();
+};
+
+static void encode(QJsonStreamWriter &writer, const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        return writer.appendNull();
+    case QJsonValue::Bool:
+        return writer.append(value.toBool());
+    case QJsonValue::Double:
+        if (value.toInteger(-1) == value.toInteger(-2))
+            return writer.append(value.toInteger());
+        return writer.append(value.toDouble());
+    case QJsonValue::String:
+        return writer.append(value.toString());
+    case QJsonValue::Array:
+        writer.startArray();
+        for (const QJsonValue &v : value.toArray())
+            encode(writer, v);
+        QVERIFY(writer.endArray());
+        return;
+    case QJsonValue::Object: {
+        writer.startObject();
+        const QJsonObject object = value.toObject();
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            writer.append(it.key());
+            encode(writer, it.value());
+        }
+        QVERIFY(writer.endObject());
+        return;
+    }
+    }
+}
+
+void tst_QJsonStreamWriter::initTestCase_data()
+{
+    QTest::addColumn<QJsonDocument::JsonFormat>("format");
+    QTest::newRow("indented") << QJsonDocument::Indented;
+    QTest::newRow("compact") << QJsonDocument::Compact;
+}
+
+void tst_QJsonStreamWriter::scalars_data()
+{
+    QTest::addColumn<QJsonValue>("value");
+
+    QTest::newRow("null") << QJsonValue(QJsonValue::Null);
+    QTest::newRow("true") << QJsonValue(true);
+    QTest::newRow("false") << QJsonValue(false);
+    QTest::newRow("integer") << QJsonValue(qint64(-1234567890123));
+    QTest::newRow("double") << QJsonValue(0.1);
+    QTest::newRow("integral-double") << QJsonValue(2.0);
+    QTest::newRow("infinity") << QJsonValue(qInf());
+    QTest::newRow("empty-string") << QJsonValue(u""_s);
+    QTest::newRow("string") << QJsonValue(u"Hello"_s);
+    QTest::newRow("escapes") << QJsonValue(u"\"\\/\b\f\n\r\t\x01\x1f"_s);
+    QTest::newRow("non-ascii") << QJsonValue(u"Düsseldorf 中 \U0001F600"_s);
+    QTest::newRow("lone-surrogate") << QJsonValue(QString(QChar(0xd800)));
+}
+
+void tst_QJsonStreamWriter::scalars()
+{
+    QFETCH_GLOBAL(QJsonDocument::JsonFormat, format);
+    QFETCH(QJsonValue, value);
+
+    const QJsonArray array{ value };
+    const QJsonObject object{ { u"key"_s, value } };
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    QCOMPARE(writer.format(), format);
+    QCOMPARE(writer.device(), nullptr);
+
+    encode(writer, array);
+    QCOMPARE(output, QJsonDocument(array).toJson(format));
+
+    output.clear();
+    encode(writer, object);
+    QCOMPARE(output, QJsonDocument(object).toJson(format));
+}
+
+void tst_QJsonStreamWriter::documents_data()
+{
+    QTest::addColumn<QJsonValue>("value");
+
+    QTest::newRow("empty-array") << QJsonValue(QJsonArray());
+    QTest::newRow("empty-object") << QJsonValue(QJsonObject());
+    QTest::newRow("nested-empty") << QJsonValue(QJsonArray{ QJsonArray(), QJsonObject() });
+    QTest::newRow("nested") << QJsonValue(QJsonObject{
+            { u"array"_s, QJsonArray{ 1, 2.5, u"three"_s, QJsonArray{ true, false } } },
+            { u"object"_s, QJsonObject{ { u"a"_s, QJsonValue::Null },
+                                        { u"b"_s, QJsonObject{ { u"c"_s, -1 } } } } },
+            { u"string"_s, u"value"_s } });
+    QTest::newRow("deep") << QJsonValue(QJsonArray{ QJsonArray{ QJsonArray{ QJsonArray{ 1 } } } });
+}
+
+void tst_QJsonStreamWriter::documents()
+{
+    QFETCH_GLOBAL(QJsonDocument::JsonFormat, format);
+    QFETCH(QJsonValue, value);
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    encode(writer, value);
+
+    const QJsonDocument doc = value.isArray() ? QJsonDocument(value.toArray())
+                                              : QJsonDocument(value.toObject());
+    QCOMPARE(output, doc.toJson(format));
+}
+
+void tst_QJsonStreamWriter::appendValue()
+{
+    QFETCH_GLOBAL(QJsonDocument::JsonFormat, format);
+    QFETCH(QJsonValue, value);
+
+    // whole values can be mixed with streamed elements
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    writer.startObject();
+    writer.append("streamed"_L1);
+    writer.startArray();
+    writer.append(value);
+    writer.append(1);
+    QVERIFY(writer.endArray());
+    writer.append(u"value"_s);
+    writer.append(value);
+    QVERIFY(writer.endObject());
+
+    const QJsonObject expected{ { u"streamed"_s, QJsonArray{ value, 1 } }, { u"value"_s, value } };
+    QCOMPARE(output, QJsonDocument(expected).toJson(format));
+}
+
+void tst_QJsonStreamWriter::device()
+{
+    QFETCH_GLOBAL(QJsonDocument::JsonFormat, format);
+
+    // more than the writer buffers before flushing
+    QJsonArray array;
+    for (int i = 0; i < 10000; ++i)
+        array.append(QJsonObject{ { u"index"_s, i }, { u"name"_s, u"element %1"_s.arg(i) } });
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    {
+        QJsonStreamWriter writer(&buffer);
+        QCOMPARE(writer.device(), &buffer);
+        writer.setFormat(format);
+        writer.startArray();
+        for (qsizetype i = 0; i < array.size(); ++i) {
+            encode(writer, array.at(i));
+            if (i == array.size() / 2)
+                QVERIFY(buffer.size() > 0);
+        }
+        QVERIFY(writer.endArray());
+        QCOMPARE(buffer.data(), QJsonDocument(array).toJson(format));
+
+        // anything after the document is flushed on destruction
+        writer.startArray();
+    }
+    QCOMPARE(buffer.data(), QJsonDocument(array).toJson(format) + (format == QJsonDocument::Compact ? "[" : "[\n"));
+}
+
+void tst_QJsonStreamWriter::structure()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(QJsonDocument::Compact);
+
+    QVERIFY(!writer.endArray());
+    QVERIFY(!writer.endObject());
+
+    writer.startObject();
+    QVERIFY(!writer.endArray());
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: object member names must be strings");
+    writer.append(1);
+    writer.append("key");
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: object member has no value");
+    QVERIFY(!writer.endObject());
+    writer.append(nullptr);
+    writer.append("key2");
+    writer.append(u"é"_s);
+    QVERIFY(writer.endObject());
+    QCOMPARE(output, "{\"key\":null,\"key2\":\"\xc3\xa9\"}");
+}
+
+QTEST_MAIN(tst_QJsonStreamWriter)
+
+#include "tst_qjsonstreamwriter.moc"
@@ -39,6 +39,7 @@
 #include <QFile>
 #include <QStringConverter>
 #include <QTcpSocket>
+#include <QSharedPointer>
 #include <QTemporaryDir>
 #include <QTextStream>
 #if QT_CONFIG(process)
@@ -80,6 +81,13 @@ private slots:
     void readLineMaxlen();
     void readLinesFromBufferCRCR();
     void readLineInto();
+    void readLineViewFromDevice_data();
+    void readLineViewFromDevice();
+    void readLineViewFromString_data();
+    void readLineViewFromString();
+    void readUtf8LineViewLargeFile();
+    void readUtf8LineViewInterleaved();
+    void readUtf8LineViewDeviceClosed();
 
     // all
     void readAllFromDevice_data();
@@ -622,6 +630,237 @@ protected:
     }
 };
 
+class SequentialBuffer : public QIODevice
+{
+public:
+    SequentialBuffer(const QByteArray *byteArray) : buf(byteArray) { }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override
+    { return buf->size() - offset + QIODevice::bytesAvailable(); }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        maxSize = qMin(maxSize, qint64(buf->size() - offset));
+        if (maxSize > 0)
+            memcpy(data, buf->constData() + offset, maxSize);
+        offset += maxSize;
+        return maxSize;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    const QByteArray *buf;
+    qsizetype offset = 0;
+};
+
+// Devices of all kinds that readUtf8LineView() reads differently: files it
+// maps, with and without text translation, and devices it reads in blocks
+static QList<QSharedPointer<QIODevice>> lineViewDevices(const QString &fileName,
+                                                        QByteArray *data)
+{
+    QList<QSharedPointer<QIODevice>> devices;
+    devices << QSharedPointer<QIODevice>(new QFile(fileName));
+    devices.last()->setObjectName("file");
+    devices.last()->open(QIODevice::ReadOnly);
+    devices << QSharedPointer<QIODevice>(new QFile(fileName));
+    devices.last()->setObjectName("text file");
+    devices.last()->open(QIODevice::ReadOnly | QIODevice::Text);
+    devices << QSharedPointer<QIODevice>(new QBuffer(data));
+    devices.last()->setObjectName("buffer");
+    devices.last()->open(QIODevice::ReadOnly);
+    devices << QSharedPointer<QIODevice>(new SequentialBuffer(data));
+    devices.last()->setObjectName("sequential");
+    devices.last()->open(QIODevice::ReadOnly);
+    return devices;
+}
+
+void tst_QTextStream::readLineViewFromDevice_data()
+{
+    generateLineData(false);
+}
+
+void tst_QTextStream::readLineViewFromDevice()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QStringList, lines);
+
+    QFile::remove(testFileName);
+    {
+        QFile file(testFileName);
+        QVERIFY(file.open(QFile::WriteOnly));
+        QCOMPARE(file.write(data), qlonglong(data.size()));
+    }
+
+    for (const auto &device : lineViewDevices(testFileName, &data)) {
+        QVERIFY(device->isOpen());
+        QTextStream stream(device.data());
+        QStringList list;
+        for (QUtf8StringView line = stream.readUtf8LineView(); !line.isNull();
+             line = stream.readUtf8LineView()) {
+            list << line.toString();
+        }
+        QVERIFY2(stream.atEnd(), qPrintable(device->objectName()));
+        QCOMPARE(list, lines);
+
+        if (device->isSequential())
+            continue;
+        // in text mode, readLine() drops a lone carriage return entirely
+        QVERIFY(stream.seek(0));
+        QStringList readLineList;
+        for (QString line = stream.readLine(); !line.isNull(); line = stream.readLine())
+            readLineList << line;
+        QVERIFY(stream.seek(0));
+        list.clear();
+        for (QStringView line = stream.readLineView(); !line.isNull(); line = stream.readLineView())
+            list << line.toString();
+        QVERIFY2(stream.atEnd(), qPrintable(device->objectName()));
+        QCOMPARE(list, readLineList);
+        if (!device->isTextModeEnabled())
+            QCOMPARE(list, lines);
+    }
+}
+
+void tst_QTextStream::readLineViewFromString_data()
+{
+    generateLineData(true);
+}
+
+void tst_QTextStream::readLineViewFromString()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QStringList, lines);
+
+    QString dataString = data;
+
+    QTextStream stream(&dataString, QIODevice::ReadOnly);
+    QStringList list;
+    for (QStringView line = stream.readLineView(); !line.isNull(); line = stream.readLineView())
+        list << line.toString();
+    QCOMPARE(list, lines);
+
+    stream.seek(0);
+    list.clear();
+    for (QUtf8StringView line = stream.readUtf8LineView(); !line.isNull();
+         line = stream.readUtf8LineView()) {
+        list << line.toString();
+    }
+    QCOMPARE(list, lines);
+}
+
+static QByteArray largeFileLine(int i)
+{
+    // mostly short lines, non-ASCII text, and every 2000th line longer
+    // than the buffers used for reading
+    QByteArray line = QByteArray::number(i) + ":\xc3\xa5";
+    line += QByteArray(i % 2000 ? (i * 7) % 200 : 100000, char('a' + i % 26));
+    if (i % 3 == 0)
+        line += '\r';
+    return line;
+}
+
+void tst_QTextStream::readUtf8LineViewLargeFile()
+{
+    // more than one window of QTEXTSTREAM_MAPSIZE for mapped files
+    const int lineCount = 480000;
+    QByteArray data;
+    data.reserve(80 * 1024 * 1024);
+    for (int i = 0; i < lineCount; ++i)
+        data += largeFileLine(i) + '\n';
+    QVERIFY(data.size() > 64 * 1024 * 1024);
+
+    QFile::remove(testFileName);
+    {
+        QFile file(testFileName);
+        QVERIFY(file.open(QFile::WriteOnly));
+        QCOMPARE(file.write(data), qlonglong(data.size()));
+    }
+
+    for (const auto &device : lineViewDevices(testFileName, &data)) {
+        QVERIFY(device->isOpen());
+        QTextStream stream(device.data());
+        int i = 0;
+        for (QUtf8StringView line = stream.readUtf8LineView(); !line.isNull();
+             line = stream.readUtf8LineView()) {
+            QByteArray expected = largeFileLine(i++);
+            if (expected.endsWith('\r'))
+                expected.chop(1);
+            if (line != QUtf8StringView(expected)) {
+                QFAIL(qPrintable(device->objectName() + ": line " + QString::number(i - 1)
+                                 + " differs"));
+            }
+        }
+        QCOMPARE(i, lineCount);
+        QVERIFY(stream.atEnd());
+        QCOMPARE(stream.pos(), device->isSequential() ? 0 : qint64(data.size()));
+    }
+}
+
+void tst_QTextStream::readUtf8LineViewInterleaved()
+{
+    QByteArray data("alpha\nbeta\ngamma\r\ndelta 42\nepsilon\n");
+    QFile::remove(testFileName);
+    {
+        QFile file(testFileName);
+        QVERIFY(file.open(QFile::WriteOnly));
+        QCOMPARE(file.write(data), qlonglong(data.size()));
+    }
+
+    for (const auto &device : lineViewDevices(testFileName, &data)) {
+        QVERIFY(device->isOpen());
+        const bool sequential = device->isSequential();
+        QTextStream stream(device.data());
+        QCOMPARE(stream.readUtf8LineView().toString(), QStringLiteral("alpha"));
+        if (!sequential)
+            QCOMPARE(stream.pos(), 6);
+        QCOMPARE(stream.readLine(), QStringLiteral("beta"));
+        if (!sequential)
+            QCOMPARE(stream.pos(), 11);
+        QCOMPARE(stream.readUtf8LineView().toString(), QStringLiteral("gamma"));
+        QString word;
+        int number = 0;
+        stream >> word >> number;
+        QCOMPARE(word, QStringLiteral("delta"));
+        QCOMPARE(number, 42);
+        QVERIFY(stream.readLineView().isEmpty());
+        QCOMPARE(stream.readLineView().toString(), QStringLiteral("epsilon"));
+        QVERIFY(stream.readUtf8LineView().isNull());
+        QVERIFY(stream.readLineView().isNull());
+        QVERIFY(stream.atEnd());
+
+        if (sequential)
+            continue;
+        QVERIFY(stream.seek(11));
+        QCOMPARE(stream.readUtf8LineView().toString(), QStringLiteral("gamma"));
+        QCOMPARE(stream.readAll(), QStringLiteral("delta 42\nepsilon\n"));
+    }
+}
+
+void tst_QTextStream::readUtf8LineViewDeviceClosed()
+{
+    QByteArray data("alpha\nbeta\n");
+    QFile::remove(testFileName);
+    {
+        QFile file(testFileName);
+        QVERIFY(file.open(QFile::WriteOnly));
+        QCOMPARE(file.write(data), qlonglong(data.size()));
+    }
+
+    QScopedPointer<QFile> file(new QFile(testFileName));
+    QVERIFY(file->open(QFile::ReadOnly));
+    QTextStream stream(file.data());
+    QCOMPARE(stream.readUtf8LineView().toString(), QStringLiteral("alpha"));
+
+    // closing the file drops the mapped read-ahead
+    file->close();
+    QVERIFY(file->open(QFile::ReadOnly));
+    QCOMPARE(stream.readUtf8LineView().toString(), QStringLiteral("alpha"));
+
+    // the stream must not touch the file once it is gone
+    file.reset();
+}
+
 void tst_QTextStream::readLineInto()
 {
     QByteArray data = "1\n2\n3";
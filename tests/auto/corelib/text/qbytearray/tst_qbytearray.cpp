@@ -32,6 +32,8 @@
 #include <qbytearray.h>
 #include <qfile.h>
 #include <qhash.h>
+#include <qlocale.h>
+#include <qrandom.h>
 #include <limits.h>
 #include <private/qtools_p.h>
 
@@ -95,6 +97,10 @@ private slots:
     void number_double();
     void number_base_data();
     void number_base();
+    void number_shortestRoundTrip();
+    void appendNumber();
+    void toLongLong_decimal_data();
+    void toLongLong_decimal();
     void nullness();
     void blockSizeCalculations();
 
@@ -1317,6 +1323,11 @@ void tst_QByteArray::number_double()
         }
     }
     QTEST(QByteArray::number(value, format, precision), "expected");
+
+    QFETCH(QByteArray, expected);
+    QByteArray appended("x=");
+    appended.appendNumber(value, format, precision);
+    QCOMPARE(appended, "x=" + expected);
 }
 
 void tst_QByteArray::number_base_data()
@@ -1370,6 +1381,127 @@ void tst_QByteArray::number_base()
     }
 }
 
+void tst_QByteArray::number_shortestRoundTrip()
+{
+    const auto check = [](double value) {
+        const QByteArray text = QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+        bool ok = false;
+        const double parsed = text.toDouble(&ok);
+        QVERIFY2(ok, text.constData());
+        QVERIFY2(parsed == value, text.constData());
+
+        // No representation with one significant digit less may round-trip
+        const qsizetype digits = std::count_if(text.begin(), text.indexOf('e') < 0
+                                                   ? text.end() : text.begin() + text.indexOf('e'),
+                                               [](char c) { return c >= '1' && c <= '9'; });
+        if (digits > 1) {
+            const QByteArray shorter = QByteArray::number(value, 'e', int(digits) - 2);
+            QVERIFY2(shorter.toDouble() != value, shorter.constData());
+        }
+    };
+
+    for (double value : { 0.1, 1.0 / 3, 5e-324, 1.7976931348623157e308, 2.2250738585072014e-308,
+                          9007199254740993.0, 123456789.0, 1e23, -0.5, -0.0 }) {
+        check(value);
+        if (QTest::currentTestFailed())
+            return;
+    }
+
+    QRandomGenerator64 rng(20221014);
+    for (int i = 0; i < 10000; ++i) {
+        double value;
+        do {
+            const quint64 bits = rng.generate64();
+            memcpy(&value, &bits, sizeof(double));
+        } while (!qIsFinite(value));
+        check(value);
+        if (QTest::currentTestFailed())
+            return;
+    }
+}
+
+void tst_QByteArray::appendNumber()
+{
+    QByteArray csv;
+    csv.appendNumber(42).append(',').appendNumber(-7LL).append(',')
+            .appendNumber(std::numeric_limits<qulonglong>::max()).append(',')
+            .appendNumber(255u, 16).append(',').appendNumber(short(-3)).append(',')
+            .appendNumber(0.25).append(',').appendNumber(1.5f, 'f', 2).append(',')
+            .appendNumber(qInf(), 'E');
+    QCOMPARE(csv, QByteArray("42,-7,18446744073709551615,ff,-3,0.25,1.50,INF"));
+
+    QByteArray ba("n:");
+    ba.appendNumber(std::numeric_limits<qlonglong>::min());
+    QCOMPARE(ba, QByteArray("n:-9223372036854775808"));
+
+    // Appending many values must give the same text as joining number()
+    QByteArray appended;
+    QByteArray joined;
+    for (int i = -500; i < 500; ++i) {
+        const double value = i * 1.25e-3;
+        appended.appendNumber(i * 7919).append(' ').appendNumber(value, 'g', 12).append('\n');
+        joined += QByteArray::number(i * 7919) + ' ' + QByteArray::number(value, 'g', 12) + '\n';
+    }
+    QCOMPARE(appended, joined);
+}
+
+void tst_QByteArray::toLongLong_decimal_data()
+{
+    QTest::addColumn<QByteArray>("text");
+    QTest::addColumn<bool>("ok");
+    QTest::addColumn<qlonglong>("expected");
+    QTest::addColumn<bool>("unsignedOk");
+    QTest::addColumn<qulonglong>("unsignedExpected");
+
+    const auto row = [](const char *text, bool ok, qlonglong expected) {
+        const bool unsignedOk = ok && expected >= 0 && !strchr(text, '-');
+        QTest::newRow(text) << QByteArray(text) << ok << expected
+                            << unsignedOk << (unsignedOk ? qulonglong(expected) : 0);
+    };
+    row("12345678", true, 12345678LL);
+    row("123456789", true, 123456789LL);
+    row("1234567890123456", true, 1234567890123456LL);
+    row("0000000000000000000042", true, 42LL);
+    row("-98765432109", true, -98765432109LL);
+    row("+98765432109", true, 98765432109LL);
+    row("  87654321  ", true, 87654321LL);
+    row("9223372036854775807", true, std::numeric_limits<qlonglong>::max());
+    row("-9223372036854775808", true, std::numeric_limits<qlonglong>::min());
+    row("-9223372036854775809", false, 0);
+    row("1234a678", false, 0);
+    row("123456789012345/", false, 0);
+    row("12345678:", false, 0);
+    row("-", false, 0);
+    row("", false, 0);
+
+    QTest::newRow("9223372036854775808") << QByteArray("9223372036854775808") << false << 0LL
+                                         << true << 9223372036854775808ULL;
+    QTest::newRow("18446744073709551615") << QByteArray("18446744073709551615") << false << 0LL
+                                          << true << std::numeric_limits<qulonglong>::max();
+    QTest::newRow("18446744073709551616") << QByteArray("18446744073709551616") << false << 0LL
+                                          << false << 0ULL;
+    QTest::newRow("000000000000000000000018446744073709551615")
+            << QByteArray("000000000000000000000018446744073709551615") << false << 0LL
+            << true << std::numeric_limits<qulonglong>::max();
+}
+
+void tst_QByteArray::toLongLong_decimal()
+{
+    QFETCH(QByteArray, text);
+    QFETCH(bool, ok);
+    QFETCH(qlonglong, expected);
+    QFETCH(bool, unsignedOk);
+    QFETCH(qulonglong, unsignedExpected);
+
+    bool parsed = !ok;
+    QCOMPARE(text.toLongLong(&parsed), expected);
+    QCOMPARE(parsed, ok);
+
+    parsed = !unsignedOk;
+    QCOMPARE(text.toULongLong(&parsed), unsignedExpected);
+    QCOMPARE(parsed, unsignedOk);
+}
+
 void tst_QByteArray::nullness()
 {
     {
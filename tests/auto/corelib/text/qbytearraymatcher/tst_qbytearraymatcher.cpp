@@ -31,6 +31,8 @@
 
 #include <qbytearraymatcher.h>
 
+#include <QRandomGenerator>
+
 #include <numeric>
 #include <string>
 
@@ -53,6 +55,10 @@ private slots:
     void indexIn();
     void staticByteArrayMatcher();
     void haystacksWithMoreThan4GiBWork();
+    void multiByteArrayMatcher();
+    void multiByteArrayMatcherCaseInsensitive();
+    void multiByteArrayMatcherReference_data();
+    void multiByteArrayMatcherReference();
 };
 
 void tst_QByteArrayMatcher::overloads()
@@ -316,6 +322,166 @@ void tst_QByteArrayMatcher::haystacksWithMoreThan4GiBWork()
 
 }
 
+static QByteArray describeMatches(const QList<QMultiByteArrayMatcher::Match> &matches)
+{
+    QByteArray result;
+    for (const auto &match : matches) {
+        result += QByteArray::number(match.position) + ':' + QByteArray::number(match.length)
+                + ':' + QByteArray::number(match.patternIndex) + ' ';
+    }
+    return result;
+}
+
+void tst_QByteArrayMatcher::multiByteArrayMatcher()
+{
+    {
+        QMultiByteArrayMatcher m;
+        QVERIFY(m.patterns().isEmpty());
+        QVERIFY(!m.indexIn("hello").isValid());
+        QVERIFY(m.indexesIn("hello").isEmpty());
+    }
+
+    QMultiByteArrayMatcher m({ "he", "she", "his", "hers" });
+    QCOMPARE(m.patterns().size(), 4);
+    QCOMPARE(m.caseSensitivity(), Qt::CaseSensitive);
+
+    // leftmost first, even though "he" ends earlier than "hers"
+    auto match = m.indexIn("ushers");
+    QCOMPARE(match.position, 1);
+    QCOMPARE(match.length, 3);
+    QCOMPARE(match.patternIndex, 1);
+
+    // longest among those starting at the same position
+    match = m.indexIn("ushers", 2);
+    QCOMPARE(match.position, 2);
+    QCOMPARE(match.length, 4);
+    QCOMPARE(match.patternIndex, 3);
+
+    QVERIFY(!m.indexIn("ushers", 3).isValid());
+    QVERIFY(!m.indexIn("ushers", 100).isValid());
+    QCOMPARE(m.indexIn("ushers", -5).position, 1);
+
+    QCOMPARE(describeMatches(m.indexesIn("ushers")), "1:3:1 2:2:0 2:4:3 ");
+    QCOMPARE(describeMatches(m.indexesIn("ushers", 2)), "2:2:0 2:4:3 ");
+    QCOMPARE(describeMatches(m.indexesIn("this is his")), "1:3:2 8:3:2 ");
+
+    // a pattern that is a suffix of another one only matches where it
+    // occurs itself
+    QMultiByteArrayMatcher suffixes({ "abcd", "bc" });
+    QCOMPARE(suffixes.indexIn("xabcd").position, 1);
+    QCOMPARE(suffixes.indexIn("xabcd").patternIndex, 0);
+    QCOMPARE(suffixes.indexIn("xabce").position, 2);
+    QCOMPARE(suffixes.indexIn("xabce").patternIndex, 1);
+
+    // empty patterns never match, repeated ones report their first index
+    QMultiByteArrayMatcher odd({ "", "ab", "ab", QByteArray("\0\xff", 2) });
+    QCOMPARE(describeMatches(odd.indexesIn("abab")), "0:2:1 2:2:1 ");
+    QCOMPARE(describeMatches(odd.indexesIn(QByteArrayView("x\0\xff", 3))), "1:2:3 ");
+
+    // copies share the automaton and stay usable after the original changes
+    QMultiByteArrayMatcher copy = m;
+    m.setPatterns({ "x" });
+    QCOMPARE(copy.indexIn("ushers").position, 1);
+    QCOMPARE(m.indexIn("ushers").position, -1);
+    QCOMPARE(m.indexIn("abcx").position, 3);
+}
+
+void tst_QByteArrayMatcher::multiByteArrayMatcherCaseInsensitive()
+{
+    QMultiByteArrayMatcher m({ "Content-Length:", "\xc9t\xe9" }, Qt::CaseInsensitive);
+    QCOMPARE(m.caseSensitivity(), Qt::CaseInsensitive);
+
+    QCOMPARE(m.indexIn("Host: x\r\ncontent-length: 3").position, 9);
+    QCOMPARE(m.indexIn("CONTENT-LENGTH:").position, 0);
+    // Latin-1 letters fold too
+    QCOMPARE(m.indexIn("en \xe9T\xc9").position, 3);
+    QCOMPARE(m.indexIn("en \xe9T\xc9").patternIndex, 1);
+
+    m.setCaseSensitivity(Qt::CaseSensitive);
+    QVERIFY(!m.indexIn("content-length:").isValid());
+    QVERIFY(!m.indexIn("\xe9t\xe9").isValid());
+    QCOMPARE(m.indexIn("\xc9t\xe9").position, 0);
+}
+
+void tst_QByteArrayMatcher::multiByteArrayMatcherReference_data()
+{
+    QTest::addColumn<QList<QByteArray>>("patterns");
+    QTest::addColumn<QByteArray>("alphabet");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    const QList<QByteArray> single = { "a", "bc", "cab", "abcab" };
+    const QList<QByteArray> pairs = { "ab", "ba", "aab", "bbbb", "cd" };
+    QList<QByteArray> many;
+    for (char c = 'a'; c <= 'z'; ++c)
+        many << QByteArray(1, c) + 'x' << QByteArray(1, c) + "yy" << QByteArray(2, c) + 'z';
+
+    QTest::newRow("one-byte") << single << QByteArray("abcx") << Qt::CaseSensitive;
+    QTest::newRow("two-byte") << pairs << QByteArray("abcd") << Qt::CaseSensitive;
+    QTest::newRow("two-byte-ci") << pairs << QByteArray("aAbBcD") << Qt::CaseInsensitive;
+    QTest::newRow("high-bytes") << QList<QByteArray>{ "\xe0\xff", "\xff\xe0", "\xc0x" }
+                                << QByteArray("\xc0\xe0\xffx") << Qt::CaseInsensitive;
+    QTest::newRow("many") << many << QByteArray("abcxyzABZ") << Qt::CaseSensitive;
+    QTest::newRow("many-ci") << many << QByteArray("abcxyzABZ") << Qt::CaseInsensitive;
+}
+
+void tst_QByteArrayMatcher::multiByteArrayMatcherReference()
+{
+    QFETCH(QList<QByteArray>, patterns);
+    QFETCH(QByteArray, alphabet);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    const auto fold = [cs](uchar c) {
+        const char32_t folded = QChar::toCaseFolded(char32_t(c));
+        return cs == Qt::CaseSensitive || folded > 0xff ? c : uchar(folded);
+    };
+    const auto matchesAt = [&](const QByteArray &data, qsizetype pos, const QByteArray &pattern) {
+        if (pattern.isEmpty() || pos + pattern.size() > data.size())
+            return false;
+        for (qsizetype i = 0; i < pattern.size(); ++i) {
+            if (fold(data.at(pos + i)) != fold(pattern.at(i)))
+                return false;
+        }
+        return true;
+    };
+
+    // long enough for the SIMD prefilter to see full blocks and a tail
+    QRandomGenerator rng(2022);
+    QMultiByteArrayMatcher matcher(patterns, cs);
+    for (int round = 0; round < 20; ++round) {
+        QByteArray data(200 + rng.bounded(50), Qt::Uninitialized);
+        for (char &c : data) {
+            // mostly filler, so that the prefilter actually skips something
+            c = rng.bounded(4) ? '.' : alphabet.at(rng.bounded(int(alphabet.size())));
+        }
+
+        QList<QMultiByteArrayMatcher::Match> expected;
+        for (qsizetype pos = 0; pos < data.size(); ++pos) {
+            QList<QMultiByteArrayMatcher::Match> here;
+            for (qsizetype i = 0; i < patterns.size(); ++i) {
+                if (patterns.indexOf(patterns.at(i)) == i && matchesAt(data, pos, patterns.at(i)))
+                    here.append({ pos, patterns.at(i).size(), i });
+            }
+            std::sort(here.begin(), here.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.length < rhs.length;
+            });
+            expected += here;
+        }
+        QCOMPARE(describeMatches(matcher.indexesIn(data)), describeMatches(expected));
+
+        for (qsizetype from = 0; from <= data.size(); from += 7) {
+            QMultiByteArrayMatcher::Match leftmost;
+            for (const auto &match : expected) {
+                if (match.position >= from
+                        && (!leftmost.isValid() || match.position == leftmost.position)) {
+                    leftmost = match;
+                }
+            }
+            QCOMPARE(describeMatches({ matcher.indexIn(data, from) }),
+                     describeMatches({ leftmost }));
+        }
+    }
+}
+
 #undef LONG_STRING_256
 #undef LONG_STRING_128
 #undef LONG_STRING__64
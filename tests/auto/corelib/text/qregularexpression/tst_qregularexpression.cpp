@@ -28,6 +28,7 @@
 ****************************************************************************/
 
 #include <QTest>
+#include <qscopeguard.h>
 #include <qstring.h>
 #include <qlist.h>
 #include <qstringlist.h>
@@ -36,6 +37,7 @@
 #include <qobject.h>
 #include <qregularexpression.h>
 #include <qthread.h>
+#include <qthreadpool.h>
 
 #include <iostream>
 #include <optional>
@@ -88,6 +90,13 @@ private slots:
     void QStringAndQStringViewEquivalence();
     void threadSafety_data();
     void threadSafety();
+    void streamMatcher_data();
+    void streamMatcher();
+    void streamMatcherReset();
+    void globalMatchParallel_data();
+    void globalMatchParallel();
+    void compiledPatternCache();
+    void serializeCompiledPatterns();
 
     void returnsViewsIntoOriginalString();
     void wildcard_data();
@@ -2438,6 +2447,249 @@ void tst_QRegularExpression::threadSafety()
     }
 }
 
+static QStringList describeMatches(const QList<QRegularExpressionMatch> &matches)
+{
+    QStringList result;
+    for (const QRegularExpressionMatch &match : matches) {
+        QString description;
+        for (int i = 0; i <= match.lastCapturedIndex(); ++i) {
+            description += QString::number(match.capturedStart(i)) + u'-'
+                    + QString::number(match.capturedEnd(i)) + u':' + match.captured(i) + u';';
+        }
+        result.append(description);
+    }
+    return result;
+}
+
+static QList<QRegularExpressionMatch> globalMatches(const QRegularExpression &re, const QString &subject,
+                                                    QRegularExpression::MatchOptions options = {})
+{
+    QList<QRegularExpressionMatch> matches;
+    for (const QRegularExpressionMatch &match : re.globalMatch(subject, 0, QRegularExpression::NormalMatch, options))
+        matches.append(match);
+    return matches;
+}
+
+void tst_QRegularExpression::streamMatcher_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QString>("subject");
+
+    QTest::newRow("words") << "\\w+" << "the quick brown fox";
+    QTest::newRow("greedy") << "\\d+" << "a1b22c333d4444";
+    QTest::newRow("across lines") << "foo\\nbar" << "xfoo\nbarfoo\nbarfoo\n";
+    QTest::newRow("lookbehind") << "(?<=ab)c" << "abcabcxcabc";
+    QTest::newRow("word boundary") << "\\bfox\\b" << "fox foxes afox fox";
+    QTest::newRow("empty matches") << "x*" << "axxbxcxx";
+    QTest::newRow("lines") << "(?m)^\\w+$" << "one\ntwo words\nthree\n\nfour";
+    QTest::newRow("caret") << "^a" << "aaa";
+    QTest::newRow("dollar") << "a$" << "aaa";
+    QTest::newRow("end of line") << "(?m)$" << "ab\ncd\n";
+    QTest::newRow("alternation") << "ab|abcd|bc" << "abcdabcabd";
+    QTest::newRow("named groups") << "(?<key>\\w+)=(?<value>\\w*)" << "a=1 b= c=33 =4";
+    QTest::newRow("optional group") << "a(b)?c" << "acabcabac";
+    QTest::newRow("surrogates") << "\\x{1F600}+|b" << QString::fromUtf8("a\xF0\x9F\x98\x80\xF0\x9F\x98\x80" "b\xF0\x9F\x98\x80");
+    QTest::newRow("any character") << "." << QString::fromUtf8("a\xF0\x9F\x98\x80" "b");
+    QTest::newRow("no match") << "xyz" << "abcdefgh";
+}
+
+void tst_QRegularExpression::streamMatcher()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, subject);
+
+    const QRegularExpression re(pattern);
+    QVERIFY(re.isValid());
+    const QStringList expected = describeMatches(globalMatches(re, subject));
+
+    for (qsizetype chunkSize : { 1, 2, 3, 5, 8 }) {
+        QRegularExpressionStreamMatcher matcher(re);
+        QList<QRegularExpressionMatch> matches;
+        for (qsizetype i = 0; i < subject.size(); i += chunkSize)
+            matches += matcher.feed(QStringView(subject).mid(i, chunkSize));
+        QCOMPARE(matcher.position(), subject.size());
+        matches += matcher.finish();
+        QCOMPARE(matcher.position(), 0);
+
+        for (const QRegularExpressionMatch &match : std::as_const(matches)) {
+            QVERIFY(match.isValid());
+            QVERIFY(match.hasMatch());
+            QCOMPARE(match.regularExpression(), re);
+        }
+        QCOMPARE(describeMatches(matches), expected);
+    }
+
+    QRegularExpressionStreamMatcher matcher(re);
+    QList<QRegularExpressionMatch> matches = matcher.feed(subject);
+    matches += matcher.finish();
+    QCOMPARE(describeMatches(matches), expected);
+}
+
+void tst_QRegularExpression::streamMatcherReset()
+{
+    QRegularExpressionStreamMatcher matcher(QRegularExpression("(\\d+)-(\\d+)"));
+
+    QVERIFY(matcher.feed(u"12-3").isEmpty());
+    matcher.reset();
+    QCOMPARE(matcher.position(), 0);
+
+    QList<QRegularExpressionMatch> matches = matcher.feed(u"x4-56 7");
+    matches += matcher.feed(u"8-9");
+    QCOMPARE(matches.size(), 1);
+    matches += matcher.finish();
+    QCOMPARE(matches.size(), 2);
+
+    QCOMPARE(matches.at(0).captured(), u"4-56");
+    QCOMPARE(matches.at(0).capturedStart(2), 3);
+    QCOMPARE(matches.at(0).capturedView(2), u"56");
+    QCOMPARE(matches.at(1).captured(1), u"78");
+    QCOMPARE(matches.at(1).capturedStart(), 6);
+    QCOMPARE(matches.at(1).capturedEnd(), 10);
+
+    // invalid UTF-16 stops the matching until the matcher is reset
+    QVERIFY(matcher.feed(u"1-2 ").size() == 1);
+    const char16_t invalid[] = { 0xdc00, u' ', u'3', u'-', u'4', u' ' };
+    QVERIFY(matcher.feed(QStringView(invalid, std::size(invalid))).isEmpty());
+    QVERIFY(matcher.finish().isEmpty());
+    QCOMPARE(matcher.feed(u"5-6 ").size(), 1);
+}
+
+void tst_QRegularExpression::globalMatchParallel_data()
+{
+    QTest::addColumn<QString>("pattern");
+
+    QTest::newRow("values") << "value=(\\d+)";
+    QTest::newRow("lines") << "(?m)^line \\d*7 .*$";
+    QTest::newRow("across lines") << "\\d\\n\\w";
+    QTest::newRow("across ranges") << "(?s)value=9(?:.{10000}){7}";
+    QTest::newRow("lazy across ranges") << "(?s)line 3\\d{3} .*?line 14\\d{3} ";
+    QTest::newRow("empty matches") << "(?m)$";
+    QTest::newRow("empty or not") << "(?s)(?:\\n.{30000})?";
+    QTest::newRow("no match") << "value=x";
+}
+
+void tst_QRegularExpression::globalMatchParallel()
+{
+    QFETCH(QString, pattern);
+
+    QString subject;
+    for (int i = 0; i < 20000; ++i)
+        subject += QString::fromLatin1("line %1 value=%2\n").arg(i).arg(i * 7 % 1000);
+
+    const QRegularExpression re(pattern);
+    QVERIFY(re.isValid());
+    const QList<QRegularExpressionMatch> expected = globalMatches(re, subject);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    QList<QRegularExpressionMatch> matches = re.globalMatchParallel(subject, {}, &pool);
+    QCOMPARE(matches.size(), expected.size());
+    QCOMPARE(describeMatches(matches), describeMatches(expected));
+
+    // too short to be split
+    const QString shortSubject = subject.left(1000);
+    matches = re.globalMatchParallel(shortSubject, {}, &pool);
+    QCOMPARE(describeMatches(matches), describeMatches(globalMatches(re, shortSubject)));
+
+    // anchored matches must form a chain from the start of the subject
+    const auto anchored = QRegularExpression::AnchorAtOffsetMatchOption;
+    matches = re.globalMatchParallel(subject, anchored, &pool);
+    QCOMPARE(describeMatches(matches),
+             describeMatches(globalMatches(re, subject, anchored)));
+}
+
+void tst_QRegularExpression::compiledPatternCache()
+{
+    const qsizetype oldCapacity = QRegularExpressionCache::capacity();
+    auto restoreCapacity = qScopeGuard([oldCapacity] {
+        QRegularExpressionCache::setCapacity(oldCapacity);
+    });
+
+    QRegularExpressionCache::clear();
+    QRegularExpressionCache::resetStatistics();
+    QCOMPARE(QRegularExpressionCache::size(), 0);
+
+    QRegularExpression re1("(\\d+)-(\\w+)");
+    QVERIFY(re1.isValid());
+    QCOMPARE(QRegularExpressionCache::missCount(), quint64(1));
+    QCOMPARE(QRegularExpressionCache::hitCount(), quint64(0));
+    QCOMPARE(QRegularExpressionCache::size(), 1);
+
+    QRegularExpression re2("(\\d+)-(\\w+)");
+    QCOMPARE(re2.captureCount(), 2);
+    QCOMPARE(QRegularExpressionCache::hitCount(), quint64(1));
+    QCOMPARE(re2.match("x 12-ab").captured(2), u"ab");
+
+    // different options make a different pattern
+    QRegularExpression re3("(\\d+)-(\\w+)", QRegularExpression::CaseInsensitiveOption);
+    re3.optimize();
+    QCOMPARE(QRegularExpressionCache::missCount(), quint64(2));
+    QCOMPARE(QRegularExpressionCache::size(), 2);
+
+    // invalid patterns are not cached
+    QRegularExpression invalid("(");
+    QVERIFY(!invalid.isValid());
+    QCOMPARE(QRegularExpressionCache::size(), 2);
+
+    // least recently used patterns are discarded first
+    QRegularExpressionCache::setCapacity(2);
+    QRegularExpression("(\\d+)-(\\w+)").optimize();
+    QRegularExpression("abc").optimize();
+    QCOMPARE(QRegularExpressionCache::size(), 2);
+    QRegularExpressionCache::resetStatistics();
+    QRegularExpression("(\\d+)-(\\w+)").optimize();
+    QRegularExpression("(\\d+)-(\\w+)", QRegularExpression::CaseInsensitiveOption).optimize();
+    QCOMPARE(QRegularExpressionCache::hitCount(), quint64(1));
+    QCOMPARE(QRegularExpressionCache::missCount(), quint64(1));
+
+    // discarded patterns stay usable
+    QRegularExpressionCache::setCapacity(0);
+    QCOMPARE(QRegularExpressionCache::size(), 0);
+    QCOMPARE(re1.match("34-cd").captured(1), u"34");
+    QCOMPARE(re3.match("56-EF").captured(2), u"EF");
+
+    QRegularExpressionCache::resetStatistics();
+    QRegularExpression("abc").optimize();
+    QRegularExpression("abc").optimize();
+    QCOMPARE(QRegularExpressionCache::hitCount(), quint64(0));
+    QCOMPARE(QRegularExpressionCache::missCount(), quint64(2));
+}
+
+void tst_QRegularExpression::serializeCompiledPatterns()
+{
+    const QList<QRegularExpression> expressions = {
+        QRegularExpression("^(?<year>\\d{4})-(?<month>\\d{2})$"),
+        QRegularExpression("[a-z]+", QRegularExpression::CaseInsensitiveOption),
+        QRegularExpression("("),
+    };
+
+    const QByteArray data = QRegularExpressionCache::serialize(expressions);
+    QVERIFY(!data.isEmpty());
+
+    QRegularExpressionCache::clear();
+    QRegularExpressionCache::resetStatistics();
+    QCOMPARE(QRegularExpressionCache::deserialize(data), 2);
+    QCOMPARE(QRegularExpressionCache::size(), 2);
+    QCOMPARE(QRegularExpressionCache::missCount(), quint64(0));
+
+    const QRegularExpression date("^(?<year>\\d{4})-(?<month>\\d{2})$");
+    const QRegularExpressionMatch match = date.match("2022-05");
+    QCOMPARE(QRegularExpressionCache::hitCount(), quint64(1));
+    QCOMPARE(QRegularExpressionCache::missCount(), quint64(0));
+    QCOMPARE(match.captured("month"), u"05");
+    QCOMPARE(date.namedCaptureGroups(), QStringList({ QString(), "year", "month" }));
+
+    const QRegularExpression word("[a-z]+", QRegularExpression::CaseInsensitiveOption);
+    QCOMPARE(word.match("12 AbC").captured(), u"AbC");
+    QCOMPARE(QRegularExpressionCache::hitCount(), quint64(2));
+
+    QCOMPARE(QRegularExpressionCache::deserialize(QByteArray()), -1);
+    QCOMPARE(QRegularExpressionCache::deserialize(data.left(data.size() / 2)), -1);
+    QByteArray wrongMagic = data;
+    wrongMagic[0] = 'x';
+    QCOMPARE(QRegularExpressionCache::deserialize(wrongMagic), -1);
+}
+
 void tst_QRegularExpression::returnsViewsIntoOriginalString()
 {
     // https://bugreports.qt.io/browse/QTBUG-98653
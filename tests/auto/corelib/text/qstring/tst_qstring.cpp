@@ -542,6 +542,7 @@ private slots:
     void number_double();
     void number_base_data();
     void number_base();
+    void appendNumber();
     void doubleOut();
     void arg_fillChar_data();
     void arg_fillChar();
@@ -5412,6 +5413,11 @@ void tst_QString::number_double()
         }
     }
     QTEST(QString::number(value, format, precision), "expected");
+
+    QFETCH(QString, expected);
+    QString appended(QStringLiteral("x="));
+    appended.appendNumber(value, format, precision);
+    QCOMPARE(appended, QStringLiteral("x=") + expected);
 }
 
 void tst_QString::number_base_data()
@@ -5474,6 +5480,34 @@ void tst_QString::number_base()
         QVERIFY(ok);
         QCOMPARE(n, result);
     }
+
+    QString appended(QStringLiteral("n="));
+    appended.appendNumber(n, base);
+    QCOMPARE(appended, QStringLiteral("n=") + expected);
+}
+
+void tst_QString::appendNumber()
+{
+    QString csv;
+    csv.appendNumber(42).append(u',').appendNumber(-7LL).append(u',')
+            .appendNumber(std::numeric_limits<qulonglong>::max()).append(u',')
+            .appendNumber(255u, 16).append(u',').appendNumber(short(-3)).append(u',')
+            .appendNumber(std::numeric_limits<qlonglong>::min()).append(u',')
+            .appendNumber(0.25).append(u',').appendNumber(1.5f, 'f', 2).append(u',')
+            .appendNumber(-qInf(), 'g').append(u',').appendNumber(qQNaN(), 'E');
+    QCOMPARE(csv, QStringLiteral("42,-7,18446744073709551615,ff,-3,-9223372036854775808,0.25,1.50,-inf,NAN"));
+
+    // Appending many values must give the same text as joining number()
+    QString appended;
+    QString joined;
+    for (int i = -500; i < 500; ++i) {
+        const double value = i * 1.25e-3;
+        appended.appendNumber(i * 7919).append(u' ')
+                .appendNumber(value, 'g', QLocale::FloatingPointShortest).append(u'\n');
+        joined += QString::number(i * 7919) + u' '
+                + QString::number(value, 'g', QLocale::FloatingPointShortest) + u'\n';
+    }
+    QCOMPARE(appended, joined);
 }
 
 void tst_QString::doubleOut()
@@ -61,6 +61,9 @@ private slots:
     void utf8stateful_data();
     void utf8stateful();
 
+    void utf8LongText_data();
+    void utf8LongText();
+
     void utfHeaders_data();
     void utfHeaders();
 
@@ -1477,6 +1480,166 @@ void tst_QStringConverter::utf8stateful()
     }
 }
 
+// A straightforward UTF-8 decoder, which replaces each byte that doesn't
+// start a well-formed sequence with U+FFFD
+static QString referenceFromUtf8(QByteArrayView utf8, bool *valid)
+{
+    QString result;
+    *valid = true;
+    for (qsizetype i = 0; i < utf8.size(); ) {
+        const uchar lead = uchar(utf8.at(i));
+        const int size = lead < 0x80 ? 1 : lead < 0xc0 ? 0 : lead < 0xe0 ? 2 : lead < 0xf0 ? 3
+                : lead < 0xf8 ? 4 : 0;
+        char32_t ucs4 = size == 1 ? lead : lead & (0x7f >> size);
+        bool ok = size > 0 && i + size <= utf8.size();
+        for (int j = 1; ok && j < size; ++j) {
+            const uchar continuation = uchar(utf8.at(i + j));
+            ok = (continuation & 0xc0) == 0x80;
+            ucs4 = ucs4 << 6 | (continuation & 0x3f);
+        }
+        const char32_t minimum[] = { 0, 0, 0x80, 0x800, 0x10000 };
+        ok = ok && ucs4 >= minimum[size] && ucs4 <= 0x10ffff
+                && !QChar::isSurrogate(ucs4);
+        if (!ok) {
+            result += QChar::ReplacementCharacter;
+            *valid = false;
+            ++i;
+            continue;
+        }
+        result += QStringView(QChar::fromUcs4(ucs4));
+        i += size;
+    }
+    return result;
+}
+
+// The matching encoder, which replaces lone surrogates with '?'
+static QByteArray referenceToUtf8(QStringView utf16)
+{
+    QByteArray result;
+    for (qsizetype i = 0; i < utf16.size(); ++i) {
+        char32_t ucs4 = utf16.at(i).unicode();
+        if (QChar::isHighSurrogate(ucs4) && i + 1 < utf16.size()
+                && utf16.at(i + 1).isLowSurrogate()) {
+            ucs4 = QChar::surrogateToUcs4(char16_t(ucs4), utf16.at(++i).unicode());
+        } else if (QChar::isSurrogate(ucs4)) {
+            result += '?';
+            continue;
+        }
+
+        if (ucs4 < 0x80) {
+            result += char(ucs4);
+        } else if (ucs4 < 0x800) {
+            result += char(0xc0 | ucs4 >> 6);
+            result += char(0x80 | (ucs4 & 0x3f));
+        } else if (ucs4 < 0x10000) {
+            result += char(0xe0 | ucs4 >> 12);
+            result += char(0x80 | (ucs4 >> 6 & 0x3f));
+            result += char(0x80 | (ucs4 & 0x3f));
+        } else {
+            result += char(0xf0 | ucs4 >> 18);
+            result += char(0x80 | (ucs4 >> 12 & 0x3f));
+            result += char(0x80 | (ucs4 >> 6 & 0x3f));
+            result += char(0x80 | (ucs4 & 0x3f));
+        }
+    }
+    return result;
+}
+
+void tst_QStringConverter::utf8LongText_data()
+{
+    // Long runs of non-ASCII text are decoded and encoded many characters at
+    // a time; errors anywhere in them must be handled as in short strings.
+    QTest::addColumn<QByteArray>("utf8");
+    QTest::addColumn<QString>("utf16");
+
+    const auto repeated = [](QStringView sample) {
+        QString text;
+        while (text.size() < 100)
+            text += sample;
+        return text;
+    };
+    const QString samples[] = {
+        repeated(u"Ελληνικά και русский текст "),
+        repeated(u"中文字符和日本語のテキスト "),
+        repeated(u"mostly ASCII with an occasional é or ü "),
+        repeated(u"߿ࠀ￿﻿퟿"),
+        repeated(u"4-byte: 😀 mixed 🙃 with κείμενο 中文 "),
+    };
+
+    for (const QString &sample : samples) {
+        const QByteArray utf8 = sample.toUtf8();
+        const QByteArray name = utf8.left(6).toHex();
+        QTest::addRow("valid-%s", name.constData()) << utf8 << sample;
+
+        // each kind of error at every offset in the first two blocks
+        for (int offset = 0; offset < 36; ++offset) {
+            QByteArray data = utf8;
+            data[offset] = char(0x80);
+            QTest::addRow("continuation-%s-%d", name.constData(), offset) << data << QString();
+
+            data = utf8;
+            data.insert(offset, "\xe4\xb8");
+            QTest::addRow("truncated-%s-%d", name.constData(), offset) << data << QString();
+
+            data = utf8;
+            data.insert(offset, "\xed\xa0\x80");
+            QTest::addRow("surrogate-%s-%d", name.constData(), offset) << data << QString();
+
+            data = utf8;
+            data.insert(offset, "\xe0\x9f\xbf");
+            QTest::addRow("overlong3-%s-%d", name.constData(), offset) << data << QString();
+
+            data = utf8;
+            data.insert(offset, "\xc1\xbf");
+            QTest::addRow("overlong2-%s-%d", name.constData(), offset) << data << QString();
+
+            data = utf8;
+            data.insert(offset, "\xf4\x90\x80\x80");
+            QTest::addRow("too-large-%s-%d", name.constData(), offset) << data << QString();
+
+            data = utf8.left(offset + 17);
+            QTest::addRow("cut-%s-%d", name.constData(), offset) << data << QString();
+
+            QString text = sample;
+            text[offset] = QChar(0xdc00);
+            QTest::addRow("lone-surrogate-%s-%d", name.constData(), offset)
+                    << QByteArray() << text;
+        }
+    }
+}
+
+void tst_QStringConverter::utf8LongText()
+{
+    QFETCH(QByteArray, utf8);
+    QFETCH(QString, utf16);
+
+    if (!utf8.isNull()) {
+        bool valid;
+        const QString expected = referenceFromUtf8(utf8, &valid);
+        if (!utf16.isNull())
+            QCOMPARE(expected, utf16);
+
+        QCOMPARE(QString::fromUtf8(utf8), expected);
+        QCOMPARE(utf8.isValidUtf8(), valid);
+
+        QStringDecoder decoder(QStringDecoder::Utf8, QStringDecoder::Flag::Stateless);
+        QCOMPARE(QString(decoder(utf8)), expected);
+        QCOMPARE(decoder.hasError(), !valid);
+    }
+
+    if (!utf16.isNull()) {
+        const QByteArray expected = referenceToUtf8(utf16);
+        if (!utf8.isNull())
+            QCOMPARE(expected, utf8);
+
+        QCOMPARE(utf16.toUtf8(), expected);
+
+        QStringEncoder encoder(QStringEncoder::Utf8);
+        const QByteArray encoded = encoder(utf16);
+        QCOMPARE(encoded, QByteArray(expected).replace('?', "\xef\xbf\xbd"));
+    }
+}
+
 void tst_QStringConverter::utfHeaders_data()
 {
     QTest::addColumn<QStringConverter::Encoding>("encoding");
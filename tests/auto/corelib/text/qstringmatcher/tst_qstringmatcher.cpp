@@ -28,6 +28,7 @@
 
 #include <QTest>
 #include <qstringmatcher.h>
+#include <QRandomGenerator>
 
 class tst_QStringMatcher : public QObject
 {
@@ -41,6 +42,10 @@ private slots:
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
+    void multiStringMatcher_data();
+    void multiStringMatcher();
+    void multiStringMatcherReference_data();
+    void multiStringMatcherReference();
 };
 
 void tst_QStringMatcher::qstringmatcher()
@@ -148,6 +153,127 @@ void tst_QStringMatcher::assignOperator()
     QCOMPARE(m2.indexIn(hayStack), 3);
 }
 
+static QString describeMatches(const QList<QMultiStringMatcher::Match> &matches)
+{
+    QString result;
+    for (const auto &match : matches)
+        result += QString::asprintf("%lld:%lld:%lld ", qlonglong(match.position),
+                                    qlonglong(match.length), qlonglong(match.patternIndex));
+    return result;
+}
+
+void tst_QStringMatcher::multiStringMatcher_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<QString>("first");
+    QTest::addColumn<QString>("all");
+
+    const QStringList words = { "he", "she", "his", "hers" };
+    QTest::newRow("empty") << QStringList() << QString("ushers") << Qt::CaseSensitive
+                           << QString("-1:0:-1 ") << QString();
+    QTest::newRow("overlapping") << words << QString("ushers") << Qt::CaseSensitive
+                                 << QString("1:3:1 ") << QString("1:3:1 2:2:0 2:4:3 ");
+    QTest::newRow("sensitive") << words << QString("uSHErs") << Qt::CaseSensitive
+                               << QString("-1:0:-1 ") << QString();
+    QTest::newRow("insensitive") << words << QString("uSHErs") << Qt::CaseInsensitive
+                                 << QString("1:3:1 ") << QString("1:3:1 2:2:0 2:4:3 ");
+    QTest::newRow("non-latin1") << QStringList{ u"αβ"_qs, u"βγ"_qs, u"xα"_qs }
+                                << u"-xαβγ"_qs << Qt::CaseSensitive
+                                << QString("1:2:2 ") << QString("1:2:2 2:2:0 3:2:1 ");
+    QTest::newRow("greek-insensitive") << QStringList{ u"ΣΟΦ"_qs }
+                                       << u"σοφία"_qs << Qt::CaseInsensitive
+                                       << QString("0:3:0 ") << QString("0:3:0 ");
+    // U+212A KELVIN SIGN folds to 'k', so it disables the Latin-1 prefilter
+    QTest::newRow("kelvin") << QStringList{ "kb", "xyz" } << u"1 \u212Ab, 2 KB"_qs
+                            << Qt::CaseInsensitive
+                            << QString("2:2:0 ") << QString("2:2:0 8:2:0 ");
+    QTest::newRow("surrogates") << QStringList{ u"\U0001F600"_qs, u"a\U0001F600"_qs }
+                                << u"a\U0001F600\U0001F600"_qs << Qt::CaseSensitive
+                                << QString("0:3:1 ") << QString("0:3:1 1:2:0 3:2:0 ");
+}
+
+void tst_QStringMatcher::multiStringMatcher()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QString, haystack);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QString, first);
+    QFETCH(QString, all);
+
+    QMultiStringMatcher matcher(patterns, cs);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.caseSensitivity(), cs);
+    QCOMPARE(describeMatches({ matcher.indexIn(haystack) }), first);
+    QCOMPARE(describeMatches({ matcher.indexIn(QStringView(haystack)) }), first);
+    QCOMPARE(describeMatches(matcher.indexesIn(haystack)), all);
+
+    QMultiStringMatcher other;
+    other.setCaseSensitivity(cs);
+    other.setPatterns(patterns);
+    QCOMPARE(describeMatches(other.indexesIn(QStringView(haystack))), all);
+}
+
+void tst_QStringMatcher::multiStringMatcherReference_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QString>("alphabet");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    const QStringList latin1 = { "ab", "ba", "abc", "cab", "éa" };
+    // first characters in Latin-1, so that the prefilter is used on text
+    // with characters it has to saturate
+    const QStringList mixed = { "ab", u"aα"_qs, u"bαα"_qs, "b" };
+    QTest::newRow("latin1") << latin1 << QString("abcABéÉ") << Qt::CaseSensitive;
+    QTest::newRow("latin1-ci") << latin1 << QString("abcABéÉ") << Qt::CaseInsensitive;
+    QTest::newRow("mixed") << mixed << u"abAB\u03b1\u0391\u0100\uffff"_qs << Qt::CaseSensitive;
+    QTest::newRow("mixed-ci") << mixed << u"abAB\u03b1\u0391\u0100\uffff"_qs << Qt::CaseInsensitive;
+}
+
+void tst_QStringMatcher::multiStringMatcherReference()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QString, alphabet);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    // long enough for the SIMD prefilter to see full blocks and a tail
+    QRandomGenerator rng(2022);
+    QMultiStringMatcher matcher(patterns, cs);
+    for (int round = 0; round < 20; ++round) {
+        QString data(200 + rng.bounded(50), Qt::Uninitialized);
+        for (QChar &c : data)
+            c = rng.bounded(4) ? u'.' : alphabet.at(rng.bounded(int(alphabet.size())));
+
+        QList<QMultiStringMatcher::Match> expected;
+        for (qsizetype pos = 0; pos < data.size(); ++pos) {
+            QList<QMultiStringMatcher::Match> here;
+            for (qsizetype i = 0; i < patterns.size(); ++i) {
+                const QString &pattern = patterns.at(i);
+                if (QStringView(data).mid(pos).startsWith(pattern, cs))
+                    here.append({ pos, pattern.size(), i });
+            }
+            std::sort(here.begin(), here.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.length < rhs.length;
+            });
+            expected += here;
+        }
+        QCOMPARE(describeMatches(matcher.indexesIn(data)), describeMatches(expected));
+
+        for (qsizetype from = 0; from <= data.size(); from += 7) {
+            QMultiStringMatcher::Match leftmost;
+            for (const auto &match : expected) {
+                if (match.position >= from
+                        && (!leftmost.isValid() || match.position == leftmost.position)) {
+                    leftmost = match;
+                }
+            }
+            QCOMPARE(describeMatches({ matcher.indexIn(data, from) }),
+                     describeMatches({ leftmost }));
+        }
+    }
+}
+
 QTEST_MAIN(tst_QStringMatcher)
 #include "tst_qstringmatcher.moc"
 
@@ -108,6 +108,10 @@ private slots:
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
     void threadReuse();
+    void workStealingNestedStart();
+    void workStealingPriority();
+    void workStealingTryTake();
+    void workStealingClear();
 
 private:
     QMutex m_functionTestMutex;
@@ -1460,5 +1464,80 @@ void tst_QThreadPool::threadReuse()
     }
 }
 
+void tst_QThreadPool::workStealingNestedStart()
+{
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(4);
+    threadPool.setWorkStealingEnabled(true);
+    QVERIFY(threadPool.isWorkStealingEnabled());
+
+    // more nested runnables than fit into a worker's run queue
+    constexpr int outerCount = 20;
+    constexpr int innerCount = 500;
+    QAtomicInt counter;
+    for (int i = 0; i < outerCount; ++i) {
+        threadPool.start([&threadPool, &counter] {
+            for (int j = 0; j < innerCount; ++j)
+                threadPool.start([&counter] { counter.ref(); });
+        });
+    }
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(counter.loadRelaxed(), outerCount * innerCount);
+    QCOMPARE(threadPool.activeThreadCount(), 0);
+}
+
+void tst_QThreadPool::workStealingPriority()
+{
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    QList<int> order;
+    threadPool.start([&threadPool, &order] {
+        // goes into this worker's run queue
+        threadPool.start([&order] { order.append(0); });
+        // goes into the shared queue, and must be taken first
+        threadPool.start([&order] { order.append(1); }, 1);
+    });
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(order, QList<int>({ 1, 0 }));
+}
+
+void tst_QThreadPool::workStealingTryTake()
+{
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    QAtomicInt ran;
+    auto runnable = QRunnable::create([&ran] { ran.ref(); });
+    runnable->setAutoDelete(false);
+    bool taken = false;
+    threadPool.start([&] {
+        threadPool.start(runnable);
+        taken = threadPool.tryTake(runnable);
+    });
+    QVERIFY(threadPool.waitForDone());
+    QVERIFY(taken);
+    QCOMPARE(ran.loadRelaxed(), 0);
+    delete runnable;
+}
+
+void tst_QThreadPool::workStealingClear()
+{
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    QAtomicInt ran;
+    threadPool.start([&threadPool, &ran] {
+        for (int i = 0; i < 10; ++i)
+            threadPool.start([&ran] { ran.ref(); });
+        threadPool.clear();
+    });
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(ran.loadRelaxed(), 0);
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
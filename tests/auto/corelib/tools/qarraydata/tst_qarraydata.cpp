@@ -30,6 +30,7 @@
 #include <QTest>
 #include <QtCore/QString>
 #include <QtCore/qarraydata.h>
+#include <QtCore/private/qarraydataarena_p.h>
 
 #include "simplevector.h"
 
@@ -41,6 +42,7 @@
 #include <stdexcept>
 #include <functional>
 #include <memory>
+#include <thread>
 
 // A wrapper for a test function. Calls a function, if it fails, reports failure
 #define RUN_TEST_FUNC(test, ...) \
@@ -89,6 +91,11 @@ private slots:
     void relocateWithExceptions_data();
     void relocateWithExceptions();
 #endif // QT_NO_EXCEPTIONS
+    void arenaAllocation();
+    void arenaGrowth();
+    void arenaOutlivesScope();
+    void arenaNested();
+    void arenaOtherThreads();
 };
 
 template <class T> const T &const_(const T &t) { return t; }
@@ -2557,5 +2564,166 @@ void tst_QArrayData::relocateWithExceptions()
 }
 #endif // QT_NO_EXCEPTIONS
 
+template <typename Container>
+static bool isArenaAllocated(Container &c)
+{
+    const QArrayData *d = c.data_ptr().d_ptr();
+    return d && QArrayDataArena::owns(d);
+}
+
+void tst_QArrayData::arenaAllocation()
+{
+    QVERIFY(!QArrayDataArena::current());
+    {
+        QArrayDataArena arena;
+        QCOMPARE(QArrayDataArena::current(), &arena);
+
+        QByteArray ba(100, 'a');
+        QString str(100, u'b');
+        QList<int> list(100, 42);
+        QVERIFY(isArenaAllocated(ba));
+        QVERIFY(isArenaAllocated(str));
+        // arena membership is not recorded in the header
+        QCOMPARE(ba.data_ptr().flags(), QArrayData::ArrayOptions());
+        QCOMPARE(ba, QByteArray(100, 'a'));
+        QCOMPARE(str, QString(100, u'b'));
+        QCOMPARE(list.count(42), 100);
+
+        // large blocks come from the heap
+        QByteArray large(QArrayDataArena::DefaultChunkSize, 'c');
+        QVERIFY(!isArenaAllocated(large));
+
+        // allocations spanning more than one chunk
+        QList<QByteArray> many;
+        for (int i = 0; i < 10000; ++i)
+            many.append(QByteArray::number(i));
+        for (int i = 0; i < 10000; ++i) {
+            QVERIFY(isArenaAllocated(many[i]));
+            QCOMPARE(many.at(i), QByteArray::number(i));
+        }
+    }
+    QVERIFY(!QArrayDataArena::current());
+
+    QByteArray ba(100, 'a');
+    QVERIFY(!isArenaAllocated(ba));
+}
+
+void tst_QArrayData::arenaGrowth()
+{
+    QArrayDataArena arena;
+
+    // the last block of the chunk grows in place
+    QByteArray ba;
+    for (int i = 0; i < 1000; ++i)
+        ba.append(char('a' + i % 26));
+    QVERIFY(isArenaAllocated(ba));
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(ba.at(i), char('a' + i % 26));
+
+    // other blocks are copied
+    QString a, b;
+    for (int i = 0; i < 500; ++i) {
+        a.append(QChar(u'a' + i % 26));
+        b.append(QChar(u'A' + i % 26));
+    }
+    QCOMPARE(a.size(), 500);
+    QCOMPARE(b.size(), 500);
+    for (int i = 0; i < 500; ++i) {
+        QCOMPARE(a.at(i), QChar(u'a' + i % 26));
+        QCOMPARE(b.at(i), QChar(u'A' + i % 26));
+    }
+
+    // growing past the size of arena blocks moves to the heap
+    ba.resize(QArrayDataArena::DefaultChunkSize);
+    QVERIFY(!isArenaAllocated(ba));
+    QCOMPARE(ba.at(999), char('a' + 999 % 26));
+
+    a.squeeze();
+    QCOMPARE(a.at(499), QChar(u'a' + 499 % 26));
+}
+
+void tst_QArrayData::arenaOutlivesScope()
+{
+    QByteArray ba;
+    QString str;
+    QList<QString> list;
+    {
+        QArrayDataArena arena;
+        ba = QByteArray("Hello, arena");
+        str = QStringLiteral("Hello, ") + QString::number(42);
+        for (int i = 0; i < 100; ++i)
+            list.append(QString::number(i));
+        QVERIFY(isArenaAllocated(ba));
+        QVERIFY(isArenaAllocated(str));
+        QVERIFY(isArenaAllocated(list.last()));
+    }
+    QCOMPARE(ba, QByteArray("Hello, arena"));
+    QCOMPARE(str, QStringLiteral("Hello, 42"));
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(list.at(i), QString::number(i));
+
+    // detaching and growing after the scope falls back to the heap
+    QByteArray copy = ba;
+    copy[0] = 'h';
+    QVERIFY(!isArenaAllocated(copy));
+    QCOMPARE(copy, QByteArray("hello, arena"));
+    QVERIFY(isArenaAllocated(ba));
+
+    str.append(QString(100, u'!'));
+    QVERIFY(!isArenaAllocated(str));
+    QVERIFY(str.startsWith(QStringLiteral("Hello, 42!")));
+    list.append(QStringLiteral("last"));
+    QCOMPARE(list.size(), 101);
+    QCOMPARE(list.at(99), QStringLiteral("99"));
+}
+
+void tst_QArrayData::arenaNested()
+{
+    QByteArray outer, inner, after;
+    {
+        QArrayDataArena arena1;
+        outer = QByteArray(10, 'o');
+        {
+            QArrayDataArena arena2(4096);
+            QCOMPARE(QArrayDataArena::current(), &arena2);
+            inner = QByteArray(10, 'i');
+        }
+        QCOMPARE(QArrayDataArena::current(), &arena1);
+        after = QByteArray(10, 'a');
+        QVERIFY(isArenaAllocated(after));
+    }
+    QCOMPARE(outer, QByteArray(10, 'o'));
+    QCOMPARE(inner, QByteArray(10, 'i'));
+    QCOMPARE(after, QByteArray(10, 'a'));
+}
+
+void tst_QArrayData::arenaOtherThreads()
+{
+    QList<QByteArray> list;
+    {
+        QArrayDataArena arena;
+        for (int i = 0; i < 1000; ++i)
+            list.append(QByteArray::number(i));
+
+        // other threads don't use this thread's arena
+        bool otherAllocated = true;
+        std::thread([&] {
+            QByteArray ba(10, 'x');
+            otherAllocated = isArenaAllocated(ba);
+        }).join();
+        QVERIFY(!otherAllocated);
+    }
+
+    // data allocated in an arena can be released on any thread
+    bool intact = false;
+    std::thread([&intact, list = std::move(list)]() mutable {
+        intact = true;
+        for (int i = 0; i < 1000; ++i)
+            intact = intact && list.at(i) == QByteArray::number(i);
+        list.clear();
+    }).join();
+    QVERIFY(intact);
+}
+
 QTEST_APPLESS_MAIN(tst_QArrayData)
 #include "tst_qarraydata.moc"
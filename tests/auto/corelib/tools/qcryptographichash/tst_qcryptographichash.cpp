@@ -31,6 +31,8 @@
 #include <QTest>
 #include <QScopeGuard>
 #include <QCryptographicHash>
+#include <QTemporaryFile>
+#include <QThreadPool>
 #include <QtCore/QMetaEnum>
 
 #if QT_CONFIG(cxx11_future)
@@ -52,8 +54,13 @@ private slots:
     void sha3();
     void blake2_data();
     void blake2();
+    void blake3_data();
+    void blake3();
+    void blake3Parallel();
     void files_data();
     void files();
+    void largeFile_data();
+    void largeFile();
     void hashLength_data();
     void hashLength();
     // keep last
@@ -379,6 +386,88 @@ void tst_QCryptographicHash::blake2()
     QCOMPARE(result, expectedResult);
 }
 
+// the input of the official BLAKE3 test vectors
+static QByteArray blake3Input(qsizetype size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; ++i)
+        data[i] = char(i % 251);
+    return data;
+}
+
+void tst_QCryptographicHash::blake3_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+#define ROW(Size, Result) \
+    QTest::addRow("%d", Size) << Size << QByteArray::fromHex(Result)
+
+    ROW(0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262");
+    ROW(1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213");
+    ROW(1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11");
+    ROW(1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7");
+    ROW(1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444");
+    ROW(2048, "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a");
+    ROW(2049, "5f4d72f40d7a5f82b15ca2b2e44b1de3c2ef86c426c95c1af0b6879522563030");
+    ROW(3072, "b98cb0ff3623be03326b373de6b9095218513e64f1ee2edd2525c7ad1e5cffd2");
+    ROW(3073, "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3");
+    ROW(4096, "015094013f57a5277b59d8475c0501042c0b642e531b0a1c8f58d2163229e969");
+    ROW(4097, "9b4052b38f1c5fc8b1f9ff7ac7b27cd242487b3d890d15c96a1c25b8aa0fb995");
+    ROW(5120, "9cadc15fed8b5d854562b26a9536d9707cadeda9b143978f319ab34230535833");
+    ROW(5121, "628bd2cb2004694adaab7bbd778a25df25c47b9d4155a55f8fbd79f2fe154cff");
+    ROW(6144, "3e2e5b74e048f3add6d21faab3f83aa44d3b2278afb83b80b3c35164ebeca205");
+    ROW(6145, "f1323a8631446cc50536a9f705ee5cb619424d46887f3c376c695b70e0f0507f");
+    ROW(7168, "61da957ec2499a95d6b8023e2b0e604ec7f6b50e80a9678b89d2628e99ada77a");
+    ROW(7169, "a003fc7a51754a9b3c7fae0367ab3d782dccf28855a03d435f8cfe74605e7817");
+    ROW(8192, "aae792484c8efe4f19e2ca7d371d8c467ffb10748d8a5a1ae579948f718a2a63");
+    ROW(8193, "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b");
+    ROW(16384, "f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4");
+    ROW(31744, "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47");
+    ROW(102400, "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085");
+
+#undef ROW
+}
+
+void tst_QCryptographicHash::blake3()
+{
+    QFETCH(int, size);
+    QFETCH(QByteArray, expectedResult);
+
+    const QByteArray data = blake3Input(size);
+    QCOMPARE(QCryptographicHash::hash(data, QCryptographicHash::Blake3_256), expectedResult);
+
+    // the same tree must result when the input arrives in pieces
+    for (int pieceSize : { 1, 63, 1000, 1025, 3000 }) {
+        QCryptographicHash hash(QCryptographicHash::Blake3_256);
+        for (int i = 0; i < size; i += pieceSize)
+            hash.addData(QByteArrayView(data).sliced(i, qMin(pieceSize, size - i)));
+        QCOMPARE(hash.result(), expectedResult);
+    }
+}
+
+void tst_QCryptographicHash::blake3Parallel()
+{
+    // large enough to be split across the threads
+    const QByteArray data = blake3Input(8 * 1024 * 1024 + 1);
+    const QByteArray expected =
+            QByteArray::fromHex("249ef5d5043bde86396029c96497c8ac6c0e7f2f5ef97b7f9afabdf23167b7fb");
+
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    const int maxThreadCount = threadPool->maxThreadCount();
+    const auto restore = qScopeGuard([&] { threadPool->setMaxThreadCount(maxThreadCount); });
+    for (int threads : { 1, 2, 3, 8 }) {
+        threadPool->setMaxThreadCount(threads);
+        QCOMPARE(QCryptographicHash::hash(data, QCryptographicHash::Blake3_256), expected);
+
+        // a subtree in the middle of the input
+        QCryptographicHash hash(QCryptographicHash::Blake3_256);
+        hash.addData(QByteArrayView(data).first(5000));
+        hash.addData(QByteArrayView(data).sliced(5000));
+        QCOMPARE(hash.result(), expected);
+    }
+}
+
 void tst_QCryptographicHash::files_data() {
     QTest::addColumn<QString>("filename");
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
@@ -408,6 +497,57 @@ void tst_QCryptographicHash::files()
     }
 }
 
+void tst_QCryptographicHash::largeFile_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("fromStart");
+    QTest::addColumn<QByteArray>("fromOffset");
+
+    QTest::newRow("sha1") << QCryptographicHash::Sha1
+                          << QByteArray("da6de52b0377c05cb5717f7517861dc0eb7ba169")
+                          << QByteArray("0e1a4273ba9d1766584e6fa604f5bc8939df63ce");
+    QTest::newRow("sha224") << QCryptographicHash::Sha224
+                            << QByteArray("07463d97a0c72d2d6b07de8bc122030b1b112ada46e3dbb6d1e70e31")
+                            << QByteArray("08ca94eb207317eed502e5acf844c1a1ae11fbc98410c43e6d5092cd");
+    QTest::newRow("sha256")
+            << QCryptographicHash::Sha256
+            << QByteArray("fe2aaf82bfa2ffec207a0c6fa7ce7d4af268d67e2672fdaec675f3f9b65d0854")
+            << QByteArray("4bc965a5673ce75711d7c84203987dc835554b1716c4f61738fb7d5cca66194e");
+    QTest::newRow("blake3")
+            << QCryptographicHash::Blake3_256
+            << QByteArray("26003c63117013de5d02be76e5e32a2f75bfbc075f17180fd5f9f0b4752d2bfe")
+            << QByteArray("e90e49fe7aa4ff1a2c17846c249cc757867e299c97624b74f42629603a6d2ef1");
+}
+
+void tst_QCryptographicHash::largeFile()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(QByteArray, fromStart);
+    QFETCH(QByteArray, fromOffset);
+
+    // large enough to be mapped into memory
+    const QByteArray data = blake3Input(3 * 1024 * 1024 + 17);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), qint64(data.size()));
+    QVERIFY(file.seek(0));
+
+    QCryptographicHash hash(algorithm);
+    QVERIFY(hash.addData(&file));
+    QCOMPARE(hash.result().toHex(), fromStart);
+    QVERIFY(file.atEnd());
+
+    // what was read already is not hashed
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.read(100), data.first(100));
+    hash.reset();
+    QVERIFY(hash.addData(&file));
+    QCOMPARE(hash.result().toHex(), fromOffset);
+
+    // same as without the file
+    QCOMPARE(QCryptographicHash::hash(data.sliced(100), algorithm).toHex(), fromOffset);
+}
+
 void tst_QCryptographicHash::hashLength_data()
 {
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
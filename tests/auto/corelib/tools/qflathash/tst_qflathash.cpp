@@ -0,0 +1,417 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+
+#include <private/qflathash_p.h>
+#include <qhash.h>
+#include <qstring.h>
+
+#include <algorithm>
+#include <random>
+
+namespace {
+// all keys collide in the control bytes and in the first probed group
+struct BadKey
+{
+    int k;
+    friend bool operator==(BadKey lhs, BadKey rhs) { return lhs.k == rhs.k; }
+    friend size_t qHash(BadKey, size_t) { return 0; }
+};
+
+struct Counted
+{
+    static int instances;
+    int v = 0;
+    Counted(int v = 0) : v(v) { ++instances; }
+    Counted(const Counted &other) : v(other.v) { ++instances; }
+    ~Counted() { --instances; }
+    Counted &operator=(const Counted &) = default;
+    friend bool operator==(const Counted &lhs, const Counted &rhs) { return lhs.v == rhs.v; }
+};
+int Counted::instances = 0;
+}
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void empty();
+    void insertAndLookup();
+    void stringKeys();
+    void operatorBracket();
+    void remove();
+    void churn();
+    void collisions();
+    void take();
+    void iterators();
+    void erase();
+    void implicitSharing();
+    void reserveAndSqueeze();
+    void equality();
+    void nodeLifetime();
+    void groupMatch();
+};
+
+void tst_QFlatHash::empty()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.size(), 0);
+    QCOMPARE(hash.capacity(), 0);
+    QVERIFY(!hash.contains(1));
+    QCOMPARE(hash.value(1, 42), 42);
+    QVERIFY(!hash.remove(1));
+    QCOMPARE(hash.take(1), 0);
+    QVERIFY(hash.constBegin() == hash.constEnd());
+    QVERIFY(hash.find(1) == hash.end());
+    QVERIFY(!hash.isDetached());
+}
+
+void tst_QFlatHash::insertAndLookup()
+{
+    constexpr int N = 100000;
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < N; ++i) {
+        hash.insert(i * 7, i);
+        QCOMPARE(hash.size(), i + 1);
+    }
+    QVERIFY(hash.capacity() >= N);
+    for (int i = 0; i < N; ++i) {
+        QVERIFY(hash.contains(i * 7));
+        QCOMPARE(hash.value(i * 7), i);
+        QVERIFY(!hash.contains(i * 7 + 1));
+    }
+
+    // inserting an existing key replaces the value
+    hash.insert(7, -1);
+    QCOMPARE(hash.size(), N);
+    QCOMPARE(hash.value(7), -1);
+    auto it = hash.emplace(14, -2);
+    QCOMPARE(it.key(), 14);
+    QCOMPARE(it.value(), -2);
+    QCOMPARE(hash.size(), N);
+}
+
+void tst_QFlatHash::stringKeys()
+{
+    QFlatHash<QString, qsizetype> hash;
+    QHash<QString, qsizetype> reference;
+    for (int i = 0; i < 5000; ++i) {
+        const QString key = QString::number(i, 36) + QLatin1String("-key");
+        hash.insert(key, key.size());
+        reference.insert(key, key.size());
+    }
+    QCOMPARE(hash.size(), reference.size());
+    for (auto it = reference.cbegin(); it != reference.cend(); ++it)
+        QCOMPARE(hash.value(it.key(), -1), it.value());
+    QVERIFY(!hash.contains(QStringLiteral("not there")));
+}
+
+void tst_QFlatHash::operatorBracket()
+{
+    QFlatHash<int, QString> hash;
+    QCOMPARE(hash[1], QString());
+    QCOMPARE(hash.size(), 1);
+    hash[1] = QStringLiteral("one");
+    hash[2] += QStringLiteral("two");
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(1), QStringLiteral("one"));
+    QCOMPARE(hash.value(2), QStringLiteral("two"));
+
+    const auto &constHash = hash;
+    QCOMPARE(constHash[3], QString());
+    QCOMPARE(hash.size(), 2);
+}
+
+void tst_QFlatHash::remove()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    for (int i = 0; i < 1000; i += 2)
+        QVERIFY(hash.remove(i));
+    QVERIFY(!hash.remove(0));
+    QCOMPARE(hash.size(), 500);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.contains(i), i % 2 == 1);
+
+    for (int i = 0; i < 1000; i += 2)
+        hash.insert(i, -i);
+    QCOMPARE(hash.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(i), i % 2 ? i : -i);
+}
+
+void tst_QFlatHash::churn()
+{
+    // many removals and insertions at a constant size must not let the
+    // deleted markers fill up the table
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 20000);
+    QFlatHash<int, int> hash;
+    QHash<int, int> reference;
+    hash.reserve(1000);
+    const qsizetype capacity = hash.capacity();
+    for (int round = 0; round < 200000; ++round) {
+        const int key = dist(rng);
+        if (reference.size() < 1000) {
+            hash.insert(key, round);
+            reference.insert(key, round);
+        } else {
+            const int victim = reference.begin().key();
+            QCOMPARE(hash.remove(victim), reference.remove(victim));
+        }
+    }
+    QCOMPARE(hash.size(), reference.size());
+    QCOMPARE(hash.capacity(), capacity);
+    for (auto it = reference.cbegin(); it != reference.cend(); ++it)
+        QCOMPARE(hash.value(it.key(), -1), it.value());
+    qsizetype count = 0;
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it, ++count)
+        QCOMPARE(reference.value(it.key(), -1), it.value());
+    QCOMPARE(count, reference.size());
+}
+
+void tst_QFlatHash::collisions()
+{
+    QFlatHash<BadKey, int> hash;
+    for (int i = 0; i < 200; ++i)
+        hash.insert(BadKey{i}, i);
+    QCOMPARE(hash.size(), 200);
+    for (int i = 0; i < 200; ++i)
+        QCOMPARE(hash.value(BadKey{i}, -1), i);
+    for (int i = 0; i < 200; i += 3)
+        QVERIFY(hash.remove(BadKey{i}));
+    for (int i = 0; i < 200; ++i)
+        QCOMPARE(hash.contains(BadKey{i}), i % 3 != 0);
+    QVERIFY(!hash.contains(BadKey{1000}));
+}
+
+void tst_QFlatHash::take()
+{
+    QFlatHash<int, QString> hash;
+    hash.insert(1, QStringLiteral("one"));
+    hash.insert(2, QStringLiteral("two"));
+    QCOMPARE(hash.take(1), QStringLiteral("one"));
+    QCOMPARE(hash.take(1), QString());
+    QCOMPARE(hash.size(), 1);
+    QVERIFY(!hash.contains(1));
+    QVERIFY(hash.contains(2));
+}
+
+void tst_QFlatHash::iterators()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 500; ++i)
+        hash.insert(i, i * i);
+
+    QList<int> keys;
+    for (auto it = hash.begin(); it != hash.end(); ++it) {
+        QCOMPARE(it.value(), it.key() * it.key());
+        keys << it.key();
+        *it = -it.key();
+    }
+    std::sort(keys.begin(), keys.end());
+    QCOMPARE(keys.size(), 500);
+    for (int i = 0; i < 500; ++i)
+        QCOMPARE(keys.at(i), i);
+    for (int i = 0; i < 500; ++i)
+        QCOMPARE(hash.value(i), -i);
+
+    QList<int> sortedKeys = hash.keys();
+    std::sort(sortedKeys.begin(), sortedKeys.end());
+    QCOMPARE(sortedKeys, keys);
+    QCOMPARE(hash.values().size(), 500);
+
+    auto it = hash.find(42);
+    QVERIFY(it != hash.end());
+    QCOMPARE(it.key(), 42);
+    QVERIFY(hash.constFind(1000) == hash.constEnd());
+}
+
+void tst_QFlatHash::erase()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i);
+    for (auto it = hash.begin(); it != hash.end(); ) {
+        if (it.key() % 2)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(hash.size(), 50);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.contains(i), i % 2 == 0);
+}
+
+void tst_QFlatHash::implicitSharing()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i);
+
+    QFlatHash<int, int> copy = hash;
+    QVERIFY(copy.isSharedWith(hash));
+    QVERIFY(!hash.isDetached());
+
+    copy.insert(100, 100);
+    QVERIFY(!copy.isSharedWith(hash));
+    QCOMPARE(hash.size(), 100);
+    QCOMPARE(copy.size(), 101);
+    QVERIFY(!hash.contains(100));
+
+    copy = hash;
+    QVERIFY(copy.remove(5));
+    QVERIFY(hash.contains(5));
+    QVERIFY(!copy.contains(5));
+
+    copy = hash;
+    QCOMPARE(copy.take(6), 6);
+    QVERIFY(hash.contains(6));
+
+    copy = hash;
+    copy[7] = -7;
+    QCOMPARE(hash.value(7), 7);
+    QCOMPARE(copy.value(7), -7);
+
+    // lookups and removing keys that are not there don't detach
+    copy = hash;
+    QVERIFY(!copy.remove(1000));
+    QVERIFY(copy.isSharedWith(hash));
+    QCOMPARE(std::as_const(copy).find(5).value(), 5);
+    QVERIFY(copy.isSharedWith(hash));
+
+    // a key that refers into the container survives the detach
+    QFlatHash<QString, QString> strings;
+    strings.insert(QStringLiteral("a"), QStringLiteral("b"));
+    QFlatHash<QString, QString> stringsCopy = strings;
+    stringsCopy[std::as_const(stringsCopy).constBegin().value()] = QStringLiteral("c");
+    QCOMPARE(stringsCopy.size(), 2);
+    QCOMPARE(stringsCopy.value(QStringLiteral("b")), QStringLiteral("c"));
+    QCOMPARE(strings.size(), 1);
+
+    QFlatHash<int, int> moved = std::move(copy);
+    QVERIFY(moved.isSharedWith(hash));
+    moved.clear();
+    QVERIFY(moved.isEmpty());
+    QCOMPARE(hash.size(), 100);
+}
+
+void tst_QFlatHash::reserveAndSqueeze()
+{
+    QFlatHash<int, int> hash;
+    hash.reserve(1000);
+    QVERIFY(hash.capacity() >= 1000);
+    const qsizetype capacity = hash.capacity();
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity);
+
+    for (int i = 10; i < 1000; ++i)
+        hash.remove(i);
+    hash.squeeze();
+    QVERIFY(hash.capacity() < capacity);
+    QVERIFY(hash.capacity() >= 10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(hash.value(i, -1), i);
+
+    QFlatHash<int, int> copy = hash;
+    copy.reserve(2000);
+    QVERIFY(!copy.isSharedWith(hash));
+    QVERIFY(copy.capacity() >= 2000);
+    QCOMPARE(copy.size(), 10);
+}
+
+void tst_QFlatHash::equality()
+{
+    QFlatHash<int, int> a = { { 1, 1 }, { 2, 2 }, { 3, 3 } };
+    QFlatHash<int, int> b;
+    QVERIFY(a != b);
+    b.insert(3, 3);
+    b.insert(2, 2);
+    b.insert(1, 1);
+    QVERIFY(a == b);
+    b.insert(1, -1);
+    QVERIFY(a != b);
+    QVERIFY((QFlatHash<int, int>() == QFlatHash<int, int>()));
+}
+
+void tst_QFlatHash::nodeLifetime()
+{
+    {
+        QFlatHash<int, Counted> hash;
+        for (int i = 0; i < 1000; ++i)
+            hash.insert(i, Counted(i));
+        QCOMPARE(Counted::instances, 1000);
+        {
+            QFlatHash<int, Counted> copy = hash;
+            copy.insert(1000, Counted(1000));
+            QCOMPARE(Counted::instances, 2001);
+        }
+        QCOMPARE(Counted::instances, 1000);
+        for (int i = 0; i < 500; ++i)
+            hash.remove(i);
+        QCOMPARE(Counted::instances, 500);
+        hash.squeeze();
+        QCOMPARE(Counted::instances, 500);
+    }
+    QCOMPARE(Counted::instances, 0);
+}
+
+void tst_QFlatHash::groupMatch()
+{
+    using namespace QFlatHashPrivate;
+    std::mt19937 rng(42);
+    ctrl_t ctrl[Group::Width];
+    for (int round = 0; round < 1000; ++round) {
+        for (ctrl_t &c : ctrl) {
+            // mostly a few distinct values, so that matches are common
+            switch (rng() % 4) {
+            case 0: c = Empty; break;
+            case 1: c = Deleted; break;
+            default: c = ctrl_t(rng() % 4 == 0 ? 0x7f : rng() % 3); break;
+            }
+        }
+        const Group g(ctrl);
+        for (ctrl_t h : { ctrl_t(0), ctrl_t(1), ctrl_t(2), ctrl_t(0x7f), ctrl_t(Empty) }) {
+            uint expected = 0;
+            for (size_t i = 0; i < Group::Width; ++i)
+                expected |= uint(ctrl[i] == h) << i;
+            QCOMPARE(g.match(h).mask, expected);
+        }
+        uint emptyOrDeleted = 0;
+        for (size_t i = 0; i < Group::Width; ++i)
+            emptyOrDeleted |= uint(!isFull(ctrl[i])) << i;
+        QCOMPARE(g.matchEmptyOrDeleted().mask, emptyOrDeleted);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+#include "tst_qflathash.moc"
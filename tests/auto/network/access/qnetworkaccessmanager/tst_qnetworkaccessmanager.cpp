@@ -28,10 +28,59 @@
 
 #include <QTest>
 
+#include <QtNetwork/QHttpConnectionPoolConfiguration>
+#include <QtNetwork/QHttpConnectionPoolStatistics>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
 
 #include <QtCore/QDebug>
+#include <QtCore/QTimer>
+
+#include <memory>
+
+using namespace std::chrono_literals;
+
+// Answers every request with a short body after a delay and counts the
+// connections it accepts and the requests it has not answered yet.
+class PoolTestServer : public QTcpServer
+{
+public:
+    int acceptedConnections = 0;
+    int openConnections = 0;
+    int requests = 0;
+    int pendingResponses = 0;
+    int maximumPendingResponses = 0;
+    int responseDelay = 0;
+
+protected:
+    void incomingConnection(qintptr handle) override
+    {
+        auto socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(handle);
+        ++acceptedConnections;
+        ++openConnections;
+        auto buffer = std::make_shared<QByteArray>();
+        connect(socket, &QTcpSocket::readyRead, socket, [this, socket, buffer]() {
+            buffer->append(socket->readAll());
+            qsizetype end;
+            while ((end = buffer->indexOf("\r\n\r\n")) != -1) {
+                buffer->remove(0, end + 4);
+                ++requests;
+                maximumPendingResponses = qMax(maximumPendingResponses, ++pendingResponses);
+                QTimer::singleShot(responseDelay, socket, [this, socket]() {
+                    --pendingResponses;
+                    socket->write("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok");
+                });
+            }
+        });
+        connect(socket, &QTcpSocket::disconnected, socket, [this, socket]() {
+            --openConnections;
+            socket->deleteLater();
+        });
+    }
+};
 
 class tst_QNetworkAccessManager : public QObject
 {
@@ -42,6 +91,15 @@ public:
 
 private slots:
     void alwaysCacheRequest();
+    void connectionPoolConfiguration();
+    void connectionsPerHost_data();
+    void connectionsPerHost();
+    void preConnectCount();
+    void pipeliningDepth_data();
+    void pipeliningDepth();
+    void idleConnections_data();
+    void idleConnections();
+    void idleHostLimit();
 };
 
 tst_QNetworkAccessManager::tst_QNetworkAccessManager()
@@ -59,5 +117,245 @@ void tst_QNetworkAccessManager::alwaysCacheRequest()
     delete reply;
 }
 
+void tst_QNetworkAccessManager::connectionPoolConfiguration()
+{
+    QHttpConnectionPoolConfiguration configuration;
+    QCOMPARE(configuration.maximumConnectionsPerHost(), qsizetype(6));
+    QCOMPARE(configuration.maximumIdleHosts(), qsizetype(-1));
+    QCOMPARE(configuration.idleTimeout().count(), 120);
+    QCOMPARE(configuration.pipeliningDepth(), qsizetype(3));
+    QCOMPARE(configuration.preConnectCount(), qsizetype(1));
+
+    QNetworkAccessManager manager;
+    QCOMPARE(manager.connectionPoolConfiguration(), configuration);
+
+    QVERIFY(configuration.setMaximumConnectionsPerHost(100));
+    configuration.setMaximumIdleHosts(4);
+    QVERIFY(configuration.setIdleTimeout(5s));
+    QVERIFY(configuration.setPipeliningDepth(0));
+    QVERIFY(configuration.setPreConnectCount(8));
+
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: invalid number of connections per host");
+    QVERIFY(!configuration.setMaximumConnectionsPerHost(0));
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: invalid idle timeout");
+    QVERIFY(!configuration.setIdleTimeout(-1s));
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: invalid pipelining depth");
+    QVERIFY(!configuration.setPipeliningDepth(-1));
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: invalid pre-connect count");
+    QVERIFY(!configuration.setPreConnectCount(0));
+
+    QCOMPARE(configuration.maximumConnectionsPerHost(), qsizetype(100));
+    QCOMPARE(configuration.maximumIdleHosts(), qsizetype(4));
+    QCOMPARE(configuration.idleTimeout().count(), 5);
+    QCOMPARE(configuration.pipeliningDepth(), qsizetype(0));
+    QCOMPARE(configuration.preConnectCount(), qsizetype(8));
+
+    manager.setConnectionPoolConfiguration(configuration);
+    QCOMPARE(manager.connectionPoolConfiguration(), configuration);
+    QVERIFY(manager.connectionPoolConfiguration() != QHttpConnectionPoolConfiguration());
+
+    const QHttpConnectionPoolStatistics statistics = manager.connectionPoolStatistics();
+    QCOMPARE(statistics.poolHits(), quint64(0));
+    QCOMPARE(statistics.poolMisses(), quint64(0));
+    QCOMPARE(statistics.connectionsOpened(), quint64(0));
+    QCOMPARE(statistics.requestsDispatched(), quint64(0));
+}
+
+void tst_QNetworkAccessManager::connectionsPerHost_data()
+{
+    QTest::addColumn<int>("maximumConnections");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("3") << 3;
+    QTest::newRow("16") << 16;
+}
+
+void tst_QNetworkAccessManager::connectionsPerHost()
+{
+    QFETCH(int, maximumConnections);
+    const int requestCount = 12;
+
+    PoolTestServer server;
+    server.responseDelay = 50;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QHttpConnectionPoolConfiguration configuration;
+    QVERIFY(configuration.setMaximumConnectionsPerHost(maximumConnections));
+    QNetworkAccessManager manager;
+    manager.setConnectionPoolConfiguration(configuration);
+
+    const QUrl url(QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort()));
+    int finished = 0;
+    for (int i = 0; i < requestCount; ++i) {
+        QNetworkReply *reply = manager.get(QNetworkRequest(url));
+        connect(reply, &QNetworkReply::finished, reply, [reply, &finished]() {
+            QCOMPARE(reply->error(), QNetworkReply::NoError);
+            QCOMPARE(reply->readAll(), QByteArray("ok"));
+            ++finished;
+            reply->deleteLater();
+        });
+    }
+    QTRY_COMPARE_WITH_TIMEOUT(finished, requestCount, 20000);
+
+    const int expectedConnections = qMin(maximumConnections, requestCount);
+    QCOMPARE(server.acceptedConnections, expectedConnections);
+    QCOMPARE(server.requests, requestCount);
+
+    const QHttpConnectionPoolStatistics statistics = manager.connectionPoolStatistics();
+    QCOMPARE(statistics.poolMisses(), quint64(1));
+    QCOMPARE(statistics.poolHits(), quint64(requestCount - 1));
+    QCOMPARE(statistics.connectionsOpened(), quint64(expectedConnections));
+    QCOMPARE(statistics.requestsDispatched(), quint64(requestCount));
+    QVERIFY(statistics.maximumQueueWaitTime() <= statistics.totalQueueWaitTime());
+    if (maximumConnections == 1) {
+        // The last request waited for all the others to be answered
+        QVERIFY(statistics.maximumQueueWaitTime() >= 50ms * (requestCount - 1) / 2);
+    }
+}
+
+void tst_QNetworkAccessManager::preConnectCount()
+{
+    PoolTestServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QHttpConnectionPoolConfiguration configuration;
+    QVERIFY(configuration.setPreConnectCount(3));
+    QNetworkAccessManager manager;
+    manager.setConnectionPoolConfiguration(configuration);
+
+    manager.connectToHost(QStringLiteral("127.0.0.1"), server.serverPort());
+    QTRY_COMPARE(server.acceptedConnections, 3);
+    QTRY_COMPARE(manager.connectionPoolStatistics().connectionsOpened(), quint64(3));
+    QCOMPARE(server.requests, 0);
+
+    // The request is sent on one of the pre-connected connections
+    const QUrl url(QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort()));
+    std::unique_ptr<QNetworkReply> reply(manager.get(QNetworkRequest(url)));
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(server.acceptedConnections, 3);
+    QCOMPARE(manager.connectionPoolStatistics().connectionsOpened(), quint64(3));
+    QCOMPARE(manager.connectionPoolStatistics().poolMisses(), quint64(1));
+}
+
+void tst_QNetworkAccessManager::pipeliningDepth_data()
+{
+    QTest::addColumn<qsizetype>("depth");
+
+    QTest::newRow("disabled") << qsizetype(0);
+    QTest::newRow("1") << qsizetype(1);
+    QTest::newRow("default") << qsizetype(3);
+}
+
+void tst_QNetworkAccessManager::pipeliningDepth()
+{
+    QFETCH(qsizetype, depth);
+    const int requestCount = 8;
+
+    PoolTestServer server;
+    server.responseDelay = 50;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QHttpConnectionPoolConfiguration configuration;
+    QVERIFY(configuration.setMaximumConnectionsPerHost(1));
+    QVERIFY(configuration.setPipeliningDepth(depth));
+    QNetworkAccessManager manager;
+    manager.setConnectionPoolConfiguration(configuration);
+
+    QNetworkRequest request(QUrl(QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort())));
+    request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+
+    // Requests are pipelined once a response has shown that the server
+    // supports it
+    std::unique_ptr<QNetworkReply> reply(manager.get(request));
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    reply.reset();
+
+    int finished = 0;
+    for (int i = 0; i < requestCount; ++i) {
+        QNetworkReply *reply = manager.get(request);
+        connect(reply, &QNetworkReply::finished, reply, [reply, &finished]() {
+            QCOMPARE(reply->error(), QNetworkReply::NoError);
+            QCOMPARE(reply->readAll(), QByteArray("ok"));
+            ++finished;
+            reply->deleteLater();
+        });
+    }
+    QTRY_COMPARE_WITH_TIMEOUT(finished, requestCount, 20000);
+
+    QCOMPARE(server.acceptedConnections, 1);
+    QCOMPARE(server.requests, requestCount + 1);
+    // The request in flight, and up to depth requests behind it
+    QCOMPARE(server.maximumPendingResponses, int(depth) + 1);
+}
+
+void tst_QNetworkAccessManager::idleConnections_data()
+{
+    QTest::addColumn<qsizetype>("maximumIdleHosts");
+    QTest::addColumn<int>("idleTimeout");
+    QTest::addColumn<bool>("expectClosed");
+
+    QTest::newRow("default") << qsizetype(-1) << 120 << false;
+    QTest::newRow("no-idle-hosts") << qsizetype(0) << 120 << true;
+    QTest::newRow("zero-timeout") << qsizetype(-1) << 0 << true;
+}
+
+void tst_QNetworkAccessManager::idleConnections()
+{
+    QFETCH(qsizetype, maximumIdleHosts);
+    QFETCH(int, idleTimeout);
+    QFETCH(bool, expectClosed);
+
+    PoolTestServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QHttpConnectionPoolConfiguration configuration;
+    configuration.setMaximumIdleHosts(maximumIdleHosts);
+    QVERIFY(configuration.setIdleTimeout(std::chrono::seconds(idleTimeout)));
+    QNetworkAccessManager manager;
+    manager.setConnectionPoolConfiguration(configuration);
+
+    const QUrl url(QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort()));
+    std::unique_ptr<QNetworkReply> reply(manager.get(QNetworkRequest(url)));
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(server.acceptedConnections, 1);
+    reply.reset();
+
+    if (expectClosed) {
+        QTRY_COMPARE(server.openConnections, 0);
+    } else {
+        QTest::qWait(200);
+        QCOMPARE(server.openConnections, 1);
+    }
+}
+
+// Test that the hosts idle for the longest time are closed first
+void tst_QNetworkAccessManager::idleHostLimit()
+{
+    PoolTestServer servers[3];
+    for (PoolTestServer &server : servers)
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QHttpConnectionPoolConfiguration configuration;
+    configuration.setMaximumIdleHosts(2);
+    QNetworkAccessManager manager;
+    manager.setConnectionPoolConfiguration(configuration);
+
+    for (PoolTestServer &server : servers) {
+        const QUrl url(QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort()));
+        std::unique_ptr<QNetworkReply> reply(manager.get(QNetworkRequest(url)));
+        QTRY_VERIFY(reply->isFinished());
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+        QCOMPARE(server.acceptedConnections, 1);
+    }
+
+    QTRY_COMPARE(servers[0].openConnections, 0);
+    QTest::qWait(200);
+    QCOMPARE(servers[1].openConnections, 1);
+    QCOMPARE(servers[2].openConnections, 1);
+}
+
 QTEST_MAIN(tst_QNetworkAccessManager)
 #include "tst_qnetworkaccessmanager.moc"
@@ -0,0 +1,580 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+
+#include <QtNetwork/private/qnetworkhttpserver_p.h>
+#include <QtNetwork/private/bitstreams_p.h>
+#include <QtNetwork/private/hpack_p.h>
+#include <QtNetwork/private/http2frames_p.h>
+#include <QtNetwork/private/http2protocol_p.h>
+#include <QtNetwork/qnetworkaccessmanager.h>
+#include <QtNetwork/qnetworkreply.h>
+#include <QtNetwork/qnetworkrequest.h>
+#include <QtNetwork/qtcpsocket.h>
+
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qeventloop.h>
+#include <QtCore/qtimer.h>
+#include <QtCore/qurlquery.h>
+
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+Q_DECLARE_METATYPE(QNetworkRequest::Attribute)
+
+static void streamResponse(QNetworkHttpServerExchange *exchange, qint64 size)
+{
+    // Refills the response as it drains, never buffering more than 64K:
+    auto remaining = std::make_shared<qint64>(size);
+    auto refill = [exchange, remaining]() {
+        while (*remaining && exchange->bytesToWrite() < 64 * 1024) {
+            const qint64 chunk = qMin<qint64>(*remaining, 16 * 1024);
+            exchange->write(QByteArray(chunk, 'a'));
+            *remaining -= chunk;
+        }
+        if (!*remaining)
+            exchange->finish();
+    };
+    QObject::connect(exchange, &QIODevice::bytesWritten, exchange, refill);
+    refill();
+}
+
+static void handleRequest(QNetworkHttpServerExchange *exchange)
+{
+    const QString path = exchange->url().path();
+    const QUrlQuery query(exchange->url());
+    if (path == u"/hello") {
+        exchange->respond(200, "Hello, world", "text/plain");
+    } else if (path == u"/echo") {
+        // Streams the request body back while it is still arriving:
+        auto echo = [exchange]() {
+            exchange->write(exchange->readAll());
+            if (exchange->isRequestFinished())
+                exchange->finish();
+        };
+        QObject::connect(exchange, &QIODevice::readyRead, exchange, echo);
+        QObject::connect(exchange, &QIODevice::readChannelFinished, exchange, echo);
+        if (exchange->isRequestFinished())
+            echo();
+    } else if (path == u"/large") {
+        streamResponse(exchange, query.queryItemValue(u"size"_s).toLongLong());
+    } else if (path == u"/delayed") {
+        const int delay = query.queryItemValue(u"ms"_s).toInt();
+        QTimer::singleShot(delay, exchange, [exchange]() {
+            exchange->respond(200, exchange->target());
+        });
+    } else if (path == u"/method") {
+        exchange->setResponseHeader("X-Method", exchange->method());
+        exchange->respond(200, "body");
+    } else {
+        exchange->respond(404);
+    }
+}
+
+class tst_QNetworkHttpServer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+
+    void get_data();
+    void get();
+    void notFound_data();
+    void notFound();
+    void echo_data();
+    void echo();
+    void largeResponse_data();
+    void largeResponse();
+    void concurrentRequests_data();
+    void concurrentRequests();
+    void http2FlowControl();
+    void http2HeaderListSize();
+
+    void http1Pipelining();
+    void http1Chunked();
+    void http1ExpectContinue();
+    void http1Head();
+    void http10();
+    void http1BadRequest_data();
+    void http1BadRequest();
+    void noRequestHandler();
+    void closeWithQueuedConnection();
+
+private:
+    void addProtocolRows();
+    QNetworkRequest request(const QString &path) const;
+    void connectSocket(QTcpSocket *socket);
+    QByteArray exchange(const QByteArray &request, const QByteArray &until = QByteArray());
+
+    QNetworkHttpServer server;
+    QNetworkAccessManager manager;
+};
+
+void tst_QNetworkHttpServer::initTestCase()
+{
+    server.setWorkerThreadCount(2);
+    server.setRequestHandler(handleRequest);
+    QVERIFY2(server.listen(QHostAddress::LocalHost), qPrintable(server.errorString()));
+}
+
+void tst_QNetworkHttpServer::cleanupTestCase()
+{
+    server.close();
+    QVERIFY(!server.isListening());
+}
+
+void tst_QNetworkHttpServer::init()
+{
+    // Every test starts with a new connection, so that h2c upgrades happen:
+    manager.clearConnectionCache();
+}
+
+void tst_QNetworkHttpServer::addProtocolRows()
+{
+    QTest::addColumn<QNetworkRequest::Attribute>("attribute");
+    QTest::addColumn<bool>("http2");
+
+    QTest::addRow("http/1.1") << QNetworkRequest::Http2AllowedAttribute << false;
+    QTest::addRow("h2c-direct") << QNetworkRequest::Http2DirectAttribute << true;
+    QTest::addRow("h2c-upgrade") << QNetworkRequest::Http2AllowedAttribute << true;
+}
+
+QNetworkRequest tst_QNetworkHttpServer::request(const QString &path) const
+{
+    QFETCH(QNetworkRequest::Attribute, attribute);
+    QFETCH(bool, http2);
+
+    QUrl url;
+    url.setScheme(u"http"_s);
+    url.setHost(u"127.0.0.1"_s);
+    url.setPort(server.serverPort());
+    const qsizetype query = path.indexOf(u'?');
+    url.setPath(path.left(query));
+    if (query != -1)
+        url.setQuery(path.mid(query + 1));
+
+    QNetworkRequest request(url);
+    request.setAttribute(attribute, http2);
+    if (attribute == QNetworkRequest::Http2AllowedAttribute && http2)
+        request.setAttribute(QNetworkRequest::Http2CleartextAllowedAttribute, true);
+    return request;
+}
+
+// The server accepts connections in this thread, so the raw HTTP/1 tests
+// cannot use the blocking QTcpSocket functions.
+static QByteArray readUntil(QTcpSocket *socket, const QByteArray &until)
+{
+    QByteArray response;
+    QEventLoop loop;
+    QObject::connect(socket, &QIODevice::readyRead, &loop, [&]() {
+        response += socket->readAll();
+        if (!until.isEmpty() && response.contains(until))
+            loop.quit();
+    });
+    QObject::connect(socket, &QAbstractSocket::disconnected, &loop, &QEventLoop::quit);
+    QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+    if (socket->state() != QAbstractSocket::UnconnectedState)
+        loop.exec();
+    return response + socket->readAll();
+}
+
+void tst_QNetworkHttpServer::connectSocket(QTcpSocket *socket)
+{
+    socket->connectToHost(QHostAddress::LocalHost, server.serverPort());
+}
+
+QByteArray tst_QNetworkHttpServer::exchange(const QByteArray &request, const QByteArray &until)
+{
+    QTcpSocket socket;
+    connectSocket(&socket);
+    socket.write(request);
+    return readUntil(&socket, until);
+}
+
+void tst_QNetworkHttpServer::get_data()
+{
+    addProtocolRows();
+}
+
+void tst_QNetworkHttpServer::get()
+{
+    QFETCH(bool, http2);
+
+    std::unique_ptr<QNetworkReply> reply(manager.get(request(u"/hello"_s)));
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 200);
+    QCOMPARE(reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool(), http2);
+    QCOMPARE(reply->header(QNetworkRequest::ContentTypeHeader).toString(), u"text/plain"_s);
+    QCOMPARE(reply->header(QNetworkRequest::ContentLengthHeader).toLongLong(), 12);
+    QCOMPARE(reply->readAll(), QByteArray("Hello, world"));
+}
+
+void tst_QNetworkHttpServer::notFound_data()
+{
+    addProtocolRows();
+}
+
+void tst_QNetworkHttpServer::notFound()
+{
+    std::unique_ptr<QNetworkReply> reply(manager.get(request(u"/missing"_s)));
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::ContentNotFoundError);
+    QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 404);
+}
+
+void tst_QNetworkHttpServer::echo_data()
+{
+    addProtocolRows();
+}
+
+void tst_QNetworkHttpServer::echo()
+{
+    QByteArray body(1024 * 1024, Qt::Uninitialized);
+    for (qsizetype i = 0; i < body.size(); ++i)
+        body[i] = char(i % 251);
+
+    QNetworkRequest req = request(u"/echo"_s);
+    req.setHeader(QNetworkRequest::ContentTypeHeader, u"application/octet-stream"_s);
+    std::unique_ptr<QNetworkReply> reply(manager.post(req, body));
+    QTRY_VERIFY_WITH_TIMEOUT(reply->isFinished(), 10000);
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->readAll(), body);
+}
+
+void tst_QNetworkHttpServer::largeResponse_data()
+{
+    addProtocolRows();
+}
+
+void tst_QNetworkHttpServer::largeResponse()
+{
+    // Larger than the default HTTP/2 window of 64K, so the response has to
+    // wait for WINDOW_UPDATEs:
+    const qint64 size = 8 * 1024 * 1024;
+    std::unique_ptr<QNetworkReply> reply(
+            manager.get(request(u"/large?size="_s + QString::number(size))));
+    QTRY_VERIFY_WITH_TIMEOUT(reply->isFinished(), 20000);
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    const QByteArray data = reply->readAll();
+    QCOMPARE(data.size(), size);
+    QCOMPARE(data.count('a'), size);
+}
+
+void tst_QNetworkHttpServer::concurrentRequests_data()
+{
+    addProtocolRows();
+}
+
+void tst_QNetworkHttpServer::concurrentRequests()
+{
+    // Responses complete in reverse order:
+    const int count = 10;
+    std::vector<std::unique_ptr<QNetworkReply>> replies;
+    for (int i = 0; i < count; ++i) {
+        const QString path = u"/delayed?ms="_s + QString::number((count - i) * 10);
+        replies.emplace_back(manager.get(request(path)));
+    }
+
+    for (int i = 0; i < count; ++i) {
+        QNetworkReply *reply = replies[i].get();
+        QTRY_VERIFY(reply->isFinished());
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+        QCOMPARE(reply->readAll(), "/delayed?ms=" + QByteArray::number((count - i) * 10));
+    }
+}
+
+void tst_QNetworkHttpServer::http2FlowControl()
+{
+    // With the smallest receive windows, the upload only progresses as the
+    // handler reads it:
+    QHttp2Configuration configuration;
+    configuration.setStreamReceiveWindowSize(Http2::defaultSessionWindowSize);
+    configuration.setSessionReceiveWindowSize(Http2::defaultSessionWindowSize);
+    QNetworkHttpServer smallWindowServer;
+    smallWindowServer.setWorkerThreadCount(1);
+    smallWindowServer.setRequestHandler(handleRequest);
+    smallWindowServer.setHttp2Configuration(configuration);
+    QVERIFY(smallWindowServer.listen(QHostAddress::LocalHost));
+
+    const QByteArray body(1024 * 1024, 'b');
+    QNetworkRequest request(QUrl(u"http://127.0.0.1:%1/echo"_s.arg(smallWindowServer.serverPort())));
+    request.setAttribute(QNetworkRequest::Http2DirectAttribute, true);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, u"application/octet-stream"_s);
+    std::unique_ptr<QNetworkReply> reply(manager.post(request, body));
+    QTRY_VERIFY_WITH_TIMEOUT(reply->isFinished(), 10000);
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QVERIFY(reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool());
+    QCOMPARE(reply->readAll(), body);
+}
+
+// Reads the next frame from a raw HTTP/2 connection, running the event loop
+// until it is complete.
+static bool readFrame(QTcpSocket *socket, Http2::FrameReader *reader)
+{
+    QDeadlineTimer deadline(5000);
+    for (;;) {
+        switch (reader->read(*socket)) {
+        case Http2::FrameStatus::goodFrame:
+            return true;
+        case Http2::FrameStatus::incompleteFrame:
+            break;
+        default:
+            return false;
+        }
+        if (socket->state() == QAbstractSocket::UnconnectedState || deadline.hasExpired())
+            return false;
+        QEventLoop loop;
+        QObject::connect(socket, &QIODevice::readyRead, &loop, &QEventLoop::quit);
+        QObject::connect(socket, &QAbstractSocket::disconnected, &loop, &QEventLoop::quit);
+        QTimer::singleShot(deadline.remainingTime(), &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+}
+
+void tst_QNetworkHttpServer::http2HeaderListSize()
+{
+    using namespace Http2;
+
+    QTcpSocket socket;
+    connectSocket(&socket);
+    socket.write(Http2clientPreface, clientPrefaceLength);
+    FrameWriter writer(FrameType::SETTINGS, FrameFlag::EMPTY, connectionStreamID);
+    writer.write(socket);
+
+    // The server advertises the limit it enforces:
+    FrameReader reader;
+    QVERIFY(readFrame(&socket, &reader));
+    const Frame &settings = reader.inboundFrame();
+    QCOMPARE(settings.type(), FrameType::SETTINGS);
+    quint32 maxHeaderListSize = 0;
+    for (quint32 i = 0; i < settings.dataSize(); i += 6) {
+        const uchar *setting = settings.dataBegin() + i;
+        if (Settings(qFromBigEndian<quint16>(setting)) == Settings::MAX_HEADER_LIST_SIZE_ID)
+            maxHeaderListSize = qFromBigEndian<quint32>(setting + 2);
+    }
+    QCOMPARE(maxHeaderListSize, quint32(64 * 1024));
+
+    // A field repeated from the dynamic table makes for a small header block
+    // that decodes to more than the limit:
+    HPack::Encoder encoder(HPack::FieldLookupTable::DefaultSize, false);
+    const HPack::HttpHeader request = {
+        {":method", "GET"}, {":scheme", "http"}, {":authority", "127.0.0.1"}, {":path", "/hello"}
+    };
+    HPack::HttpHeader largeRequest = request;
+    for (int i = 0; i < 40; ++i)
+        largeRequest.push_back({"x-padding", QByteArray(2000, 'p')});
+    writer.start(FrameType::HEADERS, FrameFlag::END_HEADERS | FrameFlag::END_STREAM, 1);
+    HPack::BitOStream largeBlock(writer.outboundFrame().buffer);
+    QVERIFY(encoder.encodeRequest(largeBlock, largeRequest));
+    QVERIFY(writer.writeHEADERS(socket, minPayloadLimit));
+
+    // The stream is reset, but the connection stays usable:
+    writer.start(FrameType::HEADERS, FrameFlag::END_HEADERS | FrameFlag::END_STREAM, 3);
+    HPack::BitOStream block(writer.outboundFrame().buffer);
+    QVERIFY(encoder.encodeRequest(block, request));
+    QVERIFY(writer.writeHEADERS(socket, minPayloadLimit));
+
+    bool reset = false;
+    bool answered = false;
+    while (!answered && readFrame(&socket, &reader)) {
+        const Frame &frame = reader.inboundFrame();
+        if (frame.type() == FrameType::RST_STREAM && frame.streamID() == 1) {
+            QCOMPARE(qFromBigEndian<quint32>(frame.dataBegin()), quint32(PROTOCOL_ERROR));
+            reset = true;
+        }
+        QVERIFY(frame.type() != FrameType::GOAWAY);
+        answered = frame.type() == FrameType::HEADERS && frame.streamID() == 3;
+    }
+    QVERIFY(reset);
+    QVERIFY(answered);
+}
+
+void tst_QNetworkHttpServer::http1Pipelining()
+{
+    // The last request is answered first, but the responses keep the order of
+    // the requests:
+    const QByteArray response = exchange("GET /delayed?ms=200 HTTP/1.1\r\nHost: a\r\n\r\n"
+                                         "GET /delayed?ms=100 HTTP/1.1\r\nHost: a\r\n\r\n"
+                                         "GET /delayed?ms=0 HTTP/1.1\r\nHost: a\r\n\r\n",
+                                         "/delayed?ms=0");
+    const qsizetype first = response.indexOf("/delayed?ms=200");
+    const qsizetype second = response.indexOf("/delayed?ms=100");
+    const qsizetype third = response.indexOf("/delayed?ms=0");
+    QVERIFY2(first != -1 && first < second && second < third, response.constData());
+    QCOMPARE(response.count("HTTP/1.1 200 OK\r\n"), 3);
+}
+
+void tst_QNetworkHttpServer::http1Chunked()
+{
+    // A chunked request body, answered with a chunked response while the
+    // request is still arriving:
+    QTcpSocket socket;
+    connectSocket(&socket);
+    socket.write("POST /echo HTTP/1.1\r\nHost: a\r\n"
+                 "Transfer-Encoding: chunked\r\n\r\n"
+                 "5\r\nHello\r\n");
+    QByteArray response = readUntil(&socket, "Hello\r\n");
+    QVERIFY2(response.startsWith("HTTP/1.1 200 OK\r\n"), response.constData());
+    QVERIFY(response.contains("Transfer-Encoding: chunked\r\n"));
+
+    socket.write("7;ext=1\r\n, world\r\n"
+                 "0\r\nX-Trailer: 1\r\n\r\n");
+    response += readUntil(&socket, "0\r\n\r\n");
+
+    QByteArray decoded;
+    for (qsizetype pos = response.indexOf("\r\n\r\n") + 4;;) {
+        const qsizetype end = response.indexOf("\r\n", pos);
+        QVERIFY(end != -1);
+        bool ok = false;
+        const qsizetype size = response.mid(pos, end - pos).toLongLong(&ok, 16);
+        QVERIFY(ok);
+        if (!size)
+            break;
+        decoded += response.mid(end + 2, size);
+        pos = end + 2 + size + 2;
+    }
+    QCOMPARE(decoded, QByteArray("Hello, world"));
+}
+
+void tst_QNetworkHttpServer::http1ExpectContinue()
+{
+    QTcpSocket socket;
+    connectSocket(&socket);
+    socket.write("POST /echo HTTP/1.1\r\nHost: a\r\nContent-Length: 4\r\n"
+                 "Expect: 100-continue\r\n\r\n");
+    QCOMPARE(readUntil(&socket, "\r\n\r\n"), QByteArray("HTTP/1.1 100 Continue\r\n\r\n"));
+
+    socket.write("ping");
+    const QByteArray response = readUntil(&socket, "ping");
+    QVERIFY2(response.startsWith("HTTP/1.1 200 OK\r\n"), response.constData());
+    QVERIFY(response.contains("Content-Length: 4\r\n"));
+}
+
+void tst_QNetworkHttpServer::http1Head()
+{
+    const QByteArray response = exchange("HEAD /method HTTP/1.1\r\nHost: a\r\n\r\n"
+                                         "GET /method HTTP/1.1\r\nHost: a\r\n\r\n",
+                                         "X-Method: GET");
+    QVERIFY2(response.startsWith("HTTP/1.1 200 OK\r\n"), response.constData());
+    QVERIFY(response.contains("Content-Length: 4\r\n"));
+    const qsizetype head = response.indexOf("X-Method: HEAD\r\n");
+    QVERIFY(head != -1);
+    // No body between the two responses:
+    const qsizetype headEnd = response.indexOf("\r\n\r\n", head) + 4;
+    QVERIFY(response.mid(headEnd).startsWith("HTTP/1.1 200 OK\r\n"));
+}
+
+void tst_QNetworkHttpServer::http10()
+{
+    // The response is streamed, so the end of the body is marked by closing
+    // the connection:
+    const QByteArray response = exchange("GET /large?size=100000 HTTP/1.0\r\n\r\n");
+    QVERIFY2(response.startsWith("HTTP/1.1 200 OK\r\n"), response.left(200).constData());
+    QVERIFY(response.contains("Connection: close\r\n"));
+    QVERIFY(!response.contains("Transfer-Encoding"));
+    QCOMPARE(response.size() - (response.indexOf("\r\n\r\n") + 4), 100000);
+}
+
+void tst_QNetworkHttpServer::http1BadRequest_data()
+{
+    QTest::addColumn<QByteArray>("request");
+    QTest::addColumn<QByteArray>("status");
+
+    QTest::addRow("garbage") << QByteArray("nonsense\r\n\r\n") << QByteArray("400");
+    QTest::addRow("no-host") << QByteArray("GET / HTTP/1.1\r\n\r\n") << QByteArray("400");
+    QTest::addRow("http/2.0") << QByteArray("GET / HTTP/2.0\r\nHost: a\r\n\r\n")
+                              << QByteArray("505");
+    QTest::addRow("bad-length") << QByteArray("POST / HTTP/1.1\r\nHost: a\r\n"
+                                              "Content-Length: x\r\n\r\n")
+                                << QByteArray("400");
+    QTest::addRow("long-target") << "GET /" + QByteArray(10000, 'a') + " HTTP/1.1\r\n\r\n"
+                                 << QByteArray("414");
+    QTest::addRow("long-headers") << "GET / HTTP/1.1\r\nHost: a\r\n"
+                                     + QByteArray(70000, 'a') + "\r\n\r\n"
+                                  << QByteArray("431");
+}
+
+void tst_QNetworkHttpServer::http1BadRequest()
+{
+    QFETCH(QByteArray, request);
+    QFETCH(QByteArray, status);
+
+    QTcpSocket socket;
+    connectSocket(&socket);
+    socket.write(request);
+    const QByteArray response = readUntil(&socket, QByteArray());
+    QVERIFY2(response.startsWith("HTTP/1.1 " + status + ' '), response.constData());
+    QVERIFY(response.contains("Connection: close\r\n"));
+    QCOMPARE(socket.state(), QAbstractSocket::UnconnectedState);
+}
+
+void tst_QNetworkHttpServer::noRequestHandler()
+{
+    QNetworkHttpServer localServer;
+    localServer.setWorkerThreadCount(0);
+    QVERIFY(localServer.listen(QHostAddress::LocalHost));
+
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, localServer.serverPort());
+    socket.write("GET / HTTP/1.1\r\nHost: a\r\n\r\n");
+    const QByteArray response = readUntil(&socket, "\r\n\r\n");
+    QVERIFY2(response.startsWith("HTTP/1.1 404 "), response.constData());
+}
+
+void tst_QNetworkHttpServer::closeWithQueuedConnection()
+{
+    QNetworkHttpServer localServer;
+    localServer.setWorkerThreadCount(0);
+    localServer.setRequestHandler(handleRequest);
+    QVERIFY(localServer.listen(QHostAddress::LocalHost));
+
+    // Accepting the connection queues the call that starts serving it. If
+    // the server closes before that call ran, the socket is closed with it
+    // and not served later.
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, localServer.serverPort());
+    QVERIFY(socket.waitForConnected());
+    QCoreApplication::processEvents();
+    localServer.close();
+
+    socket.write("GET /hello HTTP/1.1\r\nHost: a\r\n\r\n");
+    QTRY_COMPARE(socket.state(), QAbstractSocket::UnconnectedState);
+    QVERIFY(!socket.readAll().contains("Hello, world"));
+}
+
+QTEST_MAIN(tst_QNetworkHttpServer)
+
+#include "tst_qnetworkhttpserver.moc"
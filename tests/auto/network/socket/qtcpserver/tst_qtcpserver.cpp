@@ -119,6 +119,8 @@ private slots:
 
     void pauseAccepting();
 
+    void portSharing();
+
 private:
     bool shouldSkipIpv6TestsForBrokenGetsockopt();
 #ifdef SHOULD_CHECK_SYSCALL_SUPPORT
@@ -140,6 +142,13 @@ void tst_QTcpServer::getSetCheck()
     QCOMPARE(INT_MIN, obj1.maxPendingConnections());
     obj1.setMaxPendingConnections(INT_MAX);
     QCOMPARE(INT_MAX, obj1.maxPendingConnections());
+    // bool QTcpServer::isPortSharingEnabled()
+    // void QTcpServer::setPortSharingEnabled(bool)
+    QCOMPARE(false, obj1.isPortSharingEnabled());
+    obj1.setPortSharingEnabled(true);
+    QCOMPARE(true, obj1.isPortSharingEnabled());
+    obj1.setPortSharingEnabled(false);
+    QCOMPARE(false, obj1.isPortSharingEnabled());
 }
 
 void tst_QTcpServer::initTestCase_data()
@@ -1083,5 +1092,58 @@ void tst_QTcpServer::pauseAccepting()
     QCOMPARE(spy.count(), 6);
 }
 
+void tst_QTcpServer::portSharing()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    const int NumSockets = 32;
+
+    QTcpServer server1;
+    server1.setPortSharingEnabled(true);
+    server1.setMaxPendingConnections(NumSockets);
+    if (!server1.listen(QHostAddress::LocalHost)) {
+        QCOMPARE(server1.serverError(), QAbstractSocket::UnsupportedSocketOperationError);
+        QSKIP("Port sharing is not supported on this platform");
+    }
+    const quint16 port = server1.serverPort();
+
+    // a server that does not share the port cannot listen on it
+    QTcpServer exclusiveServer;
+    QVERIFY(!exclusiveServer.listen(QHostAddress::LocalHost, port));
+    QCOMPARE(exclusiveServer.serverError(), QAbstractSocket::AddressInUseError);
+
+    QTcpServer server2;
+    server2.setPortSharingEnabled(true);
+    server2.setMaxPendingConnections(NumSockets);
+    QVERIFY2(server2.listen(QHostAddress::LocalHost, port), qPrintable(server2.errorString()));
+    QCOMPARE(server2.serverPort(), port);
+
+    int accepted1 = 0;
+    int accepted2 = 0;
+    connect(&server1, &QTcpServer::newConnection, this, [&] {
+        while (server1.hasPendingConnections()) {
+            delete server1.nextPendingConnection();
+            ++accepted1;
+        }
+    });
+    connect(&server2, &QTcpServer::newConnection, this, [&] {
+        while (server2.hasPendingConnections()) {
+            delete server2.nextPendingConnection();
+            ++accepted2;
+        }
+    });
+
+    QTcpSocket sockets[NumSockets];
+    for (QTcpSocket &socket : sockets)
+        socket.connectToHost(QHostAddress::LocalHost, port);
+    QTRY_COMPARE(accepted1 + accepted2, NumSockets);
+
+    // the kernel balances the connections between both listening sockets
+    QVERIFY(accepted1 > 0);
+    QVERIFY(accepted2 > 0);
+}
+
 QTEST_MAIN(tst_QTcpServer)
 #include "tst_qtcpserver.moc"
@@ -60,6 +60,7 @@
 #endif
 #include <QRandomGenerator>
 #include <QStringList>
+#include <QTemporaryFile>
 #include <QTcpServer>
 #include <QTcpSocket>
 #ifndef QT_NO_SSL
@@ -202,6 +203,10 @@ private slots:
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
     void readNotificationsAfterBind();
+    void sendFile_data();
+    void sendFile();
+    void sendFileClosedEarly();
+    void sendFileTruncated();
 
 protected slots:
     void nonBlockingIMAP_hostFound();
@@ -3236,5 +3241,121 @@ void tst_QTcpSocket::readNotificationsAfterBind()
     QCOMPARE(spyReadyRead.count(), 0);
 }
 
+static constexpr qint64 SendFileSize = 256 * 1024 + 7;
+
+static QByteArray sendFileContents()
+{
+    QByteArray contents(SendFileSize, Qt::Uninitialized);
+    for (qint64 i = 0; i < SendFileSize; ++i)
+        contents[i] = char(i * 7 + i / 251);
+    return contents;
+}
+
+void tst_QTcpSocket::sendFile_data()
+{
+    QTest::addColumn<qint64>("offset");
+    QTest::addColumn<qint64>("size");
+    QTest::addColumn<qint64>("expectedSize");
+
+    QTest::newRow("whole") << qint64(0) << qint64(-1) << SendFileSize;
+    QTest::newRow("range") << qint64(1000) << qint64(70000) << qint64(70000);
+    QTest::newRow("tail") << qint64(200000) << qint64(-1) << SendFileSize - 200000;
+    QTest::newRow("past-end") << qint64(250000) << qint64(100000) << SendFileSize - 250000;
+    QTest::newRow("empty") << qint64(1000) << qint64(0) << qint64(0);
+}
+
+// Test that files are sent in order with the data written around them
+void tst_QTcpSocket::sendFile()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+    QFETCH(qint64, offset);
+    QFETCH(qint64, size);
+    QFETCH(qint64, expectedSize);
+
+    const QByteArray contents = sendFileContents();
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(contents), SendFileSize);
+    QVERIFY(file.flush());
+
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+    socket->connectToHost(server.serverAddress(), server.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY(server.waitForNewConnection(5000));
+    std::unique_ptr<QTcpSocket> receiver(server.nextPendingConnection());
+    QVERIFY(receiver);
+
+    QByteArray received;
+    connect(receiver.get(), &QIODevice::readyRead, this, [&] { received += receiver->readAll(); });
+    qint64 bytesWritten = 0;
+    connect(socket.get(), &QIODevice::bytesWritten, this, [&](qint64 bytes) { bytesWritten += bytes; });
+
+    QCOMPARE(socket->write("head"), qint64(4));
+    QCOMPARE(socket->sendFile(&file, offset, size), expectedSize);
+    QCOMPARE(socket->bytesToWrite(), 4 + expectedSize);
+    QCOMPARE(socket->write("tail"), qint64(4));
+    QCOMPARE(socket->sendFile(&file, 0, 3), qint64(3));
+
+    const QByteArray expected = "head" + contents.mid(offset, expectedSize) + "tail"
+            + contents.left(3);
+    QTRY_COMPARE(received.size(), expected.size());
+    QCOMPARE(received, expected);
+    QTRY_COMPARE(bytesWritten, qint64(expected.size()));
+    QCOMPARE(socket->bytesToWrite(), qint64(0));
+    QCOMPARE(socket->state(), QAbstractSocket::ConnectedState);
+}
+
+// Test that closing a file before it has been sent aborts the connection
+void tst_QTcpSocket::sendFileClosedEarly()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(sendFileContents()), SendFileSize);
+    QVERIFY(file.flush());
+
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+    socket->connectToHost(server.serverAddress(), server.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+
+    QCOMPARE(socket->sendFile(&file), SendFileSize);
+    file.close();
+    QTRY_COMPARE(socket->state(), QAbstractSocket::UnconnectedState);
+    QCOMPARE(socket->error(), QAbstractSocket::UnknownSocketError);
+}
+
+// Test that a file shrinking before it has been sent aborts the connection
+void tst_QTcpSocket::sendFileTruncated()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(sendFileContents()), SendFileSize);
+    QVERIFY(file.flush());
+
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+    socket->connectToHost(server.serverAddress(), server.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+
+    QCOMPARE(socket->sendFile(&file), SendFileSize);
+    QVERIFY(file.resize(1000));
+    QTRY_COMPARE(socket->state(), QAbstractSocket::UnconnectedState);
+    QCOMPARE(socket->error(), QAbstractSocket::UnknownSocketError);
+}
+
 QTEST_MAIN(tst_QTcpSocket)
 #include "tst_qtcpsocket.moc"
@@ -107,6 +107,7 @@ private slots:
     void outOfProcessConnectedClientServerTest();
     void outOfProcessUnconnectedClientServerTest();
     void zeroLengthDatagram();
+    void readWriteDatagrams();
     void multicastTtlOption_data();
     void multicastTtlOption();
     void multicastLoopbackOption_data();
@@ -1260,6 +1261,66 @@ void tst_QUdpSocket::zeroLengthDatagram()
     QCOMPARE(receiver.readDatagram(&buf, 1), qint64(0));
 }
 
+void tst_QUdpSocket::readWriteDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+
+    // more than one batch of the native socket engine
+    QList<QNetworkDatagram> outgoing;
+    for (int i = 0; i < 70; ++i) {
+        const QByteArray payload = i == 5 ? QByteArray() : QByteArray::number(i).repeated(i + 1);
+        outgoing << QNetworkDatagram(payload, QHostAddress::LocalHost, receiver.localPort());
+    }
+
+    QUdpSocket sender;
+    QSignalSpy bytesWrittenSpy(&sender, &QUdpSocket::bytesWritten);
+    QCOMPARE(sender.writeDatagrams(outgoing.constData(), 0), qsizetype(0));
+    QCOMPARE(sender.writeDatagrams(outgoing.constData(), outgoing.size()), outgoing.size());
+    QCOMPARE(bytesWrittenSpy.count(), 1);
+    qint64 totalBytes = 0;
+    for (const QNetworkDatagram &datagram : std::as_const(outgoing))
+        totalBytes += datagram.data().size();
+    QCOMPARE(bytesWrittenSpy.at(0).at(0).toLongLong(), totalBytes);
+
+    QNetworkDatagram incoming[16];
+    qsizetype received = 0;
+    const char *firstBuffer = nullptr;
+    while (received < outgoing.size()) {
+        if (!receiver.hasPendingDatagrams())
+            QVERIFY2(receiver.waitForReadyRead(5000), QtNetworkSettings::msgSocketError(receiver).constData());
+        const qsizetype count = receiver.readDatagrams(incoming, std::size(incoming), 1024);
+        QVERIFY2(count > 0, QtNetworkSettings::msgSocketError(receiver).constData());
+        QVERIFY(count <= qsizetype(std::size(incoming)));
+
+        // the buffers are reused across calls
+        if (!firstBuffer)
+            firstBuffer = incoming[0].data().constData();
+        else
+            QCOMPARE(incoming[0].data().constData(), firstBuffer);
+
+        for (qsizetype i = 0; i < count; ++i, ++received) {
+            QVERIFY(incoming[i].isValid());
+            QCOMPARE(incoming[i].data(), outgoing.at(received).data());
+            QCOMPARE(incoming[i].senderAddress(), QHostAddress(QHostAddress::LocalHost));
+            QCOMPARE(incoming[i].senderPort(), int(sender.localPort()));
+            QCOMPARE(incoming[i].destinationPort(), int(receiver.localPort()));
+        }
+        for (qsizetype i = count; i < qsizetype(std::size(incoming)); ++i)
+            QVERIFY(incoming[i].data().isEmpty());
+    }
+    QCOMPARE(received, outgoing.size());
+
+    // nothing left to read
+    QVERIFY(!receiver.hasPendingDatagrams());
+    QCOMPARE(receiver.readDatagrams(incoming, std::size(incoming)), qsizetype(-1));
+    QCOMPARE(receiver.error(), QAbstractSocket::TemporaryError);
+}
+
 void tst_QUdpSocket::multicastTtlOption_data()
 {
     QTest::addColumn<QHostAddress>("bindAddress");
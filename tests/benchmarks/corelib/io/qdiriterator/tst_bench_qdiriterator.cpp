@@ -58,6 +58,8 @@ private slots:
     void posix_data() { data(); }
     void diriterator();
     void diriterator_data() { data(); }
+    void diriteratorParallel();
+    void diriteratorParallel_data() { data(); }
     void fsiterator();
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
@@ -203,6 +205,27 @@ void tst_QDirIterator::diriterator()
     qDebug() << count;
 }
 
+void tst_QDirIterator::diriteratorParallel()
+{
+    QFETCH(QByteArray, dirpath);
+
+    int count = 0;
+
+    QBENCHMARK {
+        int c = 0;
+
+        QDirIterator dir(dirpath, QDir::Files,
+                         QDirIterator::Subdirectories | QDirIterator::ParallelTraversal);
+
+        while (dir.hasNext()) {
+            dir.next();
+            ++c;
+        }
+        count = c;
+    }
+    qDebug() << count;
+}
+
 void tst_QDirIterator::fsiterator()
 {
     QFETCH(QByteArray, dirpath);
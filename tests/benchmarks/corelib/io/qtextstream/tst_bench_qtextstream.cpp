@@ -30,6 +30,8 @@
 #include <QIODevice>
 #include <QString>
 #include <QBuffer>
+#include <QFile>
+#include <QTemporaryFile>
 #include <qtest.h>
 
 class tst_QTextStream : public QObject
@@ -38,6 +40,8 @@ class tst_QTextStream : public QObject
 private slots:
     void writeSingleChar_data();
     void writeSingleChar();
+    void readLines_data();
+    void readLines();
 
 private:
 };
@@ -48,6 +52,9 @@ Q_DECLARE_METATYPE(Output);
 enum Input { CharStarInput, QStringInput, CharInput, QCharInput };
 Q_DECLARE_METATYPE(Input);
 
+enum LineReader { ReadLine, ReadLineInto, ReadLineView, ReadUtf8LineView };
+Q_DECLARE_METATYPE(LineReader);
+
 void tst_QTextStream::writeSingleChar_data()
 {
     QTest::addColumn<Output>("output");
@@ -115,6 +122,61 @@ void tst_QTextStream::writeSingleChar()
     QCOMPARE(result.left(10), QString("hhhhhhhhhh"));
 }
 
+void tst_QTextStream::readLines_data()
+{
+    QTest::addColumn<LineReader>("reader");
+
+    QTest::newRow("readLine") << ReadLine;
+    QTest::newRow("readLineInto") << ReadLineInto;
+    QTest::newRow("readLineView") << ReadLineView;
+    QTest::newRow("readUtf8LineView") << ReadUtf8LineView;
+}
+
+void tst_QTextStream::readLines()
+{
+    QFETCH(LineReader, reader);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    for (int i = 0; i < 100000; ++i)
+        file.write("2022-10-14 12:00:00 host service[" + QByteArray::number(i) + "]: message\n");
+    QVERIFY(file.flush());
+    QFile input(file.fileName());
+    QVERIFY(input.open(QIODevice::ReadOnly));
+
+    qsizetype total = 0;
+    QBENCHMARK {
+        QVERIFY(input.seek(0));
+        QTextStream stream(&input);
+        total = 0;
+        switch (reader) {
+        case ReadLine:
+            while (!stream.atEnd())
+                total += stream.readLine().size();
+            break;
+        case ReadLineInto: {
+            QString line;
+            while (stream.readLineInto(&line))
+                total += line.size();
+            break;
+        }
+        case ReadLineView:
+            for (QStringView line = stream.readLineView(); !line.isNull();
+                 line = stream.readLineView()) {
+                total += line.size();
+            }
+            break;
+        case ReadUtf8LineView:
+            for (QUtf8StringView line = stream.readUtf8LineView(); !line.isNull();
+                 line = stream.readUtf8LineView()) {
+                total += line.size();
+            }
+            break;
+        }
+    }
+    QVERIFY(total > 0);
+}
+
 QTEST_MAIN(tst_QTextStream)
 
 #include "tst_bench_qtextstream.moc"
@@ -29,6 +29,7 @@
 #include <QTest>
 #include <QVariantMap>
 #include <qjsondocument.h>
+#include <qjsonarray.h>
 #include <qjsonobject.h>
 
 class BenchmarkQtJson: public QObject
@@ -46,6 +47,8 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseThroughput_data();
+    void parseThroughput();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -118,6 +121,47 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+void BenchmarkQtJson::parseThroughput_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    // about 8 MB each, see the row names for the bytes per iteration
+    QJsonArray records;
+    for (int i = 0; i < 40000; ++i) {
+        records.append(QJsonObject {
+            { "id", i },
+            { "name", QString("record number %1").arg(i) },
+            { "description", QString("Some longer text that is typical for a log message or a "
+                                     "description field in a JSON document, number %1").arg(i) },
+            { "value", i * 0.25 },
+            { "tags", QJsonArray { "alpha", "beta", "gamma" } },
+            { "active", i % 2 == 0 },
+        });
+    }
+    const QJsonDocument doc(records);
+    const QByteArray compact = doc.toJson(QJsonDocument::Compact);
+    const QByteArray indented = doc.toJson(QJsonDocument::Indented);
+    QTest::addRow("compact-%lld", qlonglong(compact.size())) << compact;
+    QTest::addRow("indented-%lld", qlonglong(indented.size())) << indented;
+
+    QJsonArray strings;
+    for (int i = 0; i < 20000; ++i)
+        strings.append(QString("\u00e9l\u00e8ve \"%1\"\tcaf\u00e9 \u20ac %1 ").arg(i).repeated(8));
+    const QByteArray escaped = QJsonDocument(strings).toJson(QJsonDocument::Compact);
+    QTest::addRow("escaped-%lld", qlonglong(escaped.size())) << escaped;
+}
+
+void BenchmarkQtJson::parseThroughput()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
@@ -29,12 +29,25 @@
 #include <qtest.h>
 #include <qcoreapplication.h>
 
+#include <memory>
+#include <vector>
+
 class tst_QCoreApplication : public QObject
 {
 Q_OBJECT
 private slots:
     void event_posting_benchmark_data();
     void event_posting_benchmark();
+    void cross_thread_signals_data();
+    void cross_thread_signals();
+};
+
+class Emitter : public QObject
+{
+    Q_OBJECT
+signals:
+    void ping(int value);
+    void finished();
 };
 
 void tst_QCoreApplication::event_posting_benchmark_data()
@@ -64,6 +77,53 @@ void tst_QCoreApplication::event_posting_benchmark()
     }
 }
 
+void tst_QCoreApplication::cross_thread_signals_data()
+{
+    QTest::addColumn<int>("producers");
+    QTest::addColumn<bool>("coalesced");
+    for (bool coalesced : {false, true}) {
+        const char *mode = coalesced ? "coalesced" : "queued";
+        QTest::addRow("1 producer, %s", mode) << 1 << coalesced;
+        QTest::addRow("2 producers, %s", mode) << 2 << coalesced;
+        QTest::addRow("4 producers, %s", mode) << 4 << coalesced;
+        QTest::addRow("8 producers, %s", mode) << 8 << coalesced;
+    }
+}
+
+void tst_QCoreApplication::cross_thread_signals()
+{
+    QFETCH(int, producers);
+    QFETCH(bool, coalesced);
+    constexpr int signalCount = 200000;
+    const auto type = coalesced ? Qt::ConnectionType(Qt::QueuedConnection | Qt::CoalescedConnection)
+                                : Qt::QueuedConnection;
+
+    // benchmark queued signal delivery from other threads to this one
+    QObject receiver;
+    QBENCHMARK {
+        QEventLoop loop;
+        int finished = 0;
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < producers; ++i) {
+            threads.emplace_back(QThread::create([&, producers] {
+                Emitter emitter;
+                connect(&emitter, &Emitter::ping, &receiver, [](int) {}, type);
+                connect(&emitter, &Emitter::finished, &receiver, [&] {
+                    if (++finished == producers)
+                        loop.quit();
+                }, Qt::QueuedConnection);
+                for (int j = 0; j < signalCount / producers; ++j)
+                    emit emitter.ping(j);
+                emit emitter.finished();
+            }));
+            threads.back()->start();
+        }
+        loop.exec();
+        for (const auto &thread : threads)
+            thread->wait();
+    }
+}
+
 QTEST_MAIN(tst_QCoreApplication)
 
 #include "tst_bench_qcoreapplication.moc"
@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QTimer>
+#include <QTest>
+#include <QTestEventLoop>
+
+#include <memory>
+#include <vector>
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void restartTimers_data();
+    void restartTimers();
+    void startStopTimers_data() { restartTimers_data(); }
+    void startStopTimers();
+    void fireWithManyIdleTimers_data() { restartTimers_data(); }
+    void fireWithManyIdleTimers();
+};
+
+// Many connections, each with an idle or keep-alive timer of a few seconds
+// up to a minute, is the load the timer list has to cope with in servers.
+static std::vector<std::unique_ptr<QTimer>> createTimers(int count, Qt::TimerType type)
+{
+    std::vector<std::unique_ptr<QTimer>> timers;
+    timers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto timer = std::make_unique<QTimer>();
+        timer->setTimerType(type);
+        timer->setInterval(5000 + (i * 7919) % 55000);
+        timers.push_back(std::move(timer));
+    }
+    return timers;
+}
+
+void tst_QTimer::restartTimers_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Qt::TimerType>("type");
+
+    for (int count : { 100, 1000, 10000, 50000 }) {
+        QTest::addRow("precise-%d", count) << count << Qt::PreciseTimer;
+        QTest::addRow("coarse-%d", count) << count << Qt::CoarseTimer;
+        QTest::addRow("verycoarse-%d", count) << count << Qt::VeryCoarseTimer;
+    }
+}
+
+void tst_QTimer::restartTimers()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+
+    auto timers = createTimers(count, type);
+    for (auto &timer : timers)
+        timer->start();
+
+    // restarting an active timer unregisters and registers it again, which
+    // is what happens on every read from a connection with an idle timeout
+    QBENCHMARK {
+        for (auto &timer : timers)
+            timer->start();
+    }
+}
+
+void tst_QTimer::startStopTimers()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+
+    auto timers = createTimers(count, type);
+
+    QBENCHMARK {
+        for (auto &timer : timers)
+            timer->start();
+        for (auto &timer : timers)
+            timer->stop();
+    }
+}
+
+void tst_QTimer::fireWithManyIdleTimers()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+
+    auto timers = createTimers(count, type);
+    for (auto &timer : timers)
+        timer->start();
+
+    // the cost of finding the next timer to wait for and of activating the
+    // due ones must not depend on the number of idle timers
+    QTimer ticker;
+    ticker.setTimerType(Qt::PreciseTimer);
+    int ticks = 0;
+    connect(&ticker, &QTimer::timeout, this, [&ticks] {
+        if (++ticks == 100)
+            QTestEventLoop::instance().exitLoop();
+    });
+
+    QBENCHMARK {
+        ticks = 0;
+        ticker.start(0);
+        QTestEventLoop::instance().enterLoop(10);
+        ticker.stop();
+        QVERIFY(!QTestEventLoop::instance().timeout());
+    }
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "tst_bench_qtimer.moc"
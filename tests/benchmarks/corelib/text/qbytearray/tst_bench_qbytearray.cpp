@@ -30,6 +30,8 @@
 #include <QIODevice>
 #include <QFile>
 #include <QString>
+#include <QByteArrayMatcher>
+#include <QLocale>
 
 #include <qtest.h>
 #include <limits>
@@ -56,6 +58,12 @@ private slots:
 
     void toPercentEncoding_data();
     void toPercentEncoding();
+
+    void multiPatternSearch_data();
+    void multiPatternSearch();
+
+    void numberToCsv_data();
+    void numberToCsv();
 };
 
 void tst_QByteArray::initTestCase()
@@ -378,6 +386,92 @@ void tst_QByteArray::toPercentEncoding()
     QTEST(encoded, "expected");
 }
 
+void tst_QByteArray::multiPatternSearch_data()
+{
+    QTest::addColumn<bool>("combined");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    QTest::newRow("QByteArrayMatcher-each") << false << Qt::CaseSensitive;
+    QTest::newRow("QMultiByteArrayMatcher") << true << Qt::CaseSensitive;
+    QTest::newRow("QMultiByteArrayMatcher-ci") << true << Qt::CaseInsensitive;
+}
+
+void tst_QByteArray::multiPatternSearch()
+{
+    QFETCH(bool, combined);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    const QList<QByteArray> keywords = {
+        "QBENCHMARK", "QFETCH", "QTest", "QVERIFY", "const", "return", "void", "while",
+        "template", "static", "qsizetype", "nullptr", "\r\n", "//", "/*", "*/",
+    };
+    const QByteArray data = sourcecode.repeated(16);
+
+    qsizetype found = 0;
+    if (combined) {
+        const QMultiByteArrayMatcher matcher(keywords, cs);
+        QBENCHMARK {
+            found = 0;
+            for (auto match = matcher.indexIn(data); match.isValid();
+                 match = matcher.indexIn(data, match.position + match.length)) {
+                ++found;
+            }
+        }
+    } else {
+        QList<QByteArrayMatcher> matchers;
+        for (const QByteArray &keyword : keywords)
+            matchers.append(QByteArrayMatcher(keyword));
+        QBENCHMARK {
+            found = 0;
+            for (const QByteArrayMatcher &matcher : matchers) {
+                for (qsizetype i = matcher.indexIn(data); i >= 0;
+                     i = matcher.indexIn(data, i + matcher.pattern().size())) {
+                    ++found;
+                }
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QByteArray::numberToCsv_data()
+{
+    QTest::addColumn<bool>("append");
+    QTest::addColumn<int>("precision");
+
+    QTest::newRow("number, 6 digits") << false << 6;
+    QTest::newRow("appendNumber, 6 digits") << true << 6;
+    QTest::newRow("number, shortest") << false << int(QLocale::FloatingPointShortest);
+    QTest::newRow("appendNumber, shortest") << true << int(QLocale::FloatingPointShortest);
+}
+
+void tst_QByteArray::numberToCsv()
+{
+    QFETCH(bool, append);
+    QFETCH(int, precision);
+
+    QList<double> values;
+    for (int i = 0; i < 10000; ++i)
+        values.append(i * 0.731 - 2500.0 / (i + 1));
+
+    QByteArray csv;
+    QBENCHMARK {
+        csv.clear();
+        int row = 0;
+        for (double value : values) {
+            if (append) {
+                csv.appendNumber(++row).append(',').appendNumber(value, 'g', precision);
+            } else {
+                csv += QByteArray::number(++row);
+                csv += ',';
+                csv += QByteArray::number(value, 'g', precision);
+            }
+            csv += '\n';
+        }
+    }
+    QCOMPARE(csv.count('\n'), values.size());
+}
+
 QTEST_MAIN(tst_QByteArray)
 
 #include "tst_bench_qbytearray.moc"
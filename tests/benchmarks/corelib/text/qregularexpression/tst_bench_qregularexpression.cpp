@@ -58,6 +58,7 @@ private slots:
     void matchDefaultOptimized();
 
     void matchCustom();
+    void matchCustomUncached();
     void matchCustomOptimized();
 
     void globalMatchDefault();
@@ -70,8 +71,21 @@ private slots:
     void queryMatchResultsByGroupIndex();
     void queryMatchResultsByGroupName();
     void iterateThroughGlobalMatchResults();
+
+    void globalMatchLargeText();
+    void globalMatchParallelLargeText();
+    void streamMatcherLargeText();
 };
 
+static QString largeText()
+{
+    QString text;
+    text.reserve((textToMatch.size() + 8) * 50000);
+    for (int i = 0; i < 50000; ++i)
+        text += textToMatch + u'\n' + QString::number(i) + u'\n';
+    return text;
+}
+
 void tst_QRegularExpressionBenchmark::createDefault()
 {
     QBENCHMARK {
@@ -149,7 +163,8 @@ void tst_QRegularExpressionBenchmark::matchDefaultOptimized()
     with pattern compilation for an object with custom pattern and pattern
     options.
     We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    does not get cached in the object; it is still taken from the
+    process-wide QRegularExpressionCache.
 */
 void tst_QRegularExpressionBenchmark::matchCustom()
 {
@@ -160,6 +175,23 @@ void tst_QRegularExpressionBenchmark::matchCustom()
     }
 }
 
+/*!
+    \internal This benchmark is the same as matchCustom(), but with the
+    QRegularExpressionCache disabled, so that the pattern is really compiled
+    every time.
+*/
+void tst_QRegularExpressionBenchmark::matchCustomUncached()
+{
+    const qsizetype capacity = QRegularExpressionCache::capacity();
+    QRegularExpressionCache::setCapacity(0);
+    QBENCHMARK {
+        QRegularExpression re(nonEmptyPattern, nonEmptyPatternOptions);
+        auto matchResult = re.match(textToMatch);
+        Q_UNUSED(matchResult);
+    }
+    QRegularExpressionCache::setCapacity(capacity);
+}
+
 /*!
     \internal This benchmark measures the performance of the match() without
     pattern compilation for an object with custom pattern and pattern
@@ -295,6 +327,51 @@ void tst_QRegularExpressionBenchmark::iterateThroughGlobalMatchResults()
     }
 }
 
+/*!
+    \internal The following benchmarks find all the matches in a text of a
+    few megabytes sequentially, in parallel, and by feeding it in chunks.
+*/
+void tst_QRegularExpressionBenchmark::globalMatchLargeText()
+{
+    const QString text = largeText();
+    QRegularExpression re(nonEmptyPattern, nonEmptyPatternOptions);
+    re.optimize();
+    QBENCHMARK {
+        qsizetype count = 0;
+        for (const QRegularExpressionMatch &match : re.globalMatch(text)) {
+            Q_UNUSED(match);
+            ++count;
+        }
+        QCOMPARE(count, 50000 * 4);
+    }
+}
+
+void tst_QRegularExpressionBenchmark::globalMatchParallelLargeText()
+{
+    const QString text = largeText();
+    QRegularExpression re(nonEmptyPattern, nonEmptyPatternOptions);
+    re.optimize();
+    QBENCHMARK {
+        const auto matches = re.globalMatchParallel(text);
+        QCOMPARE(matches.size(), 50000 * 4);
+    }
+}
+
+void tst_QRegularExpressionBenchmark::streamMatcherLargeText()
+{
+    const QString text = largeText();
+    QRegularExpression re(nonEmptyPattern, nonEmptyPatternOptions);
+    re.optimize();
+    QBENCHMARK {
+        QRegularExpressionStreamMatcher matcher(re);
+        qsizetype count = 0;
+        for (qsizetype i = 0; i < text.size(); i += 64 * 1024)
+            count += matcher.feed(QStringView(text).mid(i, 64 * 1024)).size();
+        count += matcher.finish().size();
+        QCOMPARE(count, 50000 * 4);
+    }
+}
+
 QTEST_MAIN(tst_QRegularExpressionBenchmark)
 
 #include "tst_bench_qregularexpression.moc"
@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QStringDecoder>
+#include <QTest>
+
+class tst_QStringConverter : public QObject
+{
+    Q_OBJECT
+
+    void corpora_data() const;
+
+private slots:
+    void fromUtf8_data() const { corpora_data(); }
+    void fromUtf8() const;
+    void toUtf8_data() const { corpora_data(); }
+    void toUtf8() const;
+    void isValidUtf8_data() const { corpora_data(); }
+    void isValidUtf8() const;
+    void decoderChunked_data() const { corpora_data(); }
+    void decoderChunked() const;
+};
+
+void tst_QStringConverter::corpora_data() const
+{
+    QTest::addColumn<QString>("text");
+
+    const auto addRow = [](const char *name, QStringView sample) {
+        // about 64 KiB of text in each corpus
+        QString text;
+        while (text.size() < 64 * 1024)
+            text += sample;
+        QTest::newRow(name) << text;
+    };
+
+    addRow("english", u"The quick brown fox jumps over the lazy dog. Pack my box with five "
+                      u"dozen liquor jugs! How vexingly quick daft zebras jump. ");
+    addRow("french", u"Voix ambiguë d'un cœur qui, au zéphyr, préfère les jattes de kiwis. "
+                     u"Où êtes-vous allés cet été ? À la fête de Noël, déjà. ");
+    addRow("german", u"Zwölf Boxkämpfer jagen Viktor quer über den großen Sylter Deich. "
+                     u"Falsches Üben von Xylophonmusik quält jeden größeren Zwerg. ");
+    addRow("greek", u"Ξεσκεπάζω την ψυχοφθόρα βδελυγμία. Γαζέες καὶ μυρτιὲς δὲν θὰ βρῶ "
+                    u"πιὰ στὸ χρυσαφὶ ξέφωτο. ");
+    addRow("russian", u"Съешь же ещё этих мягких французских булок, да выпей чаю. "
+                      u"В чащах юга жил бы цитрус? Да, но фальшивый экземпляр! ");
+    addRow("arabic", u"نص حكيم له سر قاطع وذو شأن عظيم مكتوب على ثوب أخضر ومغلف بجلد أزرق. ");
+    addRow("hebrew", u"דג סקרן שט בים מאוכזב ולפתע מצא חברה. עטלף אבק נס דרך מזגן שהתפוצץ כי חם. ");
+    addRow("chinese", u"我能吞下玻璃而不伤身体。天地玄黄，宇宙洪荒。日月盈昃，辰宿列张。"
+                      u"寒来暑往，秋收冬藏。闰余成岁，律吕调阳。");
+    addRow("japanese", u"いろはにほへと ちりぬるを わかよたれそ つねならむ うゐのおくやま "
+                       u"けふこえて あさきゆめみし ゑひもせす（京）。");
+    addRow("korean", u"키스의 고유조건은 입술끼리 만나야 하고 특별한 기술은 필요치 않다. "
+                     u"다람쥐 헌 쳇바퀴에 타고파. ");
+    addRow("emoji", u"😀😃😄😁😆😅🤣😂🙂🙃😉😊😇🥰😍🤩😘😗☺😚😙🥲😋😛😜🤪😝🤑🤗🤭 ");
+    addRow("mixed-html", u"<li class=\"item\"><a href=\"/zh/新闻\">新闻</a> · "
+                         u"<a href=\"/ru/новости\">новости</a> · "
+                         u"<a href=\"/el/ειδήσεις\">ειδήσεις</a> 👍</li>\n");
+}
+
+void tst_QStringConverter::fromUtf8() const
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+
+    QString result;
+    QBENCHMARK {
+        result = QString::fromUtf8(utf8);
+    }
+    QCOMPARE(result, text);
+}
+
+void tst_QStringConverter::toUtf8() const
+{
+    QFETCH(QString, text);
+
+    QByteArray result;
+    QBENCHMARK {
+        result = text.toUtf8();
+    }
+    QCOMPARE(QString::fromUtf8(result), text);
+}
+
+void tst_QStringConverter::isValidUtf8() const
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+
+    bool valid = false;
+    QBENCHMARK {
+        valid = utf8.isValidUtf8();
+    }
+    QVERIFY(valid);
+}
+
+void tst_QStringConverter::decoderChunked() const
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+    constexpr qsizetype ChunkSize = 4096;
+
+    QString result;
+    QBENCHMARK {
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        result.clear();
+        for (qsizetype i = 0; i < utf8.size(); i += ChunkSize) {
+            const QByteArrayView chunk(utf8.constData() + i, qMin(ChunkSize, utf8.size() - i));
+            result += decoder.decode(chunk);
+        }
+    }
+    QCOMPARE(result, text);
+}
+
+QTEST_MAIN(tst_QStringConverter)
+#include "tst_bench_qstringconverter.moc"
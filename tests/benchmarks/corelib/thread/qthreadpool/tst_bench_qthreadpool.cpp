@@ -40,6 +40,10 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void shortRunnables_data();
+    void shortRunnables();
+    void nestedRunnables_data();
+    void nestedRunnables();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,6 +79,76 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+static void addScalingRows()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("workStealing");
+
+    QList<int> threadCounts = { 1, 2, 4, 8, 16, 32, 64 };
+    const int ideal = QThread::idealThreadCount();
+    threadCounts.erase(std::remove_if(threadCounts.begin(), threadCounts.end(),
+                                      [ideal](int n) { return n > ideal; }),
+                       threadCounts.end());
+    if (!threadCounts.contains(ideal))
+        threadCounts.append(ideal);
+
+    for (int n : qAsConst(threadCounts)) {
+        QTest::addRow("%d-shared", n) << n << false;
+        QTest::addRow("%d-stealing", n) << n << true;
+    }
+}
+
+void tst_QThreadPool::shortRunnables_data()
+{
+    addScalingRows();
+}
+
+// many tiny runnables started from outside the pool
+void tst_QThreadPool::shortRunnables()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, workStealing);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    threadPool.setWorkStealingEnabled(workStealing);
+
+    QAtomicInt counter;
+    QBENCHMARK {
+        for (int i = 0; i < 100000; ++i)
+            threadPool.start([&counter] { counter.ref(); });
+        threadPool.waitForDone();
+    }
+}
+
+void tst_QThreadPool::nestedRunnables_data()
+{
+    addScalingRows();
+}
+
+// one runnable per thread, each starting many tiny runnables, as nested
+// QtConcurrent::run() calls would
+void tst_QThreadPool::nestedRunnables()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, workStealing);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    threadPool.setWorkStealingEnabled(workStealing);
+
+    QAtomicInt counter;
+    QBENCHMARK {
+        for (int i = 0; i < threadCount; ++i) {
+            threadPool.start([&threadPool, &counter, threadCount] {
+                for (int j = 0; j < 200000 / threadCount; ++j)
+                    threadPool.start([&counter] { counter.ref(); });
+            });
+        }
+        threadPool.waitForDone();
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QTest>
+
+#include <private/qarraydataarena_p.h>
+
+#include <optional>
+
+class tst_QArrayData : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void smallAllocations_data();
+    void smallAllocations();
+    void parseRequest_data();
+    void parseRequest();
+
+private:
+    void arenaData();
+};
+
+void tst_QArrayData::arenaData()
+{
+    QTest::addColumn<bool>("arena");
+    QTest::newRow("malloc") << false;
+    QTest::newRow("arena") << true;
+}
+
+void tst_QArrayData::smallAllocations_data()
+{
+    arenaData();
+}
+
+void tst_QArrayData::smallAllocations()
+{
+    QFETCH(bool, arena);
+
+    QBENCHMARK {
+        std::optional<QArrayDataArena> scope;
+        if (arena)
+            scope.emplace();
+        QList<QByteArray> list;
+        list.reserve(10000);
+        for (int i = 0; i < 10000; ++i)
+            list.append(QByteArray(16 + i % 32, 'x'));
+    }
+}
+
+void tst_QArrayData::parseRequest_data()
+{
+    arenaData();
+}
+
+void tst_QArrayData::parseRequest()
+{
+    QFETCH(bool, arena);
+
+    // something that looks like a batch of HTTP requests
+    QByteArray input;
+    for (int i = 0; i < 100; ++i) {
+        input += "GET /api/v1/items/" + QByteArray::number(i) + " HTTP/1.1\r\n"
+                 "Host: example.com\r\n"
+                 "User-Agent: tst_bench_qarraydata\r\n"
+                 "Accept: application/json\r\n"
+                 "X-Request-Id: " + QByteArray::number(i * 7919) + "\r\n"
+                 "\r\n";
+    }
+
+    qsizetype headers = 0;
+    QBENCHMARK {
+        std::optional<QArrayDataArena> scope;
+        if (arena)
+            scope.emplace();
+        const QList<QByteArray> lines = input.split('\n');
+        QList<QPair<QString, QString>> fields;
+        for (const QByteArray &line : lines) {
+            const QByteArray trimmed = line.trimmed();
+            const qsizetype colon = trimmed.indexOf(':');
+            if (colon < 0)
+                continue;
+            fields.append({ QString::fromLatin1(trimmed.left(colon)).toLower(),
+                            QString::fromUtf8(trimmed.mid(colon + 1).trimmed()) });
+        }
+        headers += fields.size();
+    }
+    QVERIFY(headers > 0);
+}
+
+QTEST_MAIN(tst_QArrayData)
+
+#include "tst_bench_qarraydata.moc"
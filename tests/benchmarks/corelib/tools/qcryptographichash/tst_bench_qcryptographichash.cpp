@@ -31,6 +31,7 @@
 #include <QFile>
 #include <QRandomGenerator>
 #include <QString>
+#include <QTemporaryFile>
 #include <QTest>
 
 #include <time.h>
@@ -50,6 +51,8 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void addDataFile_data();
+    void addDataFile();
 };
 
 const int MaxCryptoAlgorithm = QCryptographicHash::Sha3_512;
@@ -104,6 +107,8 @@ const char *algoname(int i)
         return "blake2s_224-";
     case QCryptographicHash::Blake2s_256:
         return "blake2s_256-";
+    case QCryptographicHash::Blake3_256:
+        return "blake3_256-";
     }
     Q_UNREACHABLE();
     return nullptr;
@@ -183,6 +188,36 @@ void tst_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_QCryptographicHash::addDataFile_data()
+{
+    QTest::addColumn<int>("algorithm");
+
+    for (int algo : { QCryptographicHash::Md5, QCryptographicHash::Sha1,
+                      QCryptographicHash::Sha256, QCryptographicHash::Sha512,
+                      QCryptographicHash::Blake2b_256, QCryptographicHash::Blake3_256 }) {
+        QTest::newRow(algoname(algo)) << algo;
+    }
+}
+
+void tst_QCryptographicHash::addDataFile()
+{
+    QFETCH(int, algorithm);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    for (int i = 0; i < 256; ++i)
+        QCOMPARE(file.write(blockOfData), qint64(MaxBlockSize));
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QCryptographicHash hash(algo);
+    QBENCHMARK {
+        hash.reset();
+        QVERIFY(file.seek(0));
+        QVERIFY(hash.addData(&file));
+        hash.result();
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QCryptographicHash)
 
 #include "tst_bench_qcryptographichash.moc"
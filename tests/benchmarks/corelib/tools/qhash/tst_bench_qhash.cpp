@@ -36,6 +36,10 @@
 #include <QUuid>
 #include <QTest>
 
+#include <private/qflathash_p.h>
+
+#include <algorithm>
+#include <random>
 
 class tst_QHash : public QObject
 {
@@ -61,10 +65,17 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void lookup_int_data();
+    void lookup_int();
+    void lookup_string_data();
+    void lookup_string();
+
 private:
     void data();
     template <typename String> void qhash_template();
     template <typename String> void hashing_template();
+    template <typename Hash, typename Key>
+    void lookup_template(const QList<Key> &keys, const QList<Key> &lookups);
 
     QStringList smallFilePaths;
     QStringList uuids;
@@ -169,6 +180,82 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+void tst_QHash::lookup_int_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("flat");
+    for (bool flat : {false, true}) {
+        const char *container = flat ? "QFlatHash" : "QHash";
+        for (int size : {1000, 100000, 1000000, 4000000})
+            QTest::addRow("%s-%d", container, size) << size << flat;
+    }
+}
+
+void tst_QHash::lookup_string_data()
+{
+    QTest::addColumn<QStringList>("items");
+    QTest::addColumn<bool>("flat");
+    for (bool flat : {false, true}) {
+        const char *container = flat ? "QFlatHash" : "QHash";
+        QTest::addRow("%s-paths-small", container) << smallFilePaths << flat;
+        QTest::addRow("%s-uuids-list", container) << uuids << flat;
+        QTest::addRow("%s-dictionary", container) << dict << flat;
+        QTest::addRow("%s-numbers", container) << numbers << flat;
+    }
+}
+
+template <typename Hash, typename Key>
+void tst_QHash::lookup_template(const QList<Key> &keys, const QList<Key> &lookups)
+{
+    Hash hash;
+    for (int i = 0, n = keys.size(); i != n; ++i)
+        hash.insert(keys.at(i), i);
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        for (const Key &key : lookups)
+            found += hash.contains(key);
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QHash::lookup_int()
+{
+    QFETCH(int, size);
+    QFETCH(bool, flat);
+
+    // insert the even numbers, then look up all numbers in a shuffled
+    // order, so that half of the lookups miss
+    QList<int> keys;
+    keys.reserve(size);
+    for (int i = 0; i < size; ++i)
+        keys.append(i * 2);
+    QList<int> lookups;
+    lookups.reserve(2 * size);
+    for (int i = 0; i < 2 * size; ++i)
+        lookups.append(i);
+    std::shuffle(lookups.begin(), lookups.end(), std::mt19937(size));
+
+    if (flat)
+        lookup_template<QFlatHash<int, int>>(keys, lookups);
+    else
+        lookup_template<QHash<int, int>>(keys, lookups);
+}
+
+void tst_QHash::lookup_string()
+{
+    QFETCH(QStringList, items);
+    QFETCH(bool, flat);
+
+    QStringList lookups = items;
+    std::shuffle(lookups.begin(), lookups.end(), std::mt19937(items.size()));
+
+    if (flat)
+        lookup_template<QFlatHash<QString, int>>(items, lookups);
+    else
+        lookup_template<QHash<QString, int>>(items, lookups);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "tst_bench_qhash.moc"
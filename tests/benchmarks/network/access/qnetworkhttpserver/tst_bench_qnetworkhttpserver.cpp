@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtNetwork/private/qnetworkhttpserver_p.h>
+#include <QtNetwork/qnetworkaccessmanager.h>
+#include <QtNetwork/qnetworkreply.h>
+#include <QtNetwork/qnetworkrequest.h>
+
+#include <QtTest/QTest>
+
+#include <QtCore/qeventloop.h>
+#include <QtCore/qtimer.h>
+
+using namespace Qt::StringLiterals;
+
+// Load against a server on the loopback interface; the client (QNAM) runs
+// in its own thread, the server in its worker threads.
+
+static void handleRequest(QNetworkHttpServerExchange *exchange)
+{
+    const QByteArray target = exchange->target();
+    if (target.startsWith("/bytes/"))
+        exchange->respond(200, QByteArray(target.mid(7).toInt(), 'x'), "text/plain");
+    else
+        exchange->respond(404);
+}
+
+class tst_QNetworkHttpServer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void requests_data();
+    void requests();
+
+private:
+    QNetworkHttpServer server;
+};
+
+void tst_QNetworkHttpServer::initTestCase()
+{
+    server.setRequestHandler(handleRequest);
+    QVERIFY2(server.listen(QHostAddress::LocalHost), qPrintable(server.errorString()));
+}
+
+void tst_QNetworkHttpServer::requests_data()
+{
+    QTest::addColumn<bool>("http2");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("size");
+
+    for (bool http2 : {false, true}) {
+        const char *protocol = http2 ? "h2c" : "http/1.1";
+        QTest::addRow("%s-1000x100B", protocol) << http2 << 1000 << 100;
+        QTest::addRow("%s-100x64KB", protocol) << http2 << 100 << 64 * 1024;
+        QTest::addRow("%s-4x8MB", protocol) << http2 << 4 << 8 * 1024 * 1024;
+    }
+}
+
+void tst_QNetworkHttpServer::requests()
+{
+    QFETCH(bool, http2);
+    QFETCH(int, count);
+    QFETCH(int, size);
+
+    QNetworkRequest request(QUrl(u"http://127.0.0.1:%1/bytes/%2"_s.arg(server.serverPort())
+                                                                  .arg(size)));
+    request.setAttribute(QNetworkRequest::Http2DirectAttribute, http2);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+
+    QNetworkAccessManager manager;
+    QBENCHMARK {
+        // All requests are queued at once: HTTP/1.1 spreads them over six
+        // connections, HTTP/2 multiplexes them over one.
+        int finished = 0;
+        qint64 received = 0;
+        QEventLoop loop;
+        for (int i = 0; i < count; ++i) {
+            QNetworkReply *reply = manager.get(request);
+            connect(reply, &QNetworkReply::finished, &loop, [&, reply]() {
+                if (reply->error() == QNetworkReply::NoError)
+                    received += reply->readAll().size();
+                reply->deleteLater();
+                if (++finished == count)
+                    loop.quit();
+            });
+        }
+        QTimer::singleShot(60000, &loop, &QEventLoop::quit);
+        loop.exec();
+        QCOMPARE(finished, count);
+        QCOMPARE(received, qint64(count) * size);
+    }
+}
+
+QTEST_MAIN(tst_QNetworkHttpServer)
+
+#include "tst_bench_qnetworkhttpserver.moc"
@@ -28,6 +28,8 @@
 
 #include <QTest>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QThread>
 #include <qglobal.h>
 #include <qcoreapplication.h>
 #include <qtcpsocket.h>
@@ -59,6 +61,8 @@ private slots:
     void ipv4LoopbackPerformanceTest();
     void ipv6LoopbackPerformanceTest();
     void ipv4PerformanceTest();
+    void connectionRate_data();
+    void connectionRate();
 };
 
 tst_QTcpServer::tst_QTcpServer()
@@ -82,8 +86,6 @@ void tst_QTcpServer::initTestCase_data()
 
 void tst_QTcpServer::initTestCase()
 {
-    if (!QtNetworkSettings::verifyTestNetworkSettings())
-        QSKIP("No network test server available");
 }
 
 void tst_QTcpServer::init()
@@ -215,6 +217,9 @@ void tst_QTcpServer::ipv6LoopbackPerformanceTest()
 //----------------------------------------------------------------------------------
 void tst_QTcpServer::ipv4PerformanceTest()
 {
+    if (!QtNetworkSettings::verifyTestNetworkSettings())
+        QSKIP("No network test server available");
+
     QTcpSocket probeSocket;
     probeSocket.connectToHost(QtNetworkSettings::serverName(), 143);
     QVERIFY(probeSocket.waitForConnected(5000));
@@ -262,5 +267,78 @@ void tst_QTcpServer::ipv4PerformanceTest()
     delete clientB;
 }
 
+//----------------------------------------------------------------------------------
+void tst_QTcpServer::connectionRate_data()
+{
+    QTest::addColumn<int>("shards");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("2") << 2;
+    QTest::newRow("4") << 4;
+    QTest::newRow("8") << 8;
+}
+
+void tst_QTcpServer::connectionRate()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+    QFETCH(int, shards);
+
+    // One server per thread, all listening on the same port. Each accepts
+    // and closes the connections the kernel hands to it.
+    const int NumSockets = 200;
+    QAtomicInt accepted;
+    std::vector<std::unique_ptr<QThread>> threads;
+    std::vector<std::unique_ptr<QTcpServer>> servers;
+    auto cleanup = qScopeGuard([&] {
+        for (auto &server : servers) {
+            QTcpServer *s = server.release();
+            QMetaObject::invokeMethod(s, [s] { delete s; }, Qt::BlockingQueuedConnection);
+        }
+        for (auto &thread : threads) {
+            thread->quit();
+            thread->wait();
+        }
+    });
+    quint16 port = 0;
+    for (int i = 0; i < shards; ++i) {
+        auto server = std::make_unique<QTcpServer>();
+        server->setPortSharingEnabled(shards > 1);
+        server->setMaxPendingConnections(NumSockets);
+        server->setListenBacklogSize(NumSockets);
+        if (!server->listen(QHostAddress::LocalHost, port)) {
+            if (server->serverError() == QAbstractSocket::UnsupportedSocketOperationError)
+                QSKIP("Port sharing is not supported on this platform");
+            QFAIL(qPrintable(server->errorString()));
+        }
+        port = server->serverPort();
+        QTcpServer *s = server.get();
+        connect(s, &QTcpServer::newConnection, s, [s, &accepted] {
+            while (QTcpSocket *socket = s->nextPendingConnection()) {
+                delete socket;
+                accepted.ref();
+            }
+        });
+
+        auto thread = std::make_unique<QThread>();
+        server->moveToThread(thread.get());
+        thread->start();
+        threads.push_back(std::move(thread));
+        servers.push_back(std::move(server));
+    }
+
+    QBENCHMARK {
+        accepted.storeRelaxed(0);
+        std::vector<std::unique_ptr<QTcpSocket>> sockets(NumSockets);
+        for (auto &socket : sockets) {
+            socket = std::make_unique<QTcpSocket>();
+            socket->connectToHost(QHostAddress::LocalHost, port);
+        }
+        QTRY_COMPARE_WITH_TIMEOUT(accepted.loadRelaxed(), NumSockets, 30000);
+    }
+
+}
+
 QTEST_MAIN(tst_QTcpServer)
 #include "tst_qtcpserver.moc"
@@ -41,6 +41,8 @@ public:
 private slots:
     void pendingDatagramSize_data();
     void pendingDatagramSize();
+    void sendReceiveDatagrams_data();
+    void sendReceiveDatagrams();
 };
 
 tst_QUdpSocket::tst_QUdpSocket()
@@ -76,5 +78,47 @@ void tst_QUdpSocket::pendingDatagramSize()
     }
 }
 
+void tst_QUdpSocket::sendReceiveDatagrams_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::addColumn<int>("size");
+    for (int size : {64, 1400}) {
+        QTest::addRow("single-%d", size) << false << size;
+        QTest::addRow("batched-%d", size) << true << size;
+    }
+}
+
+void tst_QUdpSocket::sendReceiveDatagrams()
+{
+    QFETCH(bool, batched);
+    QFETCH(int, size);
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+    QUdpSocket sender;
+
+    constexpr int Count = 64;
+    QList<QNetworkDatagram> outgoing(Count, QNetworkDatagram(QByteArray(size, 'a'),
+                                                             QHostAddress::LocalHost,
+                                                             receiver.localPort()));
+    QNetworkDatagram incoming[Count];
+
+    QBENCHMARK {
+        if (batched) {
+            QCOMPARE(sender.writeDatagrams(outgoing.constData(), Count), qsizetype(Count));
+            qsizetype received = 0;
+            while (received < Count) {
+                const qsizetype count = receiver.readDatagrams(incoming, Count - received, size);
+                QVERIFY(count > 0);
+                received += count;
+            }
+        } else {
+            for (const QNetworkDatagram &datagram : std::as_const(outgoing))
+                QCOMPARE(sender.writeDatagram(datagram), qint64(size));
+            for (int i = 0; i < Count; ++i)
+                QVERIFY(receiver.receiveDatagram(size).isValid());
+        }
+    }
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"